@@ -95,6 +95,7 @@
 #include <boost/asio/version.hpp>
 #include <boost/asio/wait_traits.hpp>
 #include <boost/asio/waitable_timer_service.hpp>
+#include <boost/asio/wheel_time_traits.hpp>
 #include <boost/asio/windows/basic_handle.hpp>
 #include <boost/asio/windows/basic_object_handle.hpp>
 #include <boost/asio/windows/basic_random_access_handle.hpp>
@@ -878,6 +878,390 @@ public:
     this->get_service().async_receive_from(this->get_implementation(), buffers,
         sender_endpoint, flags, BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
   }
+
+#if !defined(BOOST_ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
+  /// Send a batch of datagrams to the specified endpoints.
+  /**
+   * This function is used to send several datagrams using a single system
+   * call where the platform supports it (@c sendmmsg on Linux). The function
+   * call will block until at least one datagram has been sent successfully or
+   * an error occurs.
+   *
+   * @param buffers A sequence of buffers, each of which contains the data for
+   * one datagram. At most 64 datagrams are sent in a single call.
+   *
+   * @param destinations An array of endpoints with at least as many elements
+   * as there are buffers. The datagram in the nth buffer is sent to the nth
+   * endpoint.
+   *
+   * @returns The number of datagrams sent. This may be less than the number
+   * of buffers.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   *
+   * @note Not available when using I/O completion ports on Windows.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_to_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().send_to_batch(
+        this->get_implementation(), buffers, destinations, 0, ec);
+    boost::asio::detail::throw_error(ec, "send_to_batch");
+    return s;
+  }
+
+  /// Send a batch of datagrams to the specified endpoints.
+  /**
+   * This function is used to send several datagrams using a single system
+   * call where the platform supports it. The function call will block until
+   * at least one datagram has been sent successfully or an error occurs.
+   *
+   * @param buffers A sequence of buffers, each of which contains the data for
+   * one datagram. At most 64 datagrams are sent in a single call.
+   *
+   * @param destinations An array of endpoints with at least as many elements
+   * as there are buffers.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @returns The number of datagrams sent.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_to_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations, socket_base::message_flags flags)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().send_to_batch(
+        this->get_implementation(), buffers, destinations, flags, ec);
+    boost::asio::detail::throw_error(ec, "send_to_batch");
+    return s;
+  }
+
+  /// Send a batch of datagrams to the specified endpoints.
+  /**
+   * This function is used to send several datagrams using a single system
+   * call where the platform supports it. The function call will block until
+   * at least one datagram has been sent successfully or an error occurs.
+   *
+   * @param buffers A sequence of buffers, each of which contains the data for
+   * one datagram. At most 64 datagrams are sent in a single call.
+   *
+   * @param destinations An array of endpoints with at least as many elements
+   * as there are buffers.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of datagrams sent.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_to_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations, socket_base::message_flags flags,
+      boost::system::error_code& ec)
+  {
+    return this->get_service().send_to_batch(this->get_implementation(),
+        buffers, destinations, flags, ec);
+  }
+
+  /// Start an asynchronous batched send.
+  /**
+   * This function is used to asynchronously send several datagrams using a
+   * single system call where the platform supports it. The function call
+   * always returns immediately.
+   *
+   * @param buffers A sequence of buffers, each of which contains the data for
+   * one datagram. At most 64 datagrams are sent in a single operation.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param destinations An array of endpoints with at least as many elements
+   * as there are buffers. Ownership of the array is retained by the caller,
+   * which must guarantee that it is valid until the handler is called.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred        // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename ConstBufferSequence, typename WriteHandler>
+  void async_send_to_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    this->get_service().async_send_to_batch(this->get_implementation(),
+        buffers, destinations, 0, BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+  /// Start an asynchronous batched send.
+  /**
+   * This function is used to asynchronously send several datagrams using a
+   * single system call where the platform supports it. The function call
+   * always returns immediately.
+   *
+   * @param buffers A sequence of buffers, each of which contains the data for
+   * one datagram. At most 64 datagrams are sent in a single operation.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param destinations An array of endpoints with at least as many elements
+   * as there are buffers. Ownership of the array is retained by the caller,
+   * which must guarantee that it is valid until the handler is called.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred        // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename ConstBufferSequence, typename WriteHandler>
+  void async_send_to_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations, socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    this->get_service().async_send_to_batch(this->get_implementation(),
+        buffers, destinations, flags,
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+  /// Receive a batch of datagrams with the endpoints of their senders.
+  /**
+   * This function is used to receive several datagrams using a single system
+   * call where the platform supports it (@c recvmmsg on Linux). The function
+   * call will block until at least one datagram has been received
+   * successfully or an error occurs. Datagrams that are already queued on the
+   * socket are then received without blocking.
+   *
+   * @param buffers A sequence of buffers, each of which receives one datagram.
+   * At most 64 datagrams are received in a single call.
+   *
+   * @param sender_endpoints An array of endpoints with at least as many
+   * elements as there are buffers. The nth element receives the endpoint of
+   * the sender of the nth datagram.
+   *
+   * @param sizes An array with at least as many elements as there are
+   * buffers. The nth element receives the size of the nth datagram.
+   *
+   * @returns The number of datagrams received.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   *
+   * @par Example
+   * @code
+   * boost::array<char, 1500> data[16];
+   * boost::array<boost::asio::mutable_buffer, 16> bufs;
+   * for (std::size_t i = 0; i < 16; ++i)
+   *   bufs[i] = boost::asio::buffer(data[i]);
+   * boost::asio::ip::udp::endpoint senders[16];
+   * std::size_t sizes[16];
+   * std::size_t n = socket.receive_from_batch(bufs, senders, sizes);
+   * @endcode
+   *
+   * @note Not available when using I/O completion ports on Windows.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().receive_from_batch(
+        this->get_implementation(), buffers, sender_endpoints, sizes, 0, ec);
+    boost::asio::detail::throw_error(ec, "receive_from_batch");
+    return s;
+  }
+
+  /// Receive a batch of datagrams with the endpoints of their senders.
+  /**
+   * This function is used to receive several datagrams using a single system
+   * call where the platform supports it. The function call will block until
+   * at least one datagram has been received successfully or an error occurs.
+   *
+   * @param buffers A sequence of buffers, each of which receives one datagram.
+   * At most 64 datagrams are received in a single call.
+   *
+   * @param sender_endpoints An array of endpoints with at least as many
+   * elements as there are buffers.
+   *
+   * @param sizes An array with at least as many elements as there are
+   * buffers, which receives the size of each datagram.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @returns The number of datagrams received.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      socket_base::message_flags flags)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().receive_from_batch(
+        this->get_implementation(), buffers, sender_endpoints, sizes,
+        flags, ec);
+    boost::asio::detail::throw_error(ec, "receive_from_batch");
+    return s;
+  }
+
+  /// Receive a batch of datagrams with the endpoints of their senders.
+  /**
+   * This function is used to receive several datagrams using a single system
+   * call where the platform supports it. The function call will block until
+   * at least one datagram has been received successfully or an error occurs.
+   *
+   * @param buffers A sequence of buffers, each of which receives one datagram.
+   * At most 64 datagrams are received in a single call.
+   *
+   * @param sender_endpoints An array of endpoints with at least as many
+   * elements as there are buffers.
+   *
+   * @param sizes An array with at least as many elements as there are
+   * buffers, which receives the size of each datagram.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of datagrams received.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    return this->get_service().receive_from_batch(this->get_implementation(),
+        buffers, sender_endpoints, sizes, flags, ec);
+  }
+
+  /// Start an asynchronous batched receive.
+  /**
+   * This function is used to asynchronously receive several datagrams using a
+   * single system call where the platform supports it. The function call
+   * always returns immediately. The operation completes once, when at least
+   * one datagram has been received.
+   *
+   * @param buffers A sequence of buffers, each of which receives one datagram.
+   * At most 64 datagrams are received in a single operation. Although the
+   * buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the handler is called.
+   *
+   * @param sender_endpoints An array of endpoints with at least as many
+   * elements as there are buffers. Ownership of the array is retained by the
+   * caller, which must guarantee that it is valid until the handler is called.
+   *
+   * @param sizes An array with at least as many elements as there are
+   * buffers, which receives the size of each datagram. Ownership of the array
+   * is retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred        // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename MutableBufferSequence, typename ReadHandler>
+  void async_receive_from_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    this->get_service().async_receive_from_batch(this->get_implementation(),
+        buffers, sender_endpoints, sizes, 0,
+        BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+
+  /// Start an asynchronous batched receive.
+  /**
+   * This function is used to asynchronously receive several datagrams using a
+   * single system call where the platform supports it. The function call
+   * always returns immediately. The operation completes once, when at least
+   * one datagram has been received.
+   *
+   * @param buffers A sequence of buffers, each of which receives one datagram.
+   * At most 64 datagrams are received in a single operation. Although the
+   * buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the handler is called.
+   *
+   * @param sender_endpoints An array of endpoints with at least as many
+   * elements as there are buffers. Ownership of the array is retained by the
+   * caller, which must guarantee that it is valid until the handler is called.
+   *
+   * @param sizes An array with at least as many elements as there are
+   * buffers, which receives the size of each datagram. Ownership of the array
+   * is retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred        // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename MutableBufferSequence, typename ReadHandler>
+  void async_receive_from_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    this->get_service().async_receive_from_batch(this->get_implementation(),
+        buffers, sender_endpoints, sizes, flags,
+        BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+#endif // !defined(BOOST_ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
 };
 
 } // namespace asio
@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 #include <cstddef>
+#include <boost/cstdint.hpp>
 #include <boost/asio/basic_socket.hpp>
 #include <boost/asio/detail/handler_type_requirements.hpp>
 #include <boost/asio/detail/throw_error.hpp>
@@ -364,6 +365,125 @@ public:
         BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
   }
 
+#if defined(BOOST_ASIO_HAS_SEND_FILE) || defined(GENERATING_DOCUMENTATION)
+  /// Send a region of a file on the socket.
+  /**
+   * This function is used to send the contents of a file on the stream socket
+   * without first copying them into user-space buffers. The function call will
+   * block until the whole region has been sent, or until an error occurs.
+   *
+   * On Linux the data is transferred using @c sendfile, or using @c splice if
+   * @c fd refers to a pipe. Other platforms, and file descriptors that support
+   * neither call, fall back to reading the file into an internal buffer. While
+   * a pipe is empty the call waits for more data to be written to it. No
+   * @c SIGPIPE signal is raised if the connection has been closed by the peer.
+   *
+   * @param fd An open file descriptor from which the data will be read. The
+   * file offset of the descriptor is not changed.
+   *
+   * @param offset The offset within the file at which to start reading.
+   *
+   * @param size The number of bytes to send.
+   *
+   * @returns The number of bytes sent.
+   *
+   * @throws boost::system::system_error Thrown on failure. An error code of
+   * boost::asio::error::eof indicates that the end of the file was reached
+   * before @c size bytes were sent.
+   *
+   * @note Unlike send(), this operation sends the whole region before
+   * completing, in the same way as the @ref write function.
+   */
+  std::size_t send_file(int fd, boost::uint64_t offset, std::size_t size)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().send_file(
+        this->get_implementation(), fd, offset, size, ec);
+    boost::asio::detail::throw_error(ec, "send_file");
+    return s;
+  }
+
+  /// Send a region of a file on the socket.
+  /**
+   * This function is used to send the contents of a file on the stream socket
+   * without first copying them into user-space buffers. The function call will
+   * block until the whole region has been sent, or until an error occurs.
+   *
+   * @param fd An open file descriptor from which the data will be read. The
+   * file offset of the descriptor is not changed.
+   *
+   * @param offset The offset within the file at which to start reading.
+   *
+   * @param size The number of bytes to send.
+   *
+   * @param ec Set to indicate what error occurred, if any. An error code of
+   * boost::asio::error::eof indicates that the end of the file was reached
+   * before @c size bytes were sent.
+   *
+   * @returns The number of bytes sent. If an error occurs, returns the number
+   * of bytes sent prior to the error.
+   */
+  std::size_t send_file(int fd, boost::uint64_t offset,
+      std::size_t size, boost::system::error_code& ec)
+  {
+    return this->get_service().send_file(
+        this->get_implementation(), fd, offset, size, ec);
+  }
+
+  /// Start an asynchronous send of a region of a file.
+  /**
+   * This function is used to asynchronously send the contents of a file on
+   * the stream socket without first copying them into user-space buffers. The
+   * function call always returns immediately. The operation continues after
+   * partial writes and completes when the whole region has been sent, or when
+   * an error occurs.
+   *
+   * @param fd An open file descriptor from which the data will be read. The
+   * file offset of the descriptor is not changed. The caller must ensure that
+   * the descriptor remains open until the handler is called. If @c fd refers
+   * to an empty pipe, the operation waits for more data to be written to it.
+   *
+   * @param offset The offset within the file at which to start reading.
+   *
+   * @param size The number of bytes to send.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post(). An error code of boost::asio::error::eof
+   * indicates that the end of the file was reached before @c size bytes were
+   * sent.
+   *
+   * @note Only one asynchronous send_file operation may be outstanding on the
+   * socket at a time. Starting another one fails with
+   * boost::asio::error::already_started.
+   *
+   * @par Example
+   * @code
+   * int fd = ::open("blob.bin", O_RDONLY);
+   * socket.async_send_file(fd, 0, file_size, handler);
+   * @endcode
+   */
+  template <typename WriteHandler>
+  void async_send_file(int fd, boost::uint64_t offset, std::size_t size,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    this->get_service().async_send_file(this->get_implementation(),
+        fd, offset, size, BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE) || defined(GENERATING_DOCUMENTATION)
+
   /// Receive some data on the socket.
   /**
    * This function is used to receive data on the stream socket. The function
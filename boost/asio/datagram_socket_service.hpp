@@ -359,6 +359,50 @@ public:
         BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
   }
 
+#if !defined(BOOST_ASIO_HAS_IOCP)
+  /// Send a batch of datagrams to the specified endpoints.
+  template <typename ConstBufferSequence>
+  std::size_t send_to_batch(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type* destinations,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    return service_impl_.send_to_batch(impl, buffers, destinations, flags, ec);
+  }
+
+  /// Start an asynchronous batched send.
+  template <typename ConstBufferSequence, typename WriteHandler>
+  void async_send_to_batch(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type* destinations,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    service_impl_.async_send_to_batch(impl, buffers, destinations, flags,
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+  /// Receive a batch of datagrams with the endpoints of their senders.
+  template <typename MutableBufferSequence>
+  std::size_t receive_from_batch(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoints,
+      std::size_t* sizes, socket_base::message_flags flags,
+      boost::system::error_code& ec)
+  {
+    return service_impl_.receive_from_batch(impl, buffers,
+        sender_endpoints, sizes, flags, ec);
+  }
+
+  /// Start an asynchronous batched receive.
+  template <typename MutableBufferSequence, typename ReadHandler>
+  void async_receive_from_batch(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoints,
+      std::size_t* sizes, socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    service_impl_.async_receive_from_batch(impl, buffers, sender_endpoints,
+        sizes, flags, BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
 private:
   // Destroy all user-defined handler objects owned by the service.
   void shutdown_service()
@@ -262,7 +262,34 @@
 # endif // defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0400)
 #endif // defined(BOOST_WINDOWS) || defined(__CYGWIN__)
 
-// Linux: epoll, eventfd and timerfd.
+// Per-thread handler queues with work stealing in the task_io_service.
+#if defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+# if defined(BOOST_HAS_THREADS) && !defined(BOOST_ASIO_DISABLE_THREADS)
+#  define BOOST_ASIO_HAS_WORK_STEALING 1
+# endif // defined(BOOST_HAS_THREADS) && !defined(BOOST_ASIO_DISABLE_THREADS)
+#endif // defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+# if !defined(BOOST_ASIO_WORK_STEALING_CHECK_USEC)
+#  define BOOST_ASIO_WORK_STEALING_CHECK_USEC 1000
+# endif // !defined(BOOST_ASIO_WORK_STEALING_CHECK_USEC)
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
+// Busy-polling in the task_io_service before a thread blocks.
+#if defined(BOOST_ASIO_ENABLE_BUSY_POLL)
+# if !defined(BOOST_ASIO_HAS_IOCP)
+#  if !defined(BOOST_WINDOWS) && !defined(__CYGWIN__)
+#   define BOOST_ASIO_HAS_BUSY_POLL 1
+#  endif // !defined(BOOST_WINDOWS) && !defined(__CYGWIN__)
+# endif // !defined(BOOST_ASIO_HAS_IOCP)
+#endif // defined(BOOST_ASIO_ENABLE_BUSY_POLL)
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+# if !defined(BOOST_ASIO_BUSY_POLL_USEC)
+#  define BOOST_ASIO_BUSY_POLL_USEC 50
+# endif // !defined(BOOST_ASIO_BUSY_POLL_USEC)
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+
+// Linux: epoll, eventfd, timerfd, recvmmsg/sendmmsg, sendfile/splice and
+// io_uring.
 #if defined(__linux__)
 # include <linux/version.h>
 # if !defined(BOOST_ASIO_DISABLE_EPOLL)
@@ -280,6 +307,23 @@
 #   define BOOST_ASIO_HAS_TIMERFD 1
 #  endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 # endif // defined(BOOST_ASIO_HAS_EPOLL)
+# if !defined(BOOST_ASIO_DISABLE_MMSG)
+#  if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#   define BOOST_ASIO_HAS_MMSG 1
+#  endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+# endif // !defined(BOOST_ASIO_DISABLE_MMSG)
+# if !defined(BOOST_ASIO_DISABLE_SENDFILE)
+#  if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,17)
+#   define BOOST_ASIO_HAS_SENDFILE 1
+#  endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,17)
+# endif // !defined(BOOST_ASIO_DISABLE_SENDFILE)
+# if defined(BOOST_ASIO_ENABLE_IO_URING)
+#  if defined(BOOST_ASIO_HAS_EPOLL)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(5,7,0)
+#    define BOOST_ASIO_HAS_IO_URING 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(5,7,0)
+#  endif // defined(BOOST_ASIO_HAS_EPOLL)
+# endif // defined(BOOST_ASIO_ENABLE_IO_URING)
 #endif // defined(__linux__)
 
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
@@ -357,6 +401,13 @@
 # endif // !defined(BOOST_WINDOWS) && !defined(__CYGWIN__)
 #endif // !defined(BOOST_ASIO_DISABLE_LOCAL_SOCKETS)
 
+// POSIX: sending the contents of a file descriptor on a stream socket.
+#if !defined(BOOST_ASIO_DISABLE_SEND_FILE)
+# if !defined(BOOST_WINDOWS) && !defined(__CYGWIN__)
+#  define BOOST_ASIO_HAS_SEND_FILE 1
+# endif // !defined(BOOST_WINDOWS) && !defined(__CYGWIN__)
+#endif // !defined(BOOST_ASIO_DISABLE_SEND_FILE)
+
 // Can use sigaction() instead of signal().
 #if !defined(BOOST_ASIO_DISABLE_SIGACTION)
 # if !defined(BOOST_WINDOWS) && !defined(__CYGWIN__)
@@ -135,7 +135,8 @@ public:
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
   // Run /dev/poll once until interrupted or events are ready to be dispatched.
-  BOOST_ASIO_DECL void run(bool block, op_queue<operation>& ops);
+  // Waits for at most usec microseconds, or indefinitely if usec is negative.
+  BOOST_ASIO_DECL void run(long usec, op_queue<operation>& ops);
 
   // Interrupt the select loop.
   BOOST_ASIO_DECL void interrupt();
@@ -151,10 +152,11 @@ private:
   // Helper function to remove a timer queue.
   BOOST_ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
 
-  // Get the timeout value for the /dev/poll DP_POLL operation. The timeout
-  // value is returned as a number of milliseconds. A return value of -1
-  // indicates that the poll should block indefinitely.
-  BOOST_ASIO_DECL int get_timeout();
+  // Get the timeout value for the /dev/poll DP_POLL operation, which is no
+  // longer than msec unless msec is negative. The timeout value is returned
+  // as a number of milliseconds. A return value of -1 indicates that the poll
+  // should block indefinitely.
+  BOOST_ASIO_DECL int get_timeout(int msec);
 
   // Cancel all operations associated with the given descriptor. The do_cancel
   // function of the handler objects will be invoked. This function does not
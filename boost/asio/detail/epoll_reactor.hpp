@@ -52,6 +52,9 @@ public:
   class descriptor_state : operation
   {
     friend class epoll_reactor;
+#if defined(BOOST_ASIO_HAS_IO_URING)
+    friend class io_uring_reactor;
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
     friend class object_pool_access;
 
     descriptor_state* next_;
@@ -60,9 +63,14 @@ public:
     mutex mutex_;
     epoll_reactor* reactor_;
     int descriptor_;
+    int shard_;
     boost::uint32_t registered_events_;
     op_queue<reactor_op> op_queue_[max_ops];
     bool shutdown_;
+#if defined(BOOST_ASIO_HAS_IO_URING)
+    unsigned char ring_request_[max_ops];
+    int ring_requests_;
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
 
     BOOST_ASIO_DECL descriptor_state();
     void set_ready_events(uint32_t events) { task_result_ = events; }
@@ -157,12 +165,19 @@ public:
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
   // Run epoll once until interrupted or events are ready to be dispatched.
-  BOOST_ASIO_DECL void run(bool block, op_queue<operation>& ops);
+  // Waits for at most usec microseconds, or indefinitely if usec is negative.
+  BOOST_ASIO_DECL void run(long usec, op_queue<operation>& ops);
 
   // Interrupt the select loop.
   BOOST_ASIO_DECL void interrupt();
 
 private:
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  // The io_uring reactor uses this reactor's descriptor and timer bookkeeping,
+  // and falls back to it entirely if io_uring is unavailable.
+  friend class io_uring_reactor;
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
 
@@ -173,8 +188,10 @@ private:
   // Create the timerfd file descriptor. Does not throw.
   BOOST_ASIO_DECL static int do_timerfd_create();
 
-  // Allocate a new descriptor state object.
-  BOOST_ASIO_DECL descriptor_state* allocate_descriptor_state();
+  // Allocate a new descriptor state object from the shard that the given
+  // descriptor maps to.
+  BOOST_ASIO_DECL descriptor_state* allocate_descriptor_state(
+      socket_type descriptor);
 
   // Free an existing descriptor state object.
   BOOST_ASIO_DECL void free_descriptor_state(descriptor_state* s);
@@ -188,10 +205,11 @@ private:
   // Called to recalculate and update the timeout.
   BOOST_ASIO_DECL void update_timeout();
 
-  // Get the timeout value for the epoll_wait call. The timeout value is
-  // returned as a number of milliseconds. A return value of -1 indicates
-  // that epoll_wait should block indefinitely.
-  BOOST_ASIO_DECL int get_timeout();
+  // Get the timeout value for the epoll_wait call, which is no longer than
+  // msec unless msec is negative. The timeout value is returned as a number of
+  // milliseconds. A return value of -1 indicates that epoll_wait should block
+  // indefinitely.
+  BOOST_ASIO_DECL int get_timeout(int msec);
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
   // Get the timeout value for the timer descriptor. The return value is the
@@ -220,11 +238,26 @@ private:
   // Whether the service has been shut down.
   bool shutdown_;
 
-  // Mutex to protect access to the registered descriptors.
-  mutex registered_descriptors_mutex_;
+  // The number of shards into which the registered descriptors are divided.
+  // Descriptors are assigned to shards by number, so that threads accepting
+  // or closing different connections rarely contend for the same mutex.
+  enum { descriptor_shards = 32 };
+
+  // A subset of the registered descriptors.
+  struct descriptor_shard
+  {
+    // Mutex to protect access to the shard's descriptors.
+    mutex mutex_;
+
+    // Keep track of the shard's registered descriptors.
+    object_pool<descriptor_state> descriptors_;
+
+    // Keep shards that are adjacent in memory out of each other's cache line.
+    char padding_[64];
+  };
 
-  // Keep track of all registered descriptors.
-  object_pool<descriptor_state> registered_descriptors_;
+  // All registered descriptors.
+  descriptor_shard registered_descriptors_[descriptor_shards];
 
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
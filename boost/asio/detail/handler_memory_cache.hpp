@@ -0,0 +1,242 @@
+//
+// detail/handler_memory_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_HANDLER_MEMORY_CACHE_HPP
+#define BOOST_ASIO_DETAIL_HANDLER_MEMORY_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <new>
+#include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A cache of small memory blocks, grouped by size class, that is used by a
+// single thread at a time. A thread that calls run(), run_one(), poll() or
+// poll_one() takes a cache from the io_service's pool and installs it, so
+// that the memory for an operation that is deallocated before its handler is
+// invoked can be reused by the next operation that the handler starts. The
+// cache goes back to the pool when the call returns, so a thread that calls
+// run_one() or poll_one() in a loop gets the same cache again on each call.
+class handler_memory_cache
+  : private noncopyable
+{
+public:
+  class pool;
+  class scope;
+
+  // Construct an empty cache.
+  handler_memory_cache()
+    : next_(0)
+  {
+    for (std::size_t i = 0; i < num_size_classes; ++i)
+    {
+      free_list_[i] = 0;
+      free_count_[i] = 0;
+    }
+  }
+
+  // Release all cached memory.
+  ~handler_memory_cache()
+  {
+    for (std::size_t i = 0; i < num_size_classes; ++i)
+    {
+      while (block* b = free_list_[i])
+      {
+        free_list_[i] = b->next_;
+        ::operator delete(b);
+      }
+    }
+  }
+
+  // Allocate memory, reusing a block from the current thread's cache if one
+  // of the right size class is available.
+  static void* allocate(std::size_t size)
+  {
+    std::size_t size_class = size_class_of(size);
+    if (size_class < num_size_classes)
+    {
+      if (handler_memory_cache* cache = call_stack<handler_memory_cache>::top())
+      {
+        if (block* b = cache->free_list_[size_class])
+        {
+          cache->free_list_[size_class] = b->next_;
+          --cache->free_count_[size_class];
+          return b;
+        }
+      }
+
+      // Allocate the whole size class so that the block can later be reused
+      // for any request in the same class.
+      return ::operator new((size_class + 1) * granularity);
+    }
+
+    return ::operator new(size);
+  }
+
+  // Deallocate memory, returning it to the current thread's cache if there is
+  // room for it.
+  static void deallocate(void* pointer, std::size_t size)
+  {
+    std::size_t size_class = size_class_of(size);
+    if (size_class < num_size_classes)
+    {
+      if (handler_memory_cache* cache = call_stack<handler_memory_cache>::top())
+      {
+        if (cache->free_count_[size_class] < max_blocks_per_size_class)
+        {
+          block* b = static_cast<block*>(pointer);
+          b->next_ = cache->free_list_[size_class];
+          cache->free_list_[size_class] = b;
+          ++cache->free_count_[size_class];
+          return;
+        }
+      }
+    }
+
+    ::operator delete(pointer);
+  }
+
+private:
+  // Blocks are cached in multiples of this size.
+  enum { granularity = 64 };
+
+  // The number of size classes. Larger blocks are not cached.
+  enum { num_size_classes = 16 };
+
+  // The maximum number of blocks held for each size class.
+  enum { max_blocks_per_size_class = 16 };
+
+  // Determine the size class for an allocation.
+  static std::size_t size_class_of(std::size_t size)
+  {
+    return size == 0 ? 0 : (size - 1) / granularity;
+  }
+
+  // Header overlaid on a cached block.
+  struct block
+  {
+    block* next_;
+  };
+
+  // The next cache in the pool.
+  handler_memory_cache* next_;
+
+  // The cached blocks for each size class.
+  block* free_list_[num_size_classes];
+
+  // The number of cached blocks for each size class.
+  std::size_t free_count_[num_size_classes];
+};
+
+// The caches that are not currently installed on a thread. There are never
+// more caches than there have been concurrent calls to run the io_service.
+class handler_memory_cache::pool
+  : private noncopyable
+{
+public:
+  // Constructor.
+  pool()
+    : first_(0)
+  {
+  }
+
+  // Destroy all caches in the pool.
+  ~pool()
+  {
+    while (handler_memory_cache* cache = first_)
+    {
+      first_ = cache->next_;
+      delete cache;
+    }
+  }
+
+private:
+  friend class handler_memory_cache::scope;
+
+  // Take the most recently returned cache, or create a new one.
+  handler_memory_cache* take()
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (handler_memory_cache* cache = first_)
+    {
+      first_ = cache->next_;
+      cache->next_ = 0;
+      return cache;
+    }
+    lock.unlock();
+    return new handler_memory_cache;
+  }
+
+  // Return a cache to the pool.
+  void put(handler_memory_cache* cache)
+  {
+    mutex::scoped_lock lock(mutex_);
+    cache->next_ = first_;
+    first_ = cache;
+  }
+
+  // Mutex to protect access to the list of caches.
+  mutex mutex_;
+
+  // The most recently returned cache.
+  handler_memory_cache* first_;
+};
+
+// Installs a cache from a pool on the current thread for the lifetime of the
+// scope object. A thread that already has a cache, because this is a nested
+// call, keeps using it.
+class handler_memory_cache::scope
+  : private noncopyable
+{
+public:
+  // Take a cache from the pool if the thread does not have one.
+  explicit scope(pool& p)
+    : pool_(p),
+      cache_(call_stack<handler_memory_cache>::top() ? 0 : p.take()),
+      context_(cache_ ? cache_ : call_stack<handler_memory_cache>::top())
+  {
+  }
+
+  // Return the cache to the pool.
+  ~scope()
+  {
+    if (cache_)
+      pool_.put(cache_);
+  }
+
+private:
+  // The pool that owns the cache.
+  pool& pool_;
+
+  // The cache taken from the pool, or 0 if the thread already had one.
+  handler_memory_cache* cache_;
+
+  // Registers the cache as belonging to the current thread.
+  call_stack<handler_memory_cache>::context context_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_HANDLER_MEMORY_CACHE_HPP
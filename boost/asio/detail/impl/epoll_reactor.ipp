@@ -76,12 +76,17 @@ void epoll_reactor::shutdown_service()
 
   op_queue<operation> ops;
 
-  while (descriptor_state* state = registered_descriptors_.first())
+  for (int shard = 0; shard < descriptor_shards; ++shard)
   {
-    for (int i = 0; i < max_ops; ++i)
-      ops.push(state->op_queue_[i]);
-    state->shutdown_ = true;
-    registered_descriptors_.free(state);
+    object_pool<descriptor_state>& descriptors
+      = registered_descriptors_[shard].descriptors_;
+    while (descriptor_state* state = descriptors.first())
+    {
+      for (int i = 0; i < max_ops; ++i)
+        ops.push(state->op_queue_[i]);
+      state->shutdown_ = true;
+      descriptors.free(state);
+    }
   }
 
   timer_queues_.get_all_timers(ops);
@@ -123,18 +128,24 @@ void epoll_reactor::fork_service(boost::asio::io_service::fork_event fork_ev)
     update_timeout();
 
     // Re-register all descriptors with epoll.
-    mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
-    for (descriptor_state* state = registered_descriptors_.first();
-        state != 0; state = state->next_)
+    for (int shard = 0; shard < descriptor_shards; ++shard)
     {
-      ev.events = state->registered_events_;
-      ev.data.ptr = state;
-      int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, state->descriptor_, &ev);
-      if (result != 0)
+      mutex::scoped_lock descriptors_lock(
+          registered_descriptors_[shard].mutex_);
+      for (descriptor_state* state
+            = registered_descriptors_[shard].descriptors_.first();
+          state != 0; state = state->next_)
       {
-        boost::system::error_code ec(errno,
-            boost::asio::error::get_system_category());
-        boost::asio::detail::throw_error(ec, "epoll re-registration");
+        ev.events = state->registered_events_;
+        ev.data.ptr = state;
+        int result = epoll_ctl(epoll_fd_,
+            EPOLL_CTL_ADD, state->descriptor_, &ev);
+        if (result != 0)
+        {
+          boost::system::error_code ec(errno,
+              boost::asio::error::get_system_category());
+          boost::asio::detail::throw_error(ec, "epoll re-registration");
+        }
       }
     }
   }
@@ -148,7 +159,7 @@ void epoll_reactor::init_task()
 int epoll_reactor::register_descriptor(socket_type descriptor,
     epoll_reactor::per_descriptor_data& descriptor_data)
 {
-  descriptor_data = allocate_descriptor_state();
+  descriptor_data = allocate_descriptor_state(descriptor);
 
   {
     mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
@@ -173,7 +184,7 @@ int epoll_reactor::register_internal_descriptor(
     int op_type, socket_type descriptor,
     epoll_reactor::per_descriptor_data& descriptor_data, reactor_op* op)
 {
-  descriptor_data = allocate_descriptor_state();
+  descriptor_data = allocate_descriptor_state(descriptor);
 
   {
     mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
@@ -369,7 +380,7 @@ void epoll_reactor::deregister_internal_descriptor(socket_type descriptor,
   }
 }
 
-void epoll_reactor::run(bool block, op_queue<operation>& ops)
+void epoll_reactor::run(long usec, op_queue<operation>& ops)
 {
   // This code relies on the fact that the task_io_service queues the reactor
   // task behind all descriptor operations generated by this function. This
@@ -377,14 +388,18 @@ void epoll_reactor::run(bool block, op_queue<operation>& ops)
   // descriptor operations have already been dequeued. Therefore it is now safe
   // for us to reuse and return them for the task_io_service to queue again.
 
-  // Calculate a timeout only if timerfd is not used.
+  // Calculate the timeout. Check the timer queues only if timerfd is not used.
   int timeout;
-  if (timer_fd_ != -1)
-    timeout = block ? -1 : 0;
+  if (usec == 0)
+    timeout = 0;
   else
   {
-    mutex::scoped_lock lock(mutex_);
-    timeout = block ? get_timeout() : 0;
+    timeout = (usec < 0) ? -1 : static_cast<int>((usec - 1) / 1000 + 1);
+    if (timer_fd_ == -1)
+    {
+      mutex::scoped_lock lock(mutex_);
+      timeout = get_timeout(timeout);
+    }
   }
 
   // Block on the epoll descriptor.
@@ -506,16 +521,23 @@ int epoll_reactor::do_timerfd_create()
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
 }
 
-epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
+epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state(
+    socket_type descriptor)
 {
-  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
-  return registered_descriptors_.alloc();
+  int shard = static_cast<unsigned int>(descriptor) % descriptor_shards;
+  mutex::scoped_lock descriptors_lock(registered_descriptors_[shard].mutex_);
+  descriptor_state* s = registered_descriptors_[shard].descriptors_.alloc();
+  s->shard_ = shard;
+  return s;
 }
 
 void epoll_reactor::free_descriptor_state(epoll_reactor::descriptor_state* s)
 {
-  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
-  registered_descriptors_.free(s);
+  // The descriptor may have been closed and its number reused by now, so the
+  // state goes back to the shard it was allocated from.
+  descriptor_shard& shard = registered_descriptors_[s->shard_];
+  mutex::scoped_lock descriptors_lock(shard.mutex_);
+  shard.descriptors_.free(s);
 }
 
 void epoll_reactor::do_add_timer_queue(timer_queue_base& queue)
@@ -545,11 +567,13 @@ void epoll_reactor::update_timeout()
   interrupt();
 }
 
-int epoll_reactor::get_timeout()
+int epoll_reactor::get_timeout(int msec)
 {
   // By default we will wait no longer than 5 minutes. This will ensure that
   // any changes to the system clock are detected after no longer than this.
-  return timer_queues_.wait_duration_msec(5 * 60 * 1000);
+  const int max_msec = 5 * 60 * 1000;
+  return timer_queues_.wait_duration_msec(
+      (msec < 0 || max_msec < msec) ? max_msec : msec);
 }
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
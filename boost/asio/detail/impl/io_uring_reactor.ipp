@@ -0,0 +1,882 @@
+//
+// detail/impl/io_uring_reactor.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_IO_URING_REACTOR_IPP
+#define BOOST_ASIO_DETAIL_IMPL_IO_URING_REACTOR_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <cstring>
+#include <errno.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <boost/asio/detail/io_uring_reactor.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+io_uring_reactor::io_uring_reactor(boost::asio::io_service& io_service)
+  : boost::asio::detail::service_base<io_uring_reactor>(io_service),
+    epoll_(io_service),
+    mutex_(),
+    ring_fd_(-1),
+    ring_ptr_(0),
+    ring_size_(0),
+    sqes_(0),
+    sqes_size_(0),
+    sq_head_(0),
+    sq_tail_(0),
+    sq_mask_(0),
+    sq_entries_(0),
+    sq_local_tail_(0),
+    cq_head_(0),
+    cq_tail_(0),
+    cq_mask_(0),
+    cqes_(0),
+    outstanding_(0),
+    waiting_(false),
+    interrupted_(false),
+    timeout_pending_(false),
+    timeout_deadline_(0),
+    timeout_generation_(0)
+{
+  open_ring();
+}
+
+io_uring_reactor::~io_uring_reactor()
+{
+  close_ring();
+}
+
+void io_uring_reactor::shutdown_service()
+{
+  if (ring_fd_ == -1)
+  {
+    epoll_.shutdown_service();
+    return;
+  }
+
+  mutex::scoped_lock lock(epoll_.mutex_);
+  epoll_.shutdown_ = true;
+  if (timeout_pending_)
+  {
+    ::io_uring_sqe sqe;
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_TIMEOUT_REMOVE;
+    sqe.addr = (timeout_generation_ << 3) | timeout_kind;
+    sqe.user_data = ignore_token;
+    submit(sqe, true);
+    timeout_pending_ = false;
+  }
+  lock.unlock();
+
+  // The kernel may still be using the memory of operations that have been
+  // handed to it, so cancel every request and wait for the kernel to finish
+  // with them before the operations are destroyed.
+  for (int shard = 0; shard < epoll_reactor::descriptor_shards; ++shard)
+  {
+    epoll_reactor::descriptor_shard& descriptors
+      = epoll_.registered_descriptors_[shard];
+    mutex::scoped_lock descriptors_lock(descriptors.mutex_);
+    for (descriptor_state* state = descriptors.descriptors_.first();
+        state != 0; state = state->next_)
+    {
+      mutex::scoped_lock descriptor_lock(state->mutex_);
+      state->shutdown_ = true;
+      cancel_requests(state);
+    }
+  }
+
+  mutex::scoped_lock ring_lock(mutex_);
+  flush_requests();
+  while (outstanding_ > 0)
+  {
+    unsigned int head = *cq_head_;
+    unsigned int tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    if (head == tail)
+    {
+      if (ring_enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+        break;
+      continue;
+    }
+    outstanding_ -= tail - head;
+    __atomic_store_n(cq_head_, tail, __ATOMIC_RELEASE);
+  }
+  ring_lock.unlock();
+
+  epoll_.shutdown_service();
+}
+
+void io_uring_reactor::fork_service(
+    boost::asio::io_service::fork_event fork_ev)
+{
+  if (ring_fd_ == -1)
+  {
+    epoll_.fork_service(fork_ev);
+    return;
+  }
+
+  if (fork_ev != boost::asio::io_service::fork_child)
+    return;
+
+  // The child shares the parent's ring, so it needs a ring of its own. None
+  // of the requests started by the parent will complete in the child.
+  close_ring();
+  open_ring();
+
+  for (int shard = 0; shard < epoll_reactor::descriptor_shards; ++shard)
+  {
+    epoll_reactor::descriptor_shard& descriptors
+      = epoll_.registered_descriptors_[shard];
+    mutex::scoped_lock descriptors_lock(descriptors.mutex_);
+    descriptor_state* state = descriptors.descriptors_.first();
+    while (state)
+    {
+      descriptor_state* next = state->next_;
+      for (int i = 0; i < max_ops; ++i)
+        state->ring_request_[i] = no_request;
+      state->ring_requests_ = 0;
+      if (state->shutdown_)
+        descriptors.descriptors_.free(state);
+      state = next;
+    }
+  }
+
+  if (ring_fd_ == -1)
+  {
+    // Carry on using epoll in the child.
+    epoll_.fork_service(fork_ev);
+    return;
+  }
+
+  // Restart the requests for any operations that are still waiting.
+  for (int shard = 0; shard < epoll_reactor::descriptor_shards; ++shard)
+  {
+    epoll_reactor::descriptor_shard& descriptors
+      = epoll_.registered_descriptors_[shard];
+    mutex::scoped_lock descriptors_lock(descriptors.mutex_);
+    for (descriptor_state* state = descriptors.descriptors_.first();
+        state != 0; state = state->next_)
+    {
+      mutex::scoped_lock descriptor_lock(state->mutex_);
+      for (int i = 0; i < max_ops; ++i)
+        if (!state->op_queue_[i].empty())
+          start_request(state, i, true);
+    }
+  }
+
+  mutex::scoped_lock lock(epoll_.mutex_);
+  timeout_pending_ = false;
+  update_timeout();
+}
+
+void io_uring_reactor::init_task()
+{
+  epoll_.init_task();
+}
+
+int io_uring_reactor::register_descriptor(socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data)
+{
+  if (ring_fd_ == -1)
+    return epoll_.register_descriptor(descriptor, descriptor_data);
+
+  descriptor_data = allocate_descriptor_state(descriptor);
+  return 0;
+}
+
+int io_uring_reactor::register_internal_descriptor(
+    int op_type, socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data, reactor_op* op)
+{
+  if (ring_fd_ == -1)
+  {
+    return epoll_.register_internal_descriptor(
+        op_type, descriptor, descriptor_data, op);
+  }
+
+  descriptor_data = allocate_descriptor_state(descriptor);
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+  descriptor_data->op_queue_[op_type].push(op);
+  if (!start_request(descriptor_data, op_type, false))
+    return ENOBUFS;
+
+  return 0;
+}
+
+void io_uring_reactor::move_descriptor(socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& target_descriptor_data,
+    io_uring_reactor::per_descriptor_data& source_descriptor_data)
+{
+  epoll_.move_descriptor(descriptor,
+      target_descriptor_data, source_descriptor_data);
+}
+
+void io_uring_reactor::start_op(int op_type, socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data,
+    reactor_op* op, bool allow_speculative)
+{
+  if (ring_fd_ == -1)
+  {
+    epoll_.start_op(op_type, descriptor,
+        descriptor_data, op, allow_speculative);
+    return;
+  }
+
+  if (!descriptor_data)
+  {
+    op->ec_ = boost::asio::error::bad_descriptor;
+    post_immediate_completion(op);
+    return;
+  }
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (descriptor_data->shutdown_)
+  {
+    post_immediate_completion(op);
+    return;
+  }
+
+  if (descriptor_data->op_queue_[op_type].empty())
+  {
+    // Exception operations must be processed first to ensure that any
+    // out-of-band data is read before normal data.
+    bool in_order = (op_type != read_op
+        || descriptor_data->op_queue_[except_op].empty());
+
+    if (descriptor_data->ring_request_[op_type] == no_request)
+    {
+      // Hand the operation to the kernel if it can be described as an
+      // io_uring request. Otherwise, try it now and wait for readiness only
+      // if it would block.
+      ::io_uring_sqe sqe;
+      std::memset(&sqe, 0, sizeof(sqe));
+      bool io = in_order && op->prepare(&sqe);
+      if (!io && allow_speculative && in_order && op->perform())
+      {
+        descriptor_lock.unlock();
+        post_immediate_completion(op);
+        return;
+      }
+
+      if (!queue_request(descriptor_data, op_type, io ? &sqe : 0))
+      {
+        op->ec_ = boost::asio::error::no_buffer_space;
+        descriptor_lock.unlock();
+        post_immediate_completion(op);
+        return;
+      }
+    }
+    else if (allow_speculative && in_order)
+    {
+      if (op->perform())
+      {
+        descriptor_lock.unlock();
+        post_immediate_completion(op);
+        return;
+      }
+    }
+  }
+
+  descriptor_data->op_queue_[op_type].push(op);
+  epoll_.io_service_.work_started();
+}
+
+void io_uring_reactor::cancel_ops(socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data)
+{
+  if (ring_fd_ == -1)
+  {
+    epoll_.cancel_ops(descriptor, descriptor_data);
+    return;
+  }
+
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  op_queue<operation> ops;
+  abort_queued_ops(descriptor_data, ops);
+  cancel_requests(descriptor_data);
+
+  descriptor_lock.unlock();
+
+  epoll_.io_service_.post_deferred_completions(ops);
+}
+
+void io_uring_reactor::deregister_descriptor(socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data, bool closing)
+{
+  if (ring_fd_ == -1)
+  {
+    epoll_.deregister_descriptor(descriptor, descriptor_data, closing);
+    return;
+  }
+
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (!descriptor_data->shutdown_)
+  {
+    op_queue<operation> ops;
+    abort_queued_ops(descriptor_data, ops);
+
+    descriptor_data->descriptor_ = -1;
+    descriptor_data->shutdown_ = true;
+    cancel_requests(descriptor_data);
+
+    // The state is freed once the kernel has finished with it.
+    bool free_state = (descriptor_data->ring_requests_ == 0);
+
+    descriptor_lock.unlock();
+
+    if (free_state)
+      epoll_.free_descriptor_state(descriptor_data);
+    descriptor_data = 0;
+
+    epoll_.io_service_.post_deferred_completions(ops);
+  }
+}
+
+void io_uring_reactor::deregister_internal_descriptor(socket_type descriptor,
+    io_uring_reactor::per_descriptor_data& descriptor_data)
+{
+  if (ring_fd_ == -1)
+  {
+    epoll_.deregister_internal_descriptor(descriptor, descriptor_data);
+    return;
+  }
+
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (!descriptor_data->shutdown_)
+  {
+    op_queue<operation> ops;
+    for (int i = 0; i < max_ops; ++i)
+      ops.push(descriptor_data->op_queue_[i]);
+
+    descriptor_data->descriptor_ = -1;
+    descriptor_data->shutdown_ = true;
+    cancel_requests(descriptor_data);
+
+    bool free_state = (descriptor_data->ring_requests_ == 0);
+
+    descriptor_lock.unlock();
+
+    if (free_state)
+      epoll_.free_descriptor_state(descriptor_data);
+    descriptor_data = 0;
+  }
+}
+
+void io_uring_reactor::run(long usec, op_queue<operation>& ops)
+{
+  if (ring_fd_ == -1)
+  {
+    epoll_.run(usec, ops);
+    return;
+  }
+
+  // A bounded wait is ended by a relative timeout request, whose completion
+  // is ignored. Its data is consumed when it is submitted below.
+  ::__kernel_timespec wait_ts;
+  bool can_wait = (usec < 0);
+  if (usec > 0)
+  {
+    wait_ts.tv_sec = usec / 1000000;
+    wait_ts.tv_nsec = (usec % 1000000) * 1000;
+
+    ::io_uring_sqe sqe;
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_TIMEOUT;
+    sqe.addr = reinterpret_cast<boost::uint64_t>(&wait_ts);
+    sqe.len = 1;
+    sqe.user_data = ignore_token;
+    can_wait = submit(sqe, false);
+  }
+
+  // Pass all pending requests to the kernel in a single system call, and
+  // wait for a completion in the same call if there is nothing else to do.
+  mutex::scoped_lock lock(mutex_);
+  unsigned int to_submit =
+    sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  bool wait = can_wait && !interrupted_
+    && *cq_head_ == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  waiting_ = wait;
+  interrupted_ = false;
+  lock.unlock();
+
+  if (to_submit > 0 || wait)
+  {
+    ring_enter(to_submit, wait ? 1 : 0, wait ? IORING_ENTER_GETEVENTS : 0);
+
+    lock.lock();
+    waiting_ = false;
+    lock.unlock();
+  }
+
+  // Dispatch the completed requests.
+  bool check_timers = false;
+  boost::uint64_t timeout_generation = 0;
+  std::size_t completed = 0;
+  unsigned int head = *cq_head_;
+  unsigned int tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head, ++completed)
+  {
+    const ::io_uring_cqe& cqe = cqes_[head & cq_mask_];
+    boost::uint64_t user_data = cqe.user_data;
+    int result = cqe.res;
+
+    if ((user_data & 7) == timeout_kind)
+    {
+      // A batch may hold the completion of a replaced timeout after that of
+      // the pending one. Generations only increase, so keep the highest.
+      check_timers = true;
+      if ((user_data >> 3) > timeout_generation)
+        timeout_generation = user_data >> 3;
+    }
+    else if ((user_data & ~static_cast<boost::uint64_t>(7)) != 0)
+    {
+      descriptor_state* descriptor_data = reinterpret_cast<descriptor_state*>(
+          user_data & ~static_cast<boost::uint64_t>(7));
+      int op_type = static_cast<int>(user_data & 3);
+      int kind = (user_data & 4) ? io_request : poll_request;
+      complete_request(descriptor_data, op_type, kind, result, ops);
+    }
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+  if (completed > 0)
+  {
+    lock.lock();
+    outstanding_ -= completed;
+    lock.unlock();
+  }
+
+  if (check_timers)
+  {
+    mutex::scoped_lock common_lock(epoll_.mutex_);
+    if (timeout_generation == timeout_generation_)
+      timeout_pending_ = false;
+    epoll_.timer_queues_.get_ready_timers(ops);
+    update_timeout();
+  }
+}
+
+void io_uring_reactor::interrupt()
+{
+  if (ring_fd_ == -1)
+  {
+    epoll_.interrupt();
+    return;
+  }
+
+  mutex::scoped_lock lock(mutex_);
+  if (waiting_)
+  {
+    lock.unlock();
+
+    ::io_uring_sqe sqe;
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_NOP;
+    sqe.user_data = interrupt_token;
+    submit(sqe, true);
+  }
+  else
+  {
+    // The task is not blocked, so make sure that it does not block the next
+    // time it runs.
+    interrupted_ = true;
+  }
+}
+
+void io_uring_reactor::open_ring()
+{
+  ::io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  int fd = static_cast<int>(::syscall(__NR_io_uring_setup,
+        static_cast<unsigned int>(ring_entries), &params));
+  if (fd < 0)
+    return;
+
+  // Requests must not be dropped when the completion queue is full, their
+  // data must be consumed at submission, and the kernel must be able to poll
+  // for readiness internally rather than blocking a worker thread.
+  const boost::uint32_t required_features = IORING_FEAT_SINGLE_MMAP
+    | IORING_FEAT_NODROP | IORING_FEAT_SUBMIT_STABLE | IORING_FEAT_FAST_POLL;
+  if ((params.features & required_features) != required_features)
+  {
+    ::close(fd);
+    return;
+  }
+
+  std::size_t sq_size = params.sq_off.array
+    + params.sq_entries * sizeof(unsigned int);
+  std::size_t cq_size = params.cq_off.cqes
+    + params.cq_entries * sizeof(::io_uring_cqe);
+  std::size_t ring_size = sq_size > cq_size ? sq_size : cq_size;
+  void* ring_ptr = ::mmap(0, ring_size, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (ring_ptr == MAP_FAILED)
+  {
+    ::close(fd);
+    return;
+  }
+
+  std::size_t sqes_size = params.sq_entries * sizeof(::io_uring_sqe);
+  void* sqes = ::mmap(0, sqes_size, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+  {
+    ::munmap(ring_ptr, ring_size);
+    ::close(fd);
+    return;
+  }
+
+  char* p = static_cast<char*>(ring_ptr);
+  sq_head_ = reinterpret_cast<unsigned int*>(p + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned int*>(p + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<unsigned int*>(p + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  sq_local_tail_ = *sq_tail_;
+  cq_head_ = reinterpret_cast<unsigned int*>(p + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned int*>(p + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned int*>(p + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast< ::io_uring_cqe*>(p + params.cq_off.cqes);
+
+  // Submission queue entries are always used in order.
+  unsigned int* sq_array =
+    reinterpret_cast<unsigned int*>(p + params.sq_off.array);
+  for (unsigned int i = 0; i < params.sq_entries; ++i)
+    sq_array[i] = i;
+
+  ring_fd_ = fd;
+  ring_ptr_ = ring_ptr;
+  ring_size_ = ring_size;
+  sqes_ = static_cast< ::io_uring_sqe*>(sqes);
+  sqes_size_ = sqes_size;
+  outstanding_ = 0;
+  waiting_ = false;
+  interrupted_ = false;
+}
+
+void io_uring_reactor::close_ring()
+{
+  if (ring_fd_ != -1)
+  {
+    ::munmap(sqes_, sqes_size_);
+    ::munmap(ring_ptr_, ring_size_);
+    ::close(ring_fd_);
+    ring_fd_ = -1;
+  }
+}
+
+io_uring_reactor::descriptor_state*
+io_uring_reactor::allocate_descriptor_state(socket_type descriptor)
+{
+  descriptor_state* descriptor_data
+    = epoll_.allocate_descriptor_state(descriptor);
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  descriptor_data->reactor_ = &epoll_;
+  descriptor_data->descriptor_ = descriptor;
+  descriptor_data->shutdown_ = false;
+  for (int i = 0; i < max_ops; ++i)
+    descriptor_data->ring_request_[i] = no_request;
+  descriptor_data->ring_requests_ = 0;
+
+  // Used if a forked child has to fall back to epoll.
+  descriptor_data->registered_events_ =
+    EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
+
+  return descriptor_data;
+}
+
+bool io_uring_reactor::start_request(descriptor_state* descriptor_data,
+    int op_type, bool allow_io)
+{
+  reactor_op* op = descriptor_data->op_queue_[op_type].front();
+
+  ::io_uring_sqe sqe;
+  std::memset(&sqe, 0, sizeof(sqe));
+  bool io = allow_io && op->prepare(&sqe);
+  return queue_request(descriptor_data, op_type, io ? &sqe : 0);
+}
+
+bool io_uring_reactor::queue_request(descriptor_state* descriptor_data,
+    int op_type, ::io_uring_sqe* io_sqe)
+{
+  ::io_uring_sqe poll_sqe;
+  if (!io_sqe)
+  {
+    static const unsigned short flag[max_ops] = { POLLIN, POLLOUT, POLLPRI };
+    std::memset(&poll_sqe, 0, sizeof(poll_sqe));
+    poll_sqe.opcode = IORING_OP_POLL_ADD;
+    poll_sqe.fd = descriptor_data->descriptor_;
+    poll_sqe.poll_events = flag[op_type];
+  }
+
+  ::io_uring_sqe& sqe = io_sqe ? *io_sqe : poll_sqe;
+  sqe.user_data = reinterpret_cast<boost::uint64_t>(descriptor_data)
+    | (io_sqe ? 4 : 0) | op_type;
+  if (!submit(sqe, false))
+    return false;
+
+  descriptor_data->ring_request_[op_type] =
+    static_cast<unsigned char>(io_sqe ? io_request : poll_request);
+  ++descriptor_data->ring_requests_;
+  return true;
+}
+
+void io_uring_reactor::cancel_requests(descriptor_state* descriptor_data)
+{
+  for (int i = 0; i < max_ops; ++i)
+  {
+    int kind = descriptor_data->ring_request_[i];
+
+    // A poll request for an idle descriptor is harmless, and is only
+    // cancelled when the descriptor is being removed.
+    if (kind == io_request
+        || (kind == poll_request && descriptor_data->shutdown_))
+    {
+      ::io_uring_sqe sqe;
+      std::memset(&sqe, 0, sizeof(sqe));
+      sqe.opcode = IORING_OP_ASYNC_CANCEL;
+      sqe.addr = reinterpret_cast<boost::uint64_t>(descriptor_data)
+        | (kind == io_request ? 4 : 0) | i;
+      sqe.user_data = ignore_token;
+
+      // The cancellation is passed to the kernel immediately, so that it
+      // cannot match a later request that reuses the descriptor state.
+      submit(sqe, true);
+    }
+  }
+}
+
+void io_uring_reactor::abort_queued_ops(
+    descriptor_state* descriptor_data, op_queue<operation>& ops)
+{
+  for (int i = 0; i < max_ops; ++i)
+  {
+    // An operation that has been handed to the kernel stays at the front of
+    // its queue until the kernel reports its completion.
+    reactor_op* running_op = 0;
+    if (descriptor_data->ring_request_[i] == io_request)
+    {
+      running_op = descriptor_data->op_queue_[i].front();
+      descriptor_data->op_queue_[i].pop();
+    }
+
+    while (reactor_op* op = descriptor_data->op_queue_[i].front())
+    {
+      op->ec_ = boost::asio::error::operation_aborted;
+      descriptor_data->op_queue_[i].pop();
+      ops.push(op);
+    }
+
+    if (running_op)
+      descriptor_data->op_queue_[i].push(running_op);
+  }
+}
+
+void io_uring_reactor::complete_request(descriptor_state* descriptor_data,
+    int op_type, int kind, int result, op_queue<operation>& ops)
+{
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  descriptor_data->ring_request_[op_type] = no_request;
+  --descriptor_data->ring_requests_;
+
+  bool allow_io = false;
+  if (kind == io_request)
+  {
+    if (reactor_op* op = descriptor_data->op_queue_[op_type].front())
+    {
+      if (op->finish(result))
+      {
+        descriptor_data->op_queue_[op_type].pop();
+        ops.push(op);
+        allow_io = true;
+      }
+      else if (descriptor_data->shutdown_)
+      {
+        op->ec_ = boost::asio::error::operation_aborted;
+        descriptor_data->op_queue_[op_type].pop();
+        ops.push(op);
+      }
+    }
+  }
+  else if (!descriptor_data->shutdown_)
+  {
+    // The descriptor is ready, so perform operations until one would block.
+    while (reactor_op* op = descriptor_data->op_queue_[op_type].front())
+    {
+      if (op->perform())
+      {
+        descriptor_data->op_queue_[op_type].pop();
+        ops.push(op);
+      }
+      else
+        break;
+    }
+  }
+
+  if (descriptor_data->shutdown_)
+  {
+    bool free_state = (descriptor_data->ring_requests_ == 0);
+    descriptor_lock.unlock();
+    if (free_state)
+      epoll_.free_descriptor_state(descriptor_data);
+    return;
+  }
+
+  // Start a new request for any operations that are still waiting. If the
+  // kernel could not complete the previous request without blocking, wait
+  // for readiness instead of submitting the operation again.
+  if (!descriptor_data->op_queue_[op_type].empty())
+  {
+    bool in_order = (op_type != read_op
+        || descriptor_data->op_queue_[except_op].empty());
+    if (!start_request(descriptor_data, op_type, allow_io && in_order))
+    {
+      while (reactor_op* op = descriptor_data->op_queue_[op_type].front())
+      {
+        op->ec_ = boost::asio::error::no_buffer_space;
+        descriptor_data->op_queue_[op_type].pop();
+        ops.push(op);
+      }
+    }
+  }
+}
+
+bool io_uring_reactor::submit(const ::io_uring_sqe& sqe, bool flush)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE)
+      >= sq_entries_)
+  {
+    flush_requests();
+    if (sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE)
+        >= sq_entries_)
+      return false;
+  }
+
+  sqes_[sq_local_tail_ & sq_mask_] = sqe;
+  ++sq_local_tail_;
+  __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+  ++outstanding_;
+
+  // Requests are normally left for the next call to run() so that they are
+  // submitted together. If a thread is already blocked waiting for
+  // completions, that call is too far away.
+  if (flush || waiting_)
+    flush_requests();
+
+  return true;
+}
+
+void io_uring_reactor::flush_requests()
+{
+  unsigned int to_submit =
+    sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  while (to_submit > 0)
+  {
+    if (ring_enter(to_submit, 0, 0) >= 0 || errno != EINTR)
+      break;
+  }
+}
+
+void io_uring_reactor::update_timeout()
+{
+  if (epoll_.shutdown_)
+    return;
+
+  // By default we will wait no longer than 5 minutes. This will ensure that
+  // any changes to the system clock are detected after no longer than this.
+  long usec = epoll_.timer_queues_.wait_duration_usec(5 * 60 * 1000 * 1000);
+
+  // Use an absolute timeout so that it is unaffected by any delay before the
+  // request is submitted.
+  timespec now;
+  ::clock_gettime(CLOCK_MONOTONIC, &now);
+  boost::int64_t deadline = static_cast<boost::int64_t>(now.tv_sec)
+    * 1000000000 + now.tv_nsec + static_cast<boost::int64_t>(usec) * 1000;
+
+  if (timeout_pending_ && timeout_deadline_ <= deadline)
+    return;
+
+  ::io_uring_sqe sqe;
+  if (timeout_pending_)
+  {
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_TIMEOUT_REMOVE;
+    sqe.addr = (timeout_generation_ << 3) | timeout_kind;
+    sqe.user_data = ignore_token;
+    submit(sqe, false);
+    timeout_pending_ = false;
+  }
+
+  ++timeout_generation_;
+  timeout_ts_.tv_sec = deadline / 1000000000;
+  timeout_ts_.tv_nsec = deadline % 1000000000;
+
+  std::memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_TIMEOUT;
+  sqe.addr = reinterpret_cast<boost::uint64_t>(&timeout_ts_);
+  sqe.len = 1;
+  sqe.timeout_flags = IORING_TIMEOUT_ABS;
+  sqe.user_data = (timeout_generation_ << 3) | timeout_kind;
+  if (submit(sqe, false))
+  {
+    timeout_pending_ = true;
+    timeout_deadline_ = deadline;
+  }
+}
+
+int io_uring_reactor::ring_enter(unsigned int to_submit,
+    unsigned int min_complete, unsigned int flags)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter,
+        ring_fd_, to_submit, min_complete, flags, 0, 0));
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IMPL_IO_URING_REACTOR_IPP
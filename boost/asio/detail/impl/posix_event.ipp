@@ -31,7 +31,18 @@ namespace detail {
 posix_event::posix_event()
   : signalled_(false)
 {
+#if defined(__MACH__) && defined(__APPLE__)
   int error = ::pthread_cond_init(&cond_, 0);
+#else // defined(__MACH__) && defined(__APPLE__)
+  // Timed waits are measured against the monotonic clock so that they are
+  // unaffected by changes to the system time.
+  ::pthread_condattr_t attr;
+  ::pthread_condattr_init(&attr);
+  int error = ::pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  if (error == 0)
+    error = ::pthread_cond_init(&cond_, &attr);
+  ::pthread_condattr_destroy(&attr);
+#endif // defined(__MACH__) && defined(__APPLE__)
   boost::system::error_code ec(error,
       boost::asio::error::get_system_category());
   boost::asio::detail::throw_error(ec, "event");
@@ -43,6 +43,10 @@ void reactive_socket_service_base::construct(
 {
   impl.socket_ = invalid_socket;
   impl.state_ = 0;
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+  impl.send_file_op_ = 0;
+  impl.send_file_mutex_ = 0;
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
 }
 
 void reactive_socket_service_base::base_move_construct(
@@ -57,6 +61,10 @@ void reactive_socket_service_base::base_move_construct(
 
   reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
+
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+  move_send_file(impl, reactor_, other_impl);
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
 }
 
 void reactive_socket_service_base::base_move_assign(
@@ -74,11 +82,19 @@ void reactive_socket_service_base::base_move_assign(
 
   other_service.reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
+
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+  move_send_file(impl, other_service.reactor_, other_impl);
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
 }
 
 void reactive_socket_service_base::destroy(
     reactive_socket_service_base::base_implementation_type& impl)
 {
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+  abort_send_file(impl);
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
   if (impl.socket_ != invalid_socket)
   {
     BOOST_ASIO_HANDLER_OPERATION(("socket", &impl, "close"));
@@ -95,6 +111,10 @@ boost::system::error_code reactive_socket_service_base::close(
     reactive_socket_service_base::base_implementation_type& impl,
     boost::system::error_code& ec)
 {
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+  abort_send_file(impl);
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
   if (is_open(impl))
   {
     BOOST_ASIO_HANDLER_OPERATION(("socket", &impl, "close"));
@@ -130,6 +150,10 @@ boost::system::error_code reactive_socket_service_base::cancel(
 
   BOOST_ASIO_HANDLER_OPERATION(("socket", &impl, "cancel"));
 
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+  abort_send_file(impl);
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
   reactor_.cancel_ops(impl.socket_, impl.reactor_data_);
   ec = boost::system::error_code();
   return ec;
@@ -254,6 +278,47 @@ void reactive_socket_service_base::start_connect_op(
   reactor_.post_immediate_completion(op);
 }
 
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+bool reactive_socket_service_base::send_file_in_progress(
+    reactive_socket_service_base::base_implementation_type& impl)
+{
+  // The mutex is only set by the thread using the socket, whereas the
+  // operation may clear send_file_op_ as it completes in another thread.
+  if (!impl.send_file_mutex_)
+    return false;
+  mutex::scoped_lock lock(*impl.send_file_mutex_);
+  return impl.send_file_op_ != 0;
+}
+
+void reactive_socket_service_base::abort_send_file(
+    reactive_socket_service_base::base_implementation_type& impl)
+{
+  if (impl.send_file_mutex_)
+  {
+    mutex::scoped_lock lock(*impl.send_file_mutex_);
+    if (impl.send_file_op_)
+      impl.send_file_op_->abort();
+  }
+}
+
+void reactive_socket_service_base::move_send_file(
+    reactive_socket_service_base::base_implementation_type& impl, reactor& r,
+    reactive_socket_service_base::base_implementation_type& other_impl)
+{
+  impl.send_file_op_ = 0;
+  impl.send_file_mutex_ = other_impl.send_file_mutex_;
+  other_impl.send_file_mutex_ = 0;
+  if (impl.send_file_mutex_)
+  {
+    mutex::scoped_lock lock(*impl.send_file_mutex_);
+    if (reactive_socket_send_file_op_base* op = other_impl.send_file_op_)
+      op->attach(*impl.send_file_mutex_, r, impl.socket_,
+          impl.reactor_data_, impl.send_file_op_);
+    other_impl.send_file_op_ = 0;
+  }
+}
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
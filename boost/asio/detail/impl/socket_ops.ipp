@@ -27,6 +27,15 @@
 #include <boost/asio/detail/socket_ops.hpp>
 #include <boost/asio/error.hpp>
 
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+# include <unistd.h>
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+# include <signal.h>
+# include <sys/sendfile.h>
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -247,6 +256,43 @@ bool non_blocking_accept(socket_type s,
   }
 }
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+bool finish_accept(int result, state_type state,
+    boost::system::error_code& ec, socket_type& new_socket)
+{
+  // Check if operation succeeded.
+  if (result >= 0)
+  {
+    ec = boost::system::error_code();
+    new_socket = result;
+    return true;
+  }
+
+  new_socket = invalid_socket;
+  ec = boost::system::error_code(-result,
+      boost::asio::error::get_system_category());
+
+  // Retry operation if interrupted by signal.
+  if (ec == boost::asio::error::interrupted)
+    return false;
+
+  // Operation failed.
+  if (ec == boost::asio::error::would_block
+      || ec == boost::asio::error::try_again)
+    return (state & user_set_non_blocking) != 0;
+  else if (ec == boost::asio::error::connection_aborted)
+    return (state & enable_connection_aborted) != 0;
+#if defined(EPROTO)
+  else if (ec.value() == EPROTO)
+    return (state & enable_connection_aborted) != 0;
+#endif // defined(EPROTO)
+
+  return true;
+}
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 template <typename SockLenType>
@@ -813,6 +859,39 @@ bool non_blocking_recv(socket_type s,
   }
 }
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+bool finish_recv(int result, bool is_stream,
+    boost::system::error_code& ec, size_t& bytes_transferred)
+{
+  bytes_transferred = 0;
+
+  // Check for end of stream.
+  if (is_stream && result == 0)
+  {
+    ec = boost::asio::error::eof;
+    return true;
+  }
+
+  // Operation is complete.
+  if (result >= 0)
+  {
+    ec = boost::system::error_code();
+    bytes_transferred = result;
+    return true;
+  }
+
+  ec = boost::system::error_code(-result,
+      boost::asio::error::get_system_category());
+
+  // Check if we need to run the operation again.
+  return ec != boost::asio::error::interrupted
+    && ec != boost::asio::error::would_block
+    && ec != boost::asio::error::try_again;
+}
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 int recvfrom(socket_type s, buf* bufs, size_t count, int flags,
@@ -1173,6 +1252,32 @@ bool non_blocking_send(socket_type s,
   }
 }
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+bool finish_send(int result,
+    boost::system::error_code& ec, size_t& bytes_transferred)
+{
+  bytes_transferred = 0;
+
+  // Operation is complete.
+  if (result >= 0)
+  {
+    ec = boost::system::error_code();
+    bytes_transferred = result;
+    return true;
+  }
+
+  ec = boost::system::error_code(-result,
+      boost::asio::error::get_system_category());
+
+  // Check if we need to run the operation again.
+  return ec != boost::asio::error::interrupted
+    && ec != boost::asio::error::would_block
+    && ec != boost::asio::error::try_again;
+}
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 int sendto(socket_type s, const buf* bufs, size_t count, int flags,
@@ -1279,6 +1384,508 @@ bool non_blocking_sendto(socket_type s,
 
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
+int recvmmsg(socket_type s, buf* bufs, size_t count, int flags,
+    socket_addr_type* const* addrs, std::size_t* addrlens,
+    std::size_t* sizes, boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_HAS_MMSG)
+  clear_last_error();
+  mmsghdr msgs[max_mmsg_len];
+  if (count > static_cast<size_t>(max_mmsg_len))
+    count = max_mmsg_len;
+  for (size_t i = 0; i < count; ++i)
+  {
+    msgs[i].msg_hdr = msghdr();
+    init_msghdr_msg_name(msgs[i].msg_hdr.msg_name, addrs[i]);
+    msgs[i].msg_hdr.msg_namelen = addrlens[i];
+    msgs[i].msg_hdr.msg_iov = &bufs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_len = 0;
+  }
+
+  // Only wait for the first message, so that a blocking socket returns as soon
+  // as at least one datagram is available.
+  int result = error_wrapper(::recvmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags | MSG_WAITFORONE, 0), ec);
+  if (result >= 0)
+  {
+    for (int i = 0; i < result; ++i)
+    {
+      addrlens[i] = msgs[i].msg_hdr.msg_namelen;
+      sizes[i] = msgs[i].msg_len;
+    }
+    ec = boost::system::error_code();
+    return result;
+  }
+
+  // Fall back to one recvmsg call per datagram if the kernel does not
+  // support recvmmsg.
+  if (ec.value() != ENOSYS)
+    return result;
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+  size_t n = 0;
+  while (n < count)
+  {
+    int bytes = socket_ops::recvfrom(s, &bufs[n], 1,
+        flags, addrs[n], &addrlens[n], ec);
+    if (bytes < 0)
+      break;
+    sizes[n++] = bytes;
+
+#if defined(MSG_DONTWAIT)
+    // Subsequent datagrams are only received if they are already queued.
+    flags |= MSG_DONTWAIT;
+#else // defined(MSG_DONTWAIT)
+    // There is no portable way to avoid blocking on subsequent datagrams.
+    break;
+#endif // defined(MSG_DONTWAIT)
+  }
+
+  if (n == 0)
+    return socket_error_retval;
+  ec = boost::system::error_code();
+  return static_cast<int>(n);
+}
+
+size_t sync_recvmmsg(socket_type s, state_type state, buf* bufs,
+    size_t count, int flags, socket_addr_type* const* addrs,
+    std::size_t* addrlens, std::size_t* sizes, boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Read some datagrams.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    int messages = socket_ops::recvmmsg(s, bufs,
+        count, flags, addrs, addrlens, sizes, ec);
+
+    // Check if operation succeeded.
+    if (messages >= 0)
+      return messages;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != boost::asio::error::would_block
+          && ec != boost::asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_read(s, 0, ec) < 0)
+      return 0;
+  }
+}
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+
+bool non_blocking_recvmmsg(socket_type s,
+    buf* bufs, size_t count, int flags, socket_addr_type* const* addrs,
+    std::size_t* addrlens, std::size_t* sizes,
+    boost::system::error_code& ec, size_t& messages_transferred)
+{
+  for (;;)
+  {
+    // Read some datagrams.
+    int messages = socket_ops::recvmmsg(s, bufs,
+        count, flags, addrs, addrlens, sizes, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (messages >= 0)
+    {
+      ec = boost::system::error_code();
+      messages_transferred = messages;
+    }
+    else
+      messages_transferred = 0;
+
+    return true;
+  }
+}
+
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+int sendmmsg(socket_type s, const buf* bufs, size_t count, int flags,
+    const socket_addr_type* const* addrs, const std::size_t* addrlens,
+    boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_HAS_MMSG)
+  clear_last_error();
+  mmsghdr msgs[max_mmsg_len];
+  if (count > static_cast<size_t>(max_mmsg_len))
+    count = max_mmsg_len;
+  for (size_t i = 0; i < count; ++i)
+  {
+    msgs[i].msg_hdr = msghdr();
+    init_msghdr_msg_name(msgs[i].msg_hdr.msg_name, addrs[i]);
+    msgs[i].msg_hdr.msg_namelen = addrlens[i];
+    msgs[i].msg_hdr.msg_iov = const_cast<buf*>(&bufs[i]);
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_len = 0;
+  }
+
+  int result = error_wrapper(::sendmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags | MSG_NOSIGNAL), ec);
+  if (result >= 0)
+  {
+    ec = boost::system::error_code();
+    return result;
+  }
+
+  // Fall back to one sendmsg call per datagram if the kernel does not
+  // support sendmmsg.
+  if (ec.value() != ENOSYS)
+    return result;
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+  size_t n = 0;
+  while (n < count)
+  {
+    if (socket_ops::sendto(s, &bufs[n], 1,
+          flags, addrs[n], addrlens[n], ec) < 0)
+      break;
+    ++n;
+  }
+
+  if (n == 0)
+    return socket_error_retval;
+  ec = boost::system::error_code();
+  return static_cast<int>(n);
+}
+
+size_t sync_sendmmsg(socket_type s, state_type state, const buf* bufs,
+    size_t count, int flags, const socket_addr_type* const* addrs,
+    const std::size_t* addrlens, boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Write some datagrams.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    int messages = socket_ops::sendmmsg(s, bufs,
+        count, flags, addrs, addrlens, ec);
+
+    // Check if operation succeeded.
+    if (messages >= 0)
+      return messages;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != boost::asio::error::would_block
+          && ec != boost::asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, 0, ec) < 0)
+      return 0;
+  }
+}
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+
+bool non_blocking_sendmmsg(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* const* addrs, const std::size_t* addrlens,
+    boost::system::error_code& ec, size_t& messages_transferred)
+{
+  for (;;)
+  {
+    // Write some datagrams.
+    int messages = socket_ops::sendmmsg(s, bufs,
+        count, flags, addrs, addrlens, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (messages >= 0)
+    {
+      ec = boost::system::error_code();
+      messages_transferred = messages;
+    }
+    else
+      messages_transferred = 0;
+
+    return true;
+  }
+}
+
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+// Neither sendfile nor splice accept MSG_NOSIGNAL, and SO_NOSIGPIPE does not
+// exist on Linux, so SIGPIPE is blocked in the calling thread while they write
+// to the socket. The kernel only raises the signal when a write to the socket
+// fails with EPIPE, which may follow a partial transfer. In those cases any
+// SIGPIPE that is pending afterwards is discarded, unless the signal was
+// already blocked by the caller.
+class sigpipe_blocker
+{
+public:
+  sigpipe_blocker()
+    : may_be_raised_(false)
+  {
+    sigemptyset(&sigpipe_);
+    sigaddset(&sigpipe_, SIGPIPE);
+    blocked_ = ::pthread_sigmask(SIG_BLOCK, &sigpipe_, &old_mask_) == 0
+      && !sigismember(&old_mask_, SIGPIPE);
+  }
+
+  ~sigpipe_blocker()
+  {
+    if (blocked_)
+    {
+      int saved_errno = errno;
+      sigset_t pending;
+      if (may_be_raised_ && ::sigpending(&pending) == 0
+          && sigismember(&pending, SIGPIPE))
+      {
+        timespec no_wait = { 0, 0 };
+        while (::sigtimedwait(&sigpipe_, 0, &no_wait) == -1 && errno == EINTR)
+          ;
+      }
+      ::pthread_sigmask(SIG_SETMASK, &old_mask_, 0);
+      errno = saved_errno;
+    }
+  }
+
+  // Record the outcome of a transfer of the given size.
+  void transferred(int result, size_t size,
+      const boost::system::error_code& ec)
+  {
+    if (result < 0 ? ec == boost::asio::error::broken_pipe
+        : static_cast<size_t>(result) < size)
+      may_be_raised_ = true;
+  }
+
+private:
+  sigset_t sigpipe_;
+  sigset_t old_mask_;
+  bool blocked_;
+  bool may_be_raised_;
+};
+
+inline int call_sendfile(socket_type s, int fd, boost::uint64_t& offset,
+    size_t size, bool& source_empty, boost::system::error_code& ec)
+{
+  sigpipe_blocker blocker;
+
+  off_t off = static_cast<off_t>(offset);
+  int result = static_cast<int>(error_wrapper(
+        ::sendfile(s, fd, &off, size), ec));
+  blocker.transferred(result, size, ec);
+  if (result >= 0)
+  {
+    ec = boost::system::error_code();
+    offset += result;
+    return result;
+  }
+
+  // The file descriptor cannot be used with sendfile, but if it refers to a
+  // pipe then its contents can be moved directly to the socket using splice.
+  // Pipes have no notion of an offset, so the offset is simply advanced.
+  if (ec == boost::asio::error::invalid_argument || ec.value() == ESPIPE)
+  {
+    clear_last_error();
+    result = static_cast<int>(error_wrapper(::splice(fd, 0, s, 0,
+          size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK), ec));
+    blocker.transferred(result, size, ec);
+    if (result >= 0)
+    {
+      ec = boost::system::error_code();
+      offset += result;
+    }
+    else if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+    {
+      // The splice fails in the same way whether the pipe is empty or the
+      // socket is full. Only the latter is resolved by the socket becoming
+      // writable, so the caller needs to know which one to wait for.
+      pollfd fds;
+      fds.fd = fd;
+      fds.events = POLLIN;
+      fds.revents = 0;
+      source_empty = ::poll(&fds, 1, 0) == 0;
+    }
+  }
+
+  return result;
+}
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
+inline int copy_file_to_socket(socket_type s, int fd,
+    boost::uint64_t& offset, size_t size, boost::system::error_code& ec)
+{
+  // Read a block from the file at the given offset. If the socket can't take
+  // all of it then the remainder is read again on the next call.
+  char data[16384];
+  if (size > sizeof(data))
+    size = sizeof(data);
+  clear_last_error();
+  int bytes = static_cast<int>(error_wrapper(::pread(fd,
+          data, size, static_cast<off_t>(offset)), ec));
+  if (bytes <= 0)
+  {
+    if (bytes == 0)
+      ec = boost::system::error_code();
+    return bytes;
+  }
+
+  buf b;
+  init_buf(b, data, bytes);
+  int result = socket_ops::send(s, &b, 1, 0, ec);
+  if (result >= 0)
+    offset += result;
+  return result;
+}
+
+int send_file(socket_type s, int fd, boost::uint64_t& offset,
+    size_t size, bool& source_empty, boost::system::error_code& ec)
+{
+  source_empty = false;
+
+  // Limit the amount transferred by one call so that the result fits in an
+  // int. Linux imposes a similar limit of its own.
+  if (size > 0x7ffff000)
+    size = 0x7ffff000;
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+  clear_last_error();
+  int result = call_sendfile(s, fd, offset, size, source_empty, ec);
+  if (result >= 0 || (ec != boost::asio::error::invalid_argument
+        && ec.value() != ENOSYS))
+    return result;
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
+  return copy_file_to_socket(s, fd, offset, size, ec);
+}
+
+size_t sync_send_file(socket_type s, state_type state, int fd,
+    boost::uint64_t offset, size_t size, boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Write the whole region, or until an error occurs.
+  size_t total_transferred = 0;
+  ec = boost::system::error_code();
+  while (total_transferred < size)
+  {
+    // Try to complete the operation without blocking.
+    bool source_empty = false;
+    int bytes = socket_ops::send_file(s, fd,
+        offset, size - total_transferred, source_empty, ec);
+
+    // Check if operation succeeded.
+    if (bytes > 0)
+    {
+      total_transferred += bytes;
+      continue;
+    }
+
+    // The end of the file was reached before the region was sent.
+    if (bytes == 0)
+    {
+      ec = boost::asio::error::eof;
+      break;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != boost::asio::error::would_block
+          && ec != boost::asio::error::try_again))
+      break;
+
+    // Wait for the pipe to be refilled, or for socket to become ready.
+    if (source_empty)
+    {
+      if (socket_ops::poll_read(fd, 0, ec) < 0)
+        break;
+    }
+    else if (socket_ops::poll_write(s, 0, ec) < 0)
+      break;
+  }
+
+  return total_transferred;
+}
+
+bool non_blocking_send_file(socket_type s, int fd,
+    boost::uint64_t& offset, size_t& remaining, bool& source_empty,
+    boost::system::error_code& ec, size_t& bytes_transferred)
+{
+  while (remaining > 0)
+  {
+    // Write some data.
+    int bytes = socket_ops::send_file(s, fd,
+        offset, remaining, source_empty, ec);
+
+    // Continue with the rest of the region after a partial write.
+    if (bytes > 0)
+    {
+      bytes_transferred += bytes;
+      remaining -= bytes;
+      continue;
+    }
+
+    // The end of the file was reached before the region was sent.
+    if (bytes == 0)
+    {
+      ec = boost::asio::error::eof;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    return true;
+  }
+
+  ec = boost::system::error_code();
+  return true;
+}
+
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
 socket_type socket(int af, int type, int protocol,
     boost::system::error_code& ec)
 {
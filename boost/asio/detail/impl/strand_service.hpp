@@ -27,6 +27,20 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+inline strand_service::strand_impl::strand_impl(strand_service& service)
+  : operation(&strand_service::do_complete),
+    service_(service),
+    incoming_(0),
+    pending_(0),
+    ref_count_(1),
+    delayed_count_(0),
+    retry_count_(0),
+    next_(0),
+    prev_(0)
+{
+}
+#else // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
 inline strand_service::strand_impl::strand_impl()
   : operation(&strand_service::do_complete),
     locked_(false)
@@ -49,6 +63,7 @@ struct strand_service::on_dispatch_exit
       io_service_->post_immediate_completion(impl_);
   }
 };
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
 
 template <typename Handler>
 void strand_service::dispatch(strand_service::implementation_type& impl,
@@ -71,6 +86,11 @@ void strand_service::dispatch(strand_service::implementation_type& impl,
 
   BOOST_ASIO_HANDLER_CREATION((p.p, "strand", impl, "dispatch"));
 
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+  operation* o = p.p;
+  p.v = p.p = 0;
+  do_dispatch(impl, o);
+#else // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
   bool dispatch_immediately = do_dispatch(impl, p.p);
   operation* o = p.p;
   p.v = p.p = 0;
@@ -87,6 +107,7 @@ void strand_service::dispatch(strand_service::implementation_type& impl,
     completion_handler<Handler>::do_complete(
         &io_service_, o, boost::system::error_code(), 0);
   }
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
 }
 
 // Request the io_service to invoke the given handler and return immediately.
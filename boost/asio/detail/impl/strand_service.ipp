@@ -25,6 +25,236 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+
+struct strand_service::on_do_complete_exit
+{
+  io_service_impl* owner_;
+  strand_impl* impl_;
+  std::size_t completed_;
+  bool is_dispatch_;
+
+  ~on_do_complete_exit()
+  {
+    if (impl_->pending_.fetch_sub(completed_) != completed_)
+    {
+      // More handlers are pending, so the strand stays locked and must be
+      // scheduled to run them.
+      if (is_dispatch_)
+        owner_->post_immediate_completion(impl_);
+      else
+        owner_->post_private_immediate_completion(impl_);
+    }
+    else
+    {
+      // The strand is now unlocked. Drop the reference held by the lock.
+      strand_service::release(impl_);
+    }
+  }
+};
+
+strand_service::strand_service(boost::asio::io_service& io_service)
+  : boost::asio::detail::service_base<strand_service>(io_service),
+    io_service_(boost::asio::use_service<io_service_impl>(io_service)),
+    mutex_(),
+    impl_list_(0)
+{
+}
+
+void strand_service::shutdown_service()
+{
+  op_queue<operation> ops;
+
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+
+  for (strand_impl* impl = impl_list_; impl; impl = impl->next_)
+  {
+    take_incoming(impl);
+    ops.push(impl->ready_queue_);
+  }
+}
+
+void strand_service::construct(strand_service::implementation_type& impl)
+{
+  impl = new strand_impl(*this);
+
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+
+  impl->next_ = impl_list_;
+  impl->prev_ = 0;
+  if (impl_list_)
+    impl_list_->prev_ = impl;
+  impl_list_ = impl;
+}
+
+void strand_service::copy_construct(strand_service::implementation_type& impl,
+    const strand_service::implementation_type& other_impl)
+{
+  impl = other_impl;
+  ++impl->ref_count_;
+}
+
+void strand_service::destroy(strand_service::implementation_type& impl)
+{
+  release(impl);
+  impl = 0;
+}
+
+std::size_t strand_service::delayed_handler_count(
+    const implementation_type& impl) const
+{
+  return impl->delayed_count_.load();
+}
+
+std::size_t strand_service::enqueue_retry_count(
+    const implementation_type& impl) const
+{
+  return impl->retry_count_.load();
+}
+
+bool strand_service::enqueue(strand_impl* impl, operation* op)
+{
+  // Push the handler onto the list of incoming handlers. Only the strand lock
+  // holder ever removes entries, and it always takes the whole list, so the
+  // push is not subject to ABA problems.
+  operation* head = impl->incoming_.load();
+  for (;;)
+  {
+    op_queue_access::next(op, head);
+    if (impl->incoming_.compare_exchange_weak(head, op))
+      break;
+    ++impl->retry_count_;
+  }
+
+  if (impl->pending_.fetch_add(1) == 0)
+  {
+    // The handler is acquiring the strand lock, which holds a reference to the
+    // implementation until the strand is unlocked.
+    ++impl->ref_count_;
+    return true;
+  }
+
+  // Some other handler already holds the strand lock.
+  ++impl->delayed_count_;
+  return false;
+}
+
+void strand_service::take_incoming(strand_impl* impl)
+{
+  operation* head = impl->incoming_.exchange(0);
+
+  // Reverse the list so that handlers run in the order they were enqueued.
+  operation* reversed = 0;
+  while (head)
+  {
+    operation* next = op_queue_access::next(head);
+    op_queue_access::next(head, reversed);
+    reversed = head;
+    head = next;
+  }
+
+  while (reversed)
+  {
+    operation* next = op_queue_access::next(reversed);
+    op_queue_access::next(reversed, static_cast<operation*>(0));
+    impl->ready_queue_.push(reversed);
+    reversed = next;
+  }
+}
+
+void strand_service::release(strand_impl* impl)
+{
+  if (impl->ref_count_.fetch_sub(1) == 1)
+  {
+    strand_service& service = impl->service_;
+
+    boost::asio::detail::mutex::scoped_lock lock(service.mutex_);
+
+    if (service.impl_list_ == impl)
+      service.impl_list_ = impl->next_;
+    if (impl->prev_)
+      impl->prev_->next_ = impl->next_;
+    if (impl->next_)
+      impl->next_->prev_ = impl->prev_;
+
+    lock.unlock();
+
+    delete impl;
+  }
+}
+
+void strand_service::do_dispatch(implementation_type& impl, operation* op)
+{
+  if (!enqueue(impl, op))
+    return;
+
+  // The handler has acquired the strand lock. If we are not running inside
+  // the io_service then the strand must be scheduled.
+  if (!io_service_.can_dispatch())
+  {
+    io_service_.post_immediate_completion(impl);
+    return;
+  }
+
+  // Indicate that this strand is executing on the current thread.
+  call_stack<strand_impl>::context ctx(impl);
+
+  // Run the handler at the head of the strand. Any other handlers that were
+  // enqueued concurrently are scheduled on block exit.
+  take_incoming(impl);
+  on_do_complete_exit on_exit = { &io_service_, impl, 1, true };
+  (void)on_exit;
+
+  operation* o = impl->ready_queue_.front();
+  impl->ready_queue_.pop();
+  o->complete(io_service_, boost::system::error_code(), 0);
+}
+
+void strand_service::do_post(implementation_type& impl, operation* op)
+{
+  // The handler that acquires the strand lock is responsible for scheduling
+  // the strand.
+  if (enqueue(impl, op))
+    io_service_.post_immediate_completion(impl);
+}
+
+void strand_service::do_complete(io_service_impl* owner, operation* base,
+    const boost::system::error_code& ec, std::size_t /*bytes_transferred*/)
+{
+  strand_impl* impl = static_cast<strand_impl*>(base);
+
+  if (owner)
+  {
+    // Indicate that this strand is executing on the current thread.
+    call_stack<strand_impl>::context ctx(impl);
+
+    // Only the handlers that have been enqueued so far are run by this
+    // invocation, so that other work in the io_service is not starved.
+    take_incoming(impl);
+
+    // Ensure the next handler, if any, is scheduled on block exit.
+    on_do_complete_exit on_exit = { owner, impl, 0, false };
+
+    // Run all ready handlers. No lock is required since the ready queue is
+    // accessed only within the strand.
+    while (operation* o = impl->ready_queue_.front())
+    {
+      impl->ready_queue_.pop();
+      ++on_exit.completed_;
+      o->complete(*owner, ec, 0);
+    }
+  }
+  else
+  {
+    // The io_service is being destroyed and the strand's handlers have
+    // already been destroyed by shutdown_service(). Drop the reference held
+    // by the strand lock.
+    release(impl);
+  }
+}
+
+#else // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+
 struct strand_service::on_do_complete_exit
 {
   io_service_impl* owner_;
@@ -162,6 +392,8 @@ void strand_service::do_complete(io_service_impl* owner, operation* base,
   }
 }
 
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
@@ -24,6 +24,12 @@
 #include <boost/asio/detail/reactor.hpp>
 #include <boost/asio/detail/task_io_service.hpp>
 
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+# include <sched.h>
+# include <sys/time.h>
+# include <time.h>
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -36,6 +42,22 @@ struct task_io_service::thread_info
   op_queue<operation> private_op_queue;
   long private_outstanding_work;
   thread_info* next;
+
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  // Protects the local queue against concurrent stealing. Other threads only
+  // acquire this mutex while also holding the task_io_service's mutex.
+  mutex local_mutex;
+  op_queue<operation> local_op_queue;
+  std::size_t local_op_count;
+  std::size_t local_run_count;
+  bool local_stopped;
+  bool is_worker;
+  thread_info* next_worker;
+  thread_info* prev_worker;
+
+  // The wait count that includes this thread while it is waiting, if any.
+  atomic_count* wait_count;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
 };
 
 struct task_io_service::task_cleanup
@@ -53,6 +75,9 @@ struct task_io_service::task_cleanup
     // Enqueue the completed operations and reinsert the task at the end of
     // the operation queue.
     lock_->lock();
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+    task_io_service_->end_wait(*this_thread_);
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
     task_io_service_->task_interrupted_ = true;
     task_io_service_->op_queue_.push(this_thread_->private_op_queue);
     task_io_service_->op_queue_.push(&task_io_service_->task_operation_);
@@ -93,6 +118,40 @@ struct task_io_service::work_cleanup
   thread_info* this_thread_;
 };
 
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+struct task_io_service::worker_cleanup
+{
+  ~worker_cleanup()
+  {
+    lock_->lock();
+
+    // Remove the thread from the set of steal victims.
+    if (this_thread_->prev_worker)
+      this_thread_->prev_worker->next_worker = this_thread_->next_worker;
+    else
+      task_io_service_->first_worker_ = this_thread_->next_worker;
+    if (this_thread_->next_worker)
+      this_thread_->next_worker->prev_worker = this_thread_->prev_worker;
+    if (task_io_service_->next_victim_ == this_thread_)
+      task_io_service_->next_victim_ = this_thread_->next_worker;
+    --task_io_service_->worker_count_;
+    this_thread_->is_worker = false;
+
+    // Hand any unfinished local operations back to the shared queue.
+    if (!this_thread_->local_op_queue.empty())
+    {
+      task_io_service_->op_queue_.push(this_thread_->local_op_queue);
+      this_thread_->local_op_count = 0;
+      task_io_service_->wake_one_thread_and_unlock(*lock_);
+    }
+  }
+
+  task_io_service* task_io_service_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
 task_io_service::task_io_service(
     boost::asio::io_service& io_service, std::size_t concurrency_hint)
   : boost::asio::detail::service_base<task_io_service>(io_service),
@@ -104,6 +163,21 @@ task_io_service::task_io_service(
     stopped_(false),
     shutdown_(false),
     first_idle_thread_(0)
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+    , idle_thread_count_(0)
+    , bounded_wait_count_(0)
+    , unbounded_wait_count_(0)
+    , worker_count_(0)
+    , first_worker_(0)
+    , next_victim_(0)
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+    , busy_poll_usec_(BOOST_ASIO_BUSY_POLL_USEC)
+    , task_spinning_(false)
+    , spinning_threads_(0)
+    , busy_poll_hits_(0)
+    , busy_poll_parks_(0)
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
 {
   BOOST_ASIO_HANDLER_TRACKING_INIT;
 }
@@ -152,14 +226,28 @@ std::size_t task_io_service::run(boost::system::error_code& ec)
   this_thread.wakeup_event = &wakeup_event;
   this_thread.private_outstanding_work = 0;
   this_thread.next = 0;
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  this_thread.is_worker = false;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
   thread_call_stack::context ctx(this, this_thread);
+  handler_memory_cache::scope memory_cache(memory_cache_pool_);
 
   mutex::scoped_lock lock(mutex_);
 
   std::size_t n = 0;
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  register_worker(this_thread);
+  worker_cleanup on_exit = { this, &lock, &this_thread };
+  (void)on_exit;
+
+  while (do_run_one_local_first(lock, this_thread, ec))
+    if (n != (std::numeric_limits<std::size_t>::max)())
+      ++n;
+#else // defined(BOOST_ASIO_HAS_WORK_STEALING)
   for (; do_run_one(lock, this_thread, ec); lock.lock())
     if (n != (std::numeric_limits<std::size_t>::max)())
       ++n;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
   return n;
 }
 
@@ -177,7 +265,11 @@ std::size_t task_io_service::run_one(boost::system::error_code& ec)
   this_thread.wakeup_event = &wakeup_event;
   this_thread.private_outstanding_work = 0;
   this_thread.next = 0;
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  this_thread.is_worker = false;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
   thread_call_stack::context ctx(this, this_thread);
+  handler_memory_cache::scope memory_cache(memory_cache_pool_);
 
   mutex::scoped_lock lock(mutex_);
 
@@ -197,7 +289,11 @@ std::size_t task_io_service::poll(boost::system::error_code& ec)
   this_thread.wakeup_event = 0;
   this_thread.private_outstanding_work = 0;
   this_thread.next = 0;
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  this_thread.is_worker = false;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
   thread_call_stack::context ctx(this, this_thread);
+  handler_memory_cache::scope memory_cache(memory_cache_pool_);
 
   mutex::scoped_lock lock(mutex_);
 
@@ -230,7 +326,11 @@ std::size_t task_io_service::poll_one(boost::system::error_code& ec)
   this_thread.wakeup_event = 0;
   this_thread.private_outstanding_work = 0;
   this_thread.next = 0;
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  this_thread.is_worker = false;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
   thread_call_stack::context ctx(this, this_thread);
+  handler_memory_cache::scope memory_cache(memory_cache_pool_);
 
   mutex::scoped_lock lock(mutex_);
 
@@ -262,6 +362,14 @@ void task_io_service::reset()
 {
   mutex::scoped_lock lock(mutex_);
   stopped_ = false;
+
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  for (thread_info* worker = first_worker_; worker; worker = worker->next_worker)
+  {
+    mutex::scoped_lock local_lock(worker->local_mutex);
+    worker->local_stopped = false;
+  }
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
 }
 
 void task_io_service::post_immediate_completion(task_io_service::operation* op)
@@ -278,6 +386,18 @@ void task_io_service::post_immediate_completion(task_io_service::operation* op)
   }
 #endif // defined(BOOST_HAS_THREADS) && !defined(BOOST_ASIO_DISABLE_THREADS)
 
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  if (thread_info* this_thread = thread_call_stack::contains(this))
+  {
+    if (this_thread->is_worker)
+    {
+      work_started();
+      post_local_deferred_completion(*this_thread, op);
+      return;
+    }
+  }
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
   work_started();
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
@@ -297,6 +417,17 @@ void task_io_service::post_deferred_completion(task_io_service::operation* op)
   }
 #endif // defined(BOOST_HAS_THREADS) && !defined(BOOST_ASIO_DISABLE_THREADS)
 
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  if (thread_info* this_thread = thread_call_stack::contains(this))
+  {
+    if (this_thread->is_worker)
+    {
+      post_local_deferred_completion(*this_thread, op);
+      return;
+    }
+  }
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -318,6 +449,17 @@ void task_io_service::post_deferred_completions(
     }
 #endif // defined(BOOST_HAS_THREADS) && !defined(BOOST_ASIO_DISABLE_THREADS)
 
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+    if (thread_info* this_thread = thread_call_stack::contains(this))
+    {
+      if (this_thread->is_worker)
+      {
+        post_local_deferred_completions(*this_thread, ops);
+        return;
+      }
+    }
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
     mutex::scoped_lock lock(mutex_);
     op_queue_.push(ops);
     wake_one_thread_and_unlock(lock);
@@ -386,6 +528,42 @@ std::size_t task_io_service::do_run_one(mutex::scoped_lock& lock,
       {
         task_interrupted_ = more_handlers;
 
+        // Only block if the operation queue is empty, otherwise we want to
+        // return as soon as possible.
+        long task_usec = more_handlers ? 0 : -1;
+
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+        if (task_usec != 0 && this_thread.is_worker)
+        {
+          // A worker running a handler may be waiting for an operation that
+          // it queued locally, which the task would not see. Unless an idle
+          // thread is already checking for such operations, bound the wait.
+          bool bounded = bounded_wait_count_ == 0
+            && worker_count_
+              > static_cast<std::size_t>(idle_thread_count_) + 1;
+          begin_wait(this_thread, bounded);
+
+          // Look for local operations after being counted as waiting, so that
+          // a thread that queues one either sees the count or is seen here.
+          // Thieves only modify a worker's local queue while holding the
+          // mutex, so the result stays valid.
+          if (steal_operations(this_thread))
+          {
+            end_wait(this_thread);
+            task_usec = 0;
+          }
+          else if (bounded)
+            task_usec = BOOST_ASIO_WORK_STEALING_CHECK_USEC;
+        }
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+        // Poll the task before letting it block. While it is being polled, the
+        // task is not interrupted when new work arrives.
+        long busy_poll_usec = task_usec != 0 ? busy_poll_usec_ : 0;
+        task_spinning_ = (busy_poll_usec > 0);
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+
         if (more_handlers && !one_thread_)
         {
           if (!wake_one_idle_thread_and_unlock(lock))
@@ -394,13 +572,36 @@ std::size_t task_io_service::do_run_one(mutex::scoped_lock& lock,
         else
           lock.unlock();
 
-        task_cleanup on_exit = { this, &lock, &this_thread };
-        (void)on_exit;
+        {
+          task_cleanup on_exit = { this, &lock, &this_thread };
+          (void)on_exit;
+
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+          if (busy_poll_usec > 0
+              && busy_poll_task(lock, this_thread, busy_poll_usec))
+          {
+            // Work arrived while polling, so there is no need to block.
+          }
+          else
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+          {
+            // Run the task. May throw an exception.
+            task_->run(task_usec, this_thread.private_op_queue);
+          }
+        }
 
-        // Run the task. May throw an exception. Only block if the operation
-        // queue is empty and we're not polling, otherwise we want to return
-        // as soon as possible.
-        task_->run(!more_handlers, this_thread.private_op_queue);
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+        // The task is back on the queue, where this thread would find it
+        // again before its local queue. Run a local operation first, whether
+        // it was left there or the task returned for it to be stolen.
+        if (this_thread.is_worker && steal_operations(this_thread))
+        {
+          lock.unlock();
+          if (std::size_t n = do_run_local_one(lock, this_thread, ec))
+            return n;
+          lock.lock();
+        }
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
       }
       else
       {
@@ -421,12 +622,57 @@ std::size_t task_io_service::do_run_one(mutex::scoped_lock& lock,
         return 1;
       }
     }
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+    else if (this_thread.is_worker && steal_operations(this_thread))
+    {
+      lock.unlock();
+      if (std::size_t n = do_run_local_one(lock, this_thread, ec))
+        return n;
+      lock.lock();
+    }
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+    else if (busy_poll_usec_ > 0 && busy_poll_idle(lock, this_thread))
+    {
+      // Work arrived while polling, so go round again to pick it up.
+    }
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
     else
     {
       // Nothing to run right now, so just wait for work to do.
       this_thread.next = first_idle_thread_;
       first_idle_thread_ = &this_thread;
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+      ++idle_thread_count_;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
       this_thread.wakeup_event->clear(lock);
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+      if (this_thread.is_worker)
+      {
+        // If other workers are running handlers and neither the task nor
+        // another idle thread is checking for operations they queue locally,
+        // this thread checks periodically instead of sleeping until woken.
+        // The thread running the task, if any, is neither idle nor busy.
+        bool bounded = bounded_wait_count_ == 0
+          && worker_count_ > static_cast<std::size_t>(idle_thread_count_)
+            + (task_ ? 1 : 0);
+        begin_wait(this_thread, bounded);
+
+        if (steal_operations(this_thread))
+          remove_idle_thread(this_thread);
+        else if (bounded)
+        {
+          if (!this_thread.wakeup_event->wait_for_usec(
+                lock, BOOST_ASIO_WORK_STEALING_CHECK_USEC))
+            remove_idle_thread(this_thread);
+        }
+        else
+          this_thread.wakeup_event->wait(lock);
+
+        end_wait(this_thread);
+        continue;
+      }
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
       this_thread.wakeup_event->wait(lock);
     }
   }
@@ -434,6 +680,308 @@ std::size_t task_io_service::do_run_one(mutex::scoped_lock& lock,
   return 0;
 }
 
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+std::size_t task_io_service::do_run_one_local_first(mutex::scoped_lock& lock,
+    task_io_service::thread_info& this_thread,
+    const boost::system::error_code& ec)
+{
+  // Bound the number of consecutive local operations so that the shared queue
+  // and the task are not starved by a thread that keeps posting to itself.
+  if (this_thread.local_run_count < max_local_run)
+  {
+    lock.unlock();
+    if (std::size_t n = do_run_local_one(lock, this_thread, ec))
+      return n;
+  }
+
+  this_thread.local_run_count = 0;
+  lock.lock();
+  return do_run_one(lock, this_thread, ec);
+}
+
+std::size_t task_io_service::do_run_local_one(mutex::scoped_lock& lock,
+    task_io_service::thread_info& this_thread,
+    const boost::system::error_code& ec)
+{
+  operation* o = 0;
+  {
+    mutex::scoped_lock local_lock(this_thread.local_mutex);
+    if (this_thread.local_stopped)
+      return 0;
+    o = this_thread.local_op_queue.front();
+    if (o == 0)
+      return 0;
+    this_thread.local_op_queue.pop();
+    --this_thread.local_op_count;
+  }
+
+  ++this_thread.local_run_count;
+  std::size_t task_result = o->task_result_;
+
+  // Ensure the count of outstanding work is decremented on block exit.
+  work_cleanup on_exit = { this, &lock, &this_thread };
+  (void)on_exit;
+
+  // Complete the operation. May throw an exception. Deletes the object.
+  o->complete(*this, ec, task_result);
+
+  return 1;
+}
+
+void task_io_service::register_worker(task_io_service::thread_info& this_thread)
+{
+  this_thread.local_op_count = 0;
+  this_thread.local_run_count = 0;
+  this_thread.local_stopped = stopped_;
+  this_thread.is_worker = true;
+  this_thread.wait_count = 0;
+  ++worker_count_;
+  this_thread.prev_worker = 0;
+  this_thread.next_worker = first_worker_;
+  if (first_worker_)
+    first_worker_->prev_worker = &this_thread;
+  first_worker_ = &this_thread;
+}
+
+bool task_io_service::steal_operations(task_io_service::thread_info& this_thread)
+{
+  // Only the owning thread adds to its local queue, so operations left behind
+  // after reaching max_local_run are still there.
+  if (this_thread.local_op_count > 0)
+    return true;
+
+  thread_info* victim = next_victim_ ? next_victim_ : first_worker_;
+  thread_info* const first_victim = victim;
+  while (victim)
+  {
+    if (victim != &this_thread)
+    {
+      // Take the older half of the victim's queue, rounding up so that a
+      // single queued operation can also be stolen.
+      op_queue<operation> stolen;
+      std::size_t n = 0;
+      {
+        mutex::scoped_lock victim_lock(victim->local_mutex);
+        std::size_t wanted = (victim->local_op_count + 1) / 2;
+        while (n < wanted)
+        {
+          operation* o = victim->local_op_queue.front();
+          victim->local_op_queue.pop();
+          stolen.push(o);
+          ++n;
+        }
+        victim->local_op_count -= n;
+      }
+
+      if (n > 0)
+      {
+        next_victim_ = victim->next_worker;
+        mutex::scoped_lock local_lock(this_thread.local_mutex);
+        this_thread.local_op_queue.push(stolen);
+        this_thread.local_op_count += n;
+        return true;
+      }
+    }
+
+    victim = victim->next_worker ? victim->next_worker : first_worker_;
+    if (victim == first_victim)
+      break;
+  }
+
+  return false;
+}
+
+void task_io_service::post_local_deferred_completion(
+    task_io_service::thread_info& this_thread,
+    task_io_service::operation* op)
+{
+  std::size_t count = 0;
+  {
+    mutex::scoped_lock local_lock(this_thread.local_mutex);
+    this_thread.local_op_queue.push(op);
+    count = ++this_thread.local_op_count;
+  }
+
+  wake_for_local_operations(count == 1, count > 1);
+}
+
+void task_io_service::post_local_deferred_completions(
+    task_io_service::thread_info& this_thread,
+    op_queue<task_io_service::operation>& ops)
+{
+  std::size_t n = 0;
+  for (operation* o = ops.front(); o; o = op_queue_access::next(o))
+    ++n;
+
+  bool was_empty = false;
+  std::size_t count = 0;
+  {
+    mutex::scoped_lock local_lock(this_thread.local_mutex);
+    was_empty = (this_thread.local_op_count == 0);
+    this_thread.local_op_queue.push(ops);
+    count = (this_thread.local_op_count += n);
+  }
+
+  wake_for_local_operations(was_empty, count > 1);
+}
+
+void task_io_service::wake_for_local_operations(bool was_empty, bool backlog)
+{
+  // A backlog is shared with an idle thread. Otherwise the calling thread
+  // normally runs the operations itself once the current handler returns. If
+  // the handler instead waits for them, a thread whose wait is bounded will
+  // steal them, so a thread only needs to be woken when there is none and
+  // another thread would block indefinitely.
+  if (backlog && idle_thread_count_ > 0)
+    wake_one_idle_thread_for_stealing();
+  else if (was_empty && bounded_wait_count_ == 0 && unbounded_wait_count_ > 0)
+    wake_one_thread_for_stealing();
+}
+
+void task_io_service::wake_one_idle_thread_for_stealing()
+{
+  mutex::scoped_lock lock(mutex_);
+  wake_one_idle_thread_and_unlock(lock);
+}
+
+void task_io_service::wake_one_thread_for_stealing()
+{
+  // Wake an idle thread if there is one, otherwise interrupt the task so that
+  // the thread running it looks for operations to steal.
+  mutex::scoped_lock lock(mutex_);
+  wake_one_thread_and_unlock(lock);
+}
+
+void task_io_service::begin_wait(
+    task_io_service::thread_info& this_thread, bool bounded)
+{
+  this_thread.wait_count = bounded
+    ? &bounded_wait_count_ : &unbounded_wait_count_;
+  ++*this_thread.wait_count;
+}
+
+void task_io_service::end_wait(task_io_service::thread_info& this_thread)
+{
+  if (this_thread.is_worker && this_thread.wait_count)
+  {
+    --*this_thread.wait_count;
+    this_thread.wait_count = 0;
+  }
+}
+
+void task_io_service::remove_idle_thread(
+    task_io_service::thread_info& this_thread)
+{
+  for (thread_info** t = &first_idle_thread_; *t; t = &(*t)->next)
+  {
+    if (*t == &this_thread)
+    {
+      *t = this_thread.next;
+      this_thread.next = 0;
+      --idle_thread_count_;
+      return;
+    }
+  }
+}
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+long task_io_service::busy_poll_duration() const
+{
+  mutex::scoped_lock lock(mutex_);
+  return busy_poll_usec_;
+}
+
+void task_io_service::busy_poll_duration(long usec)
+{
+  mutex::scoped_lock lock(mutex_);
+  busy_poll_usec_ = usec > 0 ? usec : 0;
+}
+
+bool task_io_service::busy_poll_task(mutex::scoped_lock& lock,
+    task_io_service::thread_info& this_thread, long usec)
+{
+  const boost::int64_t deadline = busy_poll_clock() + usec;
+  for (;;)
+  {
+    task_->run(0, this_thread.private_op_queue);
+    bool found = !this_thread.private_op_queue.empty();
+    bool expired = !found && busy_poll_clock() >= deadline;
+
+    // Anyone posting new work or stopping the io_service while the task is
+    // spinning sets task_interrupted_ without interrupting the task.
+    lock.lock();
+    found = found || task_interrupted_;
+    if (found || expired)
+    {
+      task_spinning_ = false;
+      lock.unlock();
+      if (found)
+        ++busy_poll_hits_;
+      else
+        ++busy_poll_parks_;
+      return found;
+    }
+    lock.unlock();
+
+    // Give up the CPU between polls in case the thread that will produce the
+    // work is waiting to run on it.
+    ::sched_yield();
+  }
+}
+
+bool task_io_service::busy_poll_idle(mutex::scoped_lock& lock,
+    task_io_service::thread_info& this_thread)
+{
+  // Threads that post work skip waking the task while a thread is spinning
+  // here, so the count must be maintained under the mutex.
+  ++spinning_threads_;
+  const boost::int64_t deadline = busy_poll_clock() + busy_poll_usec_;
+  for (;;)
+  {
+    lock.unlock();
+    for (int i = 0; i < 64; ++i)
+    {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+      __asm__ __volatile__ ("pause");
+#endif // defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    }
+    ::sched_yield();
+    bool expired = busy_poll_clock() >= deadline;
+    lock.lock();
+
+    bool found = stopped_ || !op_queue_.empty();
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+    found = found || (this_thread.is_worker && steal_operations(this_thread));
+#else // defined(BOOST_ASIO_HAS_WORK_STEALING)
+    (void)this_thread;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+    if (found || expired)
+    {
+      --spinning_threads_;
+      if (found)
+        ++busy_poll_hits_;
+      else
+        ++busy_poll_parks_;
+      return found;
+    }
+  }
+}
+
+boost::int64_t task_io_service::busy_poll_clock()
+{
+#if defined(CLOCK_MONOTONIC)
+  timespec ts;
+  ::clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<boost::int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#else // defined(CLOCK_MONOTONIC)
+  timeval tv;
+  ::gettimeofday(&tv, 0);
+  return static_cast<boost::int64_t>(tv.tv_sec) * 1000000 + tv.tv_usec;
+#endif // defined(CLOCK_MONOTONIC)
+}
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+
 std::size_t task_io_service::do_poll_one(mutex::scoped_lock& lock,
     task_io_service::thread_info& this_thread,
     const boost::system::error_code& ec)
@@ -454,7 +1002,7 @@ std::size_t task_io_service::do_poll_one(mutex::scoped_lock& lock,
       // Run the task. May throw an exception. Only block if the operation
       // queue is empty and we're not polling, otherwise we want to return
       // as soon as possible.
-      task_->run(false, this_thread.private_op_queue);
+      task_->run(0, this_thread.private_op_queue);
     }
 
     o = op_queue_.front();
@@ -495,9 +1043,20 @@ void task_io_service::stop_all_threads(
     thread_info* idle_thread = first_idle_thread_;
     first_idle_thread_ = idle_thread->next;
     idle_thread->next = 0;
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+    --idle_thread_count_;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
     idle_thread->wakeup_event->signal(lock);
   }
 
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  for (thread_info* worker = first_worker_; worker; worker = worker->next_worker)
+  {
+    mutex::scoped_lock local_lock(worker->local_mutex);
+    worker->local_stopped = true;
+  }
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
   if (!task_interrupted_ && task_)
   {
     task_interrupted_ = true;
@@ -513,6 +1072,9 @@ bool task_io_service::wake_one_idle_thread_and_unlock(
     thread_info* idle_thread = first_idle_thread_;
     first_idle_thread_ = idle_thread->next;
     idle_thread->next = 0;
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+    --idle_thread_count_;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
     idle_thread->wakeup_event->signal_and_unlock(lock);
     return true;
   }
@@ -524,11 +1086,27 @@ void task_io_service::wake_one_thread_and_unlock(
 {
   if (!wake_one_idle_thread_and_unlock(lock))
   {
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+    // A spinning thread will find the work without being woken.
+    if (spinning_threads_ > 0)
+    {
+      lock.unlock();
+      return;
+    }
+
+    if (!task_interrupted_ && task_)
+    {
+      task_interrupted_ = true;
+      if (!task_spinning_)
+        task_->interrupt();
+    }
+#else // defined(BOOST_ASIO_HAS_BUSY_POLL)
     if (!task_interrupted_ && task_)
     {
       task_interrupted_ = true;
       task_->interrupt();
     }
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
     lock.unlock();
   }
 }
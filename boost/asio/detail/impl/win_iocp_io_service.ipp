@@ -154,6 +154,7 @@ size_t win_iocp_io_service::run(boost::system::error_code& ec)
   }
 
   call_stack<win_iocp_io_service>::context ctx(this);
+  handler_memory_cache::scope memory_cache(memory_cache_pool_);
 
   size_t n = 0;
   while (do_one(true, ec))
@@ -172,6 +173,7 @@ size_t win_iocp_io_service::run_one(boost::system::error_code& ec)
   }
 
   call_stack<win_iocp_io_service>::context ctx(this);
+  handler_memory_cache::scope memory_cache(memory_cache_pool_);
 
   return do_one(true, ec);
 }
@@ -186,6 +188,7 @@ size_t win_iocp_io_service::poll(boost::system::error_code& ec)
   }
 
   call_stack<win_iocp_io_service>::context ctx(this);
+  handler_memory_cache::scope memory_cache(memory_cache_pool_);
 
   size_t n = 0;
   while (do_one(false, ec))
@@ -204,6 +207,7 @@ size_t win_iocp_io_service::poll_one(boost::system::error_code& ec)
   }
 
   call_stack<win_iocp_io_service>::context ctx(this);
+  handler_memory_cache::scope memory_cache(memory_cache_pool_);
 
   return do_one(false, ec);
 }
@@ -0,0 +1,281 @@
+//
+// detail/io_uring_reactor.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_REACTOR_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_REACTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/cstdint.hpp>
+#include <boost/limits.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/epoll_reactor.hpp>
+#include <boost/asio/detail/io_uring_reactor_fwd.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/socket_types.hpp>
+#include <boost/asio/detail/timer_queue_base.hpp>
+#include <boost/asio/detail/timer_queue_fwd.hpp>
+#include <boost/asio/detail/wait_op.hpp>
+#include <linux/io_uring.h>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A backend that drives descriptors through an io_uring instance. Reads,
+// writes and accepts are handed to the kernel as io_uring requests, other
+// operations wait for readiness using io_uring poll requests, and timers are
+// implemented using io_uring timeouts. Requests are collected in the
+// submission queue and passed to the kernel in batches, either when the
+// io_service next runs the task or immediately if a thread is blocked waiting
+// for completions.
+//
+// If the kernel does not provide the required io_uring features, every
+// operation is forwarded to an epoll_reactor instead.
+class io_uring_reactor
+  : public boost::asio::detail::service_base<io_uring_reactor>
+{
+public:
+  enum op_types { read_op = 0, write_op = 1,
+    connect_op = 1, except_op = 2, max_ops = 3 };
+
+  // Per-descriptor data.
+  typedef epoll_reactor::per_descriptor_data per_descriptor_data;
+
+  // Constructor.
+  BOOST_ASIO_DECL io_uring_reactor(boost::asio::io_service& io_service);
+
+  // Destructor.
+  BOOST_ASIO_DECL ~io_uring_reactor();
+
+  // Destroy all user-defined handler objects owned by the service.
+  BOOST_ASIO_DECL void shutdown_service();
+
+  // Recreate internal descriptors following a fork.
+  BOOST_ASIO_DECL void fork_service(
+      boost::asio::io_service::fork_event fork_ev);
+
+  // Initialise the task.
+  BOOST_ASIO_DECL void init_task();
+
+  // Register a socket with the reactor. Returns 0 on success, system error
+  // code on failure.
+  BOOST_ASIO_DECL int register_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data);
+
+  // Register a descriptor with an associated single operation. Returns 0 on
+  // success, system error code on failure.
+  BOOST_ASIO_DECL int register_internal_descriptor(
+      int op_type, socket_type descriptor,
+      per_descriptor_data& descriptor_data, reactor_op* op);
+
+  // Move descriptor registration from one descriptor_data object to another.
+  BOOST_ASIO_DECL void move_descriptor(socket_type descriptor,
+      per_descriptor_data& target_descriptor_data,
+      per_descriptor_data& source_descriptor_data);
+
+  // Post a reactor operation for immediate completion.
+  void post_immediate_completion(reactor_op* op)
+  {
+    epoll_.post_immediate_completion(op);
+  }
+
+  // Start a new operation. The operation will be submitted to the kernel, or
+  // performed when the given descriptor is flagged as ready, or an error has
+  // occurred.
+  BOOST_ASIO_DECL void start_op(int op_type, socket_type descriptor,
+      per_descriptor_data& descriptor_data, reactor_op* op,
+      bool allow_speculative);
+
+  // Cancel all operations associated with the given descriptor. The
+  // handlers associated with the descriptor will be invoked with the
+  // operation_aborted error.
+  BOOST_ASIO_DECL void cancel_ops(socket_type descriptor,
+      per_descriptor_data& descriptor_data);
+
+  // Cancel any operations that are running against the descriptor and remove
+  // its registration from the reactor.
+  BOOST_ASIO_DECL void deregister_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data, bool closing);
+
+  // Remote the descriptor's registration from the reactor.
+  BOOST_ASIO_DECL void deregister_internal_descriptor(
+      socket_type descriptor, per_descriptor_data& descriptor_data);
+
+  // Add a new timer queue to the reactor.
+  template <typename Time_Traits>
+  void add_timer_queue(timer_queue<Time_Traits>& timer_queue);
+
+  // Remove a timer queue from the reactor.
+  template <typename Time_Traits>
+  void remove_timer_queue(timer_queue<Time_Traits>& timer_queue);
+
+  // Schedule a new operation in the given timer queue to expire at the
+  // specified absolute time.
+  template <typename Time_Traits>
+  void schedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer, wait_op* op);
+
+  // Cancel the timer operations associated with the given token. Returns the
+  // number of operations that have been posted or dispatched.
+  template <typename Time_Traits>
+  std::size_t cancel_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
+
+  // Submit pending requests and wait for completions. Waits for at most usec
+  // microseconds, or indefinitely if usec is negative.
+  BOOST_ASIO_DECL void run(long usec, op_queue<operation>& ops);
+
+  // Interrupt the wait for completions.
+  BOOST_ASIO_DECL void interrupt();
+
+  // Whether operations are being performed using io_uring, rather than by
+  // the fallback epoll_reactor.
+  bool uses_io_uring() const
+  {
+    return ring_fd_ != -1;
+  }
+
+private:
+  typedef epoll_reactor::descriptor_state descriptor_state;
+
+  // The number of entries in the submission queue.
+  enum { ring_entries = 1024 };
+
+  // The kind of request that is outstanding for each operation type. The
+  // kind is also stored in the low bits of the request's user data.
+  enum request_kind { no_request = 0, poll_request = 1, io_request = 2 };
+
+  // User data values that do not refer to a descriptor.
+  enum { ignore_token = 0, interrupt_token = 1, timeout_kind = 3 };
+
+  // Create the io_uring instance. Leaves ring_fd_ as -1 if io_uring cannot
+  // be used. Does not throw.
+  BOOST_ASIO_DECL void open_ring();
+
+  // Destroy the io_uring instance.
+  BOOST_ASIO_DECL void close_ring();
+
+  // Initialise the io_uring bookkeeping for a newly registered descriptor.
+  BOOST_ASIO_DECL descriptor_state* allocate_descriptor_state(
+      socket_type descriptor);
+
+  // Start a request for the operation at the front of the given queue. Must
+  // be called with the descriptor's mutex held. Returns false if the request
+  // could not be queued.
+  BOOST_ASIO_DECL bool start_request(descriptor_state* descriptor_data,
+      int op_type, bool allow_io);
+
+  // Queue a request for the given operation type. A poll request is queued
+  // if no io_uring request is supplied. Must be called with the descriptor's
+  // mutex held. Returns false if the request could not be queued.
+  BOOST_ASIO_DECL bool queue_request(descriptor_state* descriptor_data,
+      int op_type, ::io_uring_sqe* io_sqe);
+
+  // Ask the kernel to cancel any outstanding requests for the descriptor.
+  // Must be called with the descriptor's mutex held.
+  BOOST_ASIO_DECL void cancel_requests(descriptor_state* descriptor_data);
+
+  // Abort all queued operations except those currently owned by the kernel.
+  // Must be called with the descriptor's mutex held.
+  BOOST_ASIO_DECL static void abort_queued_ops(
+      descriptor_state* descriptor_data, op_queue<operation>& ops);
+
+  // Process a completion for a descriptor request.
+  BOOST_ASIO_DECL void complete_request(descriptor_state* descriptor_data,
+      int op_type, int kind, int result, op_queue<operation>& ops);
+
+  // Copy a request into the submission queue, passing it to the kernel now if
+  // a thread is waiting for completions or if flush is true. Returns false if
+  // the submission queue is full.
+  BOOST_ASIO_DECL bool submit(const ::io_uring_sqe& sqe, bool flush);
+
+  // Pass queued requests to the kernel. Must be called with mutex_ held.
+  BOOST_ASIO_DECL void flush_requests();
+
+  // Called to recalculate and update the timeout. Must be called with the
+  // timer mutex held.
+  BOOST_ASIO_DECL void update_timeout();
+
+  // Perform the io_uring_enter system call.
+  BOOST_ASIO_DECL int ring_enter(unsigned int to_submit,
+      unsigned int min_complete, unsigned int flags);
+
+  // The epoll reactor, which owns the descriptor and timer bookkeeping and
+  // which is used for all operations when io_uring is unavailable.
+  epoll_reactor epoll_;
+
+  // Mutex to protect access to the submission queue.
+  mutex mutex_;
+
+  // The io_uring file descriptor.
+  int ring_fd_;
+
+  // The mapped ring memory.
+  void* ring_ptr_;
+  std::size_t ring_size_;
+  ::io_uring_sqe* sqes_;
+  std::size_t sqes_size_;
+
+  // Submission queue.
+  unsigned int* sq_head_;
+  unsigned int* sq_tail_;
+  unsigned int sq_mask_;
+  unsigned int sq_entries_;
+  unsigned int sq_local_tail_;
+
+  // Completion queue.
+  unsigned int* cq_head_;
+  unsigned int* cq_tail_;
+  unsigned int cq_mask_;
+  ::io_uring_cqe* cqes_;
+
+  // The number of requests that have been queued but not yet completed.
+  std::size_t outstanding_;
+
+  // Whether a thread is blocked waiting for completions.
+  bool waiting_;
+
+  // Whether the task has been interrupted while it was not blocked.
+  bool interrupted_;
+
+  // Whether a timeout request is outstanding, and when it expires.
+  bool timeout_pending_;
+  boost::int64_t timeout_deadline_;
+  boost::uint64_t timeout_generation_;
+  ::__kernel_timespec timeout_ts_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/detail/impl/io_uring_reactor.hpp>
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/io_uring_reactor.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_REACTOR_HPP
@@ -156,8 +156,9 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
-  // Run the kqueue loop.
-  BOOST_ASIO_DECL void run(bool block, op_queue<operation>& ops);
+  // Run the kqueue loop. Waits for at most usec microseconds, or indefinitely
+  // if usec is negative.
+  BOOST_ASIO_DECL void run(long usec, op_queue<operation>& ops);
 
   // Interrupt the kqueue loop.
   BOOST_ASIO_DECL void interrupt();
@@ -179,8 +180,9 @@ private:
   // Helper function to remove a timer queue.
   BOOST_ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
 
-  // Get the timeout value for the kevent call.
-  BOOST_ASIO_DECL timespec* get_timeout(timespec& ts);
+  // Get the timeout value for the kevent call, which is no longer than usec
+  // unless usec is negative.
+  BOOST_ASIO_DECL timespec* get_timeout(long usec, timespec& ts);
 
   // The io_service implementation used to post completions.
   io_service_impl& io_service_;
@@ -64,6 +64,14 @@ public:
   void wait(Lock&)
   {
   }
+
+  // Wait for the event to become signalled, for at most the given number of
+  // microseconds.
+  template <typename Lock>
+  bool wait_for_usec(Lock&, long)
+  {
+    return true;
+  }
 };
 
 } // namespace detail
@@ -21,6 +21,7 @@
 
 #include <boost/assert.hpp>
 #include <pthread.h>
+#include <time.h>
 #include <boost/asio/detail/noncopyable.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -80,6 +81,35 @@ public:
       ::pthread_cond_wait(&cond_, &lock.mutex().mutex_); // Ignore EINVAL.
   }
 
+  // Wait for the event to become signalled, for at most the given number of
+  // microseconds. Returns true if the event was signalled.
+  template <typename Lock>
+  bool wait_for_usec(Lock& lock, long usec)
+  {
+    BOOST_ASSERT(lock.locked());
+    if (!signalled_)
+    {
+      timespec ts;
+#if defined(__MACH__) && defined(__APPLE__)
+      ts.tv_sec = usec / 1000000;
+      ts.tv_nsec = (usec % 1000000) * 1000;
+      ::pthread_cond_timedwait_relative_np(
+          &cond_, &lock.mutex().mutex_, &ts); // Ignore EINVAL.
+#else // defined(__MACH__) && defined(__APPLE__)
+      if (::clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+      {
+        ts.tv_sec += usec / 1000000;
+        ts.tv_nsec += (usec % 1000000) * 1000;
+        ts.tv_sec += ts.tv_nsec / 1000000000;
+        ts.tv_nsec = ts.tv_nsec % 1000000000;
+        ::pthread_cond_timedwait(&cond_,
+            &lock.mutex().mutex_, &ts); // Ignore EINVAL.
+      }
+#endif // defined(__MACH__) && defined(__APPLE__)
+    }
+    return signalled_;
+  }
+
 private:
   ::pthread_cond_t cond_;
   bool signalled_;
@@ -24,6 +24,10 @@
 #include <boost/asio/detail/socket_holder.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+# include <linux/io_uring.h>
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -44,6 +48,10 @@ public:
       protocol_(protocol),
       peer_endpoint_(peer_endpoint)
   {
+#if defined(BOOST_ASIO_HAS_IO_URING)
+    this->set_io_uring_funcs(&reactive_socket_accept_op_base::do_prepare,
+        &reactive_socket_accept_op_base::do_finish);
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
   }
 
   static bool do_perform(reactor_op* base)
@@ -70,12 +78,57 @@ public:
     return result;
   }
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  static bool do_prepare(reactor_op* base, ::io_uring_sqe* sqe)
+  {
+    reactive_socket_accept_op_base* o(
+        static_cast<reactive_socket_accept_op_base*>(base));
+
+    o->addrlen_ = static_cast<socklen_t>(
+        o->peer_endpoint_ ? o->peer_endpoint_->capacity() : 0);
+
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = o->socket_;
+    if (o->peer_endpoint_)
+    {
+      sqe->addr = reinterpret_cast<__u64>(o->peer_endpoint_->data());
+      sqe->addr2 = reinterpret_cast<__u64>(&o->addrlen_);
+    }
+    return true;
+  }
+
+  static bool do_finish(reactor_op* base, int result)
+  {
+    reactive_socket_accept_op_base* o(
+        static_cast<reactive_socket_accept_op_base*>(base));
+
+    socket_type new_socket = invalid_socket;
+    bool finished = socket_ops::finish_accept(
+        result, o->state_, o->ec_, new_socket);
+
+    // On success, assign new connection to peer socket object.
+    if (new_socket >= 0)
+    {
+      socket_holder new_socket_holder(new_socket);
+      if (o->peer_endpoint_)
+        o->peer_endpoint_->resize(o->addrlen_);
+      if (!o->peer_.assign(o->protocol_, new_socket, o->ec_))
+        new_socket_holder.release();
+    }
+
+    return finished;
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 private:
   socket_type socket_;
   socket_ops::state_type state_;
   Socket& peer_;
   Protocol protocol_;
   typename Protocol::endpoint* peer_endpoint_;
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  socklen_t addrlen_;
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
 };
 
 template <typename Socket, typename Protocol, typename Handler>
@@ -0,0 +1,258 @@
+//
+// detail/reactive_socket_send_file_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SEND_FILE_OP_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SEND_FILE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+
+#include <boost/cstdint.hpp>
+#include <boost/utility/addressof.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/reactor.hpp>
+#include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class reactive_socket_send_file_op_base : public reactor_op
+{
+public:
+  reactive_socket_send_file_op_base(socket_type socket, int fd,
+      boost::uint64_t offset, std::size_t size, func_type complete_func)
+    : reactor_op(&reactive_socket_send_file_op_base::do_perform,
+        complete_func),
+      socket_(socket),
+      fd_(fd),
+      offset_(offset),
+      remaining_(size),
+      source_empty_(false),
+      waiting_for_source_(false),
+      mutex_(0),
+      reactor_(0),
+      socket_ptr_(0),
+      socket_data_(0),
+      owner_(0),
+      source_data_()
+  {
+  }
+
+  // Associate the operation with the socket that started it. The socket keeps
+  // a pointer to the operation so that it can be aborted while it is waiting
+  // for the source pipe, where closing or cancelling the socket can't see it.
+  // The operation clears the pointer when it completes. The given mutex
+  // protects the association and must be locked once the operation has been
+  // started.
+  void attach(mutex& m, reactor& r, socket_type& socket,
+      reactor::per_descriptor_data& socket_data,
+      reactive_socket_send_file_op_base*& owner)
+  {
+    mutex_ = &m;
+    reactor_ = &r;
+    socket_ptr_ = &socket;
+    socket_data_ = &socket_data;
+    owner_ = &owner;
+    owner = this;
+  }
+
+  // Stop the operation from being restarted on the socket, and cancel its
+  // wait for the source pipe if there is one. The pipe is only deregistered
+  // by the completion of the operation, so that the two can't race. The mutex
+  // must be locked.
+  void abort()
+  {
+    *owner_ = 0;
+    owner_ = 0;
+    if (waiting_for_source_)
+      reactor_->cancel_ops(fd_, source_data_);
+  }
+
+  static bool do_perform(reactor_op* base)
+  {
+    reactive_socket_send_file_op_base* o(
+        static_cast<reactive_socket_send_file_op_base*>(base));
+
+    // Nothing is sent while waiting for the source pipe to be refilled. The
+    // operation is moved back to the socket once the pipe is readable.
+    if (o->waiting_for_source_)
+      return socket_ops::poll_read(o->fd_,
+          socket_ops::user_set_non_blocking, o->ec_) != 0;
+
+    // Partial writes advance the offset and the operation keeps waiting for
+    // the socket to become writable until the whole region has been sent.
+    if (socket_ops::non_blocking_send_file(o->socket_, o->fd_, o->offset_,
+          o->remaining_, o->source_empty_, o->ec_, o->bytes_transferred_))
+      return true;
+
+    // An empty pipe won't be refilled by the socket becoming writable, so the
+    // operation leaves the socket's queue to wait for the pipe instead.
+    return o->source_empty_;
+  }
+
+protected:
+  // Move the operation to the queue it needs to wait on next. Returns false if
+  // the operation is complete.
+  bool restart()
+  {
+    // An operation that was never attached failed without being started.
+    if (!mutex_)
+      return false;
+
+    mutex::scoped_lock lock(*mutex_);
+
+    if (waiting_for_source_)
+    {
+      waiting_for_source_ = false;
+      reactor_->deregister_descriptor(fd_, source_data_, false);
+      if (!owner_)
+      {
+        ec_ = boost::asio::error::operation_aborted;
+        return false;
+      }
+
+      if (ec_)
+        return false;
+
+      socket_ = *socket_ptr_;
+      reactor_->start_op(reactor::write_op,
+          socket_, *socket_data_, this, true);
+      return true;
+    }
+
+    if (source_empty_)
+    {
+      source_empty_ = false;
+      if (!owner_)
+      {
+        ec_ = boost::asio::error::operation_aborted;
+        return false;
+      }
+
+      ec_ = boost::system::error_code();
+      if (int err = reactor_->register_descriptor(fd_, source_data_))
+      {
+        ec_ = boost::system::error_code(err,
+            boost::asio::error::get_system_category());
+        return false;
+      }
+
+      waiting_for_source_ = true;
+      reactor_->start_op(reactor::read_op, fd_, source_data_, this, true);
+      return true;
+    }
+
+    return false;
+  }
+
+  // Release the socket's reference to the operation.
+  void detach()
+  {
+    if (mutex_)
+    {
+      mutex::scoped_lock lock(*mutex_);
+      if (owner_)
+        *owner_ = 0;
+    }
+  }
+
+private:
+  socket_type socket_;
+  int fd_;
+  boost::uint64_t offset_;
+  std::size_t remaining_;
+  bool source_empty_;
+  bool waiting_for_source_;
+  mutex* mutex_;
+  reactor* reactor_;
+  socket_type* socket_ptr_;
+  reactor::per_descriptor_data* socket_data_;
+  reactive_socket_send_file_op_base** owner_;
+  reactor::per_descriptor_data source_data_;
+};
+
+template <typename Handler>
+class reactive_socket_send_file_op :
+  public reactive_socket_send_file_op_base
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_send_file_op);
+
+  reactive_socket_send_file_op(socket_type socket, int fd,
+      boost::uint64_t offset, std::size_t size, Handler& handler)
+    : reactive_socket_send_file_op_base(socket, fd, offset,
+        size, &reactive_socket_send_file_op::do_complete),
+      handler_(BOOST_ASIO_MOVE_CAST(Handler)(handler))
+  {
+  }
+
+  static void do_complete(io_service_impl* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    reactive_socket_send_file_op* o(
+        static_cast<reactive_socket_send_file_op*>(base));
+
+    // Continue the operation on the pipe or on the socket, if required.
+    if (owner && o->restart())
+      return;
+    o->detach();
+
+    // Take ownership of the handler object.
+    ptr p = { boost::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      boost_asio_handler_invoke_helpers::invoke(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
+#endif // BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SEND_FILE_OP_HPP
@@ -23,6 +23,10 @@
 #include <boost/asio/detail/reactor_op.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+# include <linux/io_uring.h>
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -41,6 +45,10 @@ public:
       buffers_(buffers),
       flags_(flags)
   {
+#if defined(BOOST_ASIO_HAS_IO_URING)
+    this->set_io_uring_funcs(&reactive_socket_send_op_base::do_prepare,
+        &reactive_socket_send_op_base::do_finish);
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
   }
 
   static bool do_perform(reactor_op* base)
@@ -56,6 +64,35 @@ public:
           o->ec_, o->bytes_transferred_);
   }
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  static bool do_prepare(reactor_op* base, ::io_uring_sqe* sqe)
+  {
+    reactive_socket_send_op_base* o(
+        static_cast<reactive_socket_send_op_base*>(base));
+
+    // Only a single buffer can be described without additional storage.
+    buffer_sequence_adapter<boost::asio::const_buffer,
+        ConstBufferSequence> bufs(o->buffers_);
+    if (bufs.count() != 1)
+      return false;
+
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = o->socket_;
+    sqe->addr = reinterpret_cast<__u64>(bufs.buffers()[0].iov_base);
+    sqe->len = static_cast<__u32>(bufs.buffers()[0].iov_len);
+    sqe->msg_flags = static_cast<__u32>(o->flags_ | MSG_NOSIGNAL);
+    return true;
+  }
+
+  static bool do_finish(reactor_op* base, int result)
+  {
+    reactive_socket_send_op_base* o(
+        static_cast<reactive_socket_send_op_base*>(base));
+
+    return socket_ops::finish_send(result, o->ec_, o->bytes_transferred_);
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 private:
   socket_type socket_;
   ConstBufferSequence buffers_;
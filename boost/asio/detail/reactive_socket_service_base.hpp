@@ -25,9 +25,11 @@
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/reactive_null_buffers_op.hpp>
 #include <boost/asio/detail/reactive_socket_recv_op.hpp>
 #include <boost/asio/detail/reactive_socket_recvmsg_op.hpp>
+#include <boost/asio/detail/reactive_socket_send_file_op.hpp>
 #include <boost/asio/detail/reactive_socket_send_op.hpp>
 #include <boost/asio/detail/reactor.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
@@ -58,6 +60,15 @@ public:
 
     // Per-descriptor data used by the reactor.
     reactor::per_descriptor_data reactor_data_;
+
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+    // The asynchronous send_file operation in progress, if any.
+    reactive_socket_send_file_op_base* send_file_op_;
+
+    // The mutex that protects send_file_op_ once an asynchronous send_file
+    // operation has been started, or null.
+    mutex* send_file_mutex_;
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
   };
 
   // Constructor.
@@ -235,6 +246,47 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+  // Send a region of a file. Returns the number of bytes sent.
+  size_t send_file(base_implementation_type& impl, int fd,
+      boost::uint64_t offset, std::size_t size, boost::system::error_code& ec)
+  {
+    return socket_ops::sync_send_file(impl.socket_,
+        impl.state_, fd, offset, size, ec);
+  }
+
+  // Start an asynchronous send of a region of a file. The file descriptor
+  // must remain open for the lifetime of the asynchronous operation. Only one
+  // asynchronous send_file may be in progress on a socket at a time.
+  template <typename Handler>
+  void async_send_file(base_implementation_type& impl, int fd,
+      boost::uint64_t offset, std::size_t size, Handler handler)
+  {
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_file_op<Handler> op;
+    typename op::ptr p = { boost::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, fd, offset, size, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_send_file"));
+
+    if (send_file_in_progress(impl))
+    {
+      p.p->ec_ = boost::asio::error::already_started;
+      reactor_.post_immediate_completion(p.p);
+    }
+    else
+    {
+      impl.send_file_mutex_ = &send_file_mutex_;
+      p.p->attach(send_file_mutex_, reactor_, impl.socket_,
+          impl.reactor_data_, impl.send_file_op_);
+      start_op(impl, reactor::write_op, p.p, true, size == 0);
+    }
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
   // Receive some data from the peer. Returns the number of bytes received.
   template <typename MutableBufferSequence>
   size_t receive(base_implementation_type& impl,
@@ -410,8 +462,27 @@ protected:
   BOOST_ASIO_DECL void start_connect_op(base_implementation_type& impl,
       reactor_op* op, const socket_addr_type* addr, size_t addrlen);
 
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+  // Determine whether an asynchronous send_file operation is in progress.
+  BOOST_ASIO_DECL bool send_file_in_progress(base_implementation_type& impl);
+
+  // Abort the asynchronous send_file operation in progress, if any.
+  BOOST_ASIO_DECL void abort_send_file(base_implementation_type& impl);
+
+  // Move the asynchronous send_file operation in progress, if any, from one
+  // implementation to another.
+  BOOST_ASIO_DECL void move_send_file(base_implementation_type& impl,
+      reactor& r, base_implementation_type& other_impl);
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
   // The selector that performs event demultiplexing for the service.
   reactor& reactor_;
+
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+  // Protects the association between sockets and the asynchronous send_file
+  // operations started by this service, which completing operations update.
+  mutex send_file_mutex_;
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
 };
 
 } // namespace detail
@@ -17,7 +17,9 @@
 
 #include <boost/asio/detail/reactor_fwd.hpp>
 
-#if defined(BOOST_ASIO_HAS_EPOLL)
+#if defined(BOOST_ASIO_HAS_IO_URING)
+# include <boost/asio/detail/io_uring_reactor.hpp>
+#elif defined(BOOST_ASIO_HAS_EPOLL)
 # include <boost/asio/detail/epoll_reactor.hpp>
 #elif defined(BOOST_ASIO_HAS_KQUEUE)
 # include <boost/asio/detail/kqueue_reactor.hpp>
@@ -144,7 +144,8 @@ public:
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
   // Run select once until interrupted or events are ready to be dispatched.
-  BOOST_ASIO_DECL void run(bool block, op_queue<operation>& ops);
+  // Waits for at most usec microseconds, or indefinitely if usec is negative.
+  BOOST_ASIO_DECL void run(long usec, op_queue<operation>& ops);
 
   // Interrupt the select loop.
   BOOST_ASIO_DECL void interrupt();
@@ -164,8 +165,9 @@ private:
   // Helper function to remove a timer queue.
   BOOST_ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
 
-  // Get the timeout value for the select call.
-  BOOST_ASIO_DECL timeval* get_timeout(timeval& tv);
+  // Get the timeout value for the select call, which is no longer than usec
+  // unless usec is negative.
+  BOOST_ASIO_DECL timeval* get_timeout(long usec, timeval& tv);
 
   // Cancel all operations associated with the given descriptor. This function
   // does not acquire the select_reactor's mutex.
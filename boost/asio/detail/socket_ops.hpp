@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 
+#include <boost/cstdint.hpp>
 #include <boost/system/error_code.hpp>
 #include <boost/asio/detail/shared_ptr.hpp>
 #include <boost/asio/detail/socket_types.hpp>
@@ -83,6 +84,13 @@ BOOST_ASIO_DECL bool non_blocking_accept(socket_type s,
     state_type state, socket_addr_type* addr, std::size_t* addrlen,
     boost::system::error_code& ec, socket_type& new_socket);
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+BOOST_ASIO_DECL bool finish_accept(int result, state_type state,
+    boost::system::error_code& ec, socket_type& new_socket);
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 BOOST_ASIO_DECL int bind(socket_type s, const socket_addr_type* addr,
@@ -147,6 +155,13 @@ BOOST_ASIO_DECL bool non_blocking_recv(socket_type s,
     buf* bufs, size_t count, int flags, bool is_stream,
     boost::system::error_code& ec, size_t& bytes_transferred);
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+BOOST_ASIO_DECL bool finish_recv(int result, bool is_stream,
+    boost::system::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 BOOST_ASIO_DECL int recvfrom(socket_type s, buf* bufs, size_t count, int flags,
@@ -212,6 +227,13 @@ BOOST_ASIO_DECL bool non_blocking_send(socket_type s,
     const buf* bufs, size_t count, int flags,
     boost::system::error_code& ec, size_t& bytes_transferred);
 
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+BOOST_ASIO_DECL bool finish_send(int result,
+    boost::system::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 BOOST_ASIO_DECL int sendto(socket_type s, const buf* bufs, size_t count,
@@ -231,6 +253,59 @@ BOOST_ASIO_DECL bool non_blocking_sendto(socket_type s,
 
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
+BOOST_ASIO_DECL int recvmmsg(socket_type s, buf* bufs, size_t count,
+    int flags, socket_addr_type* const* addrs, std::size_t* addrlens,
+    std::size_t* sizes, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL size_t sync_recvmmsg(socket_type s, state_type state,
+    buf* bufs, size_t count, int flags, socket_addr_type* const* addrs,
+    std::size_t* addrlens, std::size_t* sizes, boost::system::error_code& ec);
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+
+BOOST_ASIO_DECL bool non_blocking_recvmmsg(socket_type s,
+    buf* bufs, size_t count, int flags, socket_addr_type* const* addrs,
+    std::size_t* addrlens, std::size_t* sizes,
+    boost::system::error_code& ec, size_t& messages_transferred);
+
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+BOOST_ASIO_DECL int sendmmsg(socket_type s, const buf* bufs, size_t count,
+    int flags, const socket_addr_type* const* addrs,
+    const std::size_t* addrlens, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL size_t sync_sendmmsg(socket_type s, state_type state,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* const* addrs, const std::size_t* addrlens,
+    boost::system::error_code& ec);
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+
+BOOST_ASIO_DECL bool non_blocking_sendmmsg(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* const* addrs, const std::size_t* addrlens,
+    boost::system::error_code& ec, size_t& messages_transferred);
+
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+
+// Sets source_empty if the operation would block because fd refers to an
+// empty pipe, rather than because the socket cannot take any more data.
+BOOST_ASIO_DECL int send_file(socket_type s, int fd,
+    boost::uint64_t& offset, size_t size, bool& source_empty,
+    boost::system::error_code& ec);
+
+BOOST_ASIO_DECL size_t sync_send_file(socket_type s, state_type state,
+    int fd, boost::uint64_t offset, size_t size,
+    boost::system::error_code& ec);
+
+BOOST_ASIO_DECL bool non_blocking_send_file(socket_type s, int fd,
+    boost::uint64_t& offset, size_t& remaining, bool& source_empty,
+    boost::system::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
 BOOST_ASIO_DECL socket_type socket(int af, int type, int protocol,
     boost::system::error_code& ec);
 
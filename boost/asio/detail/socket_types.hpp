@@ -165,6 +165,7 @@ const int max_iov_len = IOV_MAX;
 const int max_iov_len = 16;
 # endif
 #endif
+const int max_mmsg_len = 64;
 const int custom_socket_option_level = 0xA5100000;
 const int enable_connection_aborted_option = 1;
 const int always_fail_option = 2;
@@ -22,6 +22,14 @@
 #include <boost/asio/detail/operation.hpp>
 #include <boost/asio/detail/scoped_ptr.hpp>
 
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+# if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#  include <atomic>
+# else // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#  include <boost/atomic.hpp>
+# endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -39,6 +47,17 @@ private:
   // Helper class to re-post the strand on exit.
   struct on_dispatch_exit;
 
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+  // Atomic types used for the lock-free handler queue.
+# if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  typedef std::atomic<operation*> atomic_operation_ptr;
+  typedef std::atomic<std::size_t> atomic_size;
+# else // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+  typedef boost::atomic<operation*> atomic_operation_ptr;
+  typedef boost::atomic<std::size_t> atomic_size;
+# endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+
 public:
 
   // The underlying implementation of a strand.
@@ -46,7 +65,11 @@ public:
     : public operation
   {
   public:
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+    explicit strand_impl(strand_service& service);
+#else // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
     strand_impl();
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
 
   private:
     // Only this service will have access to the internal values.
@@ -54,6 +77,37 @@ public:
     friend struct on_do_complete_exit;
     friend struct on_dispatch_exit;
 
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+    // The service that owns this implementation.
+    strand_service& service_;
+
+    // Handlers that have been enqueued but not yet moved to the ready queue,
+    // most recently enqueued first. The list is linked through the operations'
+    // next pointers. Any thread may push onto it, but only the thread holding
+    // the strand lock may take from it.
+    atomic_operation_ptr incoming_;
+
+    // The number of enqueued handlers that have not yet completed. The thread
+    // that raises this count from zero acquires the strand lock and is
+    // responsible for scheduling the strand. The strand is unlocked when the
+    // count drops back to zero.
+    atomic_size pending_;
+
+    // One reference is held by each strand object, and one by the strand lock.
+    atomic_size ref_count_;
+
+    // The number of handlers that found the strand already locked when they
+    // were enqueued, and so had to wait behind other handlers.
+    atomic_size delayed_count_;
+
+    // The number of times an enqueue had to be retried due to a concurrent
+    // enqueue on the same strand.
+    atomic_size retry_count_;
+
+    // Pointers to adjacent implementations in the service's linked list.
+    strand_impl* next_;
+    strand_impl* prev_;
+#else // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
     // Mutex to protect access to internal data.
     boost::asio::detail::mutex mutex_;
 
@@ -66,6 +120,7 @@ public:
     // after the next time the strand is scheduled. This queue must only be
     // modified while the mutex is locked.
     op_queue<operation> waiting_queue_;
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
 
     // The handlers that are ready to be run. Logically speaking, these are the
     // handlers that hold the strand's lock. The ready queue is only modified
@@ -84,6 +139,24 @@ public:
   // Construct a new strand implementation.
   BOOST_ASIO_DECL void construct(implementation_type& impl);
 
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+  // Construct a strand implementation that refers to the same strand as
+  // another.
+  BOOST_ASIO_DECL void copy_construct(implementation_type& impl,
+      const implementation_type& other_impl);
+
+  // Destroy a strand implementation.
+  BOOST_ASIO_DECL void destroy(implementation_type& impl);
+
+  // Get the number of handlers that had to wait because the strand was busy.
+  BOOST_ASIO_DECL std::size_t delayed_handler_count(
+      const implementation_type& impl) const;
+
+  // Get the number of enqueue attempts that were retried due to contention.
+  BOOST_ASIO_DECL std::size_t enqueue_retry_count(
+      const implementation_type& impl) const;
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+
   // Request the io_service to invoke the given handler.
   template <typename Handler>
   void dispatch(implementation_type& impl, Handler handler);
@@ -93,9 +166,28 @@ public:
   void post(implementation_type& impl, Handler handler);
 
 private:
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+  // Helper function to dispatch a handler. The handler at the head of the
+  // strand is run immediately if the strand lock can be acquired and the
+  // current thread is running the io_service.
+  BOOST_ASIO_DECL void do_dispatch(implementation_type& impl, operation* op);
+
+  // Add a handler to the strand. Returns true if the caller acquired the
+  // strand lock.
+  BOOST_ASIO_DECL static bool enqueue(strand_impl* impl, operation* op);
+
+  // Move all newly enqueued handlers to the ready queue, in the order in
+  // which they were enqueued. Must only be called while holding the lock.
+  BOOST_ASIO_DECL static void take_incoming(strand_impl* impl);
+
+  // Release a reference to an implementation, destroying it if it was the
+  // last one.
+  BOOST_ASIO_DECL static void release(strand_impl* impl);
+#else // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
   // Helper function to dispatch a handler. Returns true if the handler should
   // be dispatched immediately.
   BOOST_ASIO_DECL bool do_dispatch(implementation_type& impl, operation* op);
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
 
   // Helper fiunction to post a handler.
   BOOST_ASIO_DECL void do_post(implementation_type& impl, operation* op);
@@ -107,6 +199,13 @@ private:
   // The io_service implementation used to post completions.
   io_service_impl& io_service_;
 
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+  // Mutex to protect access to the linked list of implementations.
+  boost::asio::detail::mutex mutex_;
+
+  // The head of a linked list of all implementations.
+  strand_impl* impl_list_;
+#else // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
   // Mutex to protect access to the array of implementations.
   boost::asio::detail::mutex mutex_;
 
@@ -123,6 +222,7 @@ private:
   // Extra value used when hashing to prevent recycled memory locations from
   // getting the same strand implementation.
   std::size_t salt_;
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
 };
 
 } // namespace detail
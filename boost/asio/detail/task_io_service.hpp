@@ -19,10 +19,12 @@
 
 #if !defined(BOOST_ASIO_HAS_IOCP)
 
+#include <boost/cstdint.hpp>
 #include <boost/system/error_code.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/handler_memory_cache.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/reactor_fwd.hpp>
@@ -126,6 +128,27 @@ public:
   // Assumes that work_started() was previously called for the operations.
   BOOST_ASIO_DECL void abandon_operations(op_queue<operation>& ops);
 
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+  // Get the number of microseconds for which a thread polls before blocking.
+  BOOST_ASIO_DECL long busy_poll_duration() const;
+
+  // Set the number of microseconds for which a thread polls before blocking.
+  // A value of zero disables busy-polling.
+  BOOST_ASIO_DECL void busy_poll_duration(long usec);
+
+  // Get the number of times that busy-polling found work to do.
+  std::size_t busy_poll_hit_count() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(busy_poll_hits_));
+  }
+
+  // Get the number of times that busy-polling ended with the thread blocking.
+  std::size_t busy_poll_park_count() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(busy_poll_parks_));
+  }
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+
 private:
   // Structure containing information about an idle thread.
   struct thread_info;
@@ -144,6 +167,79 @@ private:
   BOOST_ASIO_DECL std::size_t do_run_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const boost::system::error_code& ec);
 
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  // Run at most one operation, preferring the calling thread's local queue.
+  // May block. The mutex may be locked or unlocked on entry.
+  BOOST_ASIO_DECL std::size_t do_run_one_local_first(mutex::scoped_lock& lock,
+      thread_info& this_thread, const boost::system::error_code& ec);
+
+  // Run at most one operation from the calling thread's local queue. The mutex
+  // must be unlocked on entry. Does not block.
+  BOOST_ASIO_DECL std::size_t do_run_local_one(mutex::scoped_lock& lock,
+      thread_info& this_thread, const boost::system::error_code& ec);
+
+  // Add the calling thread to the set of threads whose local queues may be
+  // stolen from. The mutex must be locked.
+  BOOST_ASIO_DECL void register_worker(thread_info& this_thread);
+
+  // Move operations from another thread's local queue to the calling thread's
+  // local queue. The mutex must be locked. Returns true if the calling
+  // thread's local queue is non-empty afterwards.
+  BOOST_ASIO_DECL bool steal_operations(thread_info& this_thread);
+
+  // Push an operation on to the local queue of the calling thread, waking an
+  // idle thread to steal it if the local queue already has a backlog.
+  BOOST_ASIO_DECL void post_local_deferred_completion(
+      thread_info& this_thread, operation* op);
+
+  // Push operations on to the local queue of the calling thread, waking an
+  // idle thread to steal them if the local queue already has a backlog.
+  BOOST_ASIO_DECL void post_local_deferred_completions(
+      thread_info& this_thread, op_queue<operation>& ops);
+
+  // Wake another thread, if needed, after the calling thread has queued
+  // operations locally.
+  BOOST_ASIO_DECL void wake_for_local_operations(
+      bool was_empty, bool backlog);
+
+  // Wake an idle thread so that it may steal queued operations.
+  BOOST_ASIO_DECL void wake_one_idle_thread_for_stealing();
+
+  // Wake an idle thread, or interrupt the task, so that another thread may
+  // steal queued operations.
+  BOOST_ASIO_DECL void wake_one_thread_for_stealing();
+
+  // Count the calling worker as waiting, with or without a bound on the time
+  // before it next looks for operations to steal. The mutex must be locked.
+  BOOST_ASIO_DECL void begin_wait(thread_info& this_thread, bool bounded);
+
+  // Stop counting the calling thread as waiting. The mutex must be locked.
+  BOOST_ASIO_DECL void end_wait(thread_info& this_thread);
+
+  // Remove the calling thread from the list of idle threads, if it is still
+  // there after a timed wait. The mutex must be locked.
+  BOOST_ASIO_DECL void remove_idle_thread(thread_info& this_thread);
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+  // Run the task without blocking until it produces operations, the task is
+  // interrupted, or the given number of microseconds has elapsed. The mutex
+  // must be unlocked on entry and is unlocked on exit. Returns true if the
+  // task no longer needs to block.
+  BOOST_ASIO_DECL bool busy_poll_task(mutex::scoped_lock& lock,
+      thread_info& this_thread, long usec);
+
+  // Wait for operations to be queued without going to sleep, for at most
+  // busy_poll_usec_ microseconds. The mutex must be locked on entry and is
+  // locked on exit. Returns true if there is work to do or the io_service has
+  // been stopped.
+  BOOST_ASIO_DECL bool busy_poll_idle(mutex::scoped_lock& lock,
+      thread_info& this_thread);
+
+  // Get the current time in microseconds from an arbitrary epoch.
+  BOOST_ASIO_DECL static boost::int64_t busy_poll_clock();
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+
   // Poll for at most one operation.
   BOOST_ASIO_DECL std::size_t do_poll_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const boost::system::error_code& ec);
@@ -169,6 +265,12 @@ private:
   struct work_cleanup;
   friend struct work_cleanup;
 
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  // Helper class to return a thread's local operations on block exit.
+  struct worker_cleanup;
+  friend struct worker_cleanup;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
@@ -196,6 +298,9 @@ private:
   // Flag to indicate that the dispatcher has been stopped.
   bool stopped_;
 
+  // The handler memory caches that are not in use by a running thread.
+  handler_memory_cache::pool memory_cache_pool_;
+
   // Flag to indicate that the dispatcher has been shut down.
   bool shutdown_;
 
@@ -204,6 +309,50 @@ private:
 
   // The threads that are currently idle.
   thread_info* first_idle_thread_;
+
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  // The maximum number of consecutive operations a thread may run from its
+  // local queue before checking the shared queue and the task.
+  enum { max_local_run = 61 };
+
+  // The number of threads that are currently idle. May be read without
+  // holding the mutex as a hint that stealing is worthwhile.
+  atomic_count idle_thread_count_;
+
+  // The number of workers waiting for no longer than
+  // BOOST_ASIO_WORK_STEALING_CHECK_USEC before looking for operations to
+  // steal, and the number waiting without a bound. A handler may wait for an
+  // operation it queued locally, so a thread must be woken for that operation
+  // if nobody is checking and somebody is blocked. May be read without holding
+  // the mutex.
+  atomic_count bounded_wait_count_;
+  atomic_count unbounded_wait_count_;
+
+  // The number of threads whose local queues may be stolen from.
+  std::size_t worker_count_;
+
+  // The threads whose local queues may be stolen from.
+  thread_info* first_worker_;
+
+  // The worker from which the next steal attempt starts.
+  thread_info* next_victim_;
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+  // The number of microseconds for which a thread polls before blocking.
+  long busy_poll_usec_;
+
+  // Whether the task is being polled without blocking, in which case it does
+  // not need to be interrupted to notice new work.
+  bool task_spinning_;
+
+  // The number of idle threads that are polling for work rather than sleeping.
+  std::size_t spinning_threads_;
+
+  // The number of busy-polls that found work, and that ended up blocking.
+  atomic_count busy_poll_hits_;
+  atomic_count busy_poll_parks_;
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
 };
 
 } // namespace detail
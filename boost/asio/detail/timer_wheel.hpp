@@ -0,0 +1,567 @@
+//
+// detail/timer_wheel.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
+#define BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/config.hpp>
+#include <boost/limits.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/asio/detail/date_time_fwd.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/timer_queue.hpp>
+#include <boost/asio/detail/timer_queue_base.hpp>
+#include <boost/asio/detail/wait_op.hpp>
+#include <boost/asio/error.hpp>
+
+#if defined(BOOST_WINDOWS)
+# include <boost/asio/detail/socket_types.hpp>
+#else // defined(BOOST_WINDOWS)
+# include <sys/time.h>
+# include <time.h>
+#endif // defined(BOOST_WINDOWS)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+template <typename TimeTraits, long Resolution>
+struct wheel_time_traits;
+
+template <typename WaitTraits, long Resolution>
+struct wheel_wait_traits;
+
+namespace detail {
+
+template <typename Clock, typename WaitTraits>
+struct chrono_time_traits;
+
+// A hierarchical timing wheel. Time is divided into ticks of Resolution
+// microseconds of a monotonic clock, counted from the time at which the wheel
+// was constructed. The first level has one slot per tick, and each further
+// level has slots that cover a whole turn of the level below it. Timers are
+// moved down a level as the current tick reaches the start of their slot.
+// Arming and cancelling a timer are constant time operations.
+//
+// An expiry time is converted to a tick when the timer is armed, using the
+// distance from Time_Traits::now() at that moment. Changes to the clock of
+// Time_Traits after that point, such as the system clock being set back, do
+// not move the ticks of new or existing timers.
+template <typename Time_Traits, long Resolution>
+class timer_wheel
+  : public timer_queue_base
+{
+public:
+  // The time type.
+  typedef typename Time_Traits::time_type time_type;
+
+  // The duration type.
+  typedef typename Time_Traits::duration_type duration_type;
+
+  // Per-timer data.
+  class per_timer_data
+  {
+  public:
+    per_timer_data() : slot_(0) {}
+
+  private:
+    friend class timer_wheel;
+
+    // The operations waiting on the timer.
+    op_queue<wait_op> op_queue_;
+
+    // The tick at which the timer expires.
+    boost::uint64_t tick_;
+
+    // The list that holds the timer, or 0 if the timer is not queued.
+    per_timer_data** slot_;
+
+    // Pointers to adjacent timers in the same list.
+    per_timer_data* next_;
+    per_timer_data* prev_;
+  };
+
+  // Constructor.
+  timer_wheel()
+    : infinite_timers_(0),
+      origin_(monotonic_usec()),
+      base_tick_(0),
+      earliest_tick_(no_tick)
+  {
+    for (int i = 0; i < num_slots; ++i)
+      slots_[i] = 0;
+    for (int i = 0; i < num_levels; ++i)
+      level_count_[i] = 0;
+  }
+
+  // Add a new timer to the queue. Returns true if the timer expires before
+  // the time that was last reported to the reactor, in which case the
+  // reactor's event demultiplexing function call may need to be interrupted
+  // and restarted.
+  bool enqueue_timer(const time_type& time, per_timer_data& timer, wait_op* op)
+  {
+    bool earlier = false;
+
+    // Enqueue the timer object.
+    if (timer.slot_ == 0)
+    {
+      if (this->is_positive_infinity(time))
+      {
+        // Timers that never expire are kept apart from the wheel.
+        link(timer, &infinite_timers_);
+      }
+      else
+      {
+        // Bring an idle wheel up to date so that the new timer does not need
+        // to be cascaded through the time that has already passed.
+        if (wheel_empty())
+          base_tick_ = now_tick();
+
+        timer.tick_ = to_tick(time);
+        insert(timer);
+
+        boost::uint64_t tick = timer.tick_ < base_tick_
+          ? base_tick_ : timer.tick_;
+        if (tick < earliest_tick_)
+        {
+          earliest_tick_ = tick;
+          earlier = true;
+        }
+      }
+    }
+
+    // Enqueue the individual timer operation.
+    timer.op_queue_.push(op);
+
+    // Interrupt reactor only if newly added timer expires before the reactor
+    // would otherwise wake up.
+    return earlier;
+  }
+
+  // Whether there are no timers in the queue.
+  virtual bool empty() const
+  {
+    return infinite_timers_ == 0 && wheel_empty();
+  }
+
+  // Get the time until the reactor next needs to advance the wheel.
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    if (earliest_tick_ == no_tick)
+      return max_duration;
+
+    boost::int64_t usec = usec_until(earliest_tick_);
+    if (usec <= 0)
+      return 0;
+    boost::int64_t msec = (usec + 999) / 1000;
+    if (msec > max_duration)
+      return max_duration;
+    return static_cast<long>(msec);
+  }
+
+  // Get the time until the reactor next needs to advance the wheel.
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    if (earliest_tick_ == no_tick)
+      return max_duration;
+
+    boost::int64_t usec = usec_until(earliest_tick_);
+    if (usec <= 0)
+      return 0;
+    if (usec > max_duration)
+      return max_duration;
+    return static_cast<long>(usec);
+  }
+
+  // Dequeue all timers not later than the current time.
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    if (wheel_empty())
+    {
+      earliest_tick_ = no_tick;
+      return;
+    }
+
+    const boost::uint64_t now = now_tick();
+    while (base_tick_ <= now && !wheel_empty())
+    {
+      // Move the timers from the upper levels down as the current tick
+      // reaches the start of their slots.
+      if ((base_tick_ & level0_mask) == 0)
+        cascade();
+
+      if (level_count_[0] == 0)
+      {
+        // Nothing can expire before the next cascade.
+        boost::uint64_t next = next_boundary();
+        base_tick_ = next < now + 1 ? next : now + 1;
+        continue;
+      }
+
+      per_timer_data** slot = &slots_[base_tick_ & level0_mask];
+      while (per_timer_data* timer = *slot)
+      {
+        ops.push(timer->op_queue_);
+        remove_timer(*timer);
+      }
+
+      ++base_tick_;
+    }
+
+    if (wheel_empty() && base_tick_ <= now)
+      base_tick_ = now + 1;
+
+    earliest_tick_ = find_earliest();
+  }
+
+  // Dequeue all timers.
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    for (int i = 0; i < num_slots; ++i)
+      take_all(&slots_[i], ops);
+    take_all(&infinite_timers_, ops);
+
+    for (int i = 0; i < num_levels; ++i)
+      level_count_[i] = 0;
+    earliest_tick_ = no_tick;
+  }
+
+  // Cancel and dequeue operations for the given timer.
+  std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
+  {
+    std::size_t num_cancelled = 0;
+    if (timer.slot_ != 0)
+    {
+      while (wait_op* op = (num_cancelled != max_cancelled)
+          ? timer.op_queue_.front() : 0)
+      {
+        op->ec_ = boost::asio::error::operation_aborted;
+        timer.op_queue_.pop();
+        ops.push(op);
+        ++num_cancelled;
+      }
+      if (timer.op_queue_.empty())
+        remove_timer(timer);
+    }
+    return num_cancelled;
+  }
+
+private:
+  // The geometry of the wheel. The first level has one slot per tick and the
+  // remaining levels each cover 64 slots of the level below.
+  enum
+  {
+    level0_bits = 8,
+    level0_size = 1 << level0_bits,
+    level0_mask = level0_size - 1,
+    level_bits = 6,
+    level_size = 1 << level_bits,
+    level_mask = level_size - 1,
+    num_levels = 4,
+    num_slots = level0_size + (num_levels - 1) * level_size
+  };
+
+  // The number of ticks that the wheel is able to represent. Timers that are
+  // further away are kept in the last slot and revisited on each turn.
+  static const boost::uint64_t max_delta =
+    (static_cast<boost::uint64_t>(1)
+      << (level0_bits + (num_levels - 1) * level_bits)) - 1;
+
+  // Marker used when no timer is waiting to expire.
+  static const boost::uint64_t no_tick = ~static_cast<boost::uint64_t>(0);
+
+  // The number of low order tick bits below the given level.
+  static int level_shift(int level)
+  {
+    return level == 0 ? 0 : level0_bits + (level - 1) * level_bits;
+  }
+
+  // Get the index of the first slot in the given level.
+  static int level_offset(int level)
+  {
+    return level == 0 ? 0 : level0_size + (level - 1) * level_size;
+  }
+
+  // Determine the level that owns the given slot.
+  int slot_level(per_timer_data** slot) const
+  {
+    std::ptrdiff_t index = slot - slots_;
+    if (index < level0_size)
+      return 0;
+    return 1 + static_cast<int>((index - level0_size) / level_size);
+  }
+
+  // Whether there are no timers that are waiting to expire.
+  bool wheel_empty() const
+  {
+    return level_count_[0] == 0 && upper_levels_empty();
+  }
+
+  // Whether there are no timers above the first level.
+  bool upper_levels_empty() const
+  {
+    for (int i = 1; i < num_levels; ++i)
+      if (level_count_[i] != 0)
+        return false;
+    return true;
+  }
+
+  // Get the current time of a monotonic clock, in microseconds.
+  static boost::int64_t monotonic_usec()
+  {
+#if defined(BOOST_WINDOWS)
+    LARGE_INTEGER frequency, counter;
+    ::QueryPerformanceFrequency(&frequency);
+    ::QueryPerformanceCounter(&counter);
+    return static_cast<boost::int64_t>(counter.QuadPart / frequency.QuadPart)
+      * 1000000 + static_cast<boost::int64_t>(
+          counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<boost::int64_t>(ts.tv_sec) * 1000000
+      + ts.tv_nsec / 1000;
+#else // defined(CLOCK_MONOTONIC)
+    timeval tv;
+    ::gettimeofday(&tv, 0);
+    return static_cast<boost::int64_t>(tv.tv_sec) * 1000000 + tv.tv_usec;
+#endif // defined(CLOCK_MONOTONIC)
+  }
+
+  // Get the number of microseconds since the wheel was constructed.
+  boost::int64_t elapsed_usec() const
+  {
+    return monotonic_usec() - origin_;
+  }
+
+  // Get the tick at which a timer for the given time is due. The result is
+  // rounded up so that a timer never fires before its expiry time.
+  boost::uint64_t to_tick(const time_type& time) const
+  {
+    // Sample the monotonic clock last, so that any time that passes between
+    // the two samples can only make the timer later.
+    boost::int64_t delay = Time_Traits::to_posix_duration(
+        Time_Traits::subtract(time, Time_Traits::now())).total_microseconds();
+    boost::int64_t usec = elapsed_usec() + delay;
+    if (usec <= 0)
+      return 0;
+    return (static_cast<boost::uint64_t>(usec) + Resolution - 1) / Resolution;
+  }
+
+  // Get the tick that contains the current time.
+  boost::uint64_t now_tick() const
+  {
+    boost::int64_t usec = elapsed_usec();
+    if (usec <= 0)
+      return 0;
+    return static_cast<boost::uint64_t>(usec) / Resolution;
+  }
+
+  // Get the number of microseconds from now until the start of a tick.
+  boost::int64_t usec_until(boost::uint64_t tick) const
+  {
+    return static_cast<boost::int64_t>(tick * Resolution) - elapsed_usec();
+  }
+
+  // Put a timer into the slot that corresponds to its expiry tick.
+  void insert(per_timer_data& timer)
+  {
+    boost::uint64_t tick = timer.tick_ < base_tick_ ? base_tick_ : timer.tick_;
+    boost::uint64_t delta = tick - base_tick_;
+    if (delta > max_delta)
+    {
+      tick = base_tick_ + max_delta;
+      delta = max_delta;
+    }
+
+    int level = 0;
+    while (level + 1 < num_levels && delta >> level_shift(level + 1))
+      ++level;
+
+    int index = level == 0
+      ? static_cast<int>(tick & level0_mask)
+      : static_cast<int>((tick >> level_shift(level)) & level_mask);
+    link(timer, &slots_[level_offset(level) + index]);
+    ++level_count_[level];
+  }
+
+  // Add a timer to the front of a list.
+  static void link(per_timer_data& timer, per_timer_data** slot)
+  {
+    timer.slot_ = slot;
+    timer.prev_ = 0;
+    timer.next_ = *slot;
+    if (*slot)
+      (*slot)->prev_ = &timer;
+    *slot = &timer;
+  }
+
+  // Take a timer out of its list.
+  static void unlink(per_timer_data& timer)
+  {
+    if (*timer.slot_ == &timer)
+      *timer.slot_ = timer.next_;
+    if (timer.prev_)
+      timer.prev_->next_ = timer.next_;
+    if (timer.next_)
+      timer.next_->prev_ = timer.prev_;
+    timer.slot_ = 0;
+  }
+
+  // Dequeue all timers in a list.
+  static void take_all(per_timer_data** slot, op_queue<operation>& ops)
+  {
+    while (per_timer_data* timer = *slot)
+    {
+      *slot = timer->next_;
+      ops.push(timer->op_queue_);
+      timer->slot_ = 0;
+    }
+  }
+
+  // Redistribute the timers from the upper level slots that begin at the
+  // current tick.
+  void cascade()
+  {
+    for (int level = 1; level < num_levels; ++level)
+    {
+      int index = static_cast<int>(
+          (base_tick_ >> level_shift(level)) & level_mask);
+      per_timer_data** slot = &slots_[level_offset(level) + index];
+      per_timer_data* timer = *slot;
+      *slot = 0;
+      while (timer)
+      {
+        per_timer_data* next = timer->next_;
+        --level_count_[level];
+        insert(*timer);
+        timer = next;
+      }
+
+      // Only continue to the next level when this one has wrapped.
+      if (index != 0)
+        break;
+    }
+  }
+
+  // Get the next tick at which the wheel cascades timers from a level that
+  // is not empty.
+  boost::uint64_t next_boundary() const
+  {
+    int level = 1;
+    while (level + 1 < num_levels && level_count_[level] == 0)
+      ++level;
+    boost::uint64_t span = static_cast<boost::uint64_t>(1) << level_shift(level);
+    return (base_tick_ | (span - 1)) + 1;
+  }
+
+  // Find the first tick at which the wheel needs to be advanced.
+  boost::uint64_t find_earliest() const
+  {
+    if (wheel_empty())
+      return no_tick;
+
+    // Timers in the upper levels may expire soon after the next cascade, so
+    // the wheel must be advanced no later than that.
+    boost::uint64_t earliest = no_tick;
+    if (!upper_levels_empty())
+      earliest = next_boundary();
+
+    if (level_count_[0] != 0)
+    {
+      for (boost::uint64_t tick = base_tick_; tick < earliest; ++tick)
+        if (slots_[tick & level0_mask])
+          return tick;
+    }
+
+    return earliest;
+  }
+
+  // Remove a timer from the wheel.
+  void remove_timer(per_timer_data& timer)
+  {
+    if (timer.slot_ != &infinite_timers_)
+      --level_count_[slot_level(timer.slot_)];
+    unlink(timer);
+  }
+
+  // Determine if the specified absolute time is positive infinity.
+  template <typename Time_Type>
+  static bool is_positive_infinity(const Time_Type&)
+  {
+    return false;
+  }
+
+  // Determine if the specified absolute time is positive infinity.
+  template <typename T, typename TimeSystem>
+  static bool is_positive_infinity(
+      const boost::date_time::base_time<T, TimeSystem>& time)
+  {
+    return time.is_pos_infinity();
+  }
+
+  // The head of a linked list of timers that never expire.
+  per_timer_data* infinite_timers_;
+
+  // The monotonic clock time from which ticks are counted.
+  boost::int64_t origin_;
+
+  // The tick that corresponds to the current first level slot.
+  boost::uint64_t base_tick_;
+
+  // The tick at which the reactor has been asked to advance the wheel. This
+  // may be earlier than the first timer if timers have been cancelled.
+  boost::uint64_t earliest_tick_;
+
+  // The heads of the lists of timers in each slot.
+  per_timer_data* slots_[num_slots];
+
+  // The number of timers held in each level.
+  std::size_t level_count_[num_levels];
+};
+
+template <typename Time_Traits, long Resolution>
+const boost::uint64_t timer_wheel<Time_Traits, Resolution>::max_delta;
+
+template <typename Time_Traits, long Resolution>
+const boost::uint64_t timer_wheel<Time_Traits, Resolution>::no_tick;
+
+// Timers that use wheel_time_traits are kept in a timing wheel.
+template <typename TimeTraits, long Resolution>
+class timer_queue<boost::asio::wheel_time_traits<TimeTraits, Resolution> >
+  : public timer_wheel<
+      boost::asio::wheel_time_traits<TimeTraits, Resolution>, Resolution>
+{
+};
+
+// Waitable timers that use wheel_wait_traits are kept in a timing wheel.
+template <typename Clock, typename WaitTraits, long Resolution>
+class timer_queue<chrono_time_traits<Clock,
+    boost::asio::wheel_wait_traits<WaitTraits, Resolution> > >
+  : public timer_wheel<chrono_time_traits<Clock,
+      boost::asio::wheel_wait_traits<WaitTraits, Resolution> >, Resolution>
+{
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
@@ -79,6 +79,19 @@ public:
     lock.lock();
   }
 
+  // Wait for the event to become signalled, for at most the given number of
+  // microseconds. Returns true if the event was signalled.
+  template <typename Lock>
+  bool wait_for_usec(Lock& lock, long usec)
+  {
+    BOOST_ASSERT(lock.locked());
+    lock.unlock();
+    DWORD msec = usec > 0 ? (usec < 1000 ? 1 : usec / 1000) : 0;
+    DWORD result = ::WaitForSingleObject(event_, msec);
+    lock.lock();
+    return result == WAIT_OBJECT_0;
+  }
+
 private:
   HANDLE event_;
 };
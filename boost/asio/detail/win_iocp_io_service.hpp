@@ -22,6 +22,7 @@
 #include <boost/limits.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/handler_memory_cache.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/scoped_ptr.hpp>
@@ -240,6 +241,9 @@ private:
   // Flag to indicate whether the service has been shut down.
   long shutdown_;
 
+  // The handler memory caches that are not in use by a running thread.
+  handler_memory_cache::pool memory_cache_pool_;
+
   enum
   {
     // Timeout to use with GetQueuedCompletionStatus. Some versions of windows
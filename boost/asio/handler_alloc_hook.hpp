@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 #include <cstddef>
+#include <boost/asio/detail/handler_memory_cache.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -32,10 +33,16 @@ namespace asio {
  * Implement asio_handler_allocate and asio_handler_deallocate for your own
  * handlers to provide custom allocation for these temporary objects.
  *
- * This default implementation is simply:
+ * The default implementation recycles small blocks of memory through a cache
+ * that is owned by the calling thread while it is running an io_service, so
+ * that an asynchronous operation started from within a handler can usually
+ * reuse the memory released by the operation that invoked the handler. Other
+ * requests are satisfied using:
  * @code
  * return ::operator new(size);
  * @endcode
+ * Recycling can be disabled by defining
+ * @c BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING.
  *
  * @note All temporary objects associated with a handler will be deallocated
  * before the upcall to the handler is performed. This allows the same memory to
@@ -59,7 +66,11 @@ namespace asio {
  */
 inline void* asio_handler_allocate(std::size_t size, ...)
 {
+#if defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
   return ::operator new(size);
+#else // defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  return detail::handler_memory_cache::allocate(size);
+#endif // defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
 }
 
 /// Default deallocation function for handlers.
@@ -67,7 +78,8 @@ inline void* asio_handler_allocate(std::size_t size, ...)
  * Implement asio_handler_allocate and asio_handler_deallocate for your own
  * handlers to provide custom allocation for the associated temporary objects.
  *
- * This default implementation is simply:
+ * The default implementation returns small blocks of memory to the calling
+ * thread's cache, if it has one, and otherwise uses:
  * @code
  * ::operator delete(pointer);
  * @endcode
@@ -76,8 +88,12 @@ inline void* asio_handler_allocate(std::size_t size, ...)
  */
 inline void asio_handler_deallocate(void* pointer, std::size_t size, ...)
 {
+#if defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
   (void)(size);
   ::operator delete(pointer);
+#else // defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  detail::handler_memory_cache::deallocate(pointer, size);
+#endif // defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
 }
 
 } // namespace asio
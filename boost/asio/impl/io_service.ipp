@@ -120,6 +120,28 @@ void io_service::reset()
   impl_.reset();
 }
 
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+long io_service::busy_poll_duration() const
+{
+  return impl_.busy_poll_duration();
+}
+
+void io_service::busy_poll_duration(long usec)
+{
+  impl_.busy_poll_duration(usec);
+}
+
+std::size_t io_service::busy_poll_hit_count() const
+{
+  return impl_.busy_poll_hit_count();
+}
+
+std::size_t io_service::busy_poll_park_count() const
+{
+  return impl_.busy_poll_park_count();
+}
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+
 void io_service::notify_fork(boost::asio::io_service::fork_event event)
 {
   service_registry_->notify_fork(event);
@@ -419,6 +419,46 @@ public:
    */
   BOOST_ASIO_DECL void reset();
 
+#if defined(BOOST_ASIO_HAS_BUSY_POLL) || defined(GENERATING_DOCUMENTATION)
+  /// Get the busy-polling duration.
+  /**
+   * This function returns the number of microseconds for which a thread that
+   * is running the io_service polls for new work before it blocks. It is
+   * available only when @c BOOST_ASIO_ENABLE_BUSY_POLL is defined.
+   */
+  BOOST_ASIO_DECL long busy_poll_duration() const;
+
+  /// Set the busy-polling duration.
+  /**
+   * This function sets the number of microseconds for which a thread that is
+   * running the io_service polls for new work before it blocks. While
+   * polling, the thread keeps the CPU busy, but work that arrives is picked
+   * up without having to wake the thread. It is available only when
+   * @c BOOST_ASIO_ENABLE_BUSY_POLL is defined.
+   *
+   * @param usec The duration in microseconds. A value of zero disables
+   * busy-polling.
+   */
+  BOOST_ASIO_DECL void busy_poll_duration(long usec);
+
+  /// Get the number of times busy-polling found work to do.
+  /**
+   * This function returns the number of times that a thread found work while
+   * busy-polling, and so did not have to block. It is available only when
+   * @c BOOST_ASIO_ENABLE_BUSY_POLL is defined.
+   */
+  BOOST_ASIO_DECL std::size_t busy_poll_hit_count() const;
+
+  /// Get the number of times busy-polling ended with the thread blocking.
+  /**
+   * This function returns the number of times that a thread busy-polled for
+   * the full duration without finding work, and then blocked. It is
+   * available only when @c BOOST_ASIO_ENABLE_BUSY_POLL is defined.
+   */
+  BOOST_ASIO_DECL std::size_t busy_poll_park_count() const;
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Request the io_service to invoke the given handler.
   /**
    * This function is used to ask the io_service to execute the given handler.
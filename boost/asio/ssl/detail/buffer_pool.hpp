@@ -0,0 +1,117 @@
+//
+// ssl/detail/buffer_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_SSL_DETAIL_BUFFER_POOL_HPP
+#define BOOST_ASIO_SSL_DETAIL_BUFFER_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if !defined(BOOST_ASIO_ENABLE_OLD_SSL)
+# include <cstddef>
+# include <boost/asio/detail/noncopyable.hpp>
+# include <boost/asio/detail/static_mutex.hpp>
+#endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace ssl {
+namespace detail {
+
+#if !defined(BOOST_ASIO_ENABLE_OLD_SSL)
+
+// A process-wide cache of the fixed-size buffers used by SSL streams to pass
+// data between the engine and the transport. Streams that are closed return
+// their buffers to the pool so that a new stream does not need to allocate
+// (and initialise) them again.
+class buffer_pool
+{
+public:
+  // According to the OpenSSL documentation, this is the buffer size that is is
+  // sufficient to hold the largest possible TLS record.
+  enum { block_size = 17 * 1024 };
+
+  // A buffer that is obtained from the pool on construction and returned to
+  // it on destruction.
+  class block
+    : private boost::asio::detail::noncopyable
+  {
+  public:
+    block()
+      : data_(buffer_pool::allocate())
+    {
+    }
+
+    ~block()
+    {
+      buffer_pool::deallocate(data_);
+    }
+
+    unsigned char* data() const
+    {
+      return data_;
+    }
+
+  private:
+    unsigned char* data_;
+  };
+
+  // Obtain a buffer of block_size bytes, reusing a cached one if available.
+  BOOST_ASIO_DECL static unsigned char* allocate();
+
+  // Return a buffer to the pool, or free it if the pool is full.
+  BOOST_ASIO_DECL static void deallocate(unsigned char* data);
+
+  // Get the number of buffers currently held by the pool.
+  BOOST_ASIO_DECL static std::size_t cached_blocks();
+
+private:
+  // The maximum number of buffers held by the pool.
+  enum { max_cached_blocks = 256 };
+
+  // Header overlaid on a cached buffer.
+  struct cached_block
+  {
+    cached_block* next_;
+  };
+
+  // The pooled buffers. Must be accessed with the mutex held.
+  struct free_list
+  {
+    cached_block* head_;
+    std::size_t count_;
+  };
+
+  // Get the process-wide free list.
+  BOOST_ASIO_DECL static free_list& instance();
+
+  // The mutex that protects the free list.
+  BOOST_ASIO_DECL static boost::asio::detail::static_mutex& mutex();
+};
+
+#endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/ssl/detail/impl/buffer_pool.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_SSL_DETAIL_BUFFER_POOL_HPP
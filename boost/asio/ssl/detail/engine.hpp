@@ -93,6 +93,20 @@ public:
   BOOST_ASIO_DECL want read(const boost::asio::mutable_buffer& data,
       boost::system::error_code& ec, std::size_t& bytes_transferred);
 
+  // Set whether a write of several buffers should gather them into a single
+  // record, rather than writing only the first buffer.
+  BOOST_ASIO_DECL void set_write_coalescing(bool enabled);
+
+  // Get whether writes gather a buffer sequence into a single record.
+  BOOST_ASIO_DECL bool write_coalescing() const;
+
+  // Get the space in which the data for a coalesced write may be gathered.
+  // The space holds the largest amount of data that fits in one record.
+  BOOST_ASIO_DECL boost::asio::mutable_buffer coalescing_buffer();
+
+  // Get the number of records that have been produced by writes.
+  BOOST_ASIO_DECL std::size_t records_written() const;
+
   // Get output data to be written to the transport.
   BOOST_ASIO_DECL boost::asio::mutable_buffers_1 get_output(
       const boost::asio::mutable_buffer& data);
@@ -144,6 +158,16 @@ private:
 
   SSL* ssl_;
   BIO* ext_bio_;
+
+  // Whether writes gather a buffer sequence into a single record.
+  bool write_coalescing_;
+
+  // Pooled space used to gather the data for coalesced writes. Obtained the
+  // first time it is needed.
+  unsigned char* coalescing_space_;
+
+  // The number of records that have been produced by writes.
+  std::size_t records_written_;
 };
 
 #endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
@@ -0,0 +1,104 @@
+//
+// ssl/detail/impl/buffer_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_SSL_DETAIL_IMPL_BUFFER_POOL_IPP
+#define BOOST_ASIO_SSL_DETAIL_IMPL_BUFFER_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if !defined(BOOST_ASIO_ENABLE_OLD_SSL)
+# include <new>
+# include <boost/asio/ssl/detail/buffer_pool.hpp>
+#endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace ssl {
+namespace detail {
+
+#if !defined(BOOST_ASIO_ENABLE_OLD_SSL)
+
+unsigned char* buffer_pool::allocate()
+{
+  {
+    boost::asio::detail::static_mutex& m = mutex();
+    m.init();
+    boost::asio::detail::static_mutex::scoped_lock lock(m);
+    free_list& pool = instance();
+    if (cached_block* b = pool.head_)
+    {
+      pool.head_ = b->next_;
+      --pool.count_;
+      return reinterpret_cast<unsigned char*>(b);
+    }
+  }
+
+  return static_cast<unsigned char*>(::operator new(block_size));
+}
+
+void buffer_pool::deallocate(unsigned char* data)
+{
+  if (!data)
+    return;
+
+  {
+    boost::asio::detail::static_mutex& m = mutex();
+    m.init();
+    boost::asio::detail::static_mutex::scoped_lock lock(m);
+    free_list& pool = instance();
+    if (pool.count_ < max_cached_blocks)
+    {
+      cached_block* b = reinterpret_cast<cached_block*>(data);
+      b->next_ = pool.head_;
+      pool.head_ = b;
+      ++pool.count_;
+      return;
+    }
+  }
+
+  ::operator delete(data);
+}
+
+std::size_t buffer_pool::cached_blocks()
+{
+  boost::asio::detail::static_mutex& m = mutex();
+  m.init();
+  boost::asio::detail::static_mutex::scoped_lock lock(m);
+  return instance().count_;
+}
+
+buffer_pool::free_list& buffer_pool::instance()
+{
+  static free_list pool = { 0, 0 };
+  return pool;
+}
+
+boost::asio::detail::static_mutex& buffer_pool::mutex()
+{
+  static boost::asio::detail::static_mutex mutex = BOOST_ASIO_STATIC_MUTEX_INIT;
+  return mutex;
+}
+
+#endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_SSL_DETAIL_IMPL_BUFFER_POOL_IPP
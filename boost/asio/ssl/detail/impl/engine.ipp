@@ -20,6 +20,7 @@
 #if !defined(BOOST_ASIO_ENABLE_OLD_SSL)
 # include <boost/asio/detail/throw_error.hpp>
 # include <boost/asio/error.hpp>
+# include <boost/asio/ssl/detail/buffer_pool.hpp>
 # include <boost/asio/ssl/detail/engine.hpp>
 # include <boost/asio/ssl/error.hpp>
 # include <boost/asio/ssl/verify_context.hpp>
@@ -35,7 +36,10 @@ namespace detail {
 #if !defined(BOOST_ASIO_ENABLE_OLD_SSL)
 
 engine::engine(SSL_CTX* context)
-  : ssl_(::SSL_new(context))
+  : ssl_(::SSL_new(context)),
+    write_coalescing_(false),
+    coalescing_space_(0),
+    records_written_(0)
 {
   if (!ssl_)
   {
@@ -67,6 +71,8 @@ engine::~engine()
 
   ::BIO_free(ext_bio_);
   ::SSL_free(ssl_);
+
+  buffer_pool::deallocate(coalescing_space_);
 }
 
 SSL* engine::native_handle()
@@ -161,6 +167,30 @@ engine::want engine::read(const boost::asio::mutable_buffer& data,
       boost::asio::buffer_size(data), ec, &bytes_transferred);
 }
 
+void engine::set_write_coalescing(bool enabled)
+{
+  write_coalescing_ = enabled;
+}
+
+bool engine::write_coalescing() const
+{
+  return write_coalescing_;
+}
+
+boost::asio::mutable_buffer engine::coalescing_buffer()
+{
+  if (!coalescing_space_)
+    coalescing_space_ = buffer_pool::allocate();
+
+  return boost::asio::mutable_buffer(coalescing_space_,
+      SSL3_RT_MAX_PLAIN_LENGTH);
+}
+
+std::size_t engine::records_written() const
+{
+  return records_written_;
+}
+
 boost::asio::mutable_buffers_1 engine::get_output(
     const boost::asio::mutable_buffer& data)
 {
@@ -301,7 +331,14 @@ int engine::do_read(void* data, std::size_t length)
 
 int engine::do_write(void* data, std::size_t length)
 {
-  return ::SSL_write(ssl_, data, length < INT_MAX ? length : INT_MAX);
+  int result = ::SSL_write(ssl_, data, length < INT_MAX ? length : INT_MAX);
+
+  // Application data is split into records of at most this size.
+  if (result > 0)
+    records_written_ += (result + SSL3_RT_MAX_PLAIN_LENGTH - 1)
+      / SSL3_RT_MAX_PLAIN_LENGTH;
+
+  return result;
 }
 
 #endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
@@ -44,8 +44,11 @@ std::size_t io(Stream& next_layer, stream_core& core,
     // If the input buffer is empty then we need to read some more data from
     // the underlying transport.
     if (boost::asio::buffer_size(core.input_) == 0)
+    {
+      ++core.transport_reads_;
       core.input_ = boost::asio::buffer(core.input_buffer_,
           next_layer.read_some(core.input_buffer_, ec));
+    }
 
     // Pass the new input data to the engine.
     core.input_ = core.engine_.put_input(core.input_);
@@ -57,6 +60,7 @@ std::size_t io(Stream& next_layer, stream_core& core,
 
     // Get output data from the engine and write it to the underlying
     // transport.
+    ++core.transport_writes_;
     boost::asio::write(next_layer,
         core.engine_.get_output(core.output_buffer_), ec);
 
@@ -67,6 +71,7 @@ std::size_t io(Stream& next_layer, stream_core& core,
 
     // Get output data from the engine and write it to the underlying
     // transport.
+    ++core.transport_writes_;
     boost::asio::write(next_layer,
         core.engine_.get_output(core.output_buffer_), ec);
 
@@ -155,6 +160,7 @@ public:
             core_.pending_read_.expires_at(boost::posix_time::pos_infin);
 
             // Start reading some data from the underlying transport.
+            ++core_.transport_reads_;
             next_layer_.async_read_some(
                 boost::asio::buffer(core_.input_buffer_),
                 BOOST_ASIO_MOVE_CAST(io_op)(*this));
@@ -182,6 +188,7 @@ public:
             core_.pending_write_.expires_at(boost::posix_time::pos_infin);
 
             // Start writing all the data to the underlying transport.
+            ++core_.transport_writes_;
             boost::asio::async_write(next_layer_,
                 core_.engine_.get_output(core_.output_buffer_),
                 BOOST_ASIO_MOVE_CAST(io_op)(*this));
@@ -19,6 +19,7 @@
 
 #if !defined(BOOST_ASIO_ENABLE_OLD_SSL)
 # include <boost/asio/deadline_timer.hpp>
+# include <boost/asio/ssl/detail/buffer_pool.hpp>
 # include <boost/asio/ssl/detail/engine.hpp>
 # include <boost/asio/buffer.hpp>
 #endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
@@ -36,16 +37,18 @@ struct stream_core
 {
   // According to the OpenSSL documentation, this is the buffer size that is is
   // sufficient to hold the largest possible TLS record.
-  enum { max_tls_record_size = 17 * 1024 };
+  enum { max_tls_record_size = buffer_pool::block_size };
 
   stream_core(SSL_CTX* context, boost::asio::io_service& io_service)
     : engine_(context),
       pending_read_(io_service),
       pending_write_(io_service),
-      output_buffer_space_(max_tls_record_size),
-      output_buffer_(boost::asio::buffer(output_buffer_space_)),
-      input_buffer_space_(max_tls_record_size),
-      input_buffer_(boost::asio::buffer(input_buffer_space_))
+      output_buffer_(boost::asio::buffer(
+            output_buffer_space_.data(), max_tls_record_size)),
+      input_buffer_(boost::asio::buffer(
+            input_buffer_space_.data(), max_tls_record_size)),
+      transport_reads_(0),
+      transport_writes_(0)
   {
     pending_read_.expires_at(boost::posix_time::neg_infin);
     pending_write_.expires_at(boost::posix_time::neg_infin);
@@ -65,19 +68,25 @@ struct stream_core
   boost::asio::deadline_timer pending_write_;
 
   // Buffer space used to prepare output intended for the transport.
-  std::vector<unsigned char> output_buffer_space_; 
+  buffer_pool::block output_buffer_space_;
 
   // A buffer that may be used to prepare output intended for the transport.
   const boost::asio::mutable_buffers_1 output_buffer_; 
 
   // Buffer space used to read input intended for the engine.
-  std::vector<unsigned char> input_buffer_space_; 
+  buffer_pool::block input_buffer_space_;
 
   // A buffer that may be used to read input intended for the engine.
   const boost::asio::mutable_buffers_1 input_buffer_;
 
   // The buffer pointing to the engine's unconsumed input.
   boost::asio::const_buffer input_;
+
+  // The number of read operations started on the underlying transport.
+  std::size_t transport_reads_;
+
+  // The number of write operations started on the underlying transport.
+  std::size_t transport_writes_;
 };
 
 #endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
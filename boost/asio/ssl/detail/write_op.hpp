@@ -18,6 +18,7 @@
 #include <boost/asio/detail/config.hpp>
 
 #if !defined(BOOST_ASIO_ENABLE_OLD_SSL)
+# include <boost/asio/buffer.hpp>
 # include <boost/asio/detail/buffer_sequence_adapter.hpp>
 # include <boost/asio/ssl/detail/engine.hpp>
 #endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
@@ -48,6 +49,24 @@ public:
       boost::asio::detail::buffer_sequence_adapter<boost::asio::const_buffer,
         ConstBufferSequence>::first(buffers_);
 
+    // When coalescing, a first buffer that would not fill a record is
+    // combined with the buffers that follow it, so that they are sent in a
+    // single record. The same data is gathered again if the write is retried.
+    // Only the buffers of this operation are combined; data is never held
+    // back to be sent with a later write.
+    if (eng.write_coalescing())
+    {
+      boost::asio::mutable_buffer space = eng.coalescing_buffer();
+      if (boost::asio::buffer_size(buffer) < boost::asio::buffer_size(space)
+          && boost::asio::buffer_size(buffers_)
+            > boost::asio::buffer_size(buffer))
+      {
+        std::size_t length = boost::asio::buffer_copy(space, buffers_);
+        return eng.write(boost::asio::buffer(space, length),
+            ec, bytes_transferred);
+      }
+    }
+
     return eng.write(buffer, ec, bytes_transferred);
   }
 
@@ -21,6 +21,7 @@
 
 #include <boost/asio/ssl/impl/context.ipp>
 #include <boost/asio/ssl/impl/error.ipp>
+#include <boost/asio/ssl/detail/impl/buffer_pool.ipp>
 #include <boost/asio/ssl/detail/impl/engine.ipp>
 #include <boost/asio/ssl/detail/impl/openssl_init.ipp>
 #include <boost/asio/ssl/impl/rfc2818_verification.ipp>
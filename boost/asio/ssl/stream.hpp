@@ -309,6 +309,71 @@ public:
         new detail::verify_callback<VerifyCallback>(callback), ec);
   }
 
+  /// Set whether writes are coalesced into full records.
+  /**
+   * This function may be used to control how a write of several buffers is
+   * sent. By default, a call to write_some() or async_write_some() writes
+   * only the first non-empty buffer in the sequence, so that a message made
+   * up of several small buffers is sent as several small records. When
+   * coalescing is enabled, a first buffer that is smaller than the maximum
+   * record size is combined with the buffers that follow it, and as much
+   * of the data as fits in a single record is written.
+   *
+   * Only the buffers passed to a single write operation are combined. Data
+   * from separate write operations is never held back to be sent together
+   * with a later write, so messages made up of several small writes should
+   * be gathered into one buffer sequence by the caller.
+   *
+   * Coalescing is disabled by default.
+   *
+   * @param enabled Whether writes should be coalesced.
+   *
+   * @note The data is copied into a buffer owned by the stream before it is
+   * written.
+   */
+  void set_write_coalescing(bool enabled)
+  {
+    core_.engine_.set_write_coalescing(enabled);
+  }
+
+  /// Get whether writes are coalesced into full records.
+  bool write_coalescing() const
+  {
+    return core_.engine_.write_coalescing();
+  }
+
+  /// Get the number of records that have been written.
+  /**
+   * Returns the number of records that have been produced to carry the
+   * application data written to the stream. Records that are produced by
+   * handshaking or shutdown are not counted.
+   */
+  std::size_t records_written() const
+  {
+    return core_.engine_.records_written();
+  }
+
+  /// Get the number of reads performed on the next layer.
+  /**
+   * Returns the number of read operations that the stream has started on the
+   * next layer in order to obtain data for the SSL engine.
+   */
+  std::size_t transport_reads() const
+  {
+    return core_.transport_reads_;
+  }
+
+  /// Get the number of writes performed on the next layer.
+  /**
+   * Returns the number of write operations that the stream has started on the
+   * next layer in order to send data produced by the SSL engine. Each write
+   * operation writes all of the data that is pending at the time.
+   */
+  std::size_t transport_writes() const
+  {
+    return core_.transport_writes_;
+  }
+
   /// Perform SSL handshaking.
   /**
    * This function is used to perform SSL handshaking on the stream. The
@@ -96,6 +96,22 @@ public:
     service_.construct(impl_);
   }
 
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Copy constructor.
+  /**
+   * Constructs a strand that refers to the same underlying strand as @c other.
+   * Handlers dispatched through either object are subject to the same
+   * guarantee of non-concurrency.
+   */
+  strand(const strand& other)
+    : service_(other.service_)
+  {
+    service_.copy_construct(impl_, other.impl_);
+  }
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Destructor.
   /**
    * Destroys a strand.
@@ -105,6 +121,9 @@ public:
    */
   ~strand()
   {
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+    service_.destroy(impl_);
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
   }
 
   /// Get the io_service associated with the strand.
@@ -207,6 +226,34 @@ public:
     return detail::wrapped_handler<io_service::strand, Handler>(*this, handler);
   }
 
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Get the number of handlers that had to wait for the strand.
+  /**
+   * This function returns the number of handlers that, at the time they were
+   * posted or dispatched, found the strand already executing or scheduled to
+   * execute other handlers. It is available only when
+   * @c BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS is defined.
+   */
+  std::size_t delayed_handler_count() const
+  {
+    return service_.delayed_handler_count(impl_);
+  }
+
+  /// Get the number of times enqueueing a handler was retried.
+  /**
+   * This function returns the number of times a handler could not be added to
+   * the strand at the first attempt because another thread was concurrently
+   * adding a handler to the same strand. It is available only when
+   * @c BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS is defined.
+   */
+  std::size_t enqueue_retry_count() const
+  {
+    return service_.enqueue_retry_count(impl_);
+  }
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 private:
   boost::asio::detail::strand_service& service_;
   boost::asio::detail::strand_service::implementation_type impl_;
@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 #include <cstddef>
+#include <boost/cstdint.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/io_service.hpp>
 
@@ -299,6 +300,25 @@ public:
         BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
   }
 
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+  /// Send a region of a file.
+  std::size_t send_file(implementation_type& impl, int fd,
+      boost::uint64_t offset, std::size_t size, boost::system::error_code& ec)
+  {
+    return service_impl_.send_file(impl, fd, offset, size, ec);
+  }
+
+  /// Start an asynchronous send of a region of a file.
+  template <typename WriteHandler>
+  void async_send_file(implementation_type& impl, int fd,
+      boost::uint64_t offset, std::size_t size,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    service_impl_.async_send_file(impl, fd, offset, size,
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
   /// Receive some data from the peer.
   template <typename MutableBufferSequence>
   std::size_t receive(implementation_type& impl,
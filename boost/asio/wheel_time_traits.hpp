@@ -0,0 +1,94 @@
+//
+// wheel_time_traits.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_WHEEL_TIME_TRAITS_HPP
+#define BOOST_ASIO_WHEEL_TIME_TRAITS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/timer_wheel.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Time traits that select a timing wheel for the deadline timer.
+/**
+ * By default, the timers associated with an io_service are kept in a binary
+ * heap, so that arming or cancelling a timer has a cost logarithmic in the
+ * number of timers. When wheel_time_traits are used, the timers are instead
+ * kept in a hierarchical timing wheel where arming and cancelling a timer are
+ * constant time operations. This suits programs that have a large number of
+ * timers which are frequently rearmed, such as per-connection idle timeouts.
+ *
+ * The wheel rounds every expiry time up to a multiple of @c Resolution
+ * microseconds. A timer never completes before its expiry time, but may
+ * complete up to one resolution period afterwards.
+ *
+ * The wheel advances with a monotonic clock. An expiry time is converted to a
+ * delay when the wait is started, so a later change to the system clock does
+ * not cause the timer to complete sooner or later than that delay.
+ *
+ * @par Example
+ * @code
+ * typedef boost::asio::basic_deadline_timer<
+ *     boost::posix_time::ptime,
+ *     boost::asio::wheel_time_traits<
+ *       boost::asio::time_traits<boost::posix_time::ptime> > >
+ *   idle_timer;
+ * @endcode
+ */
+template <typename TimeTraits, long Resolution = 1000>
+struct wheel_time_traits
+  : TimeTraits
+{
+  /// The resolution of the timing wheel, in microseconds.
+  static const long resolution = Resolution;
+};
+
+template <typename TimeTraits, long Resolution>
+const long wheel_time_traits<TimeTraits, Resolution>::resolution;
+
+/// Wait traits that select a timing wheel for the waitable timer.
+/**
+ * The waitable timer counterpart of wheel_time_traits. Timers that use these
+ * wait traits are kept in a hierarchical timing wheel with a resolution of
+ * @c Resolution microseconds.
+ *
+ * @par Example
+ * @code
+ * typedef boost::asio::basic_waitable_timer<
+ *     boost::chrono::steady_clock,
+ *     boost::asio::wheel_wait_traits<
+ *       boost::asio::wait_traits<boost::chrono::steady_clock> > >
+ *   idle_timer;
+ * @endcode
+ */
+template <typename WaitTraits, long Resolution = 1000>
+struct wheel_wait_traits
+  : WaitTraits
+{
+  /// The resolution of the timing wheel, in microseconds.
+  static const long resolution = Resolution;
+};
+
+template <typename WaitTraits, long Resolution>
+const long wheel_wait_traits<WaitTraits, Resolution>::resolution;
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_WHEEL_TIME_TRAITS_HPP
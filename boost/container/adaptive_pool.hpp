@@ -0,0 +1,131 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_ADAPTIVE_POOL_HPP
+#define BOOST_CONTAINER_ADAPTIVE_POOL_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/detail/workaround.hpp>
+#include <boost/container/container_fwd.hpp>
+#include <boost/container/detail/version_type.hpp>
+#include <boost/container/detail/type_traits.hpp>
+#include <boost/container/detail/allocator_common.hpp>
+#include <boost/container/detail/adaptive_node_pool.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>
+
+//!\file
+//!Describes adaptive_pool, a pooled STL compatible allocator for node containers
+//!that returns unused memory to the heap
+
+namespace boost {
+namespace container {
+
+//!An STL node allocator that allocates nodes from an adaptive pool placed
+//!in the heap. All adaptive_pools with the same sizeof(T) and parameters
+//!share the same pool, which is protected by a spinlock, so containers
+//!using them can live in different threads.
+//!
+//!Nodes are allocated in blocks of at least NodesPerBlock nodes. Unlike
+//!node_allocator, blocks whose nodes are all free are returned to the heap
+//!once there are more than MaxFreeBlocks free blocks, so memory is recovered
+//!when containers shrink. OverheadPercent is the maximum percentage of a block
+//!used for the pool's bookkeeping. As adaptive_pool is a version 2 allocator,
+//!node containers obtain all the nodes of a range insertion or a copy with a
+//!single call to allocate_individual(). Array allocations (e.g. vector's
+//!buffer) are forwarded to the heap.
+#if defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+template < class T
+         , std::size_t NodesPerBlock = 256
+         , std::size_t MaxFreeBlocks = 2
+         , unsigned char OverheadPercent = 5
+         >
+#else
+template < class T
+         , std::size_t NodesPerBlock
+         , std::size_t MaxFreeBlocks
+         , unsigned char OverheadPercent
+         >
+#endif
+class adaptive_pool
+   /// @cond
+   :  public container_detail::pool_allocation_impl
+         < adaptive_pool<T, NodesPerBlock, MaxFreeBlocks, OverheadPercent>, T >
+   /// @endcond
+{
+   /// @cond
+   BOOST_STATIC_ASSERT((NodesPerBlock > 0));
+   typedef container_detail::pool_allocation_impl
+      < adaptive_pool<T, NodesPerBlock, MaxFreeBlocks, OverheadPercent>, T >   base_t;
+   friend class container_detail::pool_allocation_impl
+      < adaptive_pool<T, NodesPerBlock, MaxFreeBlocks, OverheadPercent>, T >;
+   typedef container_detail::shared_adaptive_node_pool
+      < container_detail::sizeof_value<T>::value, NodesPerBlock
+      , MaxFreeBlocks, OverheadPercent>         node_pool_t;
+
+   node_pool_t &get_node_pool() const
+   {  return node_pool_t::instance();  }
+   /// @endcond
+
+   public:
+   typedef typename base_t::value_type          value_type;
+   typedef typename base_t::pointer             pointer;
+   typedef typename base_t::const_pointer       const_pointer;
+   typedef typename base_t::reference           reference;
+   typedef typename base_t::const_reference     const_reference;
+   typedef typename base_t::size_type           size_type;
+   typedef typename base_t::difference_type     difference_type;
+   typedef typename base_t::multiallocation_chain  multiallocation_chain;
+   typedef container_detail::version_type<adaptive_pool, 2>   version;
+
+   //!Obtains adaptive_pool from
+   //!adaptive_pool
+   template<class T2>
+   struct rebind
+   {
+      typedef adaptive_pool<T2, NodesPerBlock, MaxFreeBlocks, OverheadPercent> other;
+   };
+
+   //!Default constructor. Never throws
+   adaptive_pool()
+   {}
+
+   //!Copy constructor from other adaptive_pool.
+   //!Never throws
+   adaptive_pool(const adaptive_pool &)
+   {}
+
+   //!Copy constructor from related adaptive_pool.
+   //!Never throws
+   template<class T2>
+   adaptive_pool(const adaptive_pool<T2, NodesPerBlock, MaxFreeBlocks, OverheadPercent> &)
+   {}
+
+   //!All adaptive_pools of the same type share the pool,
+   //!so they always compare equal
+   friend bool operator==(const adaptive_pool &, const adaptive_pool &)
+   {  return true;   }
+
+   //!All adaptive_pools of the same type share the pool,
+   //!so they always compare equal
+   friend bool operator!=(const adaptive_pool &, const adaptive_pool &)
+   {  return false;   }
+};
+
+}  //namespace container {
+}  //namespace boost {
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_CONTAINER_ADAPTIVE_POOL_HPP
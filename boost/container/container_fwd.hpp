@@ -32,6 +32,7 @@ namespace bi = boost::intrusive;
 
 }}}
 
+#include <cstddef>
 #include <utility>
 #include <memory>
 #include <functional>
@@ -57,6 +58,17 @@ template <class T
          ,class Allocator = std::allocator<T> >
 class stable_vector;
 
+//small_vector class
+template <class T
+         ,std::size_t N
+         ,class Allocator = std::allocator<T> >
+class small_vector;
+
+//static_vector class
+template <class T
+         ,std::size_t N>
+class static_vector;
+
 //vector class
 template <class T
          ,class Allocator = std::allocator<T> >
@@ -124,12 +136,65 @@ template <class Key
          ,class Allocator = std::allocator<std::pair<Key, T> > >
 class flat_multimap;
 
+//btree_set class
+template <class Key
+         ,class Compare  = std::less<Key>
+         ,class Allocator = std::allocator<Key>
+         ,std::size_t NodeSize = 256>
+class btree_set;
+
+//btree_multiset class
+template <class Key
+         ,class Compare  = std::less<Key>
+         ,class Allocator = std::allocator<Key>
+         ,std::size_t NodeSize = 256>
+class btree_multiset;
+
+//btree_map class
+template <class Key
+         ,class T
+         ,class Compare  = std::less<Key>
+         ,class Allocator = std::allocator<std::pair<const Key, T> >
+         ,std::size_t NodeSize = 256>
+class btree_map;
+
+//btree_multimap class
+template <class Key
+         ,class T
+         ,class Compare  = std::less<Key>
+         ,class Allocator = std::allocator<std::pair<const Key, T> >
+         ,std::size_t NodeSize = 256>
+class btree_multimap;
+
 //basic_string class
 template <class CharT
          ,class Traits = std::char_traits<CharT>
          ,class Allocator  = std::allocator<CharT> >
 class basic_string;
 
+//////////////////////////////////////////////////////////////////////////////
+//                             Allocators
+//////////////////////////////////////////////////////////////////////////////
+
+//node_allocator class
+template <class T
+         ,std::size_t NodesPerBlock = 256>
+class node_allocator;
+
+//adaptive_pool class
+template <class T
+         ,std::size_t NodesPerBlock = 256
+         ,std::size_t MaxFreeBlocks = 2
+         ,unsigned char OverheadPercent = 5>
+class adaptive_pool;
+
+//private_adaptive_pool class
+template <class T
+         ,std::size_t NodesPerBlock = 256
+         ,std::size_t MaxFreeBlocks = 2
+         ,unsigned char OverheadPercent = 5>
+class private_adaptive_pool;
+
 //! Type used to tag that the input range is
 //! guaranteed to be ordered
 struct ordered_range_t
@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_DETAIL_ADAPTIVE_NODE_POOL_HPP
+#define BOOST_CONTAINER_DETAIL_ADAPTIVE_NODE_POOL_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include "config_begin.hpp"
+#include <boost/container/detail/workaround.hpp>
+#include <boost/container/detail/adaptive_node_pool_impl.hpp>
+#include <boost/container/detail/heap_segment_manager.hpp>
+#include <boost/container/detail/node_pool.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace container {
+namespace container_detail {
+
+//!An adaptive pool placed in the heap. Unlike node pools, adaptive pools
+//!return blocks to the heap when all their nodes are free and more than
+//!MaxFreeBlocks blocks are free.
+template< std::size_t NodeSize
+        , std::size_t NodesPerBlock
+        , std::size_t MaxFreeBlocks
+        , unsigned char OverheadPercent
+        >
+class private_adaptive_node_pool
+   :  public private_adaptive_node_pool_impl<heap_segment_manager>
+{
+   typedef private_adaptive_node_pool_impl<heap_segment_manager> base_t;
+   //Non-copyable
+   private_adaptive_node_pool(const private_adaptive_node_pool &);
+   private_adaptive_node_pool &operator=(const private_adaptive_node_pool &);
+
+   public:
+   typedef typename base_t::size_type  size_type;
+
+   static const size_type nodes_per_block = NodesPerBlock;
+
+   private_adaptive_node_pool()
+      :  base_t(heap_segment_manager::get(), NodeSize, NodesPerBlock, MaxFreeBlocks, OverheadPercent)
+   {}
+};
+
+//!The adaptive pool shared by all adaptive_pools with the same parameters
+template< std::size_t NodeSize
+        , std::size_t NodesPerBlock
+        , std::size_t MaxFreeBlocks
+        , unsigned char OverheadPercent
+        >
+class shared_adaptive_node_pool
+   :  public shared_pool_impl
+      < private_adaptive_node_pool
+         <NodeSize, NodesPerBlock, MaxFreeBlocks, OverheadPercent>
+      >
+{
+   public:
+   static shared_adaptive_node_pool &instance()
+   {  return pool_singleton<shared_adaptive_node_pool>::instance();  }
+};
+
+}  //namespace container_detail {
+}  //namespace container {
+}  //namespace boost {
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_CONTAINER_DETAIL_ADAPTIVE_NODE_POOL_HPP
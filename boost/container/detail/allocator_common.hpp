@@ -0,0 +1,173 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_DETAIL_ALLOCATOR_COMMON_HPP
+#define BOOST_CONTAINER_DETAIL_ALLOCATOR_COMMON_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include "config_begin.hpp"
+#include <boost/container/detail/workaround.hpp>
+#include <boost/container/detail/allocation_type.hpp>
+#include <boost/container/detail/multiallocation_chain.hpp>
+#include <boost/container/detail/heap_segment_manager.hpp>
+#include <boost/container/detail/type_traits.hpp>
+#include <boost/move/move.hpp>
+#include <cstddef>
+#include <utility>
+#include <new>
+
+namespace boost {
+namespace container {
+namespace container_detail {
+
+template<class T>
+struct sizeof_value
+{
+   static const std::size_t value = sizeof(T);
+};
+
+template <>
+struct sizeof_value<void>
+{
+   static const std::size_t value = sizeof(void*);
+};
+
+template <>
+struct sizeof_value<const void>
+{
+   static const std::size_t value = sizeof(void*);
+};
+
+template <>
+struct sizeof_value<volatile void>
+{
+   static const std::size_t value = sizeof(void*);
+};
+
+template <>
+struct sizeof_value<const volatile void>
+{
+   static const std::size_t value = sizeof(void*);
+};
+
+//!Implements the allocation functions of the pool allocators. Derived must
+//!define get_node_pool(), returning a pool that offers allocate_node,
+//!deallocate_node, allocate_nodes, deallocate_nodes and deallocate_free_blocks.
+//!Nodes are only obtained from the pool with the version 2 functions
+//!(allocate_one, allocate_individual...), arrays come from the heap.
+template<class Derived, class T>
+class pool_allocation_impl
+{
+   Derived *derived()
+   {  return static_cast<Derived*>(this); }
+
+   public:
+   typedef T                                    value_type;
+   typedef T *                                  pointer;
+   typedef const T *                            const_pointer;
+   typedef typename add_reference
+                     <value_type>::type         reference;
+   typedef typename add_reference
+                     <const value_type>::type   const_reference;
+   typedef std::size_t                          size_type;
+   typedef std::ptrdiff_t                       difference_type;
+   typedef transform_multiallocation_chain
+      <heap_segment_manager::multiallocation_chain, T> multiallocation_chain;
+
+   //!Returns the number of elements that could be allocated.
+   //!Never throws
+   size_type max_size() const
+   {  return size_type(-1)/sizeof_value<T>::value;   }
+
+   //!Allocate memory for an array of count elements.
+   //!Throws std::bad_alloc if there is no enough memory
+   pointer allocate(size_type count, const void * = 0)
+   {
+      if(count > this->max_size()){
+         throw std::bad_alloc();
+      }
+      return static_cast<pointer>(heap_segment_manager::get()->allocate(count*sizeof_value<T>::value));
+   }
+
+   //!Deallocate allocated memory.
+   //!Never throws
+   void deallocate(const pointer &ptr, size_type)
+   {  heap_segment_manager::get()->deallocate(ptr);  }
+
+   //!Allocates memory for an array of preferred_size elements. Only allocate_new
+   //!is supported, as the heap can't expand or shrink memory in place.
+   std::pair<pointer, bool>
+      allocation_command(allocation_type command,
+                         size_type limit_size,
+                         size_type preferred_size,
+                         size_type &received_size,
+                         const pointer & = pointer())
+   {
+      (void)limit_size;
+      if(!(command & allocate_new)){
+         if(command & nothrow_allocation){
+            return std::pair<pointer, bool>(pointer(), false);
+         }
+         throw std::bad_alloc();
+      }
+      received_size = preferred_size;
+      if(command & nothrow_allocation){
+         pointer ret = 0;
+         try{
+            ret = this->allocate(preferred_size);
+         }
+         catch(...){}
+         return std::pair<pointer, bool>(ret, false);
+      }
+      return std::pair<pointer, bool>(this->allocate(preferred_size), false);
+   }
+
+   //!Allocates just one object from the pool. Memory allocated with this function
+   //!must be deallocated only with deallocate_one().
+   //!Throws std::bad_alloc if there is no enough memory
+   pointer allocate_one()
+   {  return static_cast<pointer>(this->derived()->get_node_pool().allocate_node());  }
+
+   //!Allocates num_elements objects from the pool at once.
+   //!Memory allocated with this function must be deallocated only
+   //!with deallocate_one() or deallocate_individual().
+   //!Throws std::bad_alloc if there is no enough memory
+   multiallocation_chain allocate_individual(size_type num_elements)
+   {  return multiallocation_chain(this->derived()->get_node_pool().allocate_nodes(num_elements));  }
+
+   //!Deallocates memory previously allocated with allocate_one().
+   //!Never throws
+   void deallocate_one(const pointer &p)
+   {  this->derived()->get_node_pool().deallocate_node(p);  }
+
+   //!Deallocates a chain of objects allocated with allocate_one()
+   //!or allocate_individual(). Never throws
+   void deallocate_individual(multiallocation_chain chain)
+   {
+      if(!chain.empty()){
+         this->derived()->get_node_pool().deallocate_nodes(chain.extract_multiallocation_chain());
+      }
+   }
+
+   //!Returns the free blocks of the pool to the heap.
+   void deallocate_free_blocks()
+   {  this->derived()->get_node_pool().deallocate_free_blocks();  }
+};
+
+}  //namespace container_detail {
+}  //namespace container {
+}  //namespace boost {
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_CONTAINER_DETAIL_ALLOCATOR_COMMON_HPP
@@ -0,0 +1,1561 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_BTREE_HPP
+#define BOOST_CONTAINER_BTREE_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include "config_begin.hpp"
+#include <boost/container/detail/workaround.hpp>
+#include <boost/container/container_fwd.hpp>
+
+#include <boost/move/move.hpp>
+#include <boost/intrusive/pointer_traits.hpp>
+#include <boost/detail/no_exceptions_support.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/container/detail/utilities.hpp>
+#include <boost/container/detail/mpl.hpp>
+#include <boost/container/detail/pair.hpp>
+#include <boost/container/detail/type_traits.hpp>
+#include <boost/container/allocator_traits.hpp>
+#include <boost/container/detail/preprocessor.hpp>
+#include <utility>   //std::pair
+#include <iterator>
+#include <algorithm>
+#include <new>
+
+namespace boost {
+namespace container {
+namespace container_detail {
+
+//Values are stored in nodes as btree_internal_data_type<Value>::type so that the
+//keys of std::pair<const Key, T> values can be moved when nodes are reorganized
+template<class T>
+struct btree_internal_data_type
+{
+   typedef T type;
+};
+
+template<class T1, class T2>
+struct btree_internal_data_type< std::pair<const T1, T2> >
+{
+   typedef pair<T1, T2> type;
+};
+
+//Number of values stored in each node: as many as fit in NodeSize bytes,
+//but at least 3 values, so that nodes can always be split and merged
+template<class T, std::size_t NodeSize>
+struct btree_node_slots
+{
+   static const std::size_t fit   = NodeSize/sizeof(T);
+   static const std::size_t value = fit < 3u ? 3u : (fit > 0xFFFEu ? 0xFFFEu : fit);
+};
+
+template<class T, class VoidPointer, std::size_t NodeSize>
+struct btree_internal_node;
+
+//A leaf node. Internal nodes derive from it and add the children array.
+template<class T, class VoidPointer, std::size_t NodeSize>
+struct btree_node
+{
+   static const std::size_t slots = btree_node_slots<T, NodeSize>::value;
+   typedef btree_internal_node<T, VoidPointer, NodeSize>                internal_node_t;
+   typedef typename boost::intrusive::pointer_traits<VoidPointer>::template
+      rebind_pointer<btree_node>::type                                   node_ptr;
+   typedef boost::intrusive::pointer_traits<node_ptr>                    node_ptr_traits;
+   typedef T                                                             internal_type;
+
+   btree_node()
+      : m_parent(), m_position(0), m_count(0), m_leaf(true)
+   {}
+
+   //The parent node, null for the root
+   node_ptr       m_parent;
+   //Index of this node in the children of the parent
+   unsigned short m_position;
+   //Number of constructed values
+   unsigned short m_count;
+   bool           m_leaf;
+   boost::aligned_storage<sizeof(T)*slots, alignment_of<T>::value> m_values;
+
+   T *values()
+   {  return static_cast<T*>(m_values.address());  }
+
+   const T *values() const
+   {  return static_cast<const T*>(m_values.address());  }
+
+   btree_node *parent() const
+   {  return container_detail::to_raw_pointer(m_parent);  }
+
+   btree_node *child(std::size_t i) const
+   {  return container_detail::to_raw_pointer(static_cast<const internal_node_t*>(this)->m_children[i]);  }
+
+   void set_child(std::size_t i, btree_node *c)
+   {
+      static_cast<internal_node_t*>(this)->m_children[i] = node_ptr_traits::pointer_to(*c);
+      c->m_parent   = node_ptr_traits::pointer_to(*this);
+      c->m_position = static_cast<unsigned short>(i);
+   }
+
+   //Advances (n, pos) to the next value. The last value of the
+   //tree is advanced to the end position of the rightmost leaf.
+   static void increment(btree_node *&n, std::size_t &pos)
+   {
+      if(n->m_leaf){
+         if(++pos != n->m_count){
+            return;
+         }
+         btree_node *const last_n = n;
+         while(pos == n->m_count && n->parent()){
+            pos = n->m_position;
+            n   = n->parent();
+         }
+         if(pos == n->m_count){
+            n   = last_n;
+            pos = last_n->m_count;
+         }
+      }
+      else{
+         n = n->child(pos + 1);
+         while(!n->m_leaf){
+            n = n->child(0);
+         }
+         pos = 0;
+      }
+   }
+
+   //Moves (n, pos) to the previous value
+   static void decrement(btree_node *&n, std::size_t &pos)
+   {
+      if(n->m_leaf){
+         if(pos){
+            --pos;
+            return;
+         }
+         do{
+            pos = n->m_position;
+            n   = n->parent();
+         } while(!pos);
+         --pos;
+      }
+      else{
+         n = n->child(pos);
+         while(!n->m_leaf){
+            n = n->child(n->m_count);
+         }
+         pos = n->m_count - 1u;
+      }
+   }
+};
+
+template<class T, class VoidPointer, std::size_t NodeSize>
+struct btree_internal_node
+   : public btree_node<T, VoidPointer, NodeSize>
+{
+   typedef btree_node<T, VoidPointer, NodeSize>   base_t;
+   typedef typename base_t::node_ptr              node_ptr;
+
+   btree_internal_node()
+   {
+      this->m_leaf = false;
+      for(std::size_t i = 0; i != base_t::slots + 1u; ++i){
+         m_children[i] = node_ptr();
+      }
+   }
+
+   node_ptr m_children[base_t::slots + 1u];
+};
+
+template<class Pointer, class Node>
+class btree_const_iterator
+{
+   public:
+   typedef std::bidirectional_iterator_tag                                          iterator_category;
+   typedef typename boost::intrusive::pointer_traits<Pointer>::element_type         value_type;
+   typedef typename boost::intrusive::pointer_traits<Pointer>::difference_type      difference_type;
+   typedef typename boost::intrusive::pointer_traits<Pointer>::template
+                                 rebind_pointer<const value_type>::type             pointer;
+   typedef  const value_type&                                                       reference;
+
+   /// @cond
+   protected:
+   Node        *m_node;
+   std::size_t  m_pos;
+
+   public:
+   Node *get_node() const        {  return m_node;  }
+   std::size_t get_pos() const   {  return m_pos;  }
+   btree_const_iterator(Node *n, std::size_t pos)  : m_node(n), m_pos(pos){}
+   /// @endcond
+
+   public:
+
+   //Constructors
+   btree_const_iterator() : m_node(0), m_pos(0){}
+
+   //Pointer like operators
+   reference operator*()   const
+   {  return *reinterpret_cast<const value_type*>(m_node->values() + m_pos);  }
+
+   pointer operator->()  const
+   {  return boost::intrusive::pointer_traits<pointer>::pointer_to(**this);  }
+
+   //Increment / Decrement
+   btree_const_iterator& operator++()
+   {  Node::increment(m_node, m_pos);  return *this; }
+
+   btree_const_iterator operator++(int)
+   {  btree_const_iterator tmp(*this); ++*this; return tmp;  }
+
+   btree_const_iterator& operator--()
+   {  Node::decrement(m_node, m_pos);  return *this;  }
+
+   btree_const_iterator operator--(int)
+   {  btree_const_iterator tmp(*this); --*this; return tmp; }
+
+   //Comparison operators
+   bool operator==   (const btree_const_iterator& r)  const
+   {  return m_node == r.m_node && m_pos == r.m_pos;  }
+
+   bool operator!=   (const btree_const_iterator& r)  const
+   {  return !(*this == r);  }
+};
+
+template<class Pointer, class Node>
+class btree_iterator
+   :  public btree_const_iterator<Pointer, Node>
+{
+   public:
+   typedef std::bidirectional_iterator_tag                                          iterator_category;
+   typedef typename boost::intrusive::pointer_traits<Pointer>::element_type         value_type;
+   typedef typename boost::intrusive::pointer_traits<Pointer>::difference_type      difference_type;
+   typedef Pointer                                                                  pointer;
+   typedef value_type&                                                              reference;
+
+   /// @cond
+   btree_iterator(Node *n, std::size_t pos)
+      : btree_const_iterator<Pointer, Node>(n, pos)
+   {}
+   /// @endcond
+
+   //Constructors
+   btree_iterator()
+   {}
+
+   //Pointer like operators
+   reference operator*()  const
+   {  return *reinterpret_cast<value_type*>(this->m_node->values() + this->m_pos);  }
+
+   pointer operator->() const
+   {  return boost::intrusive::pointer_traits<pointer>::pointer_to(**this);  }
+
+   //Increment / Decrement
+   btree_iterator& operator++()
+   {  Node::increment(this->m_node, this->m_pos); return *this;  }
+
+   btree_iterator operator++(int)
+   {  btree_iterator tmp(*this); ++*this; return tmp;  }
+
+   btree_iterator& operator--()
+   {  Node::decrement(this->m_node, this->m_pos); return *this;  }
+
+   btree_iterator operator--(int)
+   {  btree_iterator tmp(*this); --*this; return tmp;  }
+};
+
+template<class Compare, class Value, class KeyOfValue>
+class btree_value_compare
+   : private Compare
+{
+   typedef Value              first_argument_type;
+   typedef Value              second_argument_type;
+   typedef bool               return_type;
+   public:
+   btree_value_compare()
+      : Compare()
+   {}
+
+   btree_value_compare(const Compare &pred)
+      : Compare(pred)
+   {}
+
+   template<class V1, class V2>
+   bool operator()(const V1& lhs, const V2& rhs) const
+   {
+      KeyOfValue key_extract;
+      return Compare::operator()(key_extract(lhs), key_extract(rhs));
+   }
+
+   const Compare &get_comp() const
+      {  return *this;  }
+
+   Compare &get_comp()
+      {  return *this;  }
+};
+
+//A B-tree storing up to btree_node_slots<Value, NodeSize>::value values in each
+//node. Nodes are obtained from allocators rebound from A. Unlike node based trees,
+//insertions and erasures move values between nodes, so they invalidate iterators.
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A, std::size_t NodeSize>
+class btree
+{
+   /// @cond
+   typedef boost::container::allocator_traits<A>                              allocator_traits_type;
+   typedef typename btree_internal_data_type<Value>::type                     internal_type;
+   typedef typename allocator_traits_type::void_pointer                       void_pointer;
+   //Node types are only instantiated in member functions, so that the
+   //values can be incomplete types when the tree is declared
+   typedef btree_node<internal_type, void_pointer, NodeSize>                  node_t;
+   typedef btree_internal_node<internal_type, void_pointer, NodeSize>         internal_node_t;
+   typedef typename boost::intrusive::pointer_traits<void_pointer>::template
+      rebind_pointer<node_t>::type                                            node_ptr;
+   typedef boost::intrusive::pointer_traits<node_ptr>                         node_ptr_traits;
+   typedef typename allocator_traits_type::template
+      portable_rebind_alloc<node_t>::type                                     leaf_allocator_t;
+   typedef typename allocator_traits_type::template
+      portable_rebind_alloc<internal_node_t>::type                            internal_allocator_t;
+   typedef boost::container::allocator_traits<leaf_allocator_t>               leaf_allocator_traits;
+   typedef boost::container::allocator_traits<internal_allocator_t>           internal_allocator_traits;
+
+   BOOST_COPYABLE_AND_MOVABLE(btree)
+   /// @endcond
+
+   public:
+   typedef Key                                                                key_type;
+   typedef Value                                                              value_type;
+   typedef A                                                                  allocator_type;
+   typedef KeyCompare                                                         key_compare;
+   typedef btree_value_compare<KeyCompare, Value, KeyOfValue>                 value_compare;
+   typedef typename allocator_traits_type::pointer                            pointer;
+   typedef typename allocator_traits_type::const_pointer                      const_pointer;
+   typedef typename allocator_traits_type::reference                          reference;
+   typedef typename allocator_traits_type::const_reference                    const_reference;
+   typedef typename allocator_traits_type::size_type                          size_type;
+   typedef typename allocator_traits_type::difference_type                    difference_type;
+   typedef A                                                                  stored_allocator_type;
+   typedef btree_iterator<pointer, node_t>                                    iterator;
+   typedef btree_const_iterator<pointer, node_t>                              const_iterator;
+   typedef std::reverse_iterator<iterator>                                    reverse_iterator;
+   typedef std::reverse_iterator<const_iterator>                              const_reverse_iterator;
+
+   /// @cond
+   private:
+   struct Data
+      //Inherit from the allocator and value_compare to do EBO
+      : public A, public value_compare
+   {
+      explicit Data(const key_compare &comp)
+         : A(), value_compare(comp), m_root(), m_leftmost(), m_rightmost(), m_size(0)
+      {}
+
+      Data(const key_compare &comp, const A &a)
+         : A(a), value_compare(comp), m_root(), m_leftmost(), m_rightmost(), m_size(0)
+      {}
+
+      Data(const key_compare &comp, BOOST_RV_REF(A) a)
+         : A(boost::move(a)), value_compare(comp), m_root(), m_leftmost(), m_rightmost(), m_size(0)
+      {}
+
+      node_ptr  m_root;
+      node_ptr  m_leftmost;
+      node_ptr  m_rightmost;
+      size_type m_size;
+   } m_data;
+
+   //Destroys a value constructed in a local buffer
+   class internal_value_destructor
+   {
+      public:
+      internal_value_destructor(A &a, internal_type &v)
+         : m_a(a), m_v(v)
+      {}
+
+      ~internal_value_destructor()
+      {  allocator_traits_type::destroy(m_a, &m_v);  }
+
+      private:
+      A &m_a;
+      internal_type &m_v;
+   };
+   /// @endcond
+
+   public:
+   btree()
+      : m_data(key_compare())
+   {}
+
+   explicit btree(const key_compare& comp, const allocator_type& a = allocator_type())
+      : m_data(comp, a)
+   {}
+
+   template <class InputIterator>
+   btree(bool unique_insertion, InputIterator first, InputIterator last, const key_compare& comp,
+          const allocator_type& a)
+      : m_data(comp, a)
+   {
+      if(unique_insertion){
+         this->insert_unique(first, last);
+      }
+      else{
+         this->insert_equal(first, last);
+      }
+   }
+
+   //Bulk load: values are appended to the rightmost leaf, so all the
+   //nodes but the rightmost ones are completely filled.
+   template <class InputIterator>
+   btree( ordered_range_t, InputIterator first, InputIterator last
+        , const key_compare& comp = key_compare(), const allocator_type& a = allocator_type())
+      : m_data(comp, a)
+   {
+      BOOST_TRY{
+         for( ; first != last; ++first){
+            this->priv_push_back(*first);
+         }
+      }
+      BOOST_CATCH(...){
+         this->clear();
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+   }
+
+   btree(const btree& x)
+      : m_data( x.key_comp()
+              , allocator_traits_type::select_on_container_copy_construction(x.priv_alloc()))
+   {
+      this->priv_clone_from(x);
+   }
+
+   btree(BOOST_RV_REF(btree) x)
+      : m_data(x.key_comp(), boost::move(x.priv_alloc()))
+   {
+      this->priv_steal(x);
+   }
+
+   btree(const btree& x, const allocator_type &a)
+      : m_data(x.key_comp(), a)
+   {
+      this->priv_clone_from(x);
+   }
+
+   btree(BOOST_RV_REF(btree) x, const allocator_type &a)
+      : m_data(x.key_comp(), a)
+   {
+      if(this->priv_alloc() == x.priv_alloc()){
+         this->priv_steal(x);
+      }
+      else{
+         this->priv_move_elements(x);
+      }
+   }
+
+   ~btree()
+   {  this->clear();  }
+
+   btree& operator=(BOOST_COPY_ASSIGN_REF(btree) x)
+   {
+      if (&x != this){
+         this->clear();
+         container_detail::bool_<allocator_traits_type::
+            propagate_on_container_copy_assignment::value> flag;
+         container_detail::assign_alloc(this->priv_alloc(), x.priv_alloc(), flag);
+         this->priv_value_comp() = x.priv_value_comp();
+         this->priv_clone_from(x);
+      }
+      return *this;
+   }
+
+   btree& operator=(BOOST_RV_REF(btree) x)
+   {
+      if (&x != this){
+         this->clear();
+         this->priv_value_comp() = x.priv_value_comp();
+         container_detail::bool_<allocator_traits_type::
+            propagate_on_container_move_assignment::value> flag;
+         //If allocators are equal or propagated we can just steal the nodes
+         if(flag || this->priv_alloc() == x.priv_alloc()){
+            container_detail::move_alloc(this->priv_alloc(), x.priv_alloc(), flag);
+            this->priv_steal(x);
+         }
+         //If unequal allocators, then do a one by one move
+         else{
+            this->priv_move_elements(x);
+         }
+      }
+      return *this;
+   }
+
+   public:
+   // accessors:
+   value_compare value_comp() const
+   {  return this->priv_value_comp(); }
+
+   key_compare key_comp() const
+   {  return this->priv_value_comp().get_comp(); }
+
+   allocator_type get_allocator() const
+   {  return this->priv_alloc(); }
+
+   const stored_allocator_type &get_stored_allocator() const
+   {  return this->priv_alloc(); }
+
+   stored_allocator_type &get_stored_allocator()
+   {  return this->priv_alloc(); }
+
+   iterator begin()
+   {  return iterator(this->priv_leftmost(), 0);  }
+
+   const_iterator begin() const
+   {  return this->cbegin();  }
+
+   iterator end()
+   {
+      node_t *const n = this->priv_rightmost();
+      return iterator(n, n ? n->m_count : 0u);
+   }
+
+   const_iterator end() const
+   {  return this->cend();  }
+
+   reverse_iterator rbegin()
+   {  return reverse_iterator(end());  }
+
+   const_reverse_iterator rbegin() const
+   {  return this->crbegin();  }
+
+   reverse_iterator rend()
+   {  return reverse_iterator(begin());   }
+
+   const_reverse_iterator rend() const
+   {  return this->crend();   }
+
+   const_iterator cbegin() const
+   {  return const_iterator(this->priv_leftmost(), 0);  }
+
+   const_iterator cend() const
+   {
+      node_t *const n = this->priv_rightmost();
+      return const_iterator(n, n ? n->m_count : 0u);
+   }
+
+   const_reverse_iterator crbegin() const
+   {  return const_reverse_iterator(cend());  }
+
+   const_reverse_iterator crend() const
+   {  return const_reverse_iterator(cbegin());  }
+
+   bool empty() const
+   {  return !m_data.m_size;  }
+
+   size_type size() const
+   {  return m_data.m_size;  }
+
+   size_type max_size() const
+   {  return allocator_traits_type::max_size(this->priv_alloc());  }
+
+   void swap(btree& x)
+   {
+      container_detail::bool_<allocator_traits_type::
+         propagate_on_container_swap::value> flag;
+      container_detail::swap_alloc(this->priv_alloc(), x.priv_alloc(), flag);
+      container_detail::do_swap(this->priv_value_comp(), x.priv_value_comp());
+      container_detail::do_swap(m_data.m_root,      x.m_data.m_root);
+      container_detail::do_swap(m_data.m_leftmost,  x.m_data.m_leftmost);
+      container_detail::do_swap(m_data.m_rightmost, x.m_data.m_rightmost);
+      container_detail::do_swap(m_data.m_size,      x.m_data.m_size);
+   }
+
+   public:
+   // insert/erase
+   std::pair<iterator,bool> insert_unique(const value_type& v)
+   {  return this->priv_insert_unique(KeyOfValue()(v), v);  }
+
+   template<class MovableConvertible>
+   std::pair<iterator,bool> insert_unique(BOOST_FWD_REF(MovableConvertible) mv)
+   {  return this->priv_insert_unique(KeyOfValue()(mv), boost::forward<MovableConvertible>(mv));  }
+
+   iterator insert_unique(const_iterator hint, const value_type& v)
+   {  return this->priv_insert_unique(hint, KeyOfValue()(v), v);  }
+
+   template<class MovableConvertible>
+   iterator insert_unique(const_iterator hint, BOOST_FWD_REF(MovableConvertible) mv)
+   {  return this->priv_insert_unique(hint, KeyOfValue()(mv), boost::forward<MovableConvertible>(mv));  }
+
+   template <class InputIterator>
+   void insert_unique(InputIterator first, InputIterator last)
+   {
+      //Use the end as hint, to achieve linear
+      //complexity if [first, last) is ordered
+      for( ; first != last; ++first){
+         this->insert_unique(this->cend(), *first);
+      }
+   }
+
+   iterator insert_equal(const value_type& v)
+   {  return this->priv_insert_equal(KeyOfValue()(v), v);  }
+
+   template<class MovableConvertible>
+   iterator insert_equal(BOOST_FWD_REF(MovableConvertible) mv)
+   {  return this->priv_insert_equal(KeyOfValue()(mv), boost::forward<MovableConvertible>(mv));  }
+
+   iterator insert_equal(const_iterator hint, const value_type& v)
+   {  return this->priv_insert_equal(hint, KeyOfValue()(v), v);  }
+
+   template<class MovableConvertible>
+   iterator insert_equal(const_iterator hint, BOOST_FWD_REF(MovableConvertible) mv)
+   {  return this->priv_insert_equal(hint, KeyOfValue()(mv), boost::forward<MovableConvertible>(mv));  }
+
+   template <class InputIterator>
+   void insert_equal(InputIterator first, InputIterator last)
+   {
+      for( ; first != last; ++first){
+         this->insert_equal(this->cend(), *first);
+      }
+   }
+
+   #ifdef BOOST_CONTAINER_PERFECT_FORWARDING
+
+   template <class... Args>
+   std::pair<iterator, bool> emplace_unique(Args&&... args)
+   {
+      aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;
+      internal_type &val = *static_cast<internal_type *>(static_cast<void *>(&v));
+      allocator_traits_type::construct(this->priv_alloc(), &val, ::boost::forward<Args>(args)... );
+      internal_value_destructor d(this->priv_alloc(), val);
+      return this->priv_insert_unique(KeyOfValue()(val), ::boost::move(val));
+   }
+
+   template <class... Args>
+   iterator emplace_hint_unique(const_iterator hint, Args&&... args)
+   {
+      aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;
+      internal_type &val = *static_cast<internal_type *>(static_cast<void *>(&v));
+      allocator_traits_type::construct(this->priv_alloc(), &val, ::boost::forward<Args>(args)... );
+      internal_value_destructor d(this->priv_alloc(), val);
+      return this->priv_insert_unique(hint, KeyOfValue()(val), ::boost::move(val));
+   }
+
+   template <class... Args>
+   iterator emplace_equal(Args&&... args)
+   {
+      aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;
+      internal_type &val = *static_cast<internal_type *>(static_cast<void *>(&v));
+      allocator_traits_type::construct(this->priv_alloc(), &val, ::boost::forward<Args>(args)... );
+      internal_value_destructor d(this->priv_alloc(), val);
+      return this->priv_insert_equal(KeyOfValue()(val), ::boost::move(val));
+   }
+
+   template <class... Args>
+   iterator emplace_hint_equal(const_iterator hint, Args&&... args)
+   {
+      aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;
+      internal_type &val = *static_cast<internal_type *>(static_cast<void *>(&v));
+      allocator_traits_type::construct(this->priv_alloc(), &val, ::boost::forward<Args>(args)... );
+      internal_value_destructor d(this->priv_alloc(), val);
+      return this->priv_insert_equal(hint, KeyOfValue()(val), ::boost::move(val));
+   }
+
+   #else //#ifdef BOOST_CONTAINER_PERFECT_FORWARDING
+
+   #define BOOST_PP_LOCAL_MACRO(n)                                                                          \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >)                   \
+   std::pair<iterator, bool> emplace_unique(BOOST_PP_ENUM(n, BOOST_CONTAINER_PP_PARAM_LIST, _))             \
+   {                                                                                                        \
+      aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;                         \
+      internal_type &val = *static_cast<internal_type *>(static_cast<void *>(&v));                          \
+      allocator_traits_type::construct(this->priv_alloc(), &val                                             \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                                  \
+      internal_value_destructor d(this->priv_alloc(), val);                                                 \
+      return this->priv_insert_unique(KeyOfValue()(val), ::boost::move(val));                               \
+   }                                                                                                        \
+                                                                                                            \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >)                   \
+   iterator emplace_hint_unique(const_iterator hint                                                         \
+                       BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_LIST, _))                         \
+   {                                                                                                        \
+      aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;                         \
+      internal_type &val = *static_cast<internal_type *>(static_cast<void *>(&v));                          \
+      allocator_traits_type::construct(this->priv_alloc(), &val                                             \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                                  \
+      internal_value_destructor d(this->priv_alloc(), val);                                                 \
+      return this->priv_insert_unique(hint, KeyOfValue()(val), ::boost::move(val));                         \
+   }                                                                                                        \
+                                                                                                            \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >)                   \
+   iterator emplace_equal(BOOST_PP_ENUM(n, BOOST_CONTAINER_PP_PARAM_LIST, _))                               \
+   {                                                                                                        \
+      aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;                         \
+      internal_type &val = *static_cast<internal_type *>(static_cast<void *>(&v));                          \
+      allocator_traits_type::construct(this->priv_alloc(), &val                                             \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                                  \
+      internal_value_destructor d(this->priv_alloc(), val);                                                 \
+      return this->priv_insert_equal(KeyOfValue()(val), ::boost::move(val));                               \
+   }                                                                                                        \
+                                                                                                            \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >)                   \
+   iterator emplace_hint_equal(const_iterator hint                                                          \
+                       BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_LIST, _))                         \
+   {                                                                                                        \
+      aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> v;                         \
+      internal_type &val = *static_cast<internal_type *>(static_cast<void *>(&v));                          \
+      allocator_traits_type::construct(this->priv_alloc(), &val                                             \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                                  \
+      internal_value_destructor d(this->priv_alloc(), val);                                                 \
+      return this->priv_insert_equal(hint, KeyOfValue()(val), ::boost::move(val));                         \
+   }                                                                                                        \
+   //!
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_CONTAINER_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+
+   #endif   //#ifdef BOOST_CONTAINER_PERFECT_FORWARDING
+
+   iterator erase(const_iterator position)
+   {
+      node_t *n = position.get_node();
+      std::size_t pos = position.get_pos();
+      allocator_traits_type::destroy(this->priv_alloc(), n->values() + pos);
+      const bool internal_delete = !n->m_leaf;
+      if(internal_delete){
+         //Fill the slot with the predecessor, which is always stored in a leaf
+         node_t *const internal_n = n;
+         const std::size_t internal_pos = pos;
+         node_t::decrement(n, pos);
+         this->priv_transfer(internal_n->values() + internal_pos, n->values() + pos);
+      }
+      this->priv_close_hole(n, pos, n->m_count);
+      --n->m_count;
+      --m_data.m_size;
+      iterator ret(this->priv_rebalance_after_erase(n, pos));
+      //The successor of the erased value follows the predecessor
+      if(internal_delete){
+         ++ret;
+      }
+      return ret;
+   }
+
+   size_type erase(const key_type& k)
+   {
+      std::pair<iterator,iterator> ret(this->equal_range(k));
+      const size_type n = static_cast<size_type>(std::distance(ret.first, ret.second));
+      this->priv_erase_n(ret.first, n);
+      return n;
+   }
+
+   iterator erase(const_iterator first, const_iterator last)
+   {
+      if(first == this->cbegin() && last == this->cend()){
+         this->clear();
+         return this->end();
+      }
+      //Erasures invalidate "last", so count the values to erase
+      return this->priv_erase_n(first, static_cast<size_type>(std::distance(first, last)));
+   }
+
+   void clear()
+   {
+      if(node_t *const r = this->priv_root()){
+         this->priv_destroy_subtree(r);
+         m_data.m_root = m_data.m_leftmost = m_data.m_rightmost = node_ptr();
+         m_data.m_size = 0;
+      }
+   }
+
+   // set operations:
+   iterator find(const key_type& k)
+   {
+      const const_iterator i(this->lower_bound(k));
+      return i != this->cend() && !this->priv_comp()(k, this->priv_key(i))
+         ? this->priv_iterator(i) : this->end();
+   }
+
+   const_iterator find(const key_type& k) const
+   {  return const_cast<btree&>(*this).find(k);  }
+
+   size_type count(const key_type& k) const
+   {
+      std::pair<const_iterator, const_iterator> ret(this->equal_range(k));
+      return static_cast<size_type>(std::distance(ret.first, ret.second));
+   }
+
+   iterator lower_bound(const key_type& k)
+   {
+      node_t *n = this->priv_root();
+      node_t *res_n = 0;
+      std::size_t res_pos = 0;
+      while(n){
+         const std::size_t pos = this->priv_node_lower_bound(n, k);
+         if(pos != n->m_count){
+            res_n = n;
+            res_pos = pos;
+         }
+         if(n->m_leaf){
+            break;
+         }
+         n = n->child(pos);
+      }
+      return res_n ? iterator(res_n, res_pos) : this->end();
+   }
+
+   const_iterator lower_bound(const key_type& k) const
+   {  return const_cast<btree&>(*this).lower_bound(k);  }
+
+   iterator upper_bound(const key_type& k)
+   {
+      node_t *n = this->priv_root();
+      node_t *res_n = 0;
+      std::size_t res_pos = 0;
+      while(n){
+         const std::size_t pos = this->priv_node_upper_bound(n, k);
+         if(pos != n->m_count){
+            res_n = n;
+            res_pos = pos;
+         }
+         if(n->m_leaf){
+            break;
+         }
+         n = n->child(pos);
+      }
+      return res_n ? iterator(res_n, res_pos) : this->end();
+   }
+
+   const_iterator upper_bound(const key_type& k) const
+   {  return const_cast<btree&>(*this).upper_bound(k);  }
+
+   std::pair<iterator,iterator> equal_range(const key_type& k)
+   {  return std::pair<iterator,iterator>(this->lower_bound(k), this->upper_bound(k));  }
+
+   std::pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+   {  return std::pair<const_iterator,const_iterator>(this->lower_bound(k), this->upper_bound(k));  }
+
+   /// @cond
+   private:
+   A &priv_alloc()
+   {  return m_data;  }
+
+   const A &priv_alloc() const
+   {  return m_data;  }
+
+   value_compare &priv_value_comp()
+   {  return m_data;  }
+
+   const value_compare &priv_value_comp() const
+   {  return m_data;  }
+
+   const key_compare &priv_comp() const
+   {  return m_data.get_comp();  }
+
+   node_t *priv_root() const
+   {  return container_detail::to_raw_pointer(m_data.m_root);  }
+
+   node_t *priv_leftmost() const
+   {  return container_detail::to_raw_pointer(m_data.m_leftmost);  }
+
+   node_t *priv_rightmost() const
+   {  return container_detail::to_raw_pointer(m_data.m_rightmost);  }
+
+   static const key_type &priv_key(const internal_type &v)
+   {  return KeyOfValue()(v);  }
+
+   static const key_type &priv_key(const const_iterator &i)
+   {  return KeyOfValue()(i.get_node()->values()[i.get_pos()]);  }
+
+   static iterator priv_iterator(const const_iterator &i)
+   {  return iterator(i.get_node(), i.get_pos());  }
+
+   std::size_t priv_node_lower_bound(const node_t *n, const key_type &k) const
+   {
+      const internal_type *const v = n->values();
+      std::size_t first = 0, len = n->m_count;
+      while(len){
+         const std::size_t half = len >> 1u;
+         if(this->priv_comp()(priv_key(v[first + half]), k)){
+            first += half + 1u;
+            len   -= half + 1u;
+         }
+         else{
+            len = half;
+         }
+      }
+      return first;
+   }
+
+   std::size_t priv_node_upper_bound(const node_t *n, const key_type &k) const
+   {
+      const internal_type *const v = n->values();
+      std::size_t first = 0, len = n->m_count;
+      while(len){
+         const std::size_t half = len >> 1u;
+         if(!this->priv_comp()(k, priv_key(v[first + half]))){
+            first += half + 1u;
+            len   -= half + 1u;
+         }
+         else{
+            len = half;
+         }
+      }
+      return first;
+   }
+
+   template<class Convertible>
+   std::pair<iterator,bool> priv_insert_unique(const key_type &k, BOOST_FWD_REF(Convertible) v)
+   {
+      node_t *n = this->priv_root();
+      std::size_t pos = 0;
+      while(n){
+         pos = this->priv_node_lower_bound(n, k);
+         if(pos != n->m_count && !this->priv_comp()(k, priv_key(n->values()[pos]))){
+            return std::pair<iterator,bool>(iterator(n, pos), false);
+         }
+         if(n->m_leaf){
+            break;
+         }
+         n = n->child(pos);
+      }
+      return std::pair<iterator,bool>(this->priv_emplace_at(n, pos, boost::forward<Convertible>(v)), true);
+   }
+
+   template<class Convertible>
+   iterator priv_insert_unique(const_iterator hint, const key_type &k, BOOST_FWD_REF(Convertible) v)
+   {
+      //The hint is valid if k goes between the previous value and the hint
+      if(hint == this->cend() || this->priv_comp()(k, priv_key(hint))){
+         const_iterator prev(hint);
+         if(hint == this->cbegin() || this->priv_comp()(priv_key(--prev), k)){
+            return this->priv_emplace_before(hint, boost::forward<Convertible>(v));
+         }
+      }
+      return this->priv_insert_unique(k, boost::forward<Convertible>(v)).first;
+   }
+
+   //Inserts v after the values equivalent to k or, if "lower" is true, before them
+   template<class Convertible>
+   iterator priv_insert_equal(const key_type &k, BOOST_FWD_REF(Convertible) v, bool lower = false)
+   {
+      node_t *n = this->priv_root();
+      std::size_t pos = 0;
+      while(n){
+         pos = lower ? this->priv_node_lower_bound(n, k) : this->priv_node_upper_bound(n, k);
+         if(n->m_leaf){
+            break;
+         }
+         n = n->child(pos);
+      }
+      return this->priv_emplace_at(n, pos, boost::forward<Convertible>(v));
+   }
+
+   template<class Convertible>
+   iterator priv_insert_equal(const_iterator hint, const key_type &k, BOOST_FWD_REF(Convertible) v)
+   {
+      if(hint == this->cend() || !this->priv_comp()(priv_key(hint), k)){
+         const_iterator prev(hint);
+         if(hint == this->cbegin() || !this->priv_comp()(k, priv_key(--prev))){
+            return this->priv_emplace_before(hint, boost::forward<Convertible>(v));
+         }
+         return this->priv_insert_equal(k, boost::forward<Convertible>(v));
+      }
+      //The hint precedes k: insert as close as possible to it
+      return this->priv_insert_equal(k, boost::forward<Convertible>(v), true);
+   }
+
+   template<class Convertible>
+   void priv_push_back(BOOST_FWD_REF(Convertible) v)
+   {
+      node_t *const n = this->priv_rightmost();
+      this->priv_emplace_at(n, n ? n->m_count : 0u, boost::forward<Convertible>(v));
+   }
+
+   template<class Convertible>
+   iterator priv_emplace_before(const_iterator hint, BOOST_FWD_REF(Convertible) v)
+   {
+      node_t *n = hint.get_node();
+      std::size_t pos = hint.get_pos();
+      //New values are always inserted in leaves, after the predecessor
+      if(n && !n->m_leaf){
+         node_t::decrement(n, pos);
+         ++pos;
+      }
+      return this->priv_emplace_at(n, pos, boost::forward<Convertible>(v));
+   }
+
+   //Constructs a value in the position "pos" of the leaf "n"
+   //or in a new root if the tree is empty.
+   template<class Convertible>
+   iterator priv_emplace_at(node_t *n, std::size_t pos, BOOST_FWD_REF(Convertible) v)
+   {
+      if(n && (n->m_count == node_t::slots || pos != n->m_count)){
+         //v might refer to a value of the tree, which is moved when the node is
+         //restructured or the hole is opened, so build the new value first
+         aligned_storage<sizeof(internal_type), alignment_of<internal_type>::value> s;
+         internal_type &val = *static_cast<internal_type *>(static_cast<void *>(&s));
+         allocator_traits_type::construct(this->priv_alloc(), &val, boost::forward<Convertible>(v));
+         internal_value_destructor d(this->priv_alloc(), val);
+         return this->priv_construct_at(n, pos, ::boost::move(val));
+      }
+      return this->priv_construct_at(n, pos, boost::forward<Convertible>(v));
+   }
+
+   //Constructs a value that does not belong to the tree in the
+   //position "pos" of the leaf "n" or in a new root if the tree is empty.
+   template<class Convertible>
+   iterator priv_construct_at(node_t *n, std::size_t pos, BOOST_FWD_REF(Convertible) v)
+   {
+      if(!n){
+         n = this->priv_new_leaf();
+         m_data.m_root = m_data.m_leftmost = m_data.m_rightmost = node_ptr_traits::pointer_to(*n);
+         pos = 0;
+      }
+      else if(n->m_count == node_t::slots){
+         this->priv_rebalance_or_split(n, pos);
+      }
+      this->priv_open_hole(n, pos, n->m_count);
+      BOOST_TRY{
+         allocator_traits_type::construct
+            (this->priv_alloc(), n->values() + pos, boost::forward<Convertible>(v));
+      }
+      BOOST_CATCH(...){
+         this->priv_close_hole(n, pos, n->m_count + 1u);
+         if(!m_data.m_size){
+            this->clear_empty_root();
+         }
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+      ++n->m_count;
+      ++m_data.m_size;
+      return iterator(n, pos);
+   }
+
+   void clear_empty_root()
+   {
+      this->priv_delete_node(this->priv_root());
+      m_data.m_root = m_data.m_leftmost = m_data.m_rightmost = node_ptr();
+   }
+
+   //Makes room for a new value in the full node "n", moving values to a sibling or
+   //splitting the node. "n" and "pos" are updated to the final insertion position.
+   void priv_rebalance_or_split(node_t *&n, std::size_t &pos)
+   {
+      node_t *parent = n->parent();
+      if(parent){
+         const std::size_t n_pos = n->m_position;
+         if(n_pos > 0){
+            //Try rebalancing with the left sibling. Move more values
+            //when appending, so that sequential insertions fill nodes.
+            node_t *const left = parent->child(n_pos - 1u);
+            if(left->m_count < node_t::slots){
+               std::size_t to_move = (node_t::slots - left->m_count) / (1u + (pos < node_t::slots));
+               to_move = to_move ? to_move : 1u;
+               if(pos >= to_move || left->m_count + to_move < node_t::slots){
+                  this->priv_rebalance_right_to_left(left, n, to_move);
+                  if(pos >= to_move){
+                     pos -= to_move;
+                  }
+                  else{
+                     pos += left->m_count + 1u - to_move;
+                     n = left;
+                  }
+                  return;
+               }
+            }
+         }
+         if(n_pos < parent->m_count){
+            //Try rebalancing with the right sibling. Move more values
+            //when prepending, so that sequential insertions fill nodes.
+            node_t *const right = parent->child(n_pos + 1u);
+            if(right->m_count < node_t::slots){
+               std::size_t to_move = (node_t::slots - right->m_count) / (1u + (pos > 0));
+               to_move = to_move ? to_move : 1u;
+               if(pos <= n->m_count - to_move || right->m_count + to_move < node_t::slots){
+                  this->priv_rebalance_left_to_right(n, right, to_move);
+                  if(pos > n->m_count){
+                     pos -= n->m_count + 1u;
+                     n = right;
+                  }
+                  return;
+               }
+            }
+         }
+         //Rebalancing failed, make sure there is room in the parent for the split value
+         if(parent->m_count == node_t::slots){
+            node_t *parent_n = parent;
+            std::size_t parent_pos = n->m_position;
+            this->priv_rebalance_or_split(parent_n, parent_pos);
+            parent = n->parent();
+         }
+      }
+      else{
+         //The root is full: the tree grows with a new root
+         node_t *const new_root = this->priv_new_internal();
+         new_root->set_child(0, n);
+         m_data.m_root = node_ptr_traits::pointer_to(*new_root);
+      }
+      node_t *const split = n->m_leaf ? this->priv_new_leaf() : this->priv_new_internal();
+      this->priv_split(n, pos, split);
+      if(this->priv_rightmost() == n){
+         m_data.m_rightmost = node_ptr_traits::pointer_to(*split);
+      }
+      if(pos > n->m_count){
+         pos -= n->m_count + 1u;
+         n = split;
+      }
+   }
+
+   //Moves the upper values of "n" to the empty node "dest", which is inserted
+   //in the parent after "n". The split is biased when inserting at the edges.
+   void priv_split(node_t *n, std::size_t pos, node_t *dest)
+   {
+      std::size_t dest_count;
+      if(pos == 0){
+         dest_count = n->m_count - 1u;
+      }
+      else if(pos == node_t::slots){
+         dest_count = 0;
+      }
+      else{
+         dest_count = n->m_count/2u;
+      }
+      const std::size_t count = n->m_count - dest_count;
+      internal_type *const src = n->values();
+      internal_type *const dst = dest->values();
+      for(std::size_t i = 0; i != dest_count; ++i){
+         this->priv_transfer(dst + i, src + count + i);
+      }
+      dest->m_count = static_cast<unsigned short>(dest_count);
+      n->m_count = static_cast<unsigned short>(count - 1u);
+      if(!n->m_leaf){
+         for(std::size_t i = 0; i <= dest_count; ++i){
+            dest->set_child(i, n->child(count + i));
+         }
+      }
+      //The last value of "n" separates both nodes in the parent
+      this->priv_insert_separator(n->parent(), n->m_position, src + count - 1u, dest);
+   }
+
+   //Moves "v" to the position "i" of the internal node "p" and inserts "right" after it
+   void priv_insert_separator(node_t *p, std::size_t i, internal_type *v, node_t *right)
+   {
+      this->priv_open_hole(p, i, p->m_count);
+      this->priv_transfer(p->values() + i, v);
+      for(std::size_t j = p->m_count + 1u; j > i + 1u; --j){
+         p->set_child(j, p->child(j - 1u));
+      }
+      ++p->m_count;
+      p->set_child(i + 1u, right);
+   }
+
+   //Moves "to_move" values from "right" to its left sibling "left" through the parent
+   void priv_rebalance_right_to_left(node_t *left, node_t *right, std::size_t to_move)
+   {
+      internal_type *const sep = left->parent()->values() + left->m_position;
+      internal_type *const l = left->values();
+      internal_type *const r = right->values();
+      const std::size_t lcount = left->m_count;
+      const std::size_t rcount = right->m_count;
+      this->priv_transfer(l + lcount, sep);
+      for(std::size_t i = 1; i != to_move; ++i){
+         this->priv_transfer(l + lcount + i, r + i - 1u);
+      }
+      this->priv_transfer(sep, r + to_move - 1u);
+      for(std::size_t i = to_move; i != rcount; ++i){
+         this->priv_transfer(r + i - to_move, r + i);
+      }
+      if(!left->m_leaf){
+         for(std::size_t i = 0; i != to_move; ++i){
+            left->set_child(lcount + 1u + i, right->child(i));
+         }
+         for(std::size_t i = to_move; i <= rcount; ++i){
+            right->set_child(i - to_move, right->child(i));
+         }
+      }
+      left->m_count  = static_cast<unsigned short>(lcount + to_move);
+      right->m_count = static_cast<unsigned short>(rcount - to_move);
+   }
+
+   //Moves "to_move" values from "left" to its right sibling "right" through the parent
+   void priv_rebalance_left_to_right(node_t *left, node_t *right, std::size_t to_move)
+   {
+      internal_type *const sep = left->parent()->values() + left->m_position;
+      internal_type *const l = left->values();
+      internal_type *const r = right->values();
+      const std::size_t lcount = left->m_count;
+      const std::size_t rcount = right->m_count;
+      for(std::size_t i = rcount; i--; ){
+         this->priv_transfer(r + i + to_move, r + i);
+      }
+      this->priv_transfer(r + to_move - 1u, sep);
+      for(std::size_t i = 1; i != to_move; ++i){
+         this->priv_transfer(r + i - 1u, l + lcount - to_move + i);
+      }
+      this->priv_transfer(sep, l + lcount - to_move);
+      if(!left->m_leaf){
+         for(std::size_t i = rcount + 1u; i--; ){
+            right->set_child(i + to_move, right->child(i));
+         }
+         for(std::size_t i = 0; i != to_move; ++i){
+            right->set_child(i, left->child(lcount - to_move + 1u + i));
+         }
+      }
+      left->m_count  = static_cast<unsigned short>(lcount - to_move);
+      right->m_count = static_cast<unsigned short>(rcount + to_move);
+   }
+
+   //Merges "right" and the separator value into its left sibling "left"
+   //and removes "right" from the parent
+   void priv_merge_nodes(node_t *left, node_t *right)
+   {
+      node_t *const parent = left->parent();
+      const std::size_t sep_pos = left->m_position;
+      internal_type *const l = left->values();
+      internal_type *const r = right->values();
+      const std::size_t lcount = left->m_count;
+      const std::size_t rcount = right->m_count;
+      this->priv_transfer(l + lcount, parent->values() + sep_pos);
+      for(std::size_t i = 0; i != rcount; ++i){
+         this->priv_transfer(l + lcount + 1u + i, r + i);
+      }
+      if(!left->m_leaf){
+         for(std::size_t i = 0; i <= rcount; ++i){
+            left->set_child(lcount + 1u + i, right->child(i));
+         }
+      }
+      left->m_count  = static_cast<unsigned short>(lcount + 1u + rcount);
+      right->m_count = 0;
+      this->priv_close_hole(parent, sep_pos, parent->m_count);
+      for(std::size_t i = sep_pos + 2u; i <= parent->m_count; ++i){
+         parent->set_child(i - 1u, parent->child(i));
+      }
+      --parent->m_count;
+      if(this->priv_rightmost() == right){
+         m_data.m_rightmost = node_ptr_traits::pointer_to(*left);
+      }
+      this->priv_delete_node(right);
+   }
+
+   //Restores the minimum occupancy of the nodes after erasing the value at
+   //(n, pos) and returns an iterator to the value that followed it
+   iterator priv_rebalance_after_erase(node_t *n, std::size_t pos)
+   {
+      node_t *res_n = n;
+      std::size_t res_pos = pos;
+      bool first_iteration = true;
+      while(true){
+         if(n == this->priv_root()){
+            this->priv_try_shrink();
+            if(!m_data.m_size){
+               return this->end();
+            }
+            break;
+         }
+         if(n->m_count >= node_t::slots/2u){
+            break;
+         }
+         const bool merged = this->priv_try_merge_or_rebalance(n, pos);
+         if(first_iteration){
+            res_n = n;
+            res_pos = pos;
+            first_iteration = false;
+         }
+         if(!merged){
+            break;
+         }
+         pos = n->m_position;
+         n   = n->parent();
+      }
+      if(res_pos == res_n->m_count){
+         res_pos = res_n->m_count - 1u;
+         node_t::increment(res_n, res_pos);
+      }
+      return iterator(res_n, res_pos);
+   }
+
+   //Merges the underfull node "n" with a sibling or moves values from a
+   //sibling. Returns true if nodes were merged, so the parent might be underfull.
+   bool priv_try_merge_or_rebalance(node_t *&n, std::size_t &pos)
+   {
+      node_t *const parent = n->parent();
+      const std::size_t n_pos = n->m_position;
+      if(n_pos > 0){
+         node_t *const left = parent->child(n_pos - 1u);
+         if(1u + left->m_count + n->m_count <= node_t::slots){
+            pos += 1u + left->m_count;
+            this->priv_merge_nodes(left, n);
+            n = left;
+            return true;
+         }
+      }
+      if(n_pos < parent->m_count){
+         node_t *const right = parent->child(n_pos + 1u);
+         if(1u + n->m_count + right->m_count <= node_t::slots){
+            this->priv_merge_nodes(n, right);
+            return true;
+         }
+         //Move values from the right sibling unless they would be
+         //placed just after the erased position, which is the end
+         if(right->m_count > node_t::slots/2u && (n->m_count == 0 || pos > 0)){
+            std::size_t to_move = (right->m_count - n->m_count)/2u;
+            to_move = to_move < right->m_count - 1u ? to_move : right->m_count - 1u;
+            this->priv_rebalance_right_to_left(n, right, to_move);
+            return false;
+         }
+      }
+      if(n_pos > 0){
+         node_t *const left = parent->child(n_pos - 1u);
+         if(left->m_count > node_t::slots/2u && (n->m_count == 0 || pos < n->m_count)){
+            std::size_t to_move = (left->m_count - n->m_count)/2u;
+            to_move = to_move < left->m_count - 1u ? to_move : left->m_count - 1u;
+            this->priv_rebalance_left_to_right(left, n, to_move);
+            pos += to_move;
+            return false;
+         }
+      }
+      return false;
+   }
+
+   //Removes an empty root, shortening the tree
+   void priv_try_shrink()
+   {
+      node_t *const r = this->priv_root();
+      if(r->m_count){
+         return;
+      }
+      if(r->m_leaf){
+         this->clear_empty_root();
+      }
+      else{
+         node_t *const c = r->child(0);
+         c->m_parent   = node_ptr();
+         c->m_position = 0;
+         m_data.m_root = node_ptr_traits::pointer_to(*c);
+         this->priv_delete_node(r);
+      }
+   }
+
+   iterator priv_erase_n(const_iterator first, size_type n)
+   {
+      iterator ret(this->priv_iterator(first));
+      while(n--){
+         ret = this->erase(ret);
+      }
+      return ret;
+   }
+
+   //Moves a value to uninitialized memory, destroying the source
+   void priv_transfer(internal_type *dst, internal_type *src)
+   {
+      A &a = this->priv_alloc();
+      allocator_traits_type::construct(a, dst, boost::move(*src));
+      allocator_traits_type::destroy(a, src);
+   }
+
+   //Moves the values [pos, count) of "n" one position up
+   void priv_open_hole(node_t *n, std::size_t pos, std::size_t count)
+   {
+      internal_type *const v = n->values();
+      for(std::size_t i = count; i != pos; --i){
+         this->priv_transfer(v + i, v + i - 1u);
+      }
+   }
+
+   //Moves the values [pos + 1, count) of "n" one position down
+   void priv_close_hole(node_t *n, std::size_t pos, std::size_t count)
+   {
+      internal_type *const v = n->values();
+      for(std::size_t i = pos + 1u; i < count; ++i){
+         this->priv_transfer(v + i - 1u, v + i);
+      }
+   }
+
+   node_t *priv_new_leaf()
+   {
+      leaf_allocator_t a(this->priv_alloc());
+      node_t *const n = container_detail::to_raw_pointer(leaf_allocator_traits::allocate(a, 1));
+      return ::new(static_cast<void*>(n)) node_t;
+   }
+
+   node_t *priv_new_internal()
+   {
+      internal_allocator_t a(this->priv_alloc());
+      internal_node_t *const n =
+         container_detail::to_raw_pointer(internal_allocator_traits::allocate(a, 1));
+      return ::new(static_cast<void*>(n)) internal_node_t;
+   }
+
+   void priv_delete_node(node_t *n)
+   {
+      if(n->m_leaf){
+         leaf_allocator_t a(this->priv_alloc());
+         n->~node_t();
+         leaf_allocator_traits::deallocate
+            (a, boost::intrusive::pointer_traits<typename leaf_allocator_traits::pointer>::pointer_to(*n), 1);
+      }
+      else{
+         internal_allocator_t a(this->priv_alloc());
+         internal_node_t *const in = static_cast<internal_node_t*>(n);
+         in->~internal_node_t();
+         internal_allocator_traits::deallocate
+            (a, boost::intrusive::pointer_traits<typename internal_allocator_traits::pointer>::pointer_to(*in), 1);
+      }
+   }
+
+   void priv_destroy_subtree(node_t *n)
+   {
+      A &a = this->priv_alloc();
+      internal_type *const v = n->values();
+      for(std::size_t i = 0, max = n->m_count; i != max; ++i){
+         allocator_traits_type::destroy(a, v + i);
+      }
+      if(!n->m_leaf){
+         //Children might be missing if a copy was interrupted
+         for(std::size_t i = 0, max = n->m_count; i <= max; ++i){
+            if(node_t *const c = n->child(i)){
+               this->priv_destroy_subtree(c);
+            }
+         }
+      }
+      this->priv_delete_node(n);
+   }
+
+   node_t *priv_clone_subtree(const node_t *src)
+   {
+      node_t *const dst = src->m_leaf ? this->priv_new_leaf() : this->priv_new_internal();
+      BOOST_TRY{
+         A &a = this->priv_alloc();
+         const internal_type *const v = src->values();
+         for(std::size_t i = 0, max = src->m_count; i != max; ++i){
+            allocator_traits_type::construct(a, dst->values() + i, v[i]);
+            ++dst->m_count;
+         }
+         if(!src->m_leaf){
+            for(std::size_t i = 0, max = src->m_count; i <= max; ++i){
+               dst->set_child(i, this->priv_clone_subtree(src->child(i)));
+            }
+         }
+      }
+      BOOST_CATCH(...){
+         this->priv_destroy_subtree(dst);
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+      return dst;
+   }
+
+   //Copies the structure of x in the empty tree
+   void priv_clone_from(const btree &x)
+   {
+      if(const node_t *const r = x.priv_root()){
+         node_t *const root = this->priv_clone_subtree(r);
+         node_t *leftmost = root, *rightmost = root;
+         while(!leftmost->m_leaf){
+            leftmost = leftmost->child(0);
+         }
+         while(!rightmost->m_leaf){
+            rightmost = rightmost->child(rightmost->m_count);
+         }
+         m_data.m_root      = node_ptr_traits::pointer_to(*root);
+         m_data.m_leftmost  = node_ptr_traits::pointer_to(*leftmost);
+         m_data.m_rightmost = node_ptr_traits::pointer_to(*rightmost);
+         m_data.m_size      = x.m_data.m_size;
+      }
+   }
+
+   //Takes the nodes of x, leaving it empty
+   void priv_steal(btree &x)
+   {
+      m_data.m_root      = x.m_data.m_root;
+      m_data.m_leftmost  = x.m_data.m_leftmost;
+      m_data.m_rightmost = x.m_data.m_rightmost;
+      m_data.m_size      = x.m_data.m_size;
+      x.m_data.m_root = x.m_data.m_leftmost = x.m_data.m_rightmost = node_ptr();
+      x.m_data.m_size = 0;
+   }
+
+   //Moves the values of x one by one, for unequal allocators
+   void priv_move_elements(btree &x)
+   {
+      for(iterator it = x.begin(), itend = x.end(); it != itend; ++it){
+         this->priv_push_back(boost::move(it.get_node()->values()[it.get_pos()]));
+      }
+   }
+   /// @endcond
+};
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A, std::size_t NodeSize>
+inline bool
+operator==(const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& x,
+           const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& y)
+{
+  return x.size() == y.size() &&
+         std::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A, std::size_t NodeSize>
+inline bool
+operator<(const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& x,
+          const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& y)
+{
+  return std::lexicographical_compare(x.begin(), x.end(),
+                                      y.begin(), y.end());
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A, std::size_t NodeSize>
+inline bool
+operator!=(const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& x,
+           const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& y) {
+  return !(x == y);
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A, std::size_t NodeSize>
+inline bool
+operator>(const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& x,
+          const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& y) {
+  return y < x;
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A, std::size_t NodeSize>
+inline bool
+operator<=(const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& x,
+           const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& y) {
+  return !(y < x);
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A, std::size_t NodeSize>
+inline bool
+operator>=(const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& x,
+           const btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& y) {
+  return !(x < y);
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class KeyCompare, class A, std::size_t NodeSize>
+inline void
+swap(btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& x,
+     btree<Key,Value,KeyOfValue,KeyCompare,A,NodeSize>& y)
+{
+  x.swap(y);
+}
+
+} //namespace container_detail {
+} //namespace container {
+} //namespace boost  {
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif //BOOST_CONTAINER_BTREE_HPP
@@ -26,6 +26,7 @@
 
 #include <boost/type_traits/has_trivial_destructor.hpp>
 #include <boost/move/move.hpp>
+#include <boost/detail/no_exceptions_support.hpp>
 
 #include <boost/container/detail/utilities.hpp>
 #include <boost/container/detail/pair.hpp>
@@ -174,6 +175,7 @@ class flat_tree
 
    //!Standard extension
    typedef allocator_type                             stored_allocator_type;
+   typedef vector_t                                   sequence_type;
 
    private:
    typedef allocator_traits<stored_allocator_type> stored_allocator_traits;
@@ -372,30 +374,20 @@ class flat_tree
 
    template <class InIt>
    void insert_unique(InIt first, InIt last)
-   {  this->priv_insert_unique_loop(first, last); }
-
-   template <class InIt>
-   void insert_equal(InIt first, InIt last
-      #if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
-      , typename container_detail::enable_if_c
-         < container_detail::is_input_iterator<InIt>::value
-         >::type * = 0
-      #endif
-      )
-   {  this->priv_insert_equal_loop(first, last);  }
+   {
+      //Append the whole range and merge it with the ordered
+      //prefix in a single pass instead of inserting one by one
+      const size_type old_size = this->size();
+      this->m_data.m_vect.insert(this->m_data.m_vect.end(), first, last);
+      this->priv_merge_appended(old_size, true);
+   }
 
    template <class InIt>
-   void insert_equal(InIt first, InIt last
-      #if !defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
-      , typename container_detail::enable_if_c
-         < !container_detail::is_input_iterator<InIt>::value
-         >::type * = 0
-      #endif
-      )
+   void insert_equal(InIt first, InIt last)
    {
-      const size_type len = static_cast<size_type>(std::distance(first, last));
-      this->reserve(this->size()+len);
-      this->priv_insert_equal_loop(first, last);
+      const size_type old_size = this->size();
+      this->m_data.m_vect.insert(this->m_data.m_vect.end(), first, last);
+      this->priv_merge_appended(old_size, false);
    }
 
    //Ordered
@@ -470,7 +462,7 @@ class flat_tree
          >::type * = 0
       #endif
       )
-   {  this->priv_insert_unique_loop_hint(first, last);  }
+   {  this->priv_insert_unique_loop_ordered(first, last);  }
 
    template <class BidirIt>
    void insert_unique(ordered_unique_range_t, BidirIt first, BidirIt last
@@ -524,6 +516,38 @@ class flat_tree
       }
    }
 
+   void merge_unique(flat_tree& source)
+   {
+      if(&source != this){
+         this->priv_merge_sorted(source.m_data.m_vect, true);
+      }
+   }
+
+   void merge_equal(flat_tree& source)
+   {
+      if(&source != this){
+         this->priv_merge_sorted(source.m_data.m_vect, false);
+      }
+   }
+
+   void adopt_sequence_unique(BOOST_RV_REF(sequence_type) seq)
+   {
+      this->m_data.m_vect = boost::move(seq);
+      this->priv_merge_appended(0u, true);
+   }
+
+   void adopt_sequence_unique(ordered_unique_range_t, BOOST_RV_REF(sequence_type) seq)
+   {  this->m_data.m_vect = boost::move(seq);   }
+
+   void adopt_sequence_equal(BOOST_RV_REF(sequence_type) seq)
+   {
+      this->m_data.m_vect = boost::move(seq);
+      this->priv_merge_appended(0u, false);
+   }
+
+   void adopt_sequence_equal(ordered_range_t, BOOST_RV_REF(sequence_type) seq)
+   {  this->m_data.m_vect = boost::move(seq);   }
+
    #ifdef BOOST_CONTAINER_PERFECT_FORWARDING
 
    template <class... Args>
@@ -932,28 +956,143 @@ class flat_tree
       return std::pair<RanIt, RanIt>(first, first);
    }
 
-   template<class InIt>
-   void priv_insert_equal_loop(InIt first, InIt last)
+   typedef boost::container::vector<value_type*>      ptr_vector_t;
+
+   struct indirect_value_compare
    {
-      for ( ; first != last; ++first){
-         this->insert_equal(*first);
+      explicit indirect_value_compare(const value_compare &comp)
+         : mp_comp(&comp)
+      {}
+
+      bool operator()(const value_type *l, const value_type *r) const
+      {  return (*mp_comp)(*l, *r);  }
+
+      const value_compare *mp_comp;
+   };
+
+   //Sorts the elements placed after the first old_size elements and merges them
+   //with that ordered prefix. If unique is true, the first of several equivalent
+   //elements is kept, preferring the ones that were already stored. If an
+   //exception is thrown, the appended elements are erased.
+   void priv_merge_appended(const size_type old_size, const bool unique)
+   {
+      vector_t &v = this->m_data.m_vect;
+      if(old_size == v.size()){
+         return;
+      }
+      BOOST_TRY{
+         ptr_vector_t sorted, order;
+         sorted.reserve(v.size() - old_size);
+         for(value_type *p = v.data() + old_size, *pend = v.data() + v.size(); p != pend; ++p){
+            sorted.push_back(p);
+         }
+         //Already ordered ranges are merged in linear time
+         const value_compare &value_comp = this->m_data;
+         const indirect_value_compare comp(value_comp);
+         if(!priv_is_sorted(sorted, comp)){
+            std::stable_sort(sorted.begin(), sorted.end(), comp);
+         }
+         this->priv_merge_order(old_size, sorted, unique, order);
+         this->priv_apply_order(order);
+      }
+      BOOST_CATCH(...){
+         v.erase(v.begin() + old_size, v.end());
+         BOOST_RETHROW
       }
+      BOOST_CATCH_END
    }
 
-   template<class InIt>
-   void priv_insert_equal_loop_ordered(InIt first, InIt last)
+   static bool priv_is_sorted(const ptr_vector_t &sorted, const indirect_value_compare &comp)
    {
-      const_iterator pos(this->cend());
-      for ( ; first != last; ++first){
-         pos = this->insert_equal(pos, *first);
+      typename ptr_vector_t::const_iterator it(sorted.begin()), itend(sorted.end());
+      if(it != itend){
+         for(typename ptr_vector_t::const_iterator prev(it); ++it != itend; prev = it){
+            if(comp(*it, *prev)){
+               return false;
+            }
+         }
+      }
+      return true;
+   }
+
+   //Merges the ordered elements of source into *this and clears source.
+   //If any comparison throws, both sequences are left unchanged.
+   void priv_merge_sorted(vector_t &source, const bool unique)
+   {
+      if(source.empty()){
+         return;
+      }
+      ptr_vector_t sorted, order;
+      sorted.reserve(source.size());
+      for(value_type *p = source.data(), *pend = source.data() + source.size(); p != pend; ++p){
+         sorted.push_back(p);
       }
+      this->priv_merge_order(this->size(), sorted, unique, order);
+      this->priv_apply_order(order);
+      source.clear();
+   }
+
+   //Calculates in "order" the final position of the first head_size
+   //elements and the ordered elements pointed by "sorted". No element is
+   //moved so that a throwing comparison does not alter the container.
+   void priv_merge_order
+      (const size_type head_size, const ptr_vector_t &sorted, const bool unique, ptr_vector_t &order)
+   {
+      const value_compare &value_comp = this->m_data;
+      value_type *head = this->m_data.m_vect.data();
+      value_type *const head_end = head + head_size;
+      typename ptr_vector_t::const_iterator it(sorted.begin()), itend(sorted.end());
+      order.reserve(head_size + sorted.size());
+      while(it != itend){
+         if(head == head_end || value_comp(**it, *head)){
+            //Discard elements equivalent to the last one placed
+            if(!unique || order.empty() || value_comp(*order.back(), **it)){
+               order.push_back(*it);
+            }
+            ++it;
+         }
+         else{
+            order.push_back(head++);
+         }
+      }
+      for(; head != head_end; ++head){
+         order.push_back(head);
+      }
+   }
+
+   //Moves the elements pointed by "order" to a new buffer that replaces the
+   //current one. No element is moved if they are already in place.
+   void priv_apply_order(const ptr_vector_t &order)
+   {
+      vector_t &v = this->m_data.m_vect;
+      value_type *p = v.data();
+      value_type *const pend = p + v.size();
+      typename ptr_vector_t::const_iterator it(order.begin()), itend(order.end());
+      //Elements stored right after the end of v, for example in the buffer
+      //of a merged source, are not in place even if their address matches
+      while(it != itend && p != pend && *it == p){
+         ++it;
+         ++p;
+      }
+      if(it == itend){
+         //Only discarded elements, if any, are out of place
+         v.erase(v.begin() + order.size(), v.end());
+         return;
+      }
+      vector_t merged(v.get_stored_allocator());
+      merged.reserve(order.size());
+      for(it = order.begin(); it != itend; ++it){
+         merged.push_back(boost::move(**it));
+      }
+      v.swap(merged);
    }
 
    template<class InIt>
-   void priv_insert_unique_loop(InIt first, InIt last)
+   void priv_insert_equal_loop_ordered(InIt first, InIt last)
    {
+      const_iterator pos(this->cend());
       for ( ; first != last; ++first){
-         this->insert_unique(*first);
+         pos = this->insert_equal(pos, *first);
       }
    }
 
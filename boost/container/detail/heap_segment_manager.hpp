@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_DETAIL_HEAP_SEGMENT_MANAGER_HPP
+#define BOOST_CONTAINER_DETAIL_HEAP_SEGMENT_MANAGER_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include "config_begin.hpp"
+#include <boost/container/detail/workaround.hpp>
+#include <boost/container/detail/multiallocation_chain.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(BOOST_WINDOWS)
+#  include <malloc.h>
+#else
+#  include <stdlib.h>
+#endif
+
+namespace boost {
+namespace container {
+namespace container_detail {
+
+//!The memory source the node pools use when they are placed in the heap.
+//!It offers the segment manager interface the pool implementations
+//!(private_node_pool_impl and private_adaptive_node_pool_impl) need.
+//!It's stateless, so a single instance is shared by all pools.
+class heap_segment_manager
+{
+   public:
+   typedef void *                                           void_pointer;
+   typedef std::size_t                                      size_type;
+   typedef std::ptrdiff_t                                   difference_type;
+   typedef basic_multiallocation_chain<void_pointer>        multiallocation_chain;
+
+   //Bytes used by a typical malloc implementation to hold a block size.
+   //Adaptive pools use it to size their blocks so that they don't waste
+   //a whole alignment unit.
+   static const size_type PayloadPerAllocation = 2*sizeof(void*);
+
+   static heap_segment_manager *get()
+   {
+      //Stateless and statically initialized, so this is thread-safe
+      static heap_segment_manager instance;
+      return &instance;
+   }
+
+   //!Allocates nbytes bytes. Throws std::bad_alloc on failure.
+   void *allocate(size_type nbytes)
+   {
+      #if defined(BOOST_WINDOWS)
+      void *ret = ::_aligned_malloc(nbytes, MinAlign);
+      #else
+      void *ret = std::malloc(nbytes);
+      #endif
+      if(!ret){
+         throw std::bad_alloc();
+      }
+      return ret;
+   }
+
+   //!Allocates nbytes bytes aligned to "alignment", a power of two.
+   //!Throws std::bad_alloc on failure.
+   void *allocate_aligned(size_type nbytes, size_type alignment)
+   {
+      if(alignment < MinAlign){
+         alignment = MinAlign;
+      }
+      #if defined(BOOST_WINDOWS)
+      void *ret = ::_aligned_malloc(nbytes, alignment);
+      #else
+      void *ret = 0;
+      if(::posix_memalign(&ret, alignment, nbytes) != 0){
+         ret = 0;
+      }
+      #endif
+      if(!ret){
+         throw std::bad_alloc();
+      }
+      return ret;
+   }
+
+   //!Deallocates memory returned by allocate or allocate_aligned.
+   void deallocate(void *addr)
+   {
+      #if defined(BOOST_WINDOWS)
+      ::_aligned_free(addr);
+      #else
+      std::free(addr);
+      #endif
+   }
+
+   private:
+   static const size_type MinAlign = sizeof(void*) > 8 ? sizeof(void*) : 8;
+};
+
+}  //namespace container_detail {
+}  //namespace container {
+}  //namespace boost {
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_CONTAINER_DETAIL_HEAP_SEGMENT_MANAGER_HPP
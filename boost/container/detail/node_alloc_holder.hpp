@@ -271,6 +271,33 @@ struct node_alloc_holder
       return beg;
    }
 
+   //Fills the (empty) intrusive container with copies of the nodes of x
+   void clone_icont(const ICont &x)
+   {  this->clone_icont(x, alloc_version());  }
+
+   void clone_icont(const ICont &x, allocator_v1)
+   {  this->icont().clone_from(x, cloner(*this), Destroyer(this->node_alloc()));   }
+
+   void clone_icont(const ICont &x, allocator_v2)
+   {
+      if(!x.empty()){
+         typedef typename NodeAlloc::multiallocation_chain multiallocation_chain;
+         //Obtain all the nodes at once. If a copy throws, clone_from
+         //destroys the cloned nodes and the unused ones are deallocated here
+         multiallocation_chain mem(this->node_alloc().allocate_individual(x.size()));
+         BOOST_TRY{
+            this->icont().clone_from(x, chain_cloner(*this, mem), Destroyer(this->node_alloc()));
+         }
+         BOOST_CATCH(...){
+            if(!mem.empty()){
+               this->node_alloc().deallocate_individual(boost::move(mem));
+            }
+            BOOST_RETHROW
+         }
+         BOOST_CATCH_END
+      }
+   }
+
    void clear(allocator_v1)
    {  this->icont().clear_and_dispose(Destroyer(this->node_alloc()));   }
 
@@ -317,6 +344,39 @@ struct node_alloc_holder
       node_alloc_holder &m_holder;
    };
 
+   //Like cloner, but takes the memory of the nodes from a chain
+   //obtained with allocate_individual
+   struct chain_cloner
+   {
+      typedef typename NodeAlloc::multiallocation_chain multiallocation_chain;
+
+      chain_cloner(node_alloc_holder &holder, multiallocation_chain &chain)
+         :  m_holder(holder), m_chain(chain)
+      {}
+
+      NodePtr operator()(const Node &other) const
+      {
+         NodePtr p = m_chain.pop_front();
+         BOOST_TRY{
+            //This can throw
+            allocator_traits<NodeAlloc>::construct
+               (m_holder.node_alloc(), container_detail::addressof(p->m_data), other.get_data());
+         }
+         BOOST_CATCH(...){
+            m_chain.push_front(p);
+            BOOST_RETHROW
+         }
+         BOOST_CATCH_END
+         //This does not throw
+         typedef typename Node::hook_type hook_type;
+         ::new(static_cast<hook_type*>(container_detail::to_raw_pointer(p))) hook_type;
+         return p;
+      }
+
+      node_alloc_holder &m_holder;
+      multiallocation_chain &m_chain;
+   };
+
    struct members_holder
       :  public NodeAlloc
    {
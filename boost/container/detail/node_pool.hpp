@@ -0,0 +1,147 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_DETAIL_NODE_POOL_HPP
+#define BOOST_CONTAINER_DETAIL_NODE_POOL_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include "config_begin.hpp"
+#include <boost/container/detail/workaround.hpp>
+#include <boost/container/detail/node_pool_impl.hpp>
+#include <boost/container/detail/heap_segment_manager.hpp>
+#include <boost/move/move.hpp>
+#include <boost/smart_ptr/detail/spinlock.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace container {
+namespace container_detail {
+
+//!Holds a single instance of Pool for the whole program. The instance
+//!is created before main() starts (or on first use, if that happens
+//!earlier) and it's never destroyed, so containers destroyed during
+//!program termination can still return their nodes.
+template<class Pool>
+class pool_singleton
+{
+   struct object_creator
+   {
+      object_creator()
+      {  pool_singleton<Pool>::instance();  }
+
+      void do_nothing() const
+      {}
+   };
+
+   static object_creator create_object;
+
+   public:
+   static Pool &instance()
+   {
+      static Pool *const p = new Pool;
+      create_object.do_nothing();
+      return *p;
+   }
+};
+
+template<class Pool>
+typename pool_singleton<Pool>::object_creator pool_singleton<Pool>::create_object;
+
+//!Makes a pool usable by several threads at once serializing its
+//!operations with a spinlock.
+template<class PrivatePool>
+class shared_pool_impl
+   :  private PrivatePool
+{
+   typedef boost::detail::spinlock::scoped_lock scoped_lock;
+
+   public:
+   typedef typename PrivatePool::multiallocation_chain   multiallocation_chain;
+   typedef typename PrivatePool::size_type               size_type;
+
+   void *allocate_node()
+   {
+      scoped_lock lock(s_lock);
+      return PrivatePool::allocate_node();
+   }
+
+   void deallocate_node(void *ptr)
+   {
+      scoped_lock lock(s_lock);
+      PrivatePool::deallocate_node(ptr);
+   }
+
+   multiallocation_chain allocate_nodes(const size_type n)
+   {
+      scoped_lock lock(s_lock);
+      return PrivatePool::allocate_nodes(n);
+   }
+
+   void deallocate_nodes(multiallocation_chain chain)
+   {
+      scoped_lock lock(s_lock);
+      PrivatePool::deallocate_nodes(boost::move(chain));
+   }
+
+   void deallocate_free_blocks()
+   {
+      scoped_lock lock(s_lock);
+      PrivatePool::deallocate_free_blocks();
+   }
+
+   private:
+   static boost::detail::spinlock s_lock;
+};
+
+template<class PrivatePool>
+boost::detail::spinlock shared_pool_impl<PrivatePool>::s_lock = BOOST_DETAIL_SPINLOCK_INIT;
+
+//!A node pool placed in the heap. Node size (NodeSize) and the number of
+//!nodes allocated per block (NodesPerBlock) are known at compile time.
+template<std::size_t NodeSize, std::size_t NodesPerBlock>
+class private_node_pool
+   :  public private_node_pool_impl<heap_segment_manager>
+{
+   typedef private_node_pool_impl<heap_segment_manager> base_t;
+   //Non-copyable
+   private_node_pool(const private_node_pool &);
+   private_node_pool &operator=(const private_node_pool &);
+
+   public:
+   typedef typename base_t::size_type  size_type;
+
+   static const size_type nodes_per_block = NodesPerBlock;
+
+   private_node_pool()
+      :  base_t(heap_segment_manager::get(), NodeSize, NodesPerBlock)
+   {}
+};
+
+//!The node pool shared by all node_allocators with the
+//!same node size and number of nodes per block
+template<std::size_t NodeSize, std::size_t NodesPerBlock>
+class shared_node_pool
+   :  public shared_pool_impl< private_node_pool<NodeSize, NodesPerBlock> >
+{
+   public:
+   static shared_node_pool &instance()
+   {  return pool_singleton<shared_node_pool>::instance();  }
+};
+
+}  //namespace container_detail {
+}  //namespace container {
+}  //namespace boost {
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_CONTAINER_DETAIL_NODE_POOL_HPP
@@ -552,8 +552,7 @@ class rbtree
    rbtree(const rbtree& x)
       :  AllocHolder(x, x.key_comp())
    {
-      this->icont().clone_from
-         (x.icont(), typename AllocHolder::cloner(*this), Destroyer(this->node_alloc()));
+      this->clone_icont(x.icont());
    }
 
    rbtree(BOOST_RV_REF(rbtree) x)
@@ -563,8 +562,7 @@ class rbtree
    rbtree(const rbtree& x, const allocator_type &a)
       :  AllocHolder(a, x.key_comp())
    {
-      this->icont().clone_from
-         (x.icont(), typename AllocHolder::cloner(*this), Destroyer(this->node_alloc()));
+      this->clone_icont(x.icont());
    }
 
    rbtree(BOOST_RV_REF(rbtree) x, const allocator_type &a)
@@ -574,8 +572,7 @@ class rbtree
          this->icont().swap(x.icont());
       }
       else{
-         this->icont().clone_from
-            (x.icont(), typename AllocHolder::cloner(*this), Destroyer(this->node_alloc()));
+         this->clone_icont(x.icont());
       }
    }
 
@@ -915,17 +912,11 @@ class rbtree
    template <class InputIterator>
    void insert_unique(InputIterator first, InputIterator last)
    {
-      if(this->empty()){
-         //Insert with end hint, to achieve linear
-         //complexity if [first, last) is ordered
-         const_iterator hint(this->cend());
-         for( ; first != last; ++first)
-            hint = this->insert_unique(hint, *first);
-      }
-      else{
-         for( ; first != last; ++first)
-            this->insert_unique(*first);
-      }
+      container_detail::bool_
+         < container_detail::is_input_iterator<InputIterator>::value
+            || container_detail::is_same<alloc_version, allocator_v1>::value
+         > one_by_one;
+      this->priv_insert_unique_range(first, last, one_by_one);
    }
 
    iterator insert_equal(const value_type& v)
@@ -957,11 +948,11 @@ class rbtree
    template <class InputIterator>
    void insert_equal(InputIterator first, InputIterator last)
    {
-      //Insert with end hint, to achieve linear
-      //complexity if [first, last) is ordered
-      const_iterator hint(this->cend());
-      for( ; first != last; ++first)
-         hint = this->insert_equal(hint, *first);
+      container_detail::bool_
+         < container_detail::is_input_iterator<InputIterator>::value
+            || container_detail::is_same<alloc_version, allocator_v1>::value
+         > one_by_one;
+      this->priv_insert_equal_range(first, last, one_by_one);
    }
 
    iterator erase(const_iterator position)
@@ -1015,6 +1006,48 @@ class rbtree
 
    private:
 
+   template <class InputIterator>
+   void priv_insert_unique_range(InputIterator first, InputIterator last, container_detail::true_)
+   {
+      if(this->empty()){
+         //Insert with end hint, to achieve linear
+         //complexity if [first, last) is ordered
+         const_iterator hint(this->cend());
+         for( ; first != last; ++first)
+            hint = this->insert_unique(hint, *first);
+      }
+      else{
+         for( ; first != last; ++first)
+            this->insert_unique(*first);
+      }
+   }
+
+   template <class InputIterator>
+   void priv_insert_unique_range(InputIterator first, InputIterator last, container_detail::false_)
+   {
+      //Optimized allocation and construction
+      this->allocate_many_and_construct
+         (first, std::distance(first, last), insert_unique_end_hint_functor(*this));
+   }
+
+   template <class InputIterator>
+   void priv_insert_equal_range(InputIterator first, InputIterator last, container_detail::true_)
+   {
+      //Insert with end hint, to achieve linear
+      //complexity if [first, last) is ordered
+      const_iterator hint(this->cend());
+      for( ; first != last; ++first)
+         hint = this->insert_equal(hint, *first);
+   }
+
+   template <class InputIterator>
+   void priv_insert_equal_range(InputIterator first, InputIterator last, container_detail::false_)
+   {
+      //Optimized allocation and construction
+      this->allocate_many_and_construct
+         (first, std::distance(first, last), insert_equal_end_hint_functor(this->icont()));
+   }
+
    class insert_equal_end_hint_functor;
    friend class insert_equal_end_hint_functor;
 
@@ -1032,6 +1065,28 @@ class rbtree
       {  this->icont_.insert_equal(cend_, n); }
    };
 
+   class insert_unique_end_hint_functor;
+   friend class insert_unique_end_hint_functor;
+
+   class insert_unique_end_hint_functor
+   {
+      rbtree &tree_;
+      const iconst_iterator cend_;
+
+      public:
+      insert_unique_end_hint_functor(rbtree &tree)
+         :  tree_(tree), cend_(tree.icont().cend())
+      {}
+
+      void operator()(Node &n)
+      {
+         //Equivalent elements are discarded
+         if(&*this->tree_.icont().insert_unique(cend_, n) != &n){
+            this->tree_.AllocHolder::destroy_node(NodePtr(&n));
+         }
+      }
+   };
+
    class push_back_functor;
    friend class push_back_functor;
 
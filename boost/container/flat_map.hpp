@@ -114,6 +114,7 @@ class flat_map
    typedef typename impl_tree_t::value_type              impl_value_type;
    typedef typename impl_tree_t::const_iterator          impl_const_iterator;
    typedef typename impl_tree_t::allocator_type          impl_allocator_type;
+   typedef typename impl_tree_t::sequence_type           impl_sequence_type;
    typedef container_detail::flat_tree_value_compare
       < Compare
       , container_detail::select1st< std::pair<Key, T> >
@@ -152,6 +153,7 @@ class flat_map
    typedef BOOST_CONTAINER_IMPDEF(const_iterator_impl)                              const_iterator;
    typedef BOOST_CONTAINER_IMPDEF(reverse_iterator_impl)                            reverse_iterator;
    typedef BOOST_CONTAINER_IMPDEF(const_reverse_iterator_impl)                      const_reverse_iterator;
+   typedef typename BOOST_CONTAINER_IMPDEF(tree_t::sequence_type)                   sequence_type;
    typedef BOOST_CONTAINER_IMPDEF(impl_value_type)                                  movable_value_type;
 
    public:
@@ -662,8 +664,8 @@ class flat_map
    //! <b>Effects</b>: inserts each element from the range [first,last) if and only
    //!   if there is no element with key equivalent to the key of that element.
    //!
-   //! <b>Complexity</b>: At most N log(size()+N) (N is the distance from first to last)
-   //!   search time plus N*size() insertion time.
+   //! <b>Complexity</b>: N log(N) comparisons to sort the range (N is the distance from
+   //!   first to last) plus a merge with the stored elements, linear to size()+N.
    //!
    //! <b>Note</b>: If an element is inserted it might invalidate elements.
    template <class InputIterator>
@@ -687,6 +689,40 @@ class flat_map
    void insert(ordered_unique_range_t, InputIterator first, InputIterator last)
       {  m_flat_tree.insert_unique(ordered_unique_range, first, last); }
 
+   //! <b>Effects</b>: Moves each element of x to *this if and only if there is no
+   //!   element in *this with key equivalent to the key of that element. Elements
+   //!   that are not moved are destroyed and x is left empty.
+   //!
+   //! <b>Complexity</b>: Linear to size()+x.size().
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void merge(BOOST_RV_REF(flat_map) x)
+      {  m_flat_tree.merge_unique(x.m_flat_tree);  }
+
+   //! <b>Effects</b>: Discards the stored elements and takes ownership of the
+   //!   elements of seq, which are then ordered. Only the first of several
+   //!   elements with equivalent keys is kept.
+   //!   Elements are moved, never copied.
+   //!
+   //! <b>Complexity</b>: N log(N) (N is seq.size()). Linear if seq is already ordered.
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void adopt_sequence(BOOST_RV_REF(sequence_type) seq)
+      {  m_flat_tree.adopt_sequence_unique(boost::move(container_detail::force<impl_sequence_type>(seq)));  }
+
+   //! <b>Requires</b>: seq must be ordered according to the predicate and must
+   //!   not contain elements with equivalent keys.
+   //!
+   //! <b>Effects</b>: Discards the stored elements and takes ownership of seq's
+   //!   buffer if get_allocator() == seq.get_allocator(). Otherwise elements are
+   //!   moved one by one. No comparison is performed.
+   //!
+   //! <b>Complexity</b>: Constant if allocators compare equal, linear otherwise.
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void adopt_sequence(ordered_unique_range_t, BOOST_RV_REF(sequence_type) seq)
+      {  m_flat_tree.adopt_sequence_unique(ordered_unique_range, boost::move(container_detail::force<impl_sequence_type>(seq)));  }
+
    //! <b>Effects</b>: Erases the element pointed to by position.
    //!
    //! <b>Returns</b>: Returns an iterator pointing to the element immediately
@@ -965,6 +1001,7 @@ class flat_multimap
    typedef typename impl_tree_t::value_type              impl_value_type;
    typedef typename impl_tree_t::const_iterator          impl_const_iterator;
    typedef typename impl_tree_t::allocator_type          impl_allocator_type;
+   typedef typename impl_tree_t::sequence_type           impl_sequence_type;
    typedef container_detail::flat_tree_value_compare
       < Compare
       , container_detail::select1st< std::pair<Key, T> >
@@ -1003,6 +1040,7 @@ class flat_multimap
    typedef BOOST_CONTAINER_IMPDEF(const_iterator_impl)                              const_iterator;
    typedef BOOST_CONTAINER_IMPDEF(reverse_iterator_impl)                            reverse_iterator;
    typedef BOOST_CONTAINER_IMPDEF(const_reverse_iterator_impl)                      const_reverse_iterator;
+   typedef typename BOOST_CONTAINER_IMPDEF(tree_t::sequence_type)                   sequence_type;
    typedef BOOST_CONTAINER_IMPDEF(impl_value_type)                                  movable_value_type;
 
    //////////////////////////////////////////////
@@ -1439,8 +1477,8 @@ class flat_multimap
    //!
    //! <b>Effects</b>: inserts each element from the range [first,last) .
    //!
-   //! <b>Complexity</b>: At most N log(size()+N) (N is the distance from first to last)
-   //!   search time plus N*size() insertion time.
+   //! <b>Complexity</b>: N log(N) comparisons to sort the range (N is the distance from
+   //!   first to last) plus a merge with the stored elements, linear to size()+N.
    //!
    //! <b>Note</b>: If an element is inserted it might invalidate elements.
    template <class InputIterator>
@@ -1463,6 +1501,38 @@ class flat_multimap
    void insert(ordered_range_t, InputIterator first, InputIterator last)
       {  m_flat_tree.insert_equal(ordered_range, first, last); }
 
+   //! <b>Effects</b>: Moves all the elements of x to *this. Elements of x are placed
+   //!   after the elements of *this with equivalent keys and x is left empty.
+   //!
+   //! <b>Complexity</b>: Linear to size()+x.size().
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void merge(BOOST_RV_REF(flat_multimap) x)
+      {  m_flat_tree.merge_equal(x.m_flat_tree);  }
+
+   //! <b>Effects</b>: Discards the stored elements and takes ownership of the
+   //!   elements of seq, which are then ordered. The relative order of elements
+   //!   with equivalent keys is preserved.
+   //!   Elements are moved, never copied.
+   //!
+   //! <b>Complexity</b>: N log(N) (N is seq.size()). Linear if seq is already ordered.
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void adopt_sequence(BOOST_RV_REF(sequence_type) seq)
+      {  m_flat_tree.adopt_sequence_equal(boost::move(container_detail::force<impl_sequence_type>(seq)));  }
+
+   //! <b>Requires</b>: seq must be ordered according to the predicate.
+   //!
+   //! <b>Effects</b>: Discards the stored elements and takes ownership of seq's
+   //!   buffer if get_allocator() == seq.get_allocator(). Otherwise elements are
+   //!   moved one by one. No comparison is performed.
+   //!
+   //! <b>Complexity</b>: Constant if allocators compare equal, linear otherwise.
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void adopt_sequence(ordered_range_t, BOOST_RV_REF(sequence_type) seq)
+      {  m_flat_tree.adopt_sequence_equal(ordered_range, boost::move(container_detail::force<impl_sequence_type>(seq)));  }
+
    //! <b>Effects</b>: Erases the element pointed to by position.
    //!
    //! <b>Returns</b>: Returns an iterator pointing to the element immediately
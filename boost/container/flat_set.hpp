@@ -97,6 +97,7 @@ class flat_set
    typedef typename BOOST_CONTAINER_IMPDEF(tree_t::const_iterator)                     const_iterator;
    typedef typename BOOST_CONTAINER_IMPDEF(tree_t::reverse_iterator)                   reverse_iterator;
    typedef typename BOOST_CONTAINER_IMPDEF(tree_t::const_reverse_iterator)             const_reverse_iterator;
+   typedef typename BOOST_CONTAINER_IMPDEF(tree_t::sequence_type)                      sequence_type;
 
    public:
    //////////////////////////////////////////////
@@ -513,8 +514,8 @@ class flat_set
    //! <b>Effects</b>: inserts each element from the range [first,last) if and only
    //!   if there is no element with key equivalent to the key of that element.
    //!
-   //! <b>Complexity</b>: At most N log(size()+N) (N is the distance from first to last)
-   //!   search time plus N*size() insertion time.
+   //! <b>Complexity</b>: N log(N) comparisons to sort the range (N is the distance from
+   //!   first to last) plus a merge with the stored elements, linear to size()+N.
    //!
    //! <b>Note</b>: If an element is inserted it might invalidate elements.
    template <class InputIterator>
@@ -536,6 +537,40 @@ class flat_set
    void insert(ordered_unique_range_t, InputIterator first, InputIterator last)
       {  m_flat_tree.insert_unique(ordered_unique_range, first, last);  }
 
+   //! <b>Effects</b>: Moves each element of x to *this if and only if there is no
+   //!   element in *this with value equivalent to the value of that element. Elements
+   //!   that are not moved are destroyed and x is left empty.
+   //!
+   //! <b>Complexity</b>: Linear to size()+x.size().
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void merge(BOOST_RV_REF(flat_set) x)
+      {  m_flat_tree.merge_unique(x.m_flat_tree);  }
+
+   //! <b>Effects</b>: Discards the stored elements and takes ownership of the
+   //!   elements of seq, which are then ordered. Only the first of several
+   //!   elements with equivalent values is kept.
+   //!   Elements are moved, never copied.
+   //!
+   //! <b>Complexity</b>: N log(N) (N is seq.size()). Linear if seq is already ordered.
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void adopt_sequence(BOOST_RV_REF(sequence_type) seq)
+      {  m_flat_tree.adopt_sequence_unique(boost::move(seq));  }
+
+   //! <b>Requires</b>: seq must be ordered according to the predicate and must
+   //!   not contain elements with equivalent values.
+   //!
+   //! <b>Effects</b>: Discards the stored elements and takes ownership of seq's
+   //!   buffer if get_allocator() == seq.get_allocator(). Otherwise elements are
+   //!   moved one by one. No comparison is performed.
+   //!
+   //! <b>Complexity</b>: Constant if allocators compare equal, linear otherwise.
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void adopt_sequence(ordered_unique_range_t, BOOST_RV_REF(sequence_type) seq)
+      {  m_flat_tree.adopt_sequence_unique(ordered_unique_range, boost::move(seq));  }
+
    //! <b>Effects</b>: Erases the element pointed to by position.
    //!
    //! <b>Returns</b>: Returns an iterator pointing to the element immediately
@@ -802,6 +837,7 @@ class flat_multiset
    typedef typename BOOST_CONTAINER_IMPDEF(tree_t::const_iterator)                     const_iterator;
    typedef typename BOOST_CONTAINER_IMPDEF(tree_t::reverse_iterator)                   reverse_iterator;
    typedef typename BOOST_CONTAINER_IMPDEF(tree_t::const_reverse_iterator)             const_reverse_iterator;
+   typedef typename BOOST_CONTAINER_IMPDEF(tree_t::sequence_type)                      sequence_type;
 
    //! <b>Effects</b>: Default constructs an empty flat_multiset.
    //!
@@ -1176,8 +1212,8 @@ class flat_multiset
    //!
    //! <b>Effects</b>: inserts each element from the range [first,last) .
    //!
-   //! <b>Complexity</b>: At most N log(size()+N) (N is the distance from first to last)
-   //!   search time plus N*size() insertion time.
+   //! <b>Complexity</b>: N log(N) comparisons to sort the range (N is the distance from
+   //!   first to last) plus a merge with the stored elements, linear to size()+N.
    //!
    //! <b>Note</b>: If an element is inserted it might invalidate elements.
    template <class InputIterator>
@@ -1198,6 +1234,38 @@ class flat_multiset
    void insert(ordered_range_t, InputIterator first, InputIterator last)
       {  m_flat_tree.insert_equal(ordered_range, first, last);  }
 
+   //! <b>Effects</b>: Moves all the elements of x to *this. Elements of x are placed
+   //!   after the elements of *this with equivalent values and x is left empty.
+   //!
+   //! <b>Complexity</b>: Linear to size()+x.size().
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void merge(BOOST_RV_REF(flat_multiset) x)
+      {  m_flat_tree.merge_equal(x.m_flat_tree);  }
+
+   //! <b>Effects</b>: Discards the stored elements and takes ownership of the
+   //!   elements of seq, which are then ordered. The relative order of elements
+   //!   with equivalent values is preserved.
+   //!   Elements are moved, never copied.
+   //!
+   //! <b>Complexity</b>: N log(N) (N is seq.size()). Linear if seq is already ordered.
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void adopt_sequence(BOOST_RV_REF(sequence_type) seq)
+      {  m_flat_tree.adopt_sequence_equal(boost::move(seq));  }
+
+   //! <b>Requires</b>: seq must be ordered according to the predicate.
+   //!
+   //! <b>Effects</b>: Discards the stored elements and takes ownership of seq's
+   //!   buffer if get_allocator() == seq.get_allocator(). Otherwise elements are
+   //!   moved one by one. No comparison is performed.
+   //!
+   //! <b>Complexity</b>: Constant if allocators compare equal, linear otherwise.
+   //!
+   //! <b>Note</b>: Non-standard extension. Invalidates all iterators and references.
+   void adopt_sequence(ordered_range_t, BOOST_RV_REF(sequence_type) seq)
+      {  m_flat_tree.adopt_sequence_equal(ordered_range, boost::move(seq));  }
+
    //! <b>Effects</b>: Erases the element pointed to by position.
    //!
    //! <b>Returns</b>: Returns an iterator pointing to the element immediately
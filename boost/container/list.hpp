@@ -937,10 +937,12 @@ class list
          >::type * = 0
       )
    {
-      //Optimized allocation and construction
-      insertion_functor func(this->icont(), p.get());
-      this->allocate_many_and_construct(first, std::distance(first, last), func);
-      return iterator(func.inserted_first());
+      //Optimized allocation and construction. The functor is copied, so
+      //it stores the position of the first inserted element in "ret"
+      typename Icont::iterator ret(p.get().unconst());
+      this->allocate_many_and_construct
+         (first, std::distance(first, last), insertion_functor(this->icont(), p.get(), ret));
+      return iterator(ret);
    }
    #endif
 
@@ -1386,12 +1388,12 @@ class list
       typedef typename Icont::const_iterator iconst_iterator;
 
       const iconst_iterator pos_;
-      iiterator ret_;
+      iiterator &ret_;
       bool first_;
 
       public:
-      insertion_functor(Icont &icont, typename Icont::const_iterator pos)
-         :  icont_(icont), pos_(pos), ret_(pos.unconst()), first_(true)
+      insertion_functor(Icont &icont, typename Icont::const_iterator pos, iiterator &ret)
+         :  icont_(icont), pos_(pos), ret_(ret), first_(true)
       {}
 
       void operator()(Node &n)
@@ -1404,9 +1406,6 @@ class list
             this->icont_.insert(pos_, n);
          }
       }
-
-      iiterator inserted_first() const
-      {  return ret_;   }
    };
 
    //Functors for member algorithm defaults
@@ -0,0 +1,123 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_NODE_ALLOCATOR_HPP
+#define BOOST_CONTAINER_NODE_ALLOCATOR_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/detail/workaround.hpp>
+#include <boost/container/container_fwd.hpp>
+#include <boost/container/detail/version_type.hpp>
+#include <boost/container/detail/type_traits.hpp>
+#include <boost/container/detail/allocator_common.hpp>
+#include <boost/container/detail/node_pool.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>
+
+//!\file
+//!Describes node_allocator, a pooled STL compatible allocator for node containers
+
+namespace boost {
+namespace container {
+
+//!An STL node allocator that allocates nodes from a segregated storage pool
+//!placed in the heap. All node_allocators with the same sizeof(T) and
+//!NodesPerBlock share the same pool, which is protected by a spinlock, so
+//!containers using them can live in different threads.
+//!
+//!Nodes are allocated in blocks of NodesPerBlock nodes and they are never
+//!returned to the heap unless deallocate_free_blocks() is called. As
+//!node_allocator is a version 2 allocator, node containers obtain all the nodes
+//!of a range insertion or a copy with a single call to allocate_individual().
+//!Array allocations (e.g. vector's buffer) are forwarded to the heap.
+#if defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+template < class T
+         , std::size_t NodesPerBlock = 256
+         >
+#else
+template < class T
+         , std::size_t NodesPerBlock
+         >
+#endif
+class node_allocator
+   /// @cond
+   :  public container_detail::pool_allocation_impl
+         < node_allocator<T, NodesPerBlock>, T >
+   /// @endcond
+{
+   /// @cond
+   BOOST_STATIC_ASSERT((NodesPerBlock > 0));
+   typedef container_detail::pool_allocation_impl
+      < node_allocator<T, NodesPerBlock>, T >   base_t;
+   friend class container_detail::pool_allocation_impl
+      < node_allocator<T, NodesPerBlock>, T >;
+   typedef container_detail::shared_node_pool
+      < container_detail::sizeof_value<T>::value
+      , NodesPerBlock>                          node_pool_t;
+
+   node_pool_t &get_node_pool() const
+   {  return node_pool_t::instance();  }
+   /// @endcond
+
+   public:
+   typedef typename base_t::value_type          value_type;
+   typedef typename base_t::pointer             pointer;
+   typedef typename base_t::const_pointer       const_pointer;
+   typedef typename base_t::reference           reference;
+   typedef typename base_t::const_reference     const_reference;
+   typedef typename base_t::size_type           size_type;
+   typedef typename base_t::difference_type     difference_type;
+   typedef typename base_t::multiallocation_chain  multiallocation_chain;
+   typedef container_detail::version_type<node_allocator, 2>   version;
+
+   //!Obtains node_allocator from
+   //!node_allocator
+   template<class T2>
+   struct rebind
+   {
+      typedef node_allocator<T2, NodesPerBlock> other;
+   };
+
+   //!Default constructor. Never throws
+   node_allocator()
+   {}
+
+   //!Copy constructor from other node_allocator.
+   //!Never throws
+   node_allocator(const node_allocator &)
+   {}
+
+   //!Copy constructor from related node_allocator.
+   //!Never throws
+   template<class T2>
+   node_allocator(const node_allocator<T2, NodesPerBlock> &)
+   {}
+
+   //!All node_allocators of the same type share the pool,
+   //!so they always compare equal
+   friend bool operator==(const node_allocator &, const node_allocator &)
+   {  return true;   }
+
+   //!All node_allocators of the same type share the pool,
+   //!so they always compare equal
+   friend bool operator!=(const node_allocator &, const node_allocator &)
+   {  return false;   }
+};
+
+}  //namespace container {
+}  //namespace boost {
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_CONTAINER_NODE_ALLOCATOR_HPP
@@ -0,0 +1,177 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_PRIVATE_ADAPTIVE_POOL_HPP
+#define BOOST_CONTAINER_PRIVATE_ADAPTIVE_POOL_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/detail/workaround.hpp>
+#include <boost/container/container_fwd.hpp>
+#include <boost/container/detail/version_type.hpp>
+#include <boost/container/detail/type_traits.hpp>
+#include <boost/container/detail/allocator_common.hpp>
+#include <boost/container/detail/adaptive_node_pool.hpp>
+#include <boost/move/move.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>
+
+//!\file
+//!Describes private_adaptive_pool, an adaptive pool allocator with a pool per allocator
+
+namespace boost {
+namespace container {
+
+//!An STL node allocator that allocates nodes from an adaptive pool owned by
+//!the allocator. As the pool is not shared, no locking is needed and the memory
+//!of the pool is returned to the heap when the allocator is destroyed. Since the
+//!container holds the allocator, each container gets its own pool.
+//!
+//!The pool is created on the first node allocation. Copies of an allocator
+//!don't share its pool, so two private_adaptive_pools only compare equal if they
+//!are the same object. Allocators are moved and swapped (but not copied) along
+//!with the containers that own them, so the nodes of a container always return
+//!to the pool they come from.
+//!
+//!See adaptive_pool for the meaning of the template parameters.
+#if defined(BOOST_CONTAINER_DOXYGEN_INVOKED)
+template < class T
+         , std::size_t NodesPerBlock = 256
+         , std::size_t MaxFreeBlocks = 2
+         , unsigned char OverheadPercent = 5
+         >
+#else
+template < class T
+         , std::size_t NodesPerBlock
+         , std::size_t MaxFreeBlocks
+         , unsigned char OverheadPercent
+         >
+#endif
+class private_adaptive_pool
+   /// @cond
+   :  public container_detail::pool_allocation_impl
+         < private_adaptive_pool<T, NodesPerBlock, MaxFreeBlocks, OverheadPercent>, T >
+   /// @endcond
+{
+   /// @cond
+   BOOST_STATIC_ASSERT((NodesPerBlock > 0));
+   typedef container_detail::pool_allocation_impl
+      < private_adaptive_pool<T, NodesPerBlock, MaxFreeBlocks, OverheadPercent>, T >   base_t;
+   friend class container_detail::pool_allocation_impl
+      < private_adaptive_pool<T, NodesPerBlock, MaxFreeBlocks, OverheadPercent>, T >;
+   typedef container_detail::private_adaptive_node_pool
+      < container_detail::sizeof_value<T>::value, NodesPerBlock
+      , MaxFreeBlocks, OverheadPercent>         node_pool_t;
+   BOOST_COPYABLE_AND_MOVABLE(private_adaptive_pool)
+
+   node_pool_t &get_node_pool()
+   {
+      if(!mp_node_pool){
+         mp_node_pool = new node_pool_t;
+      }
+      return *mp_node_pool;
+   }
+   /// @endcond
+
+   public:
+   typedef typename base_t::value_type          value_type;
+   typedef typename base_t::pointer             pointer;
+   typedef typename base_t::const_pointer       const_pointer;
+   typedef typename base_t::reference           reference;
+   typedef typename base_t::const_reference     const_reference;
+   typedef typename base_t::size_type           size_type;
+   typedef typename base_t::difference_type     difference_type;
+   typedef typename base_t::multiallocation_chain  multiallocation_chain;
+   typedef container_detail::version_type<private_adaptive_pool, 2>   version;
+
+   typedef container_detail::false_type         propagate_on_container_copy_assignment;
+   typedef container_detail::true_type          propagate_on_container_move_assignment;
+   typedef container_detail::true_type          propagate_on_container_swap;
+
+   //!Obtains private_adaptive_pool from
+   //!private_adaptive_pool
+   template<class T2>
+   struct rebind
+   {
+      typedef private_adaptive_pool<T2, NodesPerBlock, MaxFreeBlocks, OverheadPercent> other;
+   };
+
+   //!Default constructor. The pool is created on the
+   //!first node allocation. Never throws
+   private_adaptive_pool()
+      :  mp_node_pool(0)
+   {}
+
+   //!Constructs an allocator with a new pool. Never throws
+   private_adaptive_pool(const private_adaptive_pool &)
+      :  mp_node_pool(0)
+   {}
+
+   //!Constructs an allocator with a new pool. Never throws
+   template<class T2>
+   private_adaptive_pool(const private_adaptive_pool<T2, NodesPerBlock, MaxFreeBlocks, OverheadPercent> &)
+      :  mp_node_pool(0)
+   {}
+
+   //!Move constructor. Steals the pool of other. Never throws
+   private_adaptive_pool(BOOST_RV_REF(private_adaptive_pool) other)
+      :  mp_node_pool(other.mp_node_pool)
+   {  other.mp_node_pool = 0;  }
+
+   //!Keeps the pool of *this, as it might still hold allocated nodes.
+   //!Never throws
+   private_adaptive_pool &operator=(BOOST_COPY_ASSIGN_REF(private_adaptive_pool))
+   {  return *this;  }
+
+   //!Exchanges the pools of *this and other. Never throws
+   private_adaptive_pool &operator=(BOOST_RV_REF(private_adaptive_pool) other)
+   {
+      node_pool_t *const tmp = mp_node_pool;
+      mp_node_pool = other.mp_node_pool;
+      other.mp_node_pool = tmp;
+      return *this;
+   }
+
+   //!Destroys the pool, returning all its memory to the heap.
+   //!All nodes must have been deallocated. Never throws
+   ~private_adaptive_pool()
+   {  delete mp_node_pool;  }
+
+   //!Exchanges the pools of x and y. Never throws
+   friend void swap(private_adaptive_pool &x, private_adaptive_pool &y)
+   {
+      node_pool_t *const tmp = x.mp_node_pool;
+      x.mp_node_pool = y.mp_node_pool;
+      y.mp_node_pool = tmp;
+   }
+
+   //!Equal only if x and y are the same object
+   friend bool operator==(const private_adaptive_pool &x, const private_adaptive_pool &y)
+   {  return &x == &y;   }
+
+   //!Equal only if x and y are the same object
+   friend bool operator!=(const private_adaptive_pool &x, const private_adaptive_pool &y)
+   {  return &x != &y;   }
+
+   /// @cond
+   private:
+   node_pool_t *mp_node_pool;
+   /// @endcond
+};
+
+}  //namespace container {
+}  //namespace boost {
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_CONTAINER_PRIVATE_ADAPTIVE_POOL_HPP
@@ -904,10 +904,12 @@ class slist
          >::type * = 0
       )
    {
-      //Optimized allocation and construction
-      insertion_functor func(this->icont(), prev.get());
-      this->allocate_many_and_construct(first, std::distance(first, last), func);
-      return iterator(func.inserted_first());
+      //Optimized allocation and construction. The functor is copied, so
+      //it stores the position of the last inserted element in "ret"
+      typename Icont::iterator ret(prev.get().unconst());
+      this->allocate_many_and_construct
+         (first, std::distance(first, last), insertion_functor(this->icont(), ret));
+      return iterator(ret);
    }
    #endif
 
@@ -1559,21 +1561,17 @@ class slist
       Icont &icont_;
       typedef typename Icont::iterator       iiterator;
       typedef typename Icont::const_iterator iconst_iterator;
-      const iconst_iterator prev_;
-      iiterator   ret_;
+      iiterator &prev_;
 
       public:
-      insertion_functor(Icont &icont, typename Icont::const_iterator prev)
-         :  icont_(icont), prev_(prev), ret_(prev.unconst())
+      insertion_functor(Icont &icont, iiterator &prev)
+         :  icont_(icont), prev_(prev)
       {}
 
       void operator()(Node &n)
       {
-         ret_ = this->icont_.insert_after(prev_, n);
+         prev_ = this->icont_.insert_after(prev_, n);
       }
-
-      iiterator inserted_first() const
-      {  return ret_;   }
    };
 
    //Functors for member algorithm defaults
@@ -0,0 +1,356 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_SMALL_VECTOR_HPP
+#define BOOST_CONTAINER_SMALL_VECTOR_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/detail/workaround.hpp>
+#include <boost/container/container_fwd.hpp>
+#include <boost/container/vector.hpp>
+#include <boost/container/allocator_traits.hpp>
+#include <boost/container/detail/version_type.hpp>
+#include <boost/container/detail/allocation_type.hpp>
+#include <boost/container/detail/type_traits.hpp>
+#include <boost/move/move.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace boost {
+namespace container {
+
+/// @cond
+
+namespace container_detail {
+
+//!An allocator with room for N objects of type T in itself. The first
+//!allocation of N or less objects made by the vector that owns it is
+//!served from the internal buffer, the rest are forwarded to Allocator.
+//!Copies of the allocator don't share the internal buffer, so they never
+//!compare equal and they are never propagated. Elements are constructed
+//!with placement new, as Allocator's construct would not be found
+//!through this wrapper.
+template<class T, std::size_t N, class Allocator>
+class small_vector_allocator
+{
+   typedef allocator_traits<Allocator>       traits_type;
+   BOOST_STATIC_ASSERT((N > 0));
+   BOOST_STATIC_ASSERT((is_same<typename traits_type::pointer, T*>::value));
+
+   public:
+   typedef T                                          value_type;
+   typedef T*                                         pointer;
+   typedef const T*                                   const_pointer;
+   typedef T&                                         reference;
+   typedef const T&                                   const_reference;
+   typedef typename traits_type::size_type            size_type;
+   typedef typename traits_type::difference_type      difference_type;
+   typedef version_type<small_vector_allocator, 2>    version;
+   typedef container_detail::false_type               propagate_on_container_copy_assignment;
+   typedef container_detail::false_type               propagate_on_container_move_assignment;
+   typedef container_detail::false_type               propagate_on_container_swap;
+
+   small_vector_allocator()
+      :  m_alloc()
+   {}
+
+   small_vector_allocator(const Allocator &a)
+      :  m_alloc(a)
+   {}
+
+   //The internal buffer is never copied
+   small_vector_allocator(const small_vector_allocator &x)
+      :  m_alloc(x.m_alloc)
+   {}
+
+   small_vector_allocator &operator=(const small_vector_allocator &x)
+   {
+      m_alloc = x.m_alloc;
+      return *this;
+   }
+
+   pointer allocate(size_type count)
+   {  return traits_type::allocate(m_alloc, count);  }
+
+   void deallocate(const pointer &p, size_type count)
+   {
+      if(p != this->internal_storage()){
+         traits_type::deallocate(m_alloc, p, count);
+      }
+   }
+
+   size_type max_size() const
+   {  return traits_type::max_size(m_alloc);  }
+
+   //The vector only holds a buffer, so the internal buffer is free
+   //unless "reuse" points to it. Expansions are not supported.
+   std::pair<pointer, bool>
+      allocation_command(allocation_type command,
+                         size_type limit_size,
+                         size_type preferred_size,
+                         size_type &received_size,
+                         const pointer &reuse = pointer())
+   {
+      if(!(command & allocate_new)){
+         return std::pair<pointer, bool>(pointer(), false);
+      }
+      if(limit_size <= N && reuse != this->internal_storage()){
+         received_size = N;
+         return std::pair<pointer, bool>(this->internal_storage(), false);
+      }
+      received_size = preferred_size;
+      return std::pair<pointer, bool>(this->allocate(preferred_size), false);
+   }
+
+   //! Returns a copy of the allocator used when the internal buffer is exhausted.
+   Allocator get_allocator() const
+   {  return m_alloc;  }
+
+   pointer internal_storage() const
+   {  return static_cast<pointer>(const_cast<void*>(static_cast<const void*>(m_storage.address())));  }
+
+   friend bool operator==(const small_vector_allocator &x, const small_vector_allocator &y)
+   {  return &x == &y;  }
+
+   friend bool operator!=(const small_vector_allocator &x, const small_vector_allocator &y)
+   {  return &x != &y;  }
+
+   private:
+   Allocator m_alloc;
+   boost::aligned_storage<sizeof(T)*N, boost::alignment_of<T>::value> m_storage;
+};
+
+}  //namespace container_detail {
+
+/// @endcond
+
+//! \class small_vector
+//! A small_vector is a vector that stores up to N elements in an internal
+//! buffer, without allocating memory. When more elements are needed the elements
+//! are moved to a buffer obtained from Allocator, like a vector does, so
+//! containers that usually hold few elements don't pay for allocations.
+//!
+//! small_vector derives from vector, so insertion, emplacement and element
+//! move semantics are the same as vector's. Unlike vector, moving or swapping
+//! small_vectors moves the elements one by one when they are in the internal buffer,
+//! so iterators are invalidated.
+#ifdef BOOST_CONTAINER_DOXYGEN_INVOKED
+template <class T, std::size_t N, class Allocator = std::allocator<T> >
+#else
+template <class T, std::size_t N, class Allocator>
+#endif
+class small_vector
+   : public vector<T, container_detail::small_vector_allocator<T, N, Allocator> >
+{
+   /// @cond
+   typedef vector<T, container_detail::small_vector_allocator<T, N, Allocator> > base_t;
+   BOOST_COPYABLE_AND_MOVABLE(small_vector)
+   /// @endcond
+
+   public:
+   typedef typename base_t::value_type       value_type;
+   typedef typename base_t::size_type        size_type;
+   typedef typename base_t::allocator_type   allocator_type;
+   typedef typename base_t::iterator         iterator;
+   typedef typename base_t::const_iterator   const_iterator;
+
+   //! The number of elements that fit in the internal buffer.
+   static const size_type static_capacity = N;
+
+   //! <b>Effects</b>: Constructs an empty small_vector.
+   //!
+   //! <b>Postcondition</b>: capacity() == N.
+   //!
+   //! <b>Throws</b>: If Allocator's default constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant.
+   small_vector()
+      :  base_t()
+   {  this->reserve(N);  }
+
+   //! <b>Effects</b>: Constructs an empty small_vector that will use a copy
+   //!   of a when more than N elements are stored.
+   //!
+   //! <b>Throws</b>: If Allocator's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant.
+   explicit small_vector(const allocator_type &a)
+      :  base_t(a)
+   {  this->reserve(N);  }
+
+   //! <b>Effects</b>: Constructs a small_vector with n value initialized elements.
+   //!
+   //! <b>Throws</b>: If allocation throws or T's default constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   explicit small_vector(size_type n)
+      :  base_t()
+   {  this->reserve(N);  this->resize(n);  }
+
+   //! <b>Effects</b>: Constructs a small_vector that will use a copy of allocator a
+   //!   and inserts n copies of value.
+   //!
+   //! <b>Throws</b>: If allocation throws or T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   small_vector(size_type n, const T &value, const allocator_type &a = allocator_type())
+      :  base_t(a)
+   {  this->reserve(N);  this->resize(n, value);  }
+
+   //! <b>Effects</b>: Constructs a small_vector that will use a copy of allocator a
+   //!   and inserts a copy of the range [first, last).
+   //!
+   //! <b>Throws</b>: If allocation throws or T's constructor taking
+   //!   a dereferenced InIt throws.
+   //!
+   //! <b>Complexity</b>: Linear to the range [first, last).
+   template <class InIt>
+   small_vector(InIt first, InIt last, const allocator_type &a = allocator_type())
+      :  base_t(a)
+   {  this->reserve(N);  this->assign(first, last);  }
+
+   //! <b>Effects</b>: Copy constructs a small_vector.
+   //!
+   //! <b>Postcondition</b>: x == *this.
+   //!
+   //! <b>Throws</b>: If allocation throws or T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the elements x contains.
+   small_vector(const small_vector &x)
+      :  base_t(x.get_stored_allocator())
+   {
+      this->reserve(N);
+      this->assign(x.begin(), x.end());
+   }
+
+   //! <b>Effects</b>: Move constructor. If x's elements are in the internal buffer
+   //!   they are moved one by one, otherwise x's memory is transferred to *this.
+   //!   x is left empty.
+   //!
+   //! <b>Throws</b>: If T's move constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant if x had allocated memory, linear to
+   //!   the elements x contains otherwise.
+   small_vector(BOOST_RV_REF(small_vector) x)
+      :  base_t(x.get_stored_allocator())
+   {
+      this->reserve(N);
+      this->priv_move_from(x);
+   }
+
+   //! <b>Effects</b>: Makes *this contain the same elements as x.
+   //!
+   //! <b>Postcondition</b>: this->size() == x.size(). *this contains a copy
+   //! of each of x's elements.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements in x.
+   small_vector& operator=(BOOST_COPY_ASSIGN_REF(small_vector) x)
+   {
+      if (&x != this){
+         this->assign(x.begin(), x.end());
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Move assignment. All x's values are transferred to *this
+   //!   like in the move constructor.
+   //!
+   //! <b>Throws</b>: If T's move constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the elements *this contains, plus linear to the
+   //!   elements x contains if they were stored in the internal buffer.
+   small_vector& operator=(BOOST_RV_REF(small_vector) x)
+   {
+      if (&x != this){
+         this->clear();
+         this->priv_move_from(x);
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Swaps the contents of *this and x.
+   //!
+   //! <b>Throws</b>: If T's move constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant if both small_vectors have allocated memory,
+   //!   linear to the number of elements otherwise.
+   void swap(small_vector &x)
+   {
+      if(&x == this){
+         return;
+      }
+      else if(!this->priv_is_internal() && !x.priv_is_internal()){
+         base_t::swap(x);
+      }
+      else{
+         small_vector tmp(boost::move(x));
+         x = boost::move(*this);
+         *this = boost::move(tmp);
+      }
+   }
+
+   //! <b>Effects</b>: Tries to deallocate the excess of memory created
+   //!   with previous allocations. If size() <= N the elements are moved back
+   //!   to the internal buffer. The size of the small_vector is unchanged.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's move constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to size().
+   void shrink_to_fit()
+   {
+      if(!this->priv_is_internal() && this->capacity() > this->size()){
+         small_vector tmp(this->get_stored_allocator());
+         tmp.reserve(this->size());
+         tmp.insert(tmp.end(), boost::make_move_iterator(this->begin()), boost::make_move_iterator(this->end()));
+         this->swap(tmp);
+      }
+   }
+
+   /// @cond
+   private:
+   bool priv_is_internal() const
+   {  return this->data() == this->get_stored_allocator().internal_storage();  }
+
+   //Precondition: this->empty()
+   void priv_move_from(small_vector &x)
+   {
+      if(x.priv_is_internal()){
+         this->insert(this->end(), boost::make_move_iterator(x.begin()), boost::make_move_iterator(x.end()));
+         x.clear();
+      }
+      else{
+         //Release our buffer, steal x's and give x back its internal buffer
+         base_t::shrink_to_fit();
+         base_t::swap(x);
+         x.reserve(N);
+      }
+   }
+   /// @endcond
+};
+
+template <class T, std::size_t N, class Allocator>
+inline void swap(small_vector<T, N, Allocator> &x, small_vector<T, N, Allocator> &y)
+{  x.swap(y);  }
+
+}}
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif //   #ifndef  BOOST_CONTAINER_SMALL_VECTOR_HPP
@@ -0,0 +1,291 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_STATIC_VECTOR_HPP
+#define BOOST_CONTAINER_STATIC_VECTOR_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/detail/workaround.hpp>
+#include <boost/container/container_fwd.hpp>
+#include <boost/container/vector.hpp>
+#include <boost/container/detail/version_type.hpp>
+#include <boost/container/detail/allocation_type.hpp>
+#include <boost/container/detail/type_traits.hpp>
+#include <boost/move/move.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>
+#include <utility>
+#include <new>
+
+namespace boost {
+namespace container {
+
+/// @cond
+
+namespace container_detail {
+
+//!An allocator that serves a single buffer of N objects of type T
+//!stored in itself. Requests that don't fit in the buffer throw
+//!std::bad_alloc. Copies of the allocator don't share the buffer,
+//!so they never compare equal and they are never propagated.
+template<class T, std::size_t N>
+class static_vector_allocator
+{
+   BOOST_STATIC_ASSERT((N > 0));
+
+   public:
+   typedef T                                          value_type;
+   typedef T*                                         pointer;
+   typedef const T*                                   const_pointer;
+   typedef T&                                         reference;
+   typedef const T&                                   const_reference;
+   typedef std::size_t                                size_type;
+   typedef std::ptrdiff_t                             difference_type;
+   typedef version_type<static_vector_allocator, 2>   version;
+   typedef container_detail::false_type               propagate_on_container_copy_assignment;
+   typedef container_detail::false_type               propagate_on_container_move_assignment;
+   typedef container_detail::false_type               propagate_on_container_swap;
+
+   template<class T2>
+   struct rebind
+   {  typedef static_vector_allocator<T2, N> other;   };
+
+   static_vector_allocator()
+   {}
+
+   //The internal buffer is never copied
+   static_vector_allocator(const static_vector_allocator &)
+   {}
+
+   static_vector_allocator &operator=(const static_vector_allocator &)
+   {  return *this;  }
+
+   pointer allocate(size_type count)
+   {
+      if(count > N){
+         throw std::bad_alloc();
+      }
+      return this->internal_storage();
+   }
+
+   void deallocate(const pointer &, size_type)
+   {}
+
+   size_type max_size() const
+   {  return N;  }
+
+   //The vector only holds a buffer, so the internal buffer is free
+   //unless "reuse" points to it. Expansions are not supported.
+   std::pair<pointer, bool>
+      allocation_command(allocation_type command,
+                         size_type limit_size,
+                         size_type,
+                         size_type &received_size,
+                         const pointer &reuse = pointer())
+   {
+      if(!(command & allocate_new) || limit_size > N || reuse == this->internal_storage()){
+         if(command & nothrow_allocation){
+            return std::pair<pointer, bool>(pointer(), false);
+         }
+         throw std::bad_alloc();
+      }
+      received_size = N;
+      return std::pair<pointer, bool>(this->internal_storage(), false);
+   }
+
+   pointer internal_storage() const
+   {  return static_cast<pointer>(const_cast<void*>(static_cast<const void*>(m_storage.address())));  }
+
+   friend bool operator==(const static_vector_allocator &x, const static_vector_allocator &y)
+   {  return &x == &y;  }
+
+   friend bool operator!=(const static_vector_allocator &x, const static_vector_allocator &y)
+   {  return &x != &y;  }
+
+   private:
+   boost::aligned_storage<sizeof(T)*N, boost::alignment_of<T>::value> m_storage;
+};
+
+}  //namespace container_detail {
+
+/// @endcond
+
+//! \class static_vector
+//! A static_vector is a vector with a fixed capacity of N elements that are
+//! stored inside the static_vector object, so it never allocates memory.
+//! Operations that need more than N elements throw std::bad_alloc.
+//!
+//! static_vector derives from vector, so insertion, emplacement and element
+//! move semantics are the same as vector's. Unlike vector, moving or swapping
+//! static_vectors moves the elements one by one, so iterators are invalidated.
+template <class T, std::size_t N>
+class static_vector
+   : public vector<T, container_detail::static_vector_allocator<T, N> >
+{
+   /// @cond
+   typedef vector<T, container_detail::static_vector_allocator<T, N> > base_t;
+   BOOST_COPYABLE_AND_MOVABLE(static_vector)
+   /// @endcond
+
+   public:
+   typedef typename base_t::value_type       value_type;
+   typedef typename base_t::size_type        size_type;
+   typedef typename base_t::iterator         iterator;
+   typedef typename base_t::const_iterator   const_iterator;
+
+   //! The capacity of the static_vector.
+   static const size_type static_capacity = N;
+
+   //! <b>Effects</b>: Constructs an empty static_vector.
+   //!
+   //! <b>Postcondition</b>: capacity() == N.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   static_vector()
+      :  base_t()
+   {  this->reserve(N);  }
+
+   //! <b>Effects</b>: Constructs a static_vector with n value initialized elements.
+   //!
+   //! <b>Throws</b>: std::bad_alloc if n > N or T's default constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   explicit static_vector(size_type n)
+      :  base_t()
+   {  this->reserve(N);  this->resize(n);  }
+
+   //! <b>Effects</b>: Constructs a static_vector with n copies of value.
+   //!
+   //! <b>Throws</b>: std::bad_alloc if n > N or T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   static_vector(size_type n, const T &value)
+      :  base_t()
+   {  this->reserve(N);  this->resize(n, value);  }
+
+   //! <b>Effects</b>: Constructs a static_vector with a copy of the range [first, last).
+   //!
+   //! <b>Throws</b>: std::bad_alloc if the range has more than N elements
+   //!   or T's constructor taking a dereferenced InIt throws.
+   //!
+   //! <b>Complexity</b>: Linear to the range [first, last).
+   template <class InIt>
+   static_vector(InIt first, InIt last)
+      :  base_t()
+   {  this->reserve(N);  this->assign(first, last);  }
+
+   //! <b>Effects</b>: Copy constructs a static_vector.
+   //!
+   //! <b>Postcondition</b>: x == *this.
+   //!
+   //! <b>Throws</b>: If T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the elements x contains.
+   static_vector(const static_vector &x)
+      :  base_t()
+   {
+      this->reserve(N);
+      this->assign(x.begin(), x.end());
+   }
+
+   //! <b>Effects</b>: Move constructor. Moves x's elements one by one to *this.
+   //!   x is left empty.
+   //!
+   //! <b>Throws</b>: If T's move constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the elements x contains.
+   static_vector(BOOST_RV_REF(static_vector) x)
+      :  base_t()
+   {
+      this->reserve(N);
+      this->priv_move_from(x);
+   }
+
+   //! <b>Effects</b>: Makes *this contain the same elements as x.
+   //!
+   //! <b>Postcondition</b>: this->size() == x.size(). *this contains a copy
+   //! of each of x's elements.
+   //!
+   //! <b>Throws</b>: If T's copy constructor or assignment throws.
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements in x.
+   static_vector& operator=(BOOST_COPY_ASSIGN_REF(static_vector) x)
+   {
+      if (&x != this){
+         this->assign(x.begin(), x.end());
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Move assignment. Moves x's elements one by one to *this.
+   //!   x is left empty.
+   //!
+   //! <b>Throws</b>: If T's move constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the elements *this and x contain.
+   static_vector& operator=(BOOST_RV_REF(static_vector) x)
+   {
+      if (&x != this){
+         this->clear();
+         this->priv_move_from(x);
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Swaps the contents of *this and x.
+   //!
+   //! <b>Throws</b>: If T's move constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the elements *this and x contain.
+   void swap(static_vector &x)
+   {
+      if(&x != this){
+         static_vector tmp(boost::move(x));
+         x = boost::move(*this);
+         *this = boost::move(tmp);
+      }
+   }
+
+   //! <b>Effects</b>: Does nothing, the capacity of a static_vector is always N.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   void shrink_to_fit()
+   {}
+
+   /// @cond
+   private:
+   //Precondition: this->empty()
+   void priv_move_from(static_vector &x)
+   {
+      this->insert(this->end(), boost::make_move_iterator(x.begin()), boost::make_move_iterator(x.end()));
+      x.clear();
+   }
+   /// @endcond
+};
+
+template <class T, std::size_t N>
+inline void swap(static_vector<T, N> &x, static_vector<T, N> &y)
+{  x.swap(y);  }
+
+}}
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif //   #ifndef  BOOST_CONTAINER_STATIC_VECTOR_HPP
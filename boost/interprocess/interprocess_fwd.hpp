@@ -164,6 +164,9 @@ class simple_seq_fit;
 template<class MutexFamily, class VoidMutex = offset_ptr<void>, std::size_t MemAlignment = 0>
 class rbtree_best_fit;
 
+template<class MutexFamily, class VoidMutex = offset_ptr<void>, std::size_t MemAlignment = 0>
+class segregated_fit;
+
 //////////////////////////////////////////////////////////////////////////////
 //                         Index Types
 //////////////////////////////////////////////////////////////////////////////
@@ -407,6 +410,12 @@ class message_queue_t;
 
 typedef message_queue_t<offset_ptr<void> > message_queue;
 
+template<bool MultiProducer>
+class message_ring_t;
+
+typedef message_ring_t<false> message_ring;
+typedef message_ring_t<true>  mpsc_message_ring;
+
 }}  //namespace boost { namespace interprocess {
 
 //////////////////////////////////////////////////////////////////////////////
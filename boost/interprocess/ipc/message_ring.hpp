@@ -0,0 +1,600 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_MESSAGE_RING_HPP
+#define BOOST_INTERPROCESS_MESSAGE_RING_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+
+#include <boost/interprocess/interprocess_fwd.hpp>
+#include <boost/interprocess/creation_tags.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/math_functions.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/posix_time_types_wrk.hpp>
+#include <boost/interprocess/sync/detail/futex.hpp>
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>   //std::size_t
+#include <cstring>   //memcpy
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#  include <intrin.h>
+#endif
+
+//!\file
+//!Describes a lock-free ring of variable length messages that can be placed in
+//!any memory shared between processes. It allows zero-copy sending and
+//!receiving and optional blocking waits.
+
+namespace boost{  namespace interprocess{
+
+/// @cond
+namespace ipcdetail {
+
+//!Orders the loads issued after the call after the loads issued before it
+inline void ring_acquire_barrier()
+{
+   #if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+   __asm__ __volatile__ ("" : : : "memory");
+   #elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+   _ReadWriteBarrier();
+   #elif defined(__GNUC__)
+   __sync_synchronize();
+   #else
+   static volatile boost::uint32_t dummy;
+   ipcdetail::atomic_cas32(&dummy, 0, 0);
+   #endif
+}
+
+//!Orders the stores issued before the call before the stores issued after it
+inline void ring_release_barrier()
+{  ring_acquire_barrier();  }
+
+//!The control data of a ring, stored at the beginning of the memory buffer.
+//!Data written by the consumer and data written by the producers are placed
+//!in different cache lines.
+struct message_ring_hdr
+{
+   static const std::size_t CacheLineSize = 64;
+
+   //Constant after construction
+   boost::uint32_t            m_capacity;
+   boost::uint32_t            m_flags;
+   char                       m_pad0[CacheLineSize - 2*sizeof(boost::uint32_t)];
+
+   //Written by the consumer
+   volatile boost::uint32_t   m_head;
+   volatile boost::uint32_t   m_space_seq;
+   volatile boost::uint32_t   m_data_waiters;
+   char                       m_pad1[CacheLineSize - 3*sizeof(boost::uint32_t)];
+
+   //Written by the producers. With a single producer, m_tail is the end of the
+   //committed records. With several producers, it's the end of the reserved ones.
+   volatile boost::uint32_t   m_tail;
+   volatile boost::uint32_t   m_data_seq;
+   volatile boost::uint32_t   m_space_waiters;
+   char                       m_pad2[CacheLineSize - 3*sizeof(boost::uint32_t)];
+};
+
+}  //namespace ipcdetail {
+/// @endcond
+
+//!A ring of variable length messages, placed in a memory buffer shared
+//!between processes, for example a mapped_region or a block allocated from
+//!a managed segment. Messages are received in the same order they were
+//!sent, without taking any lock.
+//!
+//!The ring contains no pointers, so it can be mapped at different addresses
+//!in each process. Each process builds its own message_ring_t object on the
+//!address it has mapped, one with create_only and the rest with open_only.
+//!
+//!Messages can be written and read in place: reserve() returns the buffer
+//!where the message is written and commit() publishes it. peek() returns the
+//!next message and release() discards it. send() and receive() copy messages.
+//!
+//!If MultiProducer is false, only one thread can send messages at a time. If
+//!it's true, several threads and processes can send at the same time, each one
+//!using its own message_ring_t object. In both cases, only one thread can
+//!receive messages.
+//!
+//!If the ring is created with "blocking_wait" set, blocked senders and receivers
+//!sleep until they are notified (on Linux, with futexes), which adds an atomic
+//!operation to each commit and release. Otherwise they just yield the processor
+//!while they wait.
+template<bool MultiProducer>
+class message_ring_t
+{
+   /// @cond
+   //Blocking modes
+   enum block_t   {  blocking,   timed,   non_blocking   };
+
+   typedef ipcdetail::message_ring_hdr hdr_t;
+   typedef boost::posix_time::ptime    ptime;
+
+   //Each record starts with two words: the first one has the flags and the
+   //bytes until the next record, the second one has the message size.
+   static const boost::uint32_t HdrSize      = 2*sizeof(boost::uint32_t);
+   static const boost::uint32_t Alignment    = 8;
+   static const boost::uint32_t CommitFlag   = 0x80000000u;
+   static const boost::uint32_t PaddingFlag  = 0x40000000u;
+   static const boost::uint32_t SpanMask     = 0x3FFFFFFFu;
+   static const boost::uint32_t BlockingFlag = 1u;
+
+   message_ring_t();
+   message_ring_t(const message_ring_t &);
+   message_ring_t &operator=(const message_ring_t &);
+   /// @endcond
+
+   public:
+   typedef std::size_t size_type;
+
+   //!Formats a new ring in the buffer of "size" bytes starting in "addr", that
+   //!must be aligned to 8 bytes. The ring will use the biggest power of two that
+   //!fits in the buffer after the control data. Throws interprocess_exception
+   //!if the buffer is too small.
+   message_ring_t(create_only_t create_only, void *addr, size_type size,
+                  bool blocking_wait = false);
+
+   //!Opens a ring previously created in the buffer starting in "addr".
+   //!Never throws.
+   message_ring_t(open_only_t open_only, void *addr);
+
+   //!Reserves space for a message of "size" bytes and returns the address
+   //!where it must be written. If the ring is full the sender is blocked.
+   //!Throws interprocess_exception if "size" is bigger than get_max_msg_size().
+   void *reserve(size_type size);
+
+   //!Same as reserve() but returns 0 if the ring is full.
+   void *try_reserve(size_type size);
+
+   //!Same as reserve() but returns 0 if the ring is still full when
+   //!time "abs_time" is reached.
+   void *timed_reserve(size_type size, const boost::posix_time::ptime &abs_time);
+
+   //!Publishes the message written in the space returned by the last
+   //!reservation. "size" can be smaller than the reserved size.
+   //!Never throws.
+   void commit(size_type size);
+
+   //!Returns the address of the oldest message and stores its size in "size".
+   //!The message stays in the ring until release() is called. If the ring is
+   //!empty the receiver is blocked. Never throws.
+   const void *peek(size_type &size);
+
+   //!Same as peek() but returns 0 if the ring is empty.
+   const void *try_peek(size_type &size);
+
+   //!Same as peek() but returns 0 if the ring is still empty when
+   //!time "abs_time" is reached.
+   const void *timed_peek(size_type &size, const boost::posix_time::ptime &abs_time);
+
+   //!Removes the message returned by the last call to peek() from the ring.
+   //!Never throws.
+   void release();
+
+   //!Copies the message stored in buffer "buffer" with size "buffer_size" to the
+   //!ring. If the ring is full the sender is blocked. Throws interprocess_exception
+   //!if "buffer_size" is bigger than get_max_msg_size().
+   void send(const void *buffer, size_type buffer_size);
+
+   //!Same as send() but returns false if the ring is full.
+   bool try_send(const void *buffer, size_type buffer_size);
+
+   //!Same as send() but returns false if the ring is still full when
+   //!time "abs_time" is reached.
+   bool timed_send(const void *buffer, size_type buffer_size,
+                   const boost::posix_time::ptime &abs_time);
+
+   //!Receives a message from the ring. The message is stored in buffer "buffer",
+   //!which has size "buffer_size", and its size in "recvd_size". If the ring is
+   //!empty the receiver is blocked. Throws interprocess_exception if the message
+   //!does not fit in the buffer, in that case the message stays in the ring.
+   void receive(void *buffer, size_type buffer_size, size_type &recvd_size);
+
+   //!Same as receive() but returns false if the ring is empty.
+   bool try_receive(void *buffer, size_type buffer_size, size_type &recvd_size);
+
+   //!Same as receive() but returns false if the ring is still empty when
+   //!time "abs_time" is reached.
+   bool timed_receive(void *buffer, size_type buffer_size, size_type &recvd_size,
+                      const boost::posix_time::ptime &abs_time);
+
+   //!Returns the maximum size of a message. Never throws.
+   size_type get_max_msg_size() const;
+
+   //!Returns the bytes of memory needed to create a ring that
+   //!can hold messages of "max_msg_size" bytes. Never throws.
+   static size_type get_mem_size(size_type max_msg_size);
+
+   /// @cond
+   private:
+   static boost::uint32_t priv_record_bytes(size_type size)
+   {  return static_cast<boost::uint32_t>((HdrSize + size + Alignment - 1) & ~size_type(Alignment - 1));  }
+
+   volatile boost::uint32_t *priv_word(boost::uint32_t pos, std::size_t n) const
+   {  return reinterpret_cast<volatile boost::uint32_t*>(mp_data + (pos & m_mask)) + n;   }
+
+   void *do_reserve(block_t block, size_type size, const ptime &abs_time);
+   const void *do_peek(block_t block, size_type &size, const ptime &abs_time);
+   void *priv_try_reserve(size_type size);
+   const void *priv_try_peek(size_type &size);
+   void priv_advance_head(boost::uint32_t span);
+   bool priv_may_wait(block_t block, const ptime &abs_time);
+   void priv_notify(volatile boost::uint32_t *seq, volatile boost::uint32_t *waiters);
+
+   hdr_t          *mp_hdr;
+   char           *mp_data;
+   boost::uint32_t m_mask;
+   //Pending reservation and received message of this object
+   boost::uint32_t m_reserved_pos;
+   boost::uint32_t m_reserved_size;
+   boost::uint32_t m_reserved_span;
+   boost::uint32_t m_peeked_span;
+   /// @endcond
+};
+
+/// @cond
+
+template<bool MultiProducer>
+inline message_ring_t<MultiProducer>::message_ring_t
+   (create_only_t, void *addr, size_type size, bool blocking_wait)
+   :  mp_hdr(static_cast<hdr_t*>(addr))
+   ,  mp_data(static_cast<char*>(addr) + sizeof(hdr_t))
+   ,  m_mask(0), m_reserved_pos(0), m_reserved_size(0), m_reserved_span(0), m_peeked_span(0)
+{
+   BOOST_ASSERT((reinterpret_cast<std::size_t>(addr) & (Alignment - 1)) == 0);
+   if(size < sizeof(hdr_t) + 4*Alignment){
+      throw interprocess_exception(size_error);
+   }
+   size_type capacity = size_type(1) << ipcdetail::floor_log2(size - sizeof(hdr_t));
+   if(capacity > SpanMask + 1){
+      capacity = SpanMask + 1;
+   }
+   hdr_t *hdr = ::new(addr) hdr_t;
+   hdr->m_capacity      = static_cast<boost::uint32_t>(capacity);
+   hdr->m_flags         = blocking_wait ? BlockingFlag : 0u;
+   hdr->m_head          = 0;
+   hdr->m_space_seq     = 0;
+   hdr->m_data_waiters  = 0;
+   hdr->m_tail          = 0;
+   hdr->m_data_seq      = 0;
+   hdr->m_space_waiters = 0;
+   //Several producers rely on unused space being zeroed
+   std::memset(mp_data, 0, capacity);
+   m_mask = hdr->m_capacity - 1;
+   ipcdetail::ring_release_barrier();
+}
+
+template<bool MultiProducer>
+inline message_ring_t<MultiProducer>::message_ring_t(open_only_t, void *addr)
+   :  mp_hdr(static_cast<hdr_t*>(addr))
+   ,  mp_data(static_cast<char*>(addr) + sizeof(hdr_t))
+   ,  m_mask(mp_hdr->m_capacity - 1), m_reserved_pos(0), m_reserved_size(0), m_reserved_span(0), m_peeked_span(0)
+{}
+
+template<bool MultiProducer>
+inline typename message_ring_t<MultiProducer>::size_type
+   message_ring_t<MultiProducer>::get_max_msg_size() const
+{  return mp_hdr->m_capacity/2 - HdrSize;  }
+
+template<bool MultiProducer>
+inline typename message_ring_t<MultiProducer>::size_type
+   message_ring_t<MultiProducer>::get_mem_size(size_type max_msg_size)
+{
+   //A record never wraps, so half of the ring must hold the biggest one
+   size_type capacity = ipcdetail::upper_power_of_2(size_type(2*priv_record_bytes(max_msg_size)));
+   return sizeof(hdr_t) + capacity;
+}
+
+template<bool MultiProducer>
+inline void *message_ring_t<MultiProducer>::reserve(size_type size)
+{  return this->do_reserve(blocking, size, ptime());  }
+
+template<bool MultiProducer>
+inline void *message_ring_t<MultiProducer>::try_reserve(size_type size)
+{  return this->do_reserve(non_blocking, size, ptime());  }
+
+template<bool MultiProducer>
+inline void *message_ring_t<MultiProducer>::timed_reserve
+   (size_type size, const boost::posix_time::ptime &abs_time)
+{
+   if(abs_time == boost::posix_time::pos_infin){
+      return this->reserve(size);
+   }
+   return this->do_reserve(timed, size, abs_time);
+}
+
+template<bool MultiProducer>
+inline const void *message_ring_t<MultiProducer>::peek(size_type &size)
+{  return this->do_peek(blocking, size, ptime());  }
+
+template<bool MultiProducer>
+inline const void *message_ring_t<MultiProducer>::try_peek(size_type &size)
+{  return this->do_peek(non_blocking, size, ptime());  }
+
+template<bool MultiProducer>
+inline const void *message_ring_t<MultiProducer>::timed_peek
+   (size_type &size, const boost::posix_time::ptime &abs_time)
+{
+   if(abs_time == boost::posix_time::pos_infin){
+      return this->peek(size);
+   }
+   return this->do_peek(timed, size, abs_time);
+}
+
+template<bool MultiProducer>
+inline void message_ring_t<MultiProducer>::send(const void *buffer, size_type buffer_size)
+{
+   std::memcpy(this->reserve(buffer_size), buffer, buffer_size);
+   this->commit(buffer_size);
+}
+
+template<bool MultiProducer>
+inline bool message_ring_t<MultiProducer>::try_send(const void *buffer, size_type buffer_size)
+{
+   void *p = this->try_reserve(buffer_size);
+   if(!p)
+      return false;
+   std::memcpy(p, buffer, buffer_size);
+   this->commit(buffer_size);
+   return true;
+}
+
+template<bool MultiProducer>
+inline bool message_ring_t<MultiProducer>::timed_send
+   (const void *buffer, size_type buffer_size, const boost::posix_time::ptime &abs_time)
+{
+   void *p = this->timed_reserve(buffer_size, abs_time);
+   if(!p)
+      return false;
+   std::memcpy(p, buffer, buffer_size);
+   this->commit(buffer_size);
+   return true;
+}
+
+template<bool MultiProducer>
+inline void message_ring_t<MultiProducer>::receive
+   (void *buffer, size_type buffer_size, size_type &recvd_size)
+{
+   this->timed_receive(buffer, buffer_size, recvd_size, boost::posix_time::pos_infin);
+}
+
+template<bool MultiProducer>
+inline bool message_ring_t<MultiProducer>::try_receive
+   (void *buffer, size_type buffer_size, size_type &recvd_size)
+{
+   size_type size;
+   const void *p = this->try_peek(size);
+   if(!p)
+      return false;
+   if(size > buffer_size){
+      //Leave the message in the ring so that it can be received again
+      m_peeked_span = 0;
+      throw interprocess_exception(size_error);
+   }
+   std::memcpy(buffer, p, size);
+   this->release();
+   recvd_size = size;
+   return true;
+}
+
+template<bool MultiProducer>
+inline bool message_ring_t<MultiProducer>::timed_receive
+   (void *buffer, size_type buffer_size, size_type &recvd_size,
+    const boost::posix_time::ptime &abs_time)
+{
+   size_type size;
+   const void *p = this->timed_peek(size, abs_time);
+   if(!p)
+      return false;
+   if(size > buffer_size){
+      //Leave the message in the ring so that it can be received again
+      m_peeked_span = 0;
+      throw interprocess_exception(size_error);
+   }
+   std::memcpy(buffer, p, size);
+   this->release();
+   recvd_size = size;
+   return true;
+}
+
+template<bool MultiProducer>
+inline void *message_ring_t<MultiProducer>::do_reserve
+   (block_t block, size_type size, const ptime &abs_time)
+{
+   if(size > this->get_max_msg_size()){
+      throw interprocess_exception(size_error);
+   }
+   BOOST_ASSERT(!m_reserved_span);
+   void *p;
+   while(!(p = this->priv_try_reserve(size))){
+      if(!this->priv_may_wait(block, abs_time)){
+         return 0;
+      }
+      if(!(mp_hdr->m_flags & BlockingFlag)){
+         ipcdetail::thread_yield();
+         continue;
+      }
+      //Announce the waiter before reading the sequence. The receiver checks
+      //the waiter flag after releasing, so either it sees this waiter and
+      //changes the sequence or the space is found by the next try.
+      ipcdetail::atomic_cas32(&mp_hdr->m_space_waiters, 1, 0);
+      const boost::uint32_t seq = ipcdetail::atomic_read32(&mp_hdr->m_space_seq);
+      ipcdetail::ring_acquire_barrier();
+      p = this->priv_try_reserve(size);
+      if(p){
+         break;
+      }
+      ipcdetail::futex_wait(&mp_hdr->m_space_seq, seq, block == timed ? &abs_time : 0);
+   }
+   return p;
+}
+
+template<bool MultiProducer>
+inline const void *message_ring_t<MultiProducer>::do_peek
+   (block_t block, size_type &size, const ptime &abs_time)
+{
+   BOOST_ASSERT(!m_peeked_span);
+   const void *p;
+   while(!(p = this->priv_try_peek(size))){
+      if(!this->priv_may_wait(block, abs_time)){
+         return 0;
+      }
+      if(!(mp_hdr->m_flags & BlockingFlag)){
+         ipcdetail::thread_yield();
+         continue;
+      }
+      //Same protocol as in do_reserve
+      ipcdetail::atomic_cas32(&mp_hdr->m_data_waiters, 1, 0);
+      const boost::uint32_t seq = ipcdetail::atomic_read32(&mp_hdr->m_data_seq);
+      ipcdetail::ring_acquire_barrier();
+      p = this->priv_try_peek(size);
+      if(p){
+         break;
+      }
+      ipcdetail::futex_wait(&mp_hdr->m_data_seq, seq, block == timed ? &abs_time : 0);
+   }
+   return p;
+}
+
+template<bool MultiProducer>
+inline bool message_ring_t<MultiProducer>::priv_may_wait(block_t block, const ptime &abs_time)
+{
+   if(block == non_blocking){
+      return false;
+   }
+   return block != timed || microsec_clock::universal_time() < abs_time;
+}
+
+template<bool MultiProducer>
+inline void message_ring_t<MultiProducer>::priv_notify
+   (volatile boost::uint32_t *seq, volatile boost::uint32_t *waiters)
+{
+   if(mp_hdr->m_flags & BlockingFlag){
+      //The locked operation orders the publication before reading the flag.
+      //The flag is cleared so that only the first notification after a
+      //waiter announces itself makes a system call.
+      if(ipcdetail::atomic_cas32(waiters, 0, 1)){
+         ipcdetail::atomic_inc32(seq);
+         ipcdetail::futex_wake_all(seq);
+      }
+   }
+}
+
+template<bool MultiProducer>
+inline void *message_ring_t<MultiProducer>::priv_try_reserve(size_type size)
+{
+   const boost::uint32_t capacity = mp_hdr->m_capacity;
+   const boost::uint32_t need = priv_record_bytes(size);
+   boost::uint32_t pos, pad;
+   for(;;){
+      //Read the head first, so that it's never ahead of the tail
+      const boost::uint32_t head = ipcdetail::atomic_read32(&mp_hdr->m_head);
+      ipcdetail::ring_acquire_barrier();
+      pos = ipcdetail::atomic_read32(&mp_hdr->m_tail);
+      //Records never wrap, the end of the buffer is skipped with a padding record
+      const boost::uint32_t contiguous = capacity - (pos & m_mask);
+      pad = contiguous < need ? contiguous : 0u;
+      if(capacity - (pos - head) < pad + need){
+         return 0;
+      }
+      if(!MultiProducer || ipcdetail::atomic_cas32(&mp_hdr->m_tail, pos + pad + need, pos) == pos){
+         break;
+      }
+   }
+   if(pad){
+      *this->priv_word(pos, 1) = 0;
+      ipcdetail::ring_release_barrier();
+      *this->priv_word(pos, 0) = CommitFlag | PaddingFlag | pad;
+   }
+   m_reserved_pos  = pos + pad;
+   m_reserved_size = static_cast<boost::uint32_t>(size);
+   m_reserved_span = need;
+   return mp_data + (m_reserved_pos & m_mask) + HdrSize;
+}
+
+template<bool MultiProducer>
+inline void message_ring_t<MultiProducer>::commit(size_type size)
+{
+   BOOST_ASSERT(m_reserved_span && (size <= m_reserved_size));
+   //With several producers the following records are already reserved, so
+   //the record keeps the reserved length even if the message is shorter
+   const boost::uint32_t span = MultiProducer ? m_reserved_span : priv_record_bytes(size);
+   *this->priv_word(m_reserved_pos, 1) = static_cast<boost::uint32_t>(size);
+   ipcdetail::ring_release_barrier();
+   *this->priv_word(m_reserved_pos, 0) = CommitFlag | span;
+   if(!MultiProducer){
+      ipcdetail::ring_release_barrier();
+      ipcdetail::atomic_write32(&mp_hdr->m_tail, m_reserved_pos + span);
+   }
+   m_reserved_span = 0;
+   this->priv_notify(&mp_hdr->m_data_seq, &mp_hdr->m_data_waiters);
+}
+
+template<bool MultiProducer>
+inline const void *message_ring_t<MultiProducer>::priv_try_peek(size_type &size)
+{
+   for(;;){
+      const boost::uint32_t head = mp_hdr->m_head;
+      //With several producers, the record header tells if the message
+      //was committed, as unused space is always zeroed.
+      if(!MultiProducer && head == ipcdetail::atomic_read32(&mp_hdr->m_tail)){
+         return 0;
+      }
+      ipcdetail::ring_acquire_barrier();
+      const boost::uint32_t word = ipcdetail::atomic_read32(this->priv_word(head, 0));
+      if(!(word & CommitFlag)){
+         return 0;
+      }
+      ipcdetail::ring_acquire_barrier();
+      if(word & PaddingFlag){
+         this->priv_advance_head(word & SpanMask);
+         continue;
+      }
+      m_peeked_span = word & SpanMask;
+      size = *this->priv_word(head, 1);
+      return mp_data + (head & m_mask) + HdrSize;
+   }
+}
+
+template<bool MultiProducer>
+inline void message_ring_t<MultiProducer>::release()
+{
+   BOOST_ASSERT(m_peeked_span);
+   this->priv_advance_head(m_peeked_span);
+   m_peeked_span = 0;
+}
+
+template<bool MultiProducer>
+inline void message_ring_t<MultiProducer>::priv_advance_head(boost::uint32_t span)
+{
+   const boost::uint32_t head = mp_hdr->m_head;
+   if(MultiProducer){
+      std::memset(mp_data + (head & m_mask), 0, span);
+   }
+   ipcdetail::ring_release_barrier();
+   ipcdetail::atomic_write32(&mp_hdr->m_head, head + span);
+   this->priv_notify(&mp_hdr->m_space_seq, &mp_hdr->m_space_waiters);
+}
+
+/// @endcond
+
+}} //namespace boost { namespace interprocess {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_MESSAGE_RING_HPP
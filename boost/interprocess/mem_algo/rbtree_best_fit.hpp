@@ -156,6 +156,7 @@ class rbtree_best_fit
    }  m_header;
 
    friend class ipcdetail::memory_algorithm_common<rbtree_best_fit>;
+   friend class segregated_fit<MutexFamily, VoidPointer, MemAlignment>;
 
    typedef ipcdetail::memory_algorithm_common<rbtree_best_fit> algo_impl_t;
 
@@ -0,0 +1,609 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_MEM_ALGO_SEGREGATED_FIT_HPP
+#define BOOST_INTERPROCESS_MEM_ALGO_SEGREGATED_FIT_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+
+#include <boost/interprocess/interprocess_fwd.hpp>
+#include <boost/interprocess/mem_algo/rbtree_best_fit.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/null_mutex.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/type_traits.hpp>
+#include <boost/interprocess/detail/utilities.hpp>
+#include <boost/move/move.hpp>
+#include <cstring>
+
+//!\file
+//!Describes a segregated fit algorithm that keeps free lists of small blocks,
+//!classified by size, in front of the red-black tree of rbtree_best_fit.
+
+namespace boost {
+namespace interprocess {
+
+//!This class implements an algorithm that serves small allocations from
+//!free lists of blocks of the same size (size classes) and everything else
+//!from the red-black tree of rbtree_best_fit.
+//!
+//!The free lists are split in several stripes, each one protected by its
+//!own mutex, so that threads and processes allocating at the same time
+//!usually don't contend for the same lock. A thread always uses the same
+//!stripe. When a stripe runs out of blocks of a size class, a batch of them
+//!is obtained from the tree with a single allocate_many call, and when it has
+//!too many free blocks, the oldest half is returned to the tree. Allocations
+//!of a size class and deallocations of those blocks don't touch the
+//!tree or the segment-wide mutex otherwise.
+//!
+//!Blocks in the free lists are still allocated as far as the tree is
+//!concerned, so they are returned to the tree before the segment is shrunk,
+//!its free memory is zeroed or an allocation fails because the tree is
+//!exhausted.
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+class segregated_fit
+   :  public rbtree_best_fit<MutexFamily, VoidPointer, MemAlignment>
+{
+   /// @cond
+   //Non-copyable
+   segregated_fit();
+   segregated_fit(const segregated_fit &);
+   segregated_fit &operator=(const segregated_fit &);
+
+   typedef rbtree_best_fit<MutexFamily, VoidPointer, MemAlignment>   base_t;
+   typedef typename base_t::block_ctrl                               block_ctrl;
+   typedef typename MutexFamily::mutex_type                          mutex_type;
+   /// @endcond
+
+   public:
+   //!Pointer type to be used with the rest of the Interprocess framework
+   typedef VoidPointer                                   void_pointer;
+   typedef typename base_t::multiallocation_chain        multiallocation_chain;
+   typedef typename base_t::size_type                    size_type;
+
+   //!Constructor. "size" is the total size of the managed memory segment,
+   //!"extra_hdr_bytes" indicates the extra bytes beginning in the sizeof(segregated_fit)
+   //!offset that the allocator should not use at all.
+   segregated_fit           (size_type size, size_type extra_hdr_bytes);
+
+   //!Obtains the minimum size needed by the algorithm
+   static size_type get_min_size (size_type extra_hdr_bytes);
+
+   //!Allocates bytes, returns 0 if there is not more memory
+   void* allocate             (size_type nbytes);
+
+   /// @cond
+
+   //Experimental. Dont' use
+
+   //!Multiple element allocation, same size. Small elements
+   //!are taken from the free lists if available.
+   multiallocation_chain allocate_many(size_type elem_bytes, size_type num_elements);
+
+   //!Multiple element allocation, different size
+   multiallocation_chain allocate_many(const size_type *elem_sizes, size_type n_elements, size_type sizeof_element);
+
+   //!Multiple element allocation, different size
+   void deallocate_many(multiallocation_chain chain);
+
+   /// @endcond
+
+   //!Deallocates previously allocated bytes
+   void   deallocate          (void *addr);
+
+   //!Returns the number of free bytes of the segment,
+   //!including the blocks held in the free lists
+   size_type get_free_memory()  const;
+
+   //!Initializes to zero all the memory that's not in use.
+   //!This function is normally used for security reasons.
+   void zero_free_memory();
+
+   //!Decreases managed memory as much as possible
+   void shrink_to_fit();
+
+   //!Returns true if all allocated memory has been deallocated
+   bool all_memory_deallocated();
+
+   //!Makes an internal sanity check
+   //!and returns true if success
+   bool check_sanity();
+
+   //!Returns all the blocks held in the free lists to the red-black tree
+   void flush_caches();
+
+   /// @cond
+   private:
+   //!Returns the number of bytes this class adds to the header of rbtree_best_fit
+   static size_type priv_extra_hdr_bytes(size_type extra_hdr_bytes);
+
+   //!Obtains the size class of a block of "units" Alignment units.
+   //!Returns false if the block is not small enough to be cached.
+   static bool priv_class_of_units(size_type units, size_type &cls);
+
+   //!Returns the size in Alignment units of the blocks of a size class
+   static size_type priv_class_units(size_type cls);
+
+   //!Returns the user bytes of the blocks of a size class
+   static size_type priv_class_bytes(size_type cls);
+
+   //!Returns the number of blocks a stripe takes from the tree
+   //!when it runs out of blocks of a size class
+   static size_type priv_batch_size(size_type cls);
+
+   //!Returns the size in Alignment units of an allocated block
+   static size_type priv_block_units(const void *addr);
+
+   //!Selects the stripe used by the calling thread
+   static size_type priv_stripe_index();
+
+   struct stripe_t;
+
+   stripe_t &priv_stripe();
+
+   //!Takes a block from the free lists, refilling them if needed
+   void *priv_allocate_cached(size_type cls);
+
+   //!Moves the oldest blocks of a free list to "excess"
+   //!if the free list has grown too much
+   static void priv_trim(multiallocation_chain &list, size_type cls, multiallocation_chain &excess);
+
+   //!Unlinks the first block of a list and clears
+   //!the link, as the tree does with its own hook
+   static void *priv_pop(multiallocation_chain &list);
+
+   //!Returns all the cached blocks to the tree.
+   //!Returns false if there were no cached blocks.
+   bool priv_flush_caches();
+
+   public:
+   static const size_type Alignment = base_t::Alignment;
+
+   private:
+   //!Blocks up to this size (approximately) are held in the free lists
+   static const size_type CachedBytes = 256;
+   //!The number of size classes, one per Alignment units
+   static const size_type NumClasses = CachedBytes/Alignment ? CachedBytes/Alignment : 1;
+   //!Bytes that a stripe takes from the tree when refilling a size class
+   static const size_type BatchBytes = 2048;
+   static const size_type MinBatchSize = 4;
+   static const size_type MaxBatchSize = 32;
+   //!With a null mutex there can be no contention, so a single stripe is used
+   static const size_type NumStripes = ipcdetail::is_same<mutex_type, null_mutex>::value ? 1 : 8;
+
+   //!Each stripe derives from mutex_type to
+   //!allow EBO when using null mutex_type
+   struct stripe_t : public mutex_type
+   {
+      multiallocation_chain m_free[NumClasses];
+   };
+
+   stripe_t m_stripes[NumStripes];
+   /// @endcond
+};
+
+/// @cond
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+   segregated_fit(size_type size, size_type extra_hdr_bytes)
+   :  base_t(size, priv_extra_hdr_bytes(extra_hdr_bytes))
+{}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline typename segregated_fit<MutexFamily, VoidPointer, MemAlignment>::size_type
+   segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+      priv_extra_hdr_bytes(size_type extra_hdr_bytes)
+{
+   //rbtree_best_fit places the first block after sizeof(rbtree_best_fit) + extra_hdr_bytes
+   //so the free lists are accounted as extra header bytes
+   return extra_hdr_bytes + (sizeof(segregated_fit) - sizeof(base_t));
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline typename segregated_fit<MutexFamily, VoidPointer, MemAlignment>::size_type
+   segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+      get_min_size(size_type extra_hdr_bytes)
+{
+   return base_t::get_min_size(priv_extra_hdr_bytes(extra_hdr_bytes));
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline bool segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+   priv_class_of_units(size_type units, size_type &cls)
+{
+   //Size classes are exact block sizes, starting with the minimum block
+   BOOST_ASSERT(units >= base_t::MinBlockUnits);
+   cls = units - base_t::MinBlockUnits;
+   return cls < NumClasses;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline typename segregated_fit<MutexFamily, VoidPointer, MemAlignment>::size_type
+   segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+      priv_class_units(size_type cls)
+{  return base_t::MinBlockUnits + cls;  }
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline typename segregated_fit<MutexFamily, VoidPointer, MemAlignment>::size_type
+   segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+      priv_class_bytes(size_type cls)
+{
+   return (priv_class_units(cls) - base_t::AllocatedCtrlUnits)*Alignment + base_t::UsableByPreviousChunk;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline typename segregated_fit<MutexFamily, VoidPointer, MemAlignment>::size_type
+   segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+      priv_batch_size(size_type cls)
+{
+   const size_type n = BatchBytes/(priv_class_units(cls)*Alignment);
+   return n < MinBatchSize ? MinBatchSize : (n > MaxBatchSize ? MaxBatchSize : n);
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline typename segregated_fit<MutexFamily, VoidPointer, MemAlignment>::size_type
+   segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+      priv_block_units(const void *addr)
+{
+   //We need no synchronization since this block's size is not going
+   //to be modified by anyone else
+   return (size_type)base_t::priv_get_block(addr)->m_size;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline typename segregated_fit<MutexFamily, VoidPointer, MemAlignment>::size_type
+   segregated_fit<MutexFamily, VoidPointer, MemAlignment>::priv_stripe_index()
+{
+   //Spread threads between stripes hashing the thread id. The process id
+   //is mixed in because thread ids are only unique inside a process.
+   static const ipcdetail::OS_process_id_t pid = ipcdetail::get_current_process_id();
+   const ipcdetail::OS_thread_id_t tid = ipcdetail::get_current_thread_id();
+   const unsigned char *p = reinterpret_cast<const unsigned char*>(&tid);
+   std::size_t h = static_cast<std::size_t>(pid);
+   for(std::size_t i = 0; i != sizeof(tid); ++i){
+      h = h*131u + p[i];
+   }
+   h ^= h >> 15;
+   h *= 0x2c1b3c6dU;
+   h ^= h >> 12;
+   return h % NumStripes;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline typename segregated_fit<MutexFamily, VoidPointer, MemAlignment>::stripe_t &
+   segregated_fit<MutexFamily, VoidPointer, MemAlignment>::priv_stripe()
+{  return m_stripes[NumStripes == 1 ? 0 : priv_stripe_index()];  }
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline void *segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+   priv_pop(multiallocation_chain &list)
+{
+   void *addr = ipcdetail::to_raw_pointer(list.pop_front());
+   //Clear the memory occupied by the link, since this won't be
+   //cleared with zero_free_memory
+   std::memset(addr, 0, sizeof(void_pointer));
+   return addr;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline void segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+   priv_trim(multiallocation_chain &list, size_type cls, multiallocation_chain &excess)
+{
+   const size_type batch = priv_batch_size(cls);
+   if(list.size() <= 2*batch)
+      return;
+   //Blocks are pushed to the front, so the ones in the back are the oldest
+   typename multiallocation_chain::iterator before_first(list.before_begin());
+   for(size_type n = list.size() - batch; n; --n){
+      ++before_first;
+   }
+   excess.splice_after(excess.before_begin(), list, before_first, list.last(), batch);
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+void *segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+   priv_allocate_cached(size_type cls)
+{
+   stripe_t &stripe = priv_stripe();
+   {
+      //-----------------------
+      boost::interprocess::scoped_lock<mutex_type> guard(stripe);
+      //-----------------------
+      if(!stripe.m_free[cls].empty()){
+         return priv_pop(stripe.m_free[cls]);
+      }
+   }
+
+   //The free list is empty: obtain a batch of blocks from the tree
+   //with a single operation, without holding the stripe lock
+   multiallocation_chain chain
+      (base_t::allocate_many(priv_class_bytes(cls), priv_batch_size(cls)));
+   if(chain.empty()){
+      void *addr = base_t::allocate(priv_class_bytes(cls));
+      if(addr){
+         std::memset(addr, 0, base_t::size(addr));
+      }
+      return addr;
+   }
+   //Blocks returned to the tree from the free lists are merged with their
+   //neighbours, leaving stale control data in free memory. Clear the new
+   //blocks so that after zero_free_memory allocations still return zeroed
+   //memory, as they do with rbtree_best_fit.
+   for( typename multiallocation_chain::iterator it(chain.begin()), itend(chain.end())
+      ; it != itend; ++it){
+      char *p = reinterpret_cast<char*>(&*it) + sizeof(void_pointer);
+      std::memset(p, 0, base_t::size(&*it) - sizeof(void_pointer));
+   }
+   void *addr = priv_pop(chain);
+   if(!chain.empty()){
+      //The last block of the batch can be bigger than the rest, since
+      //it takes the remaining memory if it's too small to form a block
+      multiallocation_chain excess;
+      {
+         //-----------------------
+         boost::interprocess::scoped_lock<mutex_type> guard(stripe);
+         //-----------------------
+         while(!chain.empty()){
+            void *block = ipcdetail::to_raw_pointer(chain.pop_front());
+            size_type block_cls;
+            if(priv_class_of_units(priv_block_units(block), block_cls)){
+               stripe.m_free[block_cls].push_front(block);
+            }
+            else{
+               excess.push_front(block);
+            }
+         }
+      }
+      if(!excess.empty()){
+         base_t::deallocate_many(boost::move(excess));
+      }
+   }
+   return addr;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+bool segregated_fit<MutexFamily, VoidPointer, MemAlignment>::priv_flush_caches()
+{
+   multiallocation_chain chain;
+   for(size_type i = 0; i != NumStripes; ++i){
+      //-----------------------
+      boost::interprocess::scoped_lock<mutex_type> guard(m_stripes[i]);
+      //-----------------------
+      for(size_type cls = 0; cls != NumClasses; ++cls){
+         chain.splice_after(chain.before_begin(), m_stripes[i].m_free[cls]);
+      }
+   }
+   if(chain.empty())
+      return false;
+   base_t::deallocate_many(boost::move(chain));
+   return true;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline void segregated_fit<MutexFamily, VoidPointer, MemAlignment>::flush_caches()
+{  this->priv_flush_caches();  }
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+void* segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+   allocate(size_type nbytes)
+{
+   size_type cls;
+   if(nbytes <= priv_class_bytes(NumClasses - 1) &&
+      priv_class_of_units(base_t::priv_get_total_units(nbytes), cls)){
+      void *addr = priv_allocate_cached(cls);
+      //The tree might have enough memory once the cached blocks are returned
+      if(!addr && this->priv_flush_caches()){
+         addr = priv_allocate_cached(cls);
+      }
+      return addr;
+   }
+   void *addr = base_t::allocate(nbytes);
+   if(!addr && this->priv_flush_caches()){
+      addr = base_t::allocate(nbytes);
+   }
+   return addr;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+void segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+   deallocate(void* addr)
+{
+   if(!addr)   return;
+   size_type cls;
+   if(!priv_class_of_units(priv_block_units(addr), cls)){
+      base_t::deallocate(addr);
+      return;
+   }
+
+   multiallocation_chain excess;
+   {
+      stripe_t &stripe = priv_stripe();
+      //-----------------------
+      boost::interprocess::scoped_lock<mutex_type> guard(stripe);
+      //-----------------------
+      stripe.m_free[cls].push_front(addr);
+      priv_trim(stripe.m_free[cls], cls, excess);
+   }
+   if(!excess.empty()){
+      base_t::deallocate_many(boost::move(excess));
+   }
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+typename segregated_fit<MutexFamily, VoidPointer, MemAlignment>::multiallocation_chain
+   segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+      allocate_many(size_type elem_bytes, size_type num_elements)
+{
+   size_type cls;
+   if(!num_elements || elem_bytes > priv_class_bytes(NumClasses - 1) ||
+      !priv_class_of_units(base_t::priv_get_total_units(elem_bytes), cls)){
+      multiallocation_chain chain(base_t::allocate_many(elem_bytes, num_elements));
+      if(chain.empty() && num_elements && this->priv_flush_caches()){
+         chain = base_t::allocate_many(elem_bytes, num_elements);
+      }
+      return boost::move(chain);
+   }
+
+   //Take as many blocks as possible from the free list
+   multiallocation_chain chain;
+   {
+      stripe_t &stripe = priv_stripe();
+      //-----------------------
+      boost::interprocess::scoped_lock<mutex_type> guard(stripe);
+      //-----------------------
+      multiallocation_chain &list = stripe.m_free[cls];
+      const size_type n = list.size() < num_elements ? list.size() : num_elements;
+      if(n){
+         typename multiallocation_chain::iterator before_last(list.before_begin());
+         for(size_type i = 0; i != n; ++i){
+            ++before_last;
+         }
+         chain.splice_after(chain.before_begin(), list, list.before_begin(), before_last, n);
+      }
+   }
+
+   //And the rest from the tree, in a single operation
+   if(chain.size() < num_elements){
+      multiallocation_chain rest
+         (base_t::allocate_many(priv_class_bytes(cls), num_elements - chain.size()));
+      if(rest.empty()){
+         this->deallocate_many(boost::move(chain));
+         this->priv_flush_caches();
+         return base_t::allocate_many(elem_bytes, num_elements);
+      }
+      chain.splice_after(chain.last(), rest);
+   }
+   return boost::move(chain);
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+typename segregated_fit<MutexFamily, VoidPointer, MemAlignment>::multiallocation_chain
+   segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+      allocate_many(const size_type *elem_sizes, size_type n_elements, size_type sizeof_element)
+{
+   multiallocation_chain chain(base_t::allocate_many(elem_sizes, n_elements, sizeof_element));
+   if(chain.empty() && n_elements && this->priv_flush_caches()){
+      chain = base_t::allocate_many(elem_sizes, n_elements, sizeof_element);
+   }
+   return boost::move(chain);
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+void segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+   deallocate_many(multiallocation_chain chain)
+{
+   multiallocation_chain rest;
+   {
+      stripe_t &stripe = priv_stripe();
+      //-----------------------
+      boost::interprocess::scoped_lock<mutex_type> guard(stripe);
+      //-----------------------
+      while(!chain.empty()){
+         void *addr = ipcdetail::to_raw_pointer(chain.pop_front());
+         size_type cls;
+         if(priv_class_of_units(priv_block_units(addr), cls)){
+            stripe.m_free[cls].push_front(addr);
+         }
+         else{
+            rest.push_front(addr);
+         }
+      }
+      for(size_type cls = 0; cls != NumClasses; ++cls){
+         priv_trim(stripe.m_free[cls], cls, rest);
+      }
+   }
+   if(!rest.empty()){
+      base_t::deallocate_many(boost::move(rest));
+   }
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+typename segregated_fit<MutexFamily, VoidPointer, MemAlignment>::size_type
+segregated_fit<MutexFamily, VoidPointer, MemAlignment>::get_free_memory()  const
+{
+   size_type cached = 0;
+   for(size_type i = 0; i != NumStripes; ++i){
+      stripe_t &stripe = const_cast<stripe_t &>(m_stripes[i]);
+      //-----------------------
+      boost::interprocess::scoped_lock<mutex_type> guard(stripe);
+      //-----------------------
+      for(size_type cls = 0; cls != NumClasses; ++cls){
+         cached += stripe.m_free[cls].size()*priv_class_units(cls)*Alignment;
+      }
+   }
+   return base_t::get_free_memory() + cached;
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline void segregated_fit<MutexFamily, VoidPointer, MemAlignment>::zero_free_memory()
+{
+   this->priv_flush_caches();
+   base_t::zero_free_memory();
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline void segregated_fit<MutexFamily, VoidPointer, MemAlignment>::shrink_to_fit()
+{
+   this->priv_flush_caches();
+   base_t::shrink_to_fit();
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+inline bool segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+    all_memory_deallocated()
+{
+   this->priv_flush_caches();
+   return base_t::all_memory_deallocated();
+}
+
+template<class MutexFamily, class VoidPointer, std::size_t MemAlignment>
+bool segregated_fit<MutexFamily, VoidPointer, MemAlignment>::
+    check_sanity()
+{
+   for(size_type i = 0; i != NumStripes; ++i){
+      //-----------------------
+      boost::interprocess::scoped_lock<mutex_type> guard(m_stripes[i]);
+      //-----------------------
+      for(size_type cls = 0; cls != NumClasses; ++cls){
+         multiallocation_chain &list = m_stripes[i].m_free[cls];
+         size_type count = 0;
+         for( typename multiallocation_chain::iterator it(list.begin()), itend(list.end())
+            ; it != itend; ++it, ++count){
+            //Cached blocks are allocated blocks of the size of their class
+            const block_ctrl *block = base_t::priv_get_block(&*it);
+            if(!block->m_allocated || (size_type)block->m_size != priv_class_units(cls)){
+               return false;
+            }
+            if(!ipcdetail::memory_algorithm_common<base_t>::check_alignment(&*it)){
+               return false;
+            }
+         }
+         if(count != list.size()){
+            return false;
+         }
+      }
+   }
+   return base_t::check_sanity();
+}
+
+/// @endcond
+
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //#ifndef BOOST_INTERPROCESS_MEM_ALGO_SEGREGATED_FIT_HPP
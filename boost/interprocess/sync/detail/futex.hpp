@@ -0,0 +1,92 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_INTERPROCESS_SYNC_DETAIL_FUTEX_HPP
+#define BOOST_INTERPROCESS_SYNC_DETAIL_FUTEX_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/detail/workaround.hpp>
+#include <boost/interprocess/detail/atomic.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/interprocess/detail/posix_time_types_wrk.hpp>
+#include <boost/cstdint.hpp>
+
+#if defined(__linux__)
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  include <time.h>
+#  define BOOST_INTERPROCESS_HAS_FUTEX
+#endif
+
+//!\file
+//!Describes functions to wait until a 32 bit word in shared memory changes.
+//!On Linux they use process-shared futexes, elsewhere waiting is emulated
+//!yielding the processor.
+
+namespace boost {
+namespace interprocess {
+namespace ipcdetail {
+
+//!Blocks the calling thread while "*addr" equals "expected". Returns true
+//!when woken up (spurious wakeups are possible, so callers must check the
+//!condition again) or false if "abs_time" was reached. If "abs_time" is null
+//!waits without timeout.
+inline bool futex_wait(volatile boost::uint32_t *addr, boost::uint32_t expected,
+                       const boost::posix_time::ptime *abs_time = 0)
+{
+   #if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+   struct timespec ts;
+   struct timespec *pts = 0;
+   if(abs_time){
+      boost::posix_time::ptime now(microsec_clock::universal_time());
+      if(now >= *abs_time){
+         return false;
+      }
+      boost::posix_time::time_duration d(*abs_time - now);
+      ts.tv_sec  = static_cast<time_t>(d.total_seconds());
+      ts.tv_nsec = static_cast<long>(d.total_microseconds() % 1000000)*1000;
+      pts = &ts;
+   }
+   //Note that FUTEX_PRIVATE_FLAG is not used, the word is shared between processes
+   ::syscall(SYS_futex, const_cast<boost::uint32_t*>(addr), FUTEX_WAIT, expected, pts, 0, 0);
+   return !abs_time || microsec_clock::universal_time() < *abs_time;
+   #else
+   while(ipcdetail::atomic_read32(addr) == expected){
+      if(abs_time && microsec_clock::universal_time() >= *abs_time){
+         return false;
+      }
+      ipcdetail::thread_yield();
+   }
+   return true;
+   #endif
+}
+
+//!Wakes all the threads waiting in futex_wait for "addr".
+inline void futex_wake_all(volatile boost::uint32_t *addr)
+{
+   #if defined(BOOST_INTERPROCESS_HAS_FUTEX)
+   ::syscall(SYS_futex, const_cast<boost::uint32_t*>(addr), FUTEX_WAKE, 0x7FFFFFFF, 0, 0, 0);
+   #else
+   (void)addr;
+   #endif
+}
+
+}  //namespace ipcdetail {
+}  //namespace interprocess {
+}  //namespace boost {
+
+#include <boost/interprocess/detail/config_end.hpp>
+
+#endif   //BOOST_INTERPROCESS_SYNC_DETAIL_FUTEX_HPP
@@ -0,0 +1,537 @@
+//  lock-free freelist with epoch-based memory reclamation
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_DETAIL_EPOCH_FREELIST_HPP_INCLUDED
+#define BOOST_LOCKFREE_DETAIL_EPOCH_FREELIST_HPP_INCLUDED
+
+#include <memory>
+#include <new>
+
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/lockfree/detail/tagged_ptr.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+/** freelist, which returns the nodes to the allocator.
+ *
+ *  a node that has been removed from a data structure may still be accessed by threads, which have read a pointer to it
+ *  before it was removed. therefore nodes are not released immediately, but epoch-based reclamation is used:
+ *
+ *  - every thread-safe operation of the data structure is bracketed by an operation_guard, which announces the global
+ *    epoch that the thread has observed.
+ *  - removed nodes are retired to a limbo list, which is tagged with the global epoch read after they have been
+ *    unlinked. the epoch of the operation that retired them may be one epoch older, so it cannot be used.
+ *  - the global epoch is only advanced, if all active operations have observed the current epoch. nodes, which have been
+ *    retired two epochs ago, cannot be referenced any more and are released.
+ *
+ *  released nodes are cached, as long as the cache holds fewer nodes than have been reserved. the other nodes are returned
+ *  to the allocator.
+ * */
+template <typename T,
+          typename Alloc = std::allocator<T>
+         >
+class epoch_freelist:
+    Alloc
+{
+    struct freelist_node
+    {
+        tagged_ptr<freelist_node> next;
+    };
+
+    typedef tagged_ptr<freelist_node> tagged_node_ptr;
+
+    BOOST_STATIC_ASSERT(sizeof(T) >= sizeof(freelist_node));
+
+    struct limbo_list
+    {
+        freelist_node * head;
+        std::size_t epoch;
+    };
+
+    /* a participant in the epoch protocol. records are owned by one operation at a time, so the limbo lists don't need to
+     * be synchronized. they are only freed when the freelist is destroyed */
+    struct record
+    {
+        record(std::size_t epoch):
+            state(active_state(epoch)), next(NULL), retired(0)
+        {
+            for (int i = 0; i != 3; ++i) {
+                limbo[i].head = NULL;
+                limbo[i].epoch = 0;
+            }
+        }
+
+        atomic<std::size_t> state; /* epoch of the operation, the lowest bit is set while the record is active */
+        record * next;
+        limbo_list limbo[3];
+        std::size_t retired;
+        char padding[BOOST_LOCKFREE_CACHELINE_BYTES];
+    };
+
+    typedef typename Alloc::template rebind<record>::other record_allocator;
+
+    /* try to advance the global epoch after this number of retired nodes */
+    static const std::size_t advance_interval = 64;
+
+    static std::size_t active_state(std::size_t epoch)
+    {
+        return (epoch << 1) | 1;
+    }
+
+public:
+    typedef tagged_ptr<T> tagged_node_handle;
+
+    /** the nodes that are retired or allocated during the lifetime of an operation_guard cannot be reclaimed, before
+     *  the guard is destroyed */
+    class operation_guard:
+        boost::noncopyable
+    {
+    public:
+        explicit operation_guard(epoch_freelist & pool):
+            pool_(pool), record_(pool.enter())
+        {}
+
+        ~operation_guard(void)
+        {
+            pool_.leave(record_);
+        }
+
+    private:
+        friend class epoch_freelist;
+
+        epoch_freelist & pool_;
+        record * record_;
+    };
+
+    template <typename Allocator>
+    epoch_freelist (Allocator const & alloc, std::size_t n = 0):
+        Alloc(alloc),
+        global_epoch_(0),
+        records_(NULL),
+        pool_(tagged_node_ptr(NULL)),
+        cached_(0),
+        reserved_(0)
+    {
+        reserve<false>(n);
+    }
+
+    /** allocate count nodes for the cache. the reserved nodes will not be returned to the allocator */
+    template <bool ThreadSafe>
+    void reserve (std::size_t count)
+    {
+        reserved_.fetch_add(count, memory_order_relaxed);
+        for (std::size_t i = 0; i != count; ++i) {
+            T * node = Alloc::allocate(1);
+            cache_node<ThreadSafe>(node);
+        }
+    }
+
+    template <bool ThreadSafe, bool Bounded>
+    T * construct (void)
+    {
+        T * node = allocate<ThreadSafe, Bounded>();
+        if (node)
+            new(node) T();
+        return node;
+    }
+
+    template <bool ThreadSafe, bool Bounded, typename ArgumentType>
+    T * construct (ArgumentType const & arg)
+    {
+        T * node = allocate<ThreadSafe, Bounded>();
+        if (node)
+            new(node) T(arg);
+        return node;
+    }
+
+    template <bool ThreadSafe, bool Bounded, typename ArgumentType1, typename ArgumentType2>
+    T * construct (ArgumentType1 const & arg1, ArgumentType2 const & arg2)
+    {
+        T * node = allocate<ThreadSafe, Bounded>();
+        if (node)
+            new(node) T(arg1, arg2);
+        return node;
+    }
+
+    /** destroy and release a node, which cannot be referenced by other threads */
+    // @{
+    template <bool ThreadSafe>
+    void destruct (tagged_node_handle tagged_ptr)
+    {
+        destruct<ThreadSafe>(tagged_ptr.get_ptr());
+    }
+
+    template <bool ThreadSafe>
+    void destruct (T * n)
+    {
+        n->~T();
+        release_node<ThreadSafe>(n);
+    }
+    // @}
+
+    /** destroy a node, which has been removed from the data structure while other threads may still reference it. its
+     *  memory is released after all operations that are active at this time have finished */
+    // @{
+    void retire (operation_guard & guard, tagged_node_handle tagged_ptr)
+    {
+        retire(guard, tagged_ptr.get_ptr());
+    }
+
+    void retire (operation_guard & guard, T * n)
+    {
+        std::size_t epoch = retire_epoch();
+        n->~T();
+        retire_node(guard.record_, n, epoch);
+    }
+
+    void retire_many (operation_guard & guard, T * const * nodes, std::size_t count)
+    {
+        std::size_t epoch = retire_epoch();
+        for (std::size_t i = 0; i != count; ++i) {
+            nodes[i]->~T();
+            retire_node(guard.record_, nodes[i], epoch);
+        }
+    }
+    // @}
+
+    /** allocate up to count nodes. if the cache runs short and Bounded is false, the remaining nodes are allocated from the
+     *  allocator. the nodes are not constructed.
+     *
+     *  \returns number of nodes stored to nodes
+     * */
+    template <bool ThreadSafe, bool Bounded>
+    std::size_t allocate_many (T ** nodes, std::size_t count)
+    {
+        std::size_t allocated = 0;
+        try {
+            for (; allocated != count; ++allocated) {
+                T * node = allocate<ThreadSafe, Bounded>();
+                if (!node)
+                    break;
+                nodes[allocated] = node;
+            }
+        } catch (...) {
+            deallocate_many<ThreadSafe>(nodes, allocated);
+            throw;
+        }
+        return allocated;
+    }
+
+    /** release count unconstructed nodes, which cannot be referenced by other threads */
+    template <bool ThreadSafe>
+    void deallocate_many (T * const * nodes, std::size_t count)
+    {
+        for (std::size_t i = 0; i != count; ++i)
+            release_node<ThreadSafe>(nodes[i]);
+    }
+
+    template <bool ThreadSafe>
+    void destruct_many (T * const * nodes, std::size_t count)
+    {
+        for (std::size_t i = 0; i != count; ++i)
+            destruct<ThreadSafe>(nodes[i]);
+    }
+
+    ~epoch_freelist(void)
+    {
+        record_allocator records(*this);
+
+        record * current = records_.load(memory_order_relaxed);
+        while (current) {
+            for (int i = 0; i != 3; ++i)
+                free_nodes(current->limbo[i].head);
+
+            record * next = current->next;
+            current->~record();
+            records.deallocate(current, 1);
+            current = next;
+        }
+
+        free_nodes(pool_.load(memory_order_relaxed).get_ptr());
+    }
+
+    /** \warning a new record is allocated from the allocator, if more operations than ever before are active at the same
+     *           time, so this is not lock-free in all cases */
+    bool is_lock_free(void) const
+    {
+        return pool_.is_lock_free() && global_epoch_.is_lock_free() && records_.is_lock_free();
+    }
+
+    T * get_handle(T * pointer) const
+    {
+        return pointer;
+    }
+
+    T * get_handle(tagged_node_handle const & handle) const
+    {
+        return get_pointer(handle);
+    }
+
+    T * get_pointer(tagged_node_handle const & tptr) const
+    {
+        return tptr.get_ptr();
+    }
+
+    T * get_pointer(T * pointer) const
+    {
+        return pointer;
+    }
+
+    T * null_handle(void) const
+    {
+        return NULL;
+    }
+
+    /** \returns number of nodes that are currently held in the cache */
+    std::size_t cached_nodes(void) const
+    {
+        return cached_.load(memory_order_relaxed);
+    }
+
+private:
+    /* nodes may be taken from the cache by a thread-safe operation only under an operation_guard, because other threads
+     * may read the next pointer of a node that has just been taken from the cache */
+    template <bool ThreadSafe, bool Bounded>
+    T * allocate (void)
+    {
+        T * node = ThreadSafe ? take_cached_node() : take_cached_node_unsafe();
+        if (node)
+            return node;
+
+        if (!Bounded)
+            return Alloc::allocate(1);
+        else
+            return 0;
+    }
+
+    T * take_cached_node (void)
+    {
+        tagged_node_ptr old_pool = pool_.load(memory_order_consume);
+
+        for(;;) {
+            if (!old_pool.get_ptr())
+                return 0;
+
+            freelist_node * new_pool_ptr = old_pool->next.get_ptr();
+            tagged_node_ptr new_pool (new_pool_ptr, old_pool.get_tag() + 1);
+
+            if (pool_.compare_exchange_weak(old_pool, new_pool)) {
+                cached_.fetch_sub(1, memory_order_relaxed);
+                void * ptr = old_pool.get_ptr();
+                return reinterpret_cast<T*>(ptr);
+            }
+        }
+    }
+
+    T * take_cached_node_unsafe (void)
+    {
+        tagged_node_ptr old_pool = pool_.load(memory_order_relaxed);
+
+        if (!old_pool.get_ptr())
+            return 0;
+
+        freelist_node * new_pool_ptr = old_pool->next.get_ptr();
+        tagged_node_ptr new_pool (new_pool_ptr, old_pool.get_tag() + 1);
+
+        pool_.store(new_pool, memory_order_relaxed);
+        cached_.store(cached_.load(memory_order_relaxed) - 1, memory_order_relaxed);
+        void * ptr = old_pool.get_ptr();
+        return reinterpret_cast<T*>(ptr);
+    }
+
+    template <bool ThreadSafe>
+    void cache_node (T * n)
+    {
+        void * node = n;
+        freelist_node * new_pool_ptr = reinterpret_cast<freelist_node*>(node);
+
+        if (ThreadSafe) {
+            tagged_node_ptr old_pool = pool_.load(memory_order_consume);
+
+            for(;;) {
+                tagged_node_ptr new_pool (new_pool_ptr, old_pool.get_tag());
+                new_pool->next.set_ptr(old_pool.get_ptr());
+
+                if (pool_.compare_exchange_weak(old_pool, new_pool))
+                    break;
+            }
+            cached_.fetch_add(1, memory_order_relaxed);
+        } else {
+            tagged_node_ptr old_pool = pool_.load(memory_order_relaxed);
+
+            tagged_node_ptr new_pool (new_pool_ptr, old_pool.get_tag());
+            new_pool->next.set_ptr(old_pool.get_ptr());
+
+            pool_.store(new_pool, memory_order_relaxed);
+            cached_.store(cached_.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        }
+    }
+
+    /* keep the node in the cache, unless it already holds the reserved number of nodes */
+    template <bool ThreadSafe>
+    void release_node (T * n)
+    {
+        if (cached_.load(memory_order_relaxed) < reserved_.load(memory_order_relaxed))
+            cache_node<ThreadSafe>(n);
+        else
+            Alloc::deallocate(n, 1);
+    }
+
+    void release_nodes (freelist_node * current)
+    {
+        while (current) {
+            freelist_node * next = current->next.get_ptr();
+            void * node = current;
+            release_node<true>(reinterpret_cast<T*>(node));
+            current = next;
+        }
+    }
+
+    void free_nodes (freelist_node * current)
+    {
+        while (current) {
+            freelist_node * next = current->next.get_ptr();
+            void * node = current;
+            Alloc::deallocate(reinterpret_cast<T*>(node), 1);
+            current = next;
+        }
+    }
+
+    /* release the limbo lists, whose nodes have been retired at least two epochs before epoch */
+    void collect (record * r, std::size_t epoch)
+    {
+        for (int i = 0; i != 3; ++i) {
+            limbo_list & list = r->limbo[i];
+            if (list.head && list.epoch + 2 <= epoch) {
+                release_nodes(list.head);
+                list.head = NULL;
+            }
+        }
+    }
+
+    record * enter (void)
+    {
+        for (record * r = records_.load(memory_order_acquire); r != NULL; r = r->next) {
+            std::size_t state = r->state.load(memory_order_relaxed);
+            if (state & 1)
+                continue;
+
+            if (r->state.compare_exchange_strong(state, state | 1, memory_order_acquire)) {
+                /* the epoch is read after the record has been acquired, so it is not older than the epoch of the
+                 * previous owner. it has to be visible, before the data structure is accessed */
+                std::size_t epoch = global_epoch_.load(memory_order_relaxed);
+                r->state.store(active_state(epoch), memory_order_relaxed);
+                atomic_thread_fence(memory_order_seq_cst);
+                collect(r, epoch);
+                return r;
+            }
+        }
+
+        record_allocator records(*this);
+        record * r = records.allocate(1);
+        new(r) record(global_epoch_.load(memory_order_relaxed));
+        atomic_thread_fence(memory_order_seq_cst);
+
+        record * head = records_.load(memory_order_relaxed);
+        for (;;) {
+            r->next = head;
+            if (records_.compare_exchange_weak(head, r, memory_order_release, memory_order_relaxed))
+                return r;
+        }
+    }
+
+    void leave (record * r)
+    {
+        std::size_t state = r->state.load(memory_order_relaxed);
+        r->state.store(state & ~std::size_t(1), memory_order_release);
+    }
+
+    /* the epoch, in which a node that has just been unlinked is retired. the epoch announced by the retiring operation
+     * cannot be used: the global epoch may have been advanced after the operation has entered, and operations, which
+     * have entered in the new epoch, may have read the node before it was unlinked. the fence orders the load after
+     * the unlink, so the node can only be reached by operations, which have announced this epoch or an older one */
+    std::size_t retire_epoch (void) const
+    {
+        atomic_thread_fence(memory_order_seq_cst);
+        return global_epoch_.load(memory_order_relaxed);
+    }
+
+    /* epoch is the global epoch read after n has been unlinked. as the record is active, it is either the epoch of the
+     * record or the next one */
+    void retire_node (record * r, T * n, std::size_t epoch)
+    {
+        limbo_list & list = r->limbo[epoch % 3];
+
+        if (list.epoch != epoch) {
+            /* the list holds nodes, which have been retired three or more epochs ago */
+            release_nodes(list.head);
+            list.head = NULL;
+            list.epoch = epoch;
+        }
+
+        void * node = n;
+        freelist_node * retired = reinterpret_cast<freelist_node*>(node);
+        retired->next.set_ptr(list.head);
+        list.head = retired;
+
+        if (++r->retired % advance_interval == 0)
+            try_advance_epoch();
+    }
+
+    /* the global epoch can be advanced, if all active operations have observed it */
+    void try_advance_epoch (void)
+    {
+        std::size_t epoch = global_epoch_.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        for (record * r = records_.load(memory_order_acquire); r != NULL; r = r->next) {
+            std::size_t state = r->state.load(memory_order_relaxed);
+            if ((state & 1) && (state >> 1) != epoch)
+                return;
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+        if (global_epoch_.compare_exchange_strong(epoch, epoch + 1, memory_order_release, memory_order_relaxed))
+            collect_idle_records(epoch + 1);
+    }
+
+    /* records, which are not used by any operation, would keep their retired nodes until they are used again */
+    void collect_idle_records (std::size_t epoch)
+    {
+        for (record * r = records_.load(memory_order_acquire); r != NULL; r = r->next) {
+            std::size_t state = r->state.load(memory_order_relaxed);
+            if (state & 1)
+                continue;
+
+            if (r->state.compare_exchange_strong(state, state | 1, memory_order_acquire)) {
+                collect(r, epoch);
+                leave(r);
+            }
+        }
+    }
+
+    atomic<std::size_t> global_epoch_;
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(std::size_t);
+    char padding[padding_size];
+    atomic<record*> records_;
+    atomic<tagged_node_ptr> pool_;
+    atomic<std::size_t> cached_;
+    atomic<std::size_t> reserved_;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_DETAIL_EPOCH_FREELIST_HPP_INCLUDED */
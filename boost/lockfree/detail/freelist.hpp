@@ -18,6 +18,7 @@
 #include <boost/static_assert.hpp>
 
 #include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/epoch_freelist.hpp>
 #include <boost/lockfree/detail/parameter.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
 
@@ -25,6 +26,15 @@ namespace boost    {
 namespace lockfree {
 namespace detail   {
 
+/* the data structures bracket their thread-safe operations with an operation_guard of their freelist and hand removed
+ * nodes to retire. freelists, which never release their nodes, don't need to track the operations */
+template <typename Freelist>
+struct null_operation_guard
+{
+    explicit null_operation_guard(Freelist const &)
+    {}
+};
+
 template <typename T,
           typename Alloc = std::allocator<T>
          >
@@ -40,6 +50,7 @@ class freelist_stack:
 
 public:
     typedef tagged_ptr<T> tagged_node_handle;
+    typedef null_operation_guard<freelist_stack> operation_guard;
 
     template <typename Allocator>
     freelist_stack (Allocator const & alloc, std::size_t n = 0):
@@ -107,6 +118,67 @@ public:
         deallocate<ThreadSafe>(n);
     }
 
+    template <typename Handle>
+    void retire (operation_guard &, Handle handle)
+    {
+        destruct<true>(handle);
+    }
+
+    void retire_many (operation_guard &, T * const * nodes, std::size_t count)
+    {
+        destruct_many<true>(nodes, count);
+    }
+
+    /** allocate up to count nodes, taking them from the freelist with a single compare-and-swap. if the freelist runs
+     *  short and Bounded is false, the remaining nodes are allocated from the allocator. the nodes are not constructed.
+     *
+     *  \returns number of nodes stored to nodes
+     * */
+    template <bool ThreadSafe, bool Bounded>
+    std::size_t allocate_many (T ** nodes, std::size_t count)
+    {
+        std::size_t allocated = ThreadSafe ? allocate_many_impl(nodes, count)
+                                           : allocate_many_impl_unsafe(nodes, count);
+        if (!Bounded) {
+            try {
+                for (; allocated != count; ++allocated)
+                    nodes[allocated] = Alloc::allocate(1);
+            } catch (...) {
+                deallocate_many<ThreadSafe>(nodes, allocated);
+                throw;
+            }
+        }
+        return allocated;
+    }
+
+    /** return count unconstructed nodes to the freelist with a single compare-and-swap */
+    template <bool ThreadSafe>
+    void deallocate_many (T * const * nodes, std::size_t count)
+    {
+        if (count == 0)
+            return;
+
+        for (std::size_t i = 0; i != count - 1; ++i) {
+            void * node = nodes[i];
+            reinterpret_cast<freelist_node*>(node)->next.set_ptr(reinterpret_cast<freelist_node*>(nodes[i + 1]));
+        }
+
+        void * first = nodes[0];
+        void * last = nodes[count - 1];
+        if (ThreadSafe)
+            link_nodes_impl(reinterpret_cast<freelist_node*>(first), reinterpret_cast<freelist_node*>(last));
+        else
+            link_nodes_impl_unsafe(reinterpret_cast<freelist_node*>(first), reinterpret_cast<freelist_node*>(last));
+    }
+
+    template <bool ThreadSafe>
+    void destruct_many (T * const * nodes, std::size_t count)
+    {
+        for (std::size_t i = 0; i != count; ++i)
+            nodes[i]->~T();
+        deallocate_many<ThreadSafe>(nodes, count);
+    }
+
     ~freelist_stack(void)
     {
         tagged_node_ptr current (pool_);
@@ -203,6 +275,58 @@ private:
         return reinterpret_cast<T*>(ptr);
     }
 
+    std::size_t allocate_many_impl (T ** nodes, std::size_t count)
+    {
+        if (count == 0)
+            return 0;
+
+        tagged_node_ptr old_pool = pool_.load(memory_order_consume);
+
+        for(;;) {
+            freelist_node * last = old_pool.get_ptr();
+            if (!last)
+                return 0;
+
+            /* the nodes below the top cannot change while the tagged top is unchanged */
+            std::size_t taken = 1;
+            for (; taken != count; ++taken) {
+                freelist_node * next = last->next.get_ptr();
+                if (!next)
+                    break;
+                last = next;
+            }
+
+            tagged_node_ptr new_pool (last->next.get_ptr(), old_pool.get_tag() + 1);
+
+            if (pool_.compare_exchange_weak(old_pool, new_pool)) {
+                freelist_node * current = old_pool.get_ptr();
+                for (std::size_t i = 0; i != taken; ++i) {
+                    void * ptr = current;
+                    current = current->next.get_ptr();
+                    nodes[i] = reinterpret_cast<T*>(ptr);
+                }
+                return taken;
+            }
+        }
+    }
+
+    std::size_t allocate_many_impl_unsafe (T ** nodes, std::size_t count)
+    {
+        tagged_node_ptr old_pool = pool_.load(memory_order_relaxed);
+        freelist_node * current = old_pool.get_ptr();
+
+        std::size_t taken = 0;
+        for (; taken != count && current; ++taken) {
+            void * ptr = current;
+            current = current->next.get_ptr();
+            nodes[taken] = reinterpret_cast<T*>(ptr);
+        }
+
+        tagged_node_ptr new_pool (current, old_pool.get_tag() + 1);
+        pool_.store(new_pool, memory_order_relaxed);
+        return taken;
+    }
+
     template <bool ThreadSafe>
     void deallocate (T * n)
     {
@@ -212,6 +336,29 @@ private:
             deallocate_impl_unsafe(n);
     }
 
+    void link_nodes_impl (freelist_node * first, freelist_node * last)
+    {
+        tagged_node_ptr old_pool = pool_.load(memory_order_consume);
+
+        for(;;) {
+            tagged_node_ptr new_pool (first, old_pool.get_tag());
+            last->next.set_ptr(old_pool.get_ptr());
+
+            if (pool_.compare_exchange_weak(old_pool, new_pool))
+                return;
+        }
+    }
+
+    void link_nodes_impl_unsafe (freelist_node * first, freelist_node * last)
+    {
+        tagged_node_ptr old_pool = pool_.load(memory_order_relaxed);
+
+        tagged_node_ptr new_pool (first, old_pool.get_tag());
+        last->next.set_ptr(old_pool.get_ptr());
+
+        pool_.store(new_pool, memory_order_relaxed);
+    }
+
     void deallocate_impl (T * n)
     {
         void * node = n;
@@ -390,6 +537,7 @@ class fixed_size_freelist:
 
 public:
     typedef tagged_index tagged_node_handle;
+    typedef null_operation_guard<fixed_size_freelist> operation_guard;
 
     template <typename Allocator>
     fixed_size_freelist (Allocator const & alloc, std::size_t count):
@@ -457,6 +605,59 @@ public:
         deallocate<ThreadSafe>(n - NodeStorage::nodes());
     }
 
+    template <typename Handle>
+    void retire (operation_guard &, Handle handle)
+    {
+        destruct<true>(handle);
+    }
+
+    void retire_many (operation_guard &, T * const * nodes, std::size_t count)
+    {
+        destruct_many<true>(nodes, count);
+    }
+
+    /** allocate up to count nodes, taking them from the freelist with a single compare-and-swap. the nodes are not
+     *  constructed.
+     *
+     *  \returns number of nodes stored to nodes
+     * */
+    template <bool ThreadSafe, bool Bounded>
+    std::size_t allocate_many (T ** nodes, std::size_t count)
+    {
+        if (ThreadSafe)
+            return allocate_many_impl(nodes, count);
+        else
+            return allocate_many_impl_unsafe(nodes, count);
+    }
+
+    /** return count unconstructed nodes to the freelist with a single compare-and-swap */
+    template <bool ThreadSafe>
+    void deallocate_many (T * const * nodes, std::size_t count)
+    {
+        if (count == 0)
+            return;
+
+        for (std::size_t i = 0; i != count - 1; ++i) {
+            freelist_node * node = reinterpret_cast<freelist_node*>(nodes[i]);
+            node->next.set_index(static_cast<index_t>(nodes[i + 1] - NodeStorage::nodes()));
+        }
+
+        index_t first = static_cast<index_t>(nodes[0] - NodeStorage::nodes());
+        index_t last = static_cast<index_t>(nodes[count - 1] - NodeStorage::nodes());
+        if (ThreadSafe)
+            link_nodes_impl(first, last);
+        else
+            link_nodes_impl_unsafe(first, last);
+    }
+
+    template <bool ThreadSafe>
+    void destruct_many (T * const * nodes, std::size_t count)
+    {
+        for (std::size_t i = 0; i != count; ++i)
+            nodes[i]->~T();
+        deallocate_many<ThreadSafe>(nodes, count);
+    }
+
     bool is_lock_free(void) const
     {
         return pool_.is_lock_free();
@@ -545,6 +746,63 @@ private:
         return old_pool.get_index();
     }
 
+    index_t next_index (index_t index) const
+    {
+        tagged_index * next = reinterpret_cast<tagged_index*>(NodeStorage::nodes() + index);
+        return next->get_index();
+    }
+
+    std::size_t allocate_many_impl (T ** nodes, std::size_t count)
+    {
+        if (count == 0)
+            return 0;
+
+        tagged_index old_pool = pool_.load(memory_order_consume);
+
+        for(;;) {
+            index_t last = old_pool.get_index();
+            if (last == null_handle())
+                return 0;
+
+            /* the nodes below the top cannot change while the tagged top is unchanged. if it has changed, we may read
+             * arbitrary indices, which must not be used to address the storage */
+            std::size_t taken = 1;
+            for (; taken != count; ++taken) {
+                index_t next = next_index(last);
+                if (next >= null_handle())
+                    break;
+                last = next;
+            }
+
+            tagged_index new_pool(next_index(last), old_pool.get_tag() + 1);
+
+            if (pool_.compare_exchange_weak(old_pool, new_pool)) {
+                index_t current = old_pool.get_index();
+                for (std::size_t i = 0; i != taken; ++i) {
+                    nodes[i] = NodeStorage::nodes() + current;
+                    current = next_index(current);
+                }
+                return taken;
+            }
+        }
+    }
+
+    std::size_t allocate_many_impl_unsafe (T ** nodes, std::size_t count)
+    {
+        tagged_index old_pool = pool_.load(memory_order_consume);
+        index_t current = old_pool.get_index();
+
+        std::size_t taken = 0;
+        for (; taken != count && current != null_handle(); ++taken) {
+            nodes[taken] = NodeStorage::nodes() + current;
+            current = next_index(current);
+        }
+
+        tagged_index new_pool(current, old_pool.get_tag() + 1);
+        pool_.store(new_pool, memory_order_relaxed);
+        return taken;
+    }
+
     template <bool ThreadSafe>
     void deallocate (index_t index)
     {
@@ -579,6 +837,31 @@ private:
         pool_.store(new_pool);
     }
 
+    void link_nodes_impl (index_t first, index_t last)
+    {
+        freelist_node * last_node = reinterpret_cast<freelist_node*>(NodeStorage::nodes() + last);
+        tagged_index old_pool = pool_.load(memory_order_consume);
+
+        for(;;) {
+            tagged_index new_pool (first, old_pool.get_tag());
+            last_node->next.set_index(old_pool.get_index());
+
+            if (pool_.compare_exchange_weak(old_pool, new_pool))
+                return;
+        }
+    }
+
+    void link_nodes_impl_unsafe (index_t first, index_t last)
+    {
+        freelist_node * last_node = reinterpret_cast<freelist_node*>(NodeStorage::nodes() + last);
+        tagged_index old_pool = pool_.load(memory_order_consume);
+
+        tagged_index new_pool (first, old_pool.get_tag());
+        last_node->next.set_index(old_pool.get_index());
+
+        pool_.store(new_pool);
+    }
+
     atomic<tagged_index> pool_;
 };
 
@@ -586,7 +869,8 @@ template <typename T,
           typename Alloc,
           bool IsCompileTimeSized,
           bool IsFixedSize,
-          std::size_t Capacity
+          std::size_t Capacity,
+          bool ReclaimMemory = false
           >
 struct select_freelist
 {
@@ -595,9 +879,14 @@ struct select_freelist
                                runtime_sized_freelist_storage<T, Alloc>
                               >::type fixed_sized_storage_type;
 
+    typedef typename mpl::if_c<ReclaimMemory,
+                               epoch_freelist<T, Alloc>,
+                               freelist_stack<T, Alloc>
+                              >::type node_based_freelist_type;
+
     typedef typename mpl::if_c<IsCompileTimeSized || IsFixedSize,
                                fixed_size_freelist<T, fixed_sized_storage_type>,
-                               freelist_stack<T, Alloc>
+                               node_based_freelist_type
                               >::type type;
 };
 
@@ -66,6 +66,19 @@ struct extract_fixed_sized
     static const bool value = type::value;
 };
 
+template <typename bound_args>
+struct extract_reclaim_memory
+{
+    static const bool has_reclaim_memory = has_arg<bound_args, tag::reclaim_memory>::value;
+
+    typedef typename mpl::if_c<has_reclaim_memory,
+                               typename has_arg<bound_args, tag::reclaim_memory>::type,
+                               mpl::bool_<false>
+                              >::type type;
+
+    static const bool value = type::value;
+};
+
 
 } /* namespace detail */
 } /* namespace lockfree */
@@ -0,0 +1,469 @@
+//  lock-free bounded multi-producer/multi-consumer ringbuffer
+//  based on the bounded mpmc queue by Dmitry Vyukov
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_MPMC_QUEUE_HPP_INCLUDED
+#define BOOST_LOCKFREE_MPMC_QUEUE_HPP_INCLUDED
+
+#include <cstddef>
+#include <new>
+
+#include <boost/array.hpp>
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/copy_payload.hpp>
+#include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+typedef parameter::parameters<boost::parameter::optional<tag::capacity>,
+                              boost::parameter::optional<tag::allocator>
+                             > mpmc_ringbuffer_signature;
+
+/* each slot carries a sequence number, which tells producers and consumers whose turn it is:
+ * - sequence == position:     the slot is free and can be written by the producer, which claims position
+ * - sequence == position + 1: the slot holds the element pushed at position and can be read by the consumer, which claims
+ *                             position
+ * after reading, the consumer sets the sequence to position + capacity, so that the slot is free for the next round */
+template <typename T>
+struct mpmc_ringbuffer_slot
+{
+    mpmc_ringbuffer_slot(void):
+        sequence_(0), data()
+    {}
+
+    atomic<std::size_t> sequence_;
+    T data;
+};
+
+template <typename T>
+class mpmc_ringbuffer_base:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+protected:
+    typedef std::size_t size_t;
+    typedef mpmc_ringbuffer_slot<T> slot;
+
+private:
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(size_t);
+    char padding0[BOOST_LOCKFREE_CACHELINE_BYTES];
+    atomic<size_t> enqueue_position_;
+    char padding1[padding_size]; /* force enqueue_position and dequeue_position to different cache lines */
+    atomic<size_t> dequeue_position_;
+    char padding2[padding_size]; /* keep the storage of the derived class off the dequeue_position cache line */
+
+protected:
+    mpmc_ringbuffer_base(void):
+        enqueue_position_(0), dequeue_position_(0)
+    {}
+
+    static slot * get_slot(size_t position, slot * buffer, size_t max_size)
+    {
+        if ((max_size & (max_size - 1)) == 0)
+            return buffer + (position & (max_size - 1)); /* avoid the division for power-of-two sizes */
+        return buffer + position % max_size;
+    }
+
+    /* the difference between a sequence number and the expected one. positions only wrap around after 2**N operations,
+     * where N is the number of bits of size_t */
+    static std::ptrdiff_t distance(size_t sequence, size_t expected)
+    {
+        return static_cast<std::ptrdiff_t>(sequence - expected);
+    }
+
+    bool push(T const & t, slot * buffer, size_t max_size)
+    {
+        size_t position = enqueue_position_.load(memory_order_relaxed);
+
+        for (;;) {
+            slot * s = get_slot(position, buffer, max_size);
+            size_t sequence = s->sequence_.load(memory_order_acquire);
+            std::ptrdiff_t diff = distance(sequence, position);
+
+            if (likely(diff == 0)) {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    s->data = t;
+                    s->sequence_.store(position + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0)
+                return false; /* ringbuffer is full */
+            else
+                position = enqueue_position_.load(memory_order_relaxed);
+        }
+    }
+
+    template <typename U>
+    bool pop(U & ret, slot * buffer, size_t max_size)
+    {
+        size_t position = dequeue_position_.load(memory_order_relaxed);
+
+        for (;;) {
+            slot * s = get_slot(position, buffer, max_size);
+            size_t sequence = s->sequence_.load(memory_order_acquire);
+            std::ptrdiff_t diff = distance(sequence, position + 1);
+
+            if (likely(diff == 0)) {
+                if (dequeue_position_.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    detail::copy_payload(s->data, ret);
+                    s->sequence_.store(position + max_size, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0)
+                return false; /* ringbuffer is empty */
+            else
+                position = dequeue_position_.load(memory_order_relaxed);
+        }
+    }
+
+    bool empty(slot * buffer, size_t max_size) const
+    {
+        size_t position = dequeue_position_.load(memory_order_relaxed);
+        slot * s = get_slot(position, buffer, max_size);
+        return distance(s->sequence_.load(memory_order_acquire), position + 1) < 0;
+    }
+
+    bool is_lock_free(void) const
+    {
+        return enqueue_position_.is_lock_free() && dequeue_position_.is_lock_free();
+    }
+#endif
+};
+
+template <typename T, std::size_t max_size>
+class compile_time_sized_mpmc_ringbuffer:
+    public mpmc_ringbuffer_base<T>
+{
+    typedef std::size_t size_t;
+    typedef mpmc_ringbuffer_slot<T> slot;
+
+    BOOST_STATIC_ASSERT(max_size > 0);
+
+    mutable boost::array<slot, max_size> slots_;
+
+    slot * slots(void) const
+    {
+        return slots_.c_array();
+    }
+
+public:
+    compile_time_sized_mpmc_ringbuffer(void)
+    {
+        for (size_t i = 0; i != max_size; ++i)
+            slots_[i].sequence_.store(i, memory_order_relaxed);
+    }
+
+    bool push(T const & t)
+    {
+        return mpmc_ringbuffer_base<T>::push(t, slots(), max_size);
+    }
+
+    template <typename U>
+    bool pop(U & ret)
+    {
+        return mpmc_ringbuffer_base<T>::pop(ret, slots(), max_size);
+    }
+
+    bool empty(void) const
+    {
+        return mpmc_ringbuffer_base<T>::empty(slots(), max_size);
+    }
+
+    size_t capacity(void) const
+    {
+        return max_size;
+    }
+};
+
+template <typename T, typename Alloc>
+class runtime_sized_mpmc_ringbuffer:
+    public mpmc_ringbuffer_base<T>,
+    private Alloc::template rebind<mpmc_ringbuffer_slot<T> >::other
+{
+    typedef std::size_t size_t;
+    typedef mpmc_ringbuffer_slot<T> slot;
+    typedef typename Alloc::template rebind<slot>::other slot_allocator;
+    typedef typename slot_allocator::pointer pointer;
+
+    size_t max_elements_;
+    pointer array_;
+
+    void initialize(void)
+    {
+        BOOST_ASSERT(max_elements_ > 0);
+        array_ = slot_allocator::allocate(max_elements_);
+        for (size_t i = 0; i != max_elements_; ++i)
+            new(&*array_ + i) slot();
+        for (size_t i = 0; i != max_elements_; ++i)
+            array_[i].sequence_.store(i, memory_order_relaxed);
+    }
+
+public:
+    explicit runtime_sized_mpmc_ringbuffer(size_t max_elements):
+        max_elements_(max_elements)
+    {
+        initialize();
+    }
+
+    template <typename U>
+    runtime_sized_mpmc_ringbuffer(typename Alloc::template rebind<U>::other const & alloc, size_t max_elements):
+        slot_allocator(alloc), max_elements_(max_elements)
+    {
+        initialize();
+    }
+
+    runtime_sized_mpmc_ringbuffer(Alloc const & alloc, size_t max_elements):
+        slot_allocator(alloc), max_elements_(max_elements)
+    {
+        initialize();
+    }
+
+    ~runtime_sized_mpmc_ringbuffer(void)
+    {
+        for (size_t i = 0; i != max_elements_; ++i)
+            (&*array_ + i)->~slot();
+        slot_allocator::deallocate(array_, max_elements_);
+    }
+
+    bool push(T const & t)
+    {
+        return mpmc_ringbuffer_base<T>::push(t, &*array_, max_elements_);
+    }
+
+    template <typename U>
+    bool pop(U & ret)
+    {
+        return mpmc_ringbuffer_base<T>::pop(ret, &*array_, max_elements_);
+    }
+
+    bool empty(void) const
+    {
+        return mpmc_ringbuffer_base<T>::empty(&*array_, max_elements_);
+    }
+
+    size_t capacity(void) const
+    {
+        return max_elements_;
+    }
+};
+
+template <typename T, typename A0, typename A1>
+struct make_mpmc_ringbuffer
+{
+    typedef typename mpmc_ringbuffer_signature::bind<A0, A1>::type bound_args;
+
+    typedef extract_capacity<bound_args> extract_capacity_t;
+
+    static const bool runtime_sized = !extract_capacity_t::has_capacity;
+    static const size_t capacity    =  extract_capacity_t::capacity;
+
+    typedef extract_allocator<bound_args, T> extract_allocator_t;
+    typedef typename extract_allocator_t::type allocator;
+
+    // allocator argument is only sane, for run-time sized ringbuffers
+    BOOST_STATIC_ASSERT((mpl::if_<mpl::bool_<!runtime_sized>,
+                                  mpl::bool_<!extract_allocator_t::has_allocator>,
+                                  mpl::true_
+                                 >::type::value));
+
+    typedef typename mpl::if_c<runtime_sized,
+                               runtime_sized_mpmc_ringbuffer<T, allocator>,
+                               compile_time_sized_mpmc_ringbuffer<T, capacity>
+                              >::type ringbuffer_type;
+};
+
+
+} /* namespace detail */
+
+
+/** The mpmc_queue class provides a bounded multi-writer/multi-reader fifo queue, pushing and popping is lock-free.
+ *
+ *  The elements are stored inside a ringbuffer of slots. Each slot carries a sequence number, so that producers and
+ *  consumers only need to claim a position with a single compare-and-exchange and no internal nodes or freelist are
+ *  involved. The size of the queue is fixed at construction time.
+ *
+ *  \b Policies:
+ *  - \c boost::lockfree::capacity<>, optional <br>
+ *    If this template argument is passed to the options, the size of the ringbuffer is set at compile-time.
+ *
+ *  - \c boost::lockfree::allocator<>, defaults to \c boost::lockfree::allocator<std::allocator<T>> <br>
+ *    Specifies the allocator that is used to allocate the ringbuffer. This option is only valid, if the ringbuffer is configured
+ *    to be sized at run-time
+ *
+ *  \b Requirements:
+ *  - T must have a default constructor
+ *  - T must be copyable
+ * */
+#ifndef BOOST_DOXYGEN_INVOKED
+template <typename T,
+          class A0 = boost::parameter::void_,
+          class A1 = boost::parameter::void_>
+#else
+template <typename T, ...Options>
+#endif
+class mpmc_queue:
+    public detail::make_mpmc_ringbuffer<T, A0, A1>::ringbuffer_type
+{
+private:
+
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef typename detail::make_mpmc_ringbuffer<T, A0, A1>::ringbuffer_type base_type;
+    static const bool runtime_sized = detail::make_mpmc_ringbuffer<T, A0, A1>::runtime_sized;
+    typedef typename detail::make_mpmc_ringbuffer<T, A0, A1>::allocator allocator_arg;
+
+    struct implementation_defined
+    {
+        typedef allocator_arg allocator;
+        typedef std::size_t size_type;
+    };
+#endif
+
+public:
+    typedef T value_type;
+    typedef typename implementation_defined::allocator allocator;
+    typedef typename implementation_defined::size_type size_type;
+
+    /** Constructs a mpmc_queue
+     *
+     *  \pre mpmc_queue must be configured to be sized at compile-time
+     */
+    // @{
+    mpmc_queue(void)
+    {
+        BOOST_ASSERT(!runtime_sized);
+    }
+
+    template <typename U>
+    explicit mpmc_queue(typename allocator::template rebind<U>::other const & alloc)
+    {
+        // just for API compatibility: we don't actually need an allocator
+        BOOST_STATIC_ASSERT(!runtime_sized);
+    }
+
+    explicit mpmc_queue(allocator const & alloc)
+    {
+        // just for API compatibility: we don't actually need an allocator
+        BOOST_ASSERT(!runtime_sized);
+    }
+    // @}
+
+
+    /** Constructs a mpmc_queue for element_count elements
+     *
+     *  \pre mpmc_queue must be configured to be sized at run-time
+     */
+    // @{
+    explicit mpmc_queue(size_type element_count):
+        base_type(element_count)
+    {
+        BOOST_ASSERT(runtime_sized);
+    }
+
+    template <typename U>
+    mpmc_queue(size_type element_count, typename allocator::template rebind<U>::other const & alloc):
+        base_type(alloc, element_count)
+    {
+        BOOST_STATIC_ASSERT(runtime_sized);
+    }
+
+    mpmc_queue(size_type element_count, allocator_arg const & alloc):
+        base_type(alloc, element_count)
+    {
+        BOOST_ASSERT(runtime_sized);
+    }
+    // @}
+
+    /**
+     * \return true, if implementation is lock-free.
+     * */
+    bool is_lock_free (void) const
+    {
+        return base_type::is_lock_free();
+    }
+
+    /** Pushes object t to the queue.
+     *
+     * \post object will be pushed to the queue, unless it is full.
+     * \return true, if the push operation is successful, false if the queue was full.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool push(T const & t)
+    {
+        return base_type::push(t);
+    }
+
+    /** Pushes object t to the queue.
+     *
+     * \note Same as push. Provided for compatibility with the fixed-sized configuration of boost::lockfree::queue.
+     * */
+    bool bounded_push(T const & t)
+    {
+        return base_type::push(t);
+    }
+
+    /** Pops object from queue.
+     *
+     * \post if pop operation is successful, object will be copied to ret.
+     * \return true, if the pop operation is successful, false if the queue was empty.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool pop(T & ret)
+    {
+        return base_type::pop(ret);
+    }
+
+    /** Pops object from queue.
+     *
+     * \pre type U must be constructible by T and copyable, or T must be convertible to U
+     * \post if pop operation is successful, object will be copied to ret.
+     * \return true, if the pop operation is successful, false if the queue was empty.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    template <typename U>
+    bool pop(U & ret)
+    {
+        return base_type::pop(ret);
+    }
+
+    /** Check if the queue is empty
+     *
+     * \return true, if the queue is empty, false otherwise
+     * \note The result is only accurate, if no other thread modifies the queue. Therefore it is rarely practical to use this
+     *       value in program logic.
+     * */
+    bool empty(void) const
+    {
+        return base_type::empty();
+    }
+
+    /**
+     * \return the maximum number of elements that the queue can hold
+     * */
+    size_type capacity(void) const
+    {
+        return base_type::capacity();
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+
+#endif /* BOOST_LOCKFREE_MPMC_QUEUE_HPP_INCLUDED */
@@ -21,6 +21,7 @@ namespace lockfree {
 namespace tag { struct allocator ; }
 namespace tag { struct fixed_sized; }
 namespace tag { struct capacity; }
+namespace tag { struct reclaim_memory; }
 
 #endif
 
@@ -45,6 +46,19 @@ struct capacity:
     boost::parameter::template_keyword<tag::capacity, boost::mpl::size_t<Size> >
 {};
 
+/** Configures a node-based data structure to \b reclaim the memory of its internal nodes.
+ *
+ *  By default, nodes are pushed to a freelist and not returned to the allocator before the data structure is destroyed. If
+ *  memory reclamation is enabled, nodes are returned to the allocator as soon as no thread can reference them any more,
+ *  which is detected by an epoch-based scheme. Up to the number of nodes that has been reserved are kept in a cache, but
+ *  popped nodes only become available to \c bounded_push after they have been reclaimed.
+ *  This cannot be combined with fixed-sized data structures.
+ * */
+template <bool ReclaimMemory>
+struct reclaim_memory:
+    boost::parameter::template_keyword<tag::reclaim_memory, boost::mpl::bool_<ReclaimMemory> >
+{};
+
 /** Defines the \b allocator type of a data structure.
  * */
 template <class Alloc>
@@ -11,7 +11,9 @@
 #ifndef BOOST_LOCKFREE_FIFO_HPP_INCLUDED
 #define BOOST_LOCKFREE_FIFO_HPP_INCLUDED
 
+#include <iterator>
 #include <memory>               /* std::auto_ptr */
+#include <limits>
 
 #include <boost/assert.hpp>
 #include <boost/noncopyable.hpp>
@@ -38,7 +40,8 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
 
 /** The queue class provides a multi-writer/multi-reader queue, pushing and popping is lock-free,
  *  construction/destruction has to be synchronized. It uses a freelist for memory management,
- *  freed nodes are pushed to the freelist and not returned to the OS before the queue is destroyed.
+ *  freed nodes are pushed to the freelist and not returned to the OS before the queue is destroyed,
+ *  unless it is configured to reclaim memory.
  *
  *  \b Policies:
  *  - \ref boost::lockfree::fixed_sized, defaults to \c boost::lockfree::fixed_sized<false> \n
@@ -52,6 +55,11 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
  *    If this template argument is passed to the options, the size of the queue is set at compile-time.\n
  *    It this option implies \c fixed_sized<true>
  *
+ *  - \ref boost::lockfree::reclaim_memory, defaults to \c boost::lockfree::reclaim_memory<false> \n
+ *    If enabled, nodes are returned to the allocator once no thread can reference them any more, except for the nodes
+ *    that have been reserved. Every thread-safe operation takes part in an epoch-based reclamation scheme, which adds a few
+ *    atomic operations to it. Cannot be combined with \c fixed_sized<true> or \c capacity<>.
+ *
  *  - \ref boost::lockfree::allocator, defaults to \c boost::lockfree::allocator<std::allocator<void>> \n
  *    Specifies the allocator that is used for the internal freelist
  *
@@ -81,6 +89,10 @@ private:
     static const bool fixed_sized = detail::extract_fixed_sized<bound_args>::value;
     static const bool node_based = !(has_capacity || fixed_sized);
     static const bool compile_time_sized = has_capacity;
+    static const bool reclaim_memory = detail::extract_reclaim_memory<bound_args>::value;
+
+    // memory can only be reclaimed, if the nodes are allocated individually
+    BOOST_STATIC_ASSERT(!reclaim_memory || node_based);
 
     struct BOOST_LOCKFREE_CACHELINE_ALIGNMENT node
     {
@@ -108,8 +120,10 @@ private:
     };
 
     typedef typename detail::extract_allocator<bound_args, node>::type node_allocator;
-    typedef typename detail::select_freelist<node, node_allocator, compile_time_sized, fixed_sized, capacity>::type pool_t;
+    typedef typename detail::select_freelist<node, node_allocator, compile_time_sized, fixed_sized, capacity,
+                                             reclaim_memory>::type pool_t;
     typedef typename pool_t::tagged_node_handle tagged_node_handle;
+    typedef typename pool_t::operation_guard operation_guard;
     typedef typename detail::select_tagged_handle<node, node_based>::handle_type handle_type;
 
     void initialize(void)
@@ -126,6 +140,9 @@ private:
         typedef std::size_t size_type;
     };
 
+    /* number of nodes that bulk operations allocate from or return to the freelist at a time */
+    static const std::size_t bulk_chunk_size = 64;
+
 #endif
 
 public:
@@ -269,12 +286,97 @@ private:
     {
         using detail::likely;
 
+        operation_guard guard(pool);
         node * n = pool.template construct<true, Bounded>(t, pool.null_handle());
-        handle_type node_handle = pool.get_handle(n);
 
         if (n == NULL)
             return false;
 
+        link_nodes_atomic(n, n);
+        return true;
+    }
+
+    /* the number of nodes to allocate for the next chunk of the range. single pass iterators cannot be walked twice,
+     * so a whole chunk is allocated for them and the nodes, which are not used, are returned to the pool */
+    template <typename ConstIterator>
+    static std::size_t chunk_size(ConstIterator begin, ConstIterator end, std::forward_iterator_tag)
+    {
+        std::size_t count = 0;
+        for (; begin != end && count != bulk_chunk_size; ++begin)
+            ++count;
+        return count;
+    }
+
+    template <typename ConstIterator>
+    static std::size_t chunk_size(ConstIterator, ConstIterator, std::input_iterator_tag)
+    {
+        return bulk_chunk_size;
+    }
+
+    template <bool Bounded, typename ConstIterator>
+    ConstIterator do_push(ConstIterator begin, ConstIterator end)
+    {
+        typedef typename std::iterator_traits<ConstIterator>::iterator_category iterator_category;
+
+        operation_guard guard(pool);
+        node * first = NULL;
+        node * last = NULL;
+
+        try {
+            while (begin != end) {
+                std::size_t count = chunk_size(begin, end, iterator_category());
+
+                node * nodes[bulk_chunk_size];
+                std::size_t allocated = pool.template allocate_many<true, Bounded>(nodes, count);
+
+                std::size_t constructed = 0;
+                try {
+                    for (; constructed != allocated && begin != end; ++constructed, ++begin)
+                        new(nodes[constructed]) node(*begin, pool.null_handle());
+                } catch (...) {
+                    pool.template destruct_many<true>(nodes, constructed);
+                    pool.template deallocate_many<true>(nodes + constructed, allocated - constructed);
+                    throw;
+                }
+                pool.template deallocate_many<true>(nodes + constructed, allocated - constructed);
+
+                for (std::size_t i = 0; i != constructed; ++i) {
+                    if (last)
+                        link_node(last, nodes[i]);
+                    else
+                        first = nodes[i];
+                    last = nodes[i];
+                }
+
+                if (allocated != count)
+                    break;
+            }
+        } catch (...) {
+            destruct_chain(first, NULL);
+            throw;
+        }
+
+        if (first)
+            link_nodes_atomic(first, last);
+        return begin;
+    }
+
+    /* make next the successor of n, which is not yet part of the queue */
+    void link_node(node * n, node * next)
+    {
+        tagged_node_handle old_next = n->next.load(memory_order_relaxed);
+        tagged_node_handle new_next(pool.get_handle(next), old_next.get_tag());
+        n->next.store(new_next, memory_order_relaxed);
+    }
+
+    /* append the list of nodes from first to last to the queue */
+    void link_nodes_atomic(node * first, node * last)
+    {
+        using detail::likely;
+
+        handle_type first_handle = pool.get_handle(first);
+        handle_type last_handle = pool.get_handle(last);
+
         for (;;) {
             tagged_node_handle tail = tail_.load(memory_order_acquire);
             node * tail_node = pool.get_pointer(tail);
@@ -284,11 +386,13 @@ private:
             tagged_node_handle tail2 = tail_.load(memory_order_acquire);
             if (likely(tail == tail2)) {
                 if (next_ptr == 0) {
-                    tagged_node_handle new_tail_next(node_handle, next.get_tag() + 1);
+                    tagged_node_handle new_tail_next(first_handle, next.get_tag() + 1);
                     if ( tail_node->next.compare_exchange_weak(next, new_tail_next) ) {
-                        tagged_node_handle new_tail(node_handle, tail.get_tag() + 1);
+                        /* other threads can only advance the tail one node at a time, so we move it to the end of the
+                         * list, unless it has already been moved */
+                        tagged_node_handle new_tail(last_handle, tail.get_tag() + 1);
                         tail_.compare_exchange_strong(tail, new_tail);
-                        return true;
+                        return;
                     }
                 }
                 else {
@@ -298,10 +402,150 @@ private:
             }
         }
     }
+
+    /* destroy the nodes from first up to, but not including, last. the nodes must not be reachable from the queue. if
+     * they have been unlinked from the queue, guard is the guard of the operation that unlinked them, otherwise NULL */
+    void destruct_chain(node * first, node * last, operation_guard * guard = NULL)
+    {
+        node * nodes[bulk_chunk_size];
+        std::size_t count = 0;
+
+        for (node * current = first; current != last;) {
+            node * next = pool.get_pointer(current->next.load(memory_order_relaxed));
+            nodes[count++] = current;
+            if (count == bulk_chunk_size) {
+                destruct_nodes(nodes, count, guard);
+                count = 0;
+            }
+            current = next;
+        }
+
+        destruct_nodes(nodes, count, guard);
+    }
+
+    void destruct_nodes(node * const * nodes, std::size_t count, operation_guard * guard)
+    {
+        if (guard)
+            pool.retire_many(*guard, nodes, count);
+        else
+            pool.template destruct_many<true>(nodes, count);
+    }
+
+    template <typename Functor>
+    size_type do_consume(Functor & f, size_type max)
+    {
+        using detail::likely;
+
+        if (max == 0)
+            return 0;
+
+        operation_guard guard(pool);
+        for (;;) {
+            tagged_node_handle head = head_.load(memory_order_acquire);
+            node * head_ptr = pool.get_pointer(head);
+
+            tagged_node_handle tail = tail_.load(memory_order_acquire);
+            tagged_node_handle next = head_ptr->next.load(memory_order_acquire);
+            node * next_ptr = pool.get_pointer(next);
+
+            tagged_node_handle head2 = head_.load(memory_order_acquire);
+            if (likely(head == head2)) {
+                if (pool.get_handle(head) == pool.get_handle(tail)) {
+                    if (next_ptr == 0)
+                        return 0;
+
+                    tagged_node_handle new_tail(pool.get_handle(next), tail.get_tag() + 1);
+                    tail_.compare_exchange_strong(tail, new_tail);
+
+                } else {
+                    if (next_ptr == 0)
+                        continue;
+
+                    /* walk along the list, but never past the node that tail pointed to, so that the tail will not
+                     * point to one of the nodes that we unlink. the nodes following the head cannot be freed as long
+                     * as the head is unchanged, which is checked by the compare-and-swap */
+                    node * last_ptr = next_ptr;
+                    size_type count = 1;
+                    while (count != max && pool.get_handle(last_ptr) != pool.get_handle(tail)) {
+                        node * following = pool.get_pointer(last_ptr->next.load(memory_order_acquire));
+                        if (following == 0)
+                            break;
+                        last_ptr = following;
+                        ++count;
+                    }
+
+                    /* the last node becomes the new dummy node, which may be freed by another thread as soon as the
+                     * head is moved, so its payload is copied first */
+                    T last_data(last_ptr->data);
+
+                    tagged_node_handle new_head(pool.get_handle(last_ptr), head.get_tag() + 1);
+                    if (head_.compare_exchange_weak(head, new_head)) {
+                        for (node * current = next_ptr; current != last_ptr;
+                             current = pool.get_pointer(current->next.load(memory_order_relaxed)))
+                            f(current->data);
+                        f(last_data);
+
+                        destruct_chain(head_ptr, last_ptr, &guard);
+                        return count;
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename OutputIterator>
+    struct copy_to_iterator
+    {
+        explicit copy_to_iterator(OutputIterator it):
+            it_(it)
+        {}
+
+        void operator()(T const & t)
+        {
+            *it_ = t;
+            ++it_;
+        }
+
+        OutputIterator it_;
+    };
 #endif
 
 public:
 
+    /** Pushes as many objects from the range [begin, end) as freelist node can be allocated.
+     *
+     * \return iterator to the first element, which has not been pushed
+     *
+     * \note Operation is applied atomically: the nodes are allocated from the freelist in batches and are linked to the
+     *       queue with a single compare-and-swap, so the objects are not interleaved with objects pushed by other threads.
+     * \note Single pass input iterators are supported. As the length of the range cannot be determined in advance, nodes
+     *       are allocated in whole batches and the unused ones are returned to the freelist afterwards.
+     * \note Thread-safe. If internal memory pool is exhausted and the memory pool is not fixed-sized, new nodes will be allocated
+     *                    from the OS. This may not be lock-free.
+     * \throws if memory allocator throws
+     */
+    template <typename ConstIterator>
+    ConstIterator push(ConstIterator begin, ConstIterator end)
+    {
+        return do_push<false, ConstIterator>(begin, end);
+    }
+
+    /** Pushes as many objects from the range [begin, end) as freelist node can be allocated.
+     *
+     * \return iterator to the first element, which has not been pushed
+     *
+     * \note Operation is applied atomically
+     * \note Single pass input iterators are supported. As the length of the range cannot be determined in advance, nodes
+     *       are allocated in whole batches, so a concurrent bounded push may fail while they are held.
+     * \note Thread-safe and non-blocking. If internal memory pool is exhausted, the push operation will fail
+     * \throws if memory allocator throws
+     */
+    template <typename ConstIterator>
+    ConstIterator bounded_push(ConstIterator begin, ConstIterator end)
+    {
+        return do_push<true, ConstIterator>(begin, end);
+    }
+
     /** Pushes object t to the queue.
      *
      * \post object will be pushed to the queue, if internal node can be allocated
@@ -357,6 +601,7 @@ public:
     bool pop (U & ret)
     {
         using detail::likely;
+        operation_guard guard(pool);
         for (;;) {
             tagged_node_handle head = head_.load(memory_order_acquire);
             node * head_ptr = pool.get_pointer(head);
@@ -386,7 +631,7 @@ public:
 
                     tagged_node_handle new_head(pool.get_handle(next), head.get_tag() + 1);
                     if (head_.compare_exchange_weak(head, new_head)) {
-                        pool.template destruct<true>(head);
+                        pool.retire(guard, head);
                         return true;
                     }
                 }
@@ -394,6 +639,41 @@ public:
         }
     }
 
+    /** Pops a maximum of max objects from queue.
+     *
+     * \post the popped objects are copied to the output iterator it, in the order in which they were pushed.
+     * \returns number of popped objects
+     *
+     * \note Thread-safe and non-blocking. The objects are unlinked from the queue with a single compare-and-swap and their
+     *       nodes are returned to the freelist in batches. Fewer than max objects may be popped, even if the queue is
+     *       not empty.
+     * */
+    template <typename OutputIterator>
+    size_type pop (OutputIterator it, size_type max)
+    {
+        copy_to_iterator<OutputIterator> f(it);
+        return do_consume(f, max);
+    }
+
+    /** Consumes all objects that are in the queue, passing each of them to the functor f.
+     *
+     * \returns number of consumed objects
+     *
+     * \note Thread-safe and non-blocking. The objects are unlinked from the queue in batches, each with a single
+     *       compare-and-swap.
+     * */
+    template <typename Functor>
+    size_type consume_all (Functor & f)
+    {
+        size_type consumed = 0;
+        for (;;) {
+            size_type count = do_consume(f, (std::numeric_limits<size_type>::max)());
+            if (count == 0)
+                return consumed;
+            consumed += count;
+        }
+    }
+
     /** Pops object from queue.
      *
      * \post if pop operation is successful, object will be copied to ret.
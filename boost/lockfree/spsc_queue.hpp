@@ -234,6 +234,53 @@ protected:
         read_index_.store(new_read_index, memory_order_release);
         return avail;
     }
+
+    /* the spans end at the end of the buffer, the elements behind the wrap-around are handed out by the next call */
+    size_t write_span(T *& span, T * internal_buffer, size_t max_size)
+    {
+        size_t write_index = write_index_.load(memory_order_relaxed);  // only written from push thread
+        const size_t read_index  = read_index_.load(memory_order_acquire);
+        const size_t avail = write_available(write_index, read_index, max_size);
+
+        span = internal_buffer + write_index;
+        return (std::min)(avail, max_size - write_index);
+    }
+
+    void commit_write(size_t count, size_t max_size)
+    {
+        size_t write_index = write_index_.load(memory_order_relaxed);  // only written from push thread
+        BOOST_ASSERT(count <= write_available(write_index, read_index_.load(memory_order_relaxed), max_size));
+        BOOST_ASSERT(write_index + count <= max_size);
+
+        size_t new_write_index = write_index + count;
+        if (new_write_index == max_size)
+            new_write_index = 0;
+
+        write_index_.store(new_write_index, memory_order_release);
+    }
+
+    size_t read_span(const T *& span, const T * internal_buffer, size_t max_size)
+    {
+        const size_t write_index = write_index_.load(memory_order_acquire);
+        size_t read_index = read_index_.load(memory_order_relaxed); // only written from pop thread
+        const size_t avail = read_available(write_index, read_index, max_size);
+
+        span = internal_buffer + read_index;
+        return (std::min)(avail, max_size - read_index);
+    }
+
+    void commit_read(size_t count, size_t max_size)
+    {
+        size_t read_index = read_index_.load(memory_order_relaxed); // only written from pop thread
+        BOOST_ASSERT(count <= read_available(write_index_.load(memory_order_relaxed), read_index, max_size));
+        BOOST_ASSERT(read_index + count <= max_size);
+
+        size_t new_read_index = read_index + count;
+        if (new_read_index == max_size)
+            new_read_index = 0;
+
+        read_index_.store(new_read_index, memory_order_release);
+    }
 #endif
 
 
@@ -325,6 +372,26 @@ public:
     {
         return ringbuffer_base<T>::pop(it, array_.c_array(), max_size);
     }
+
+    size_t write_span(T *& span)
+    {
+        return ringbuffer_base<T>::write_span(span, array_.c_array(), max_size);
+    }
+
+    void commit_write(size_t count)
+    {
+        ringbuffer_base<T>::commit_write(count, max_size);
+    }
+
+    size_t read_span(const T *& span)
+    {
+        return ringbuffer_base<T>::read_span(span, array_.c_array(), max_size);
+    }
+
+    void commit_read(size_t count)
+    {
+        ringbuffer_base<T>::commit_read(count, max_size);
+    }
 };
 
 template <typename T, typename Alloc>
@@ -416,6 +483,26 @@ public:
     {
         return ringbuffer_base<T>::pop(it, array_, max_elements_);
     }
+
+    size_t write_span(T *& span)
+    {
+        return ringbuffer_base<T>::write_span(span, &*array_, max_elements_);
+    }
+
+    void commit_write(size_t count)
+    {
+        ringbuffer_base<T>::commit_write(count, max_elements_);
+    }
+
+    size_t read_span(const T *& span)
+    {
+        return ringbuffer_base<T>::read_span(span, &*array_, max_elements_);
+    }
+
+    void commit_read(size_t count)
+    {
+        ringbuffer_base<T>::commit_read(count, max_elements_);
+    }
 };
 
 template <typename T, typename A0, typename A1>
@@ -641,6 +728,60 @@ public:
     {
         return base_type::pop(it);
     }
+
+    /** Provides the free elements of the ringbuffer, so that the producer can fill them in place.
+     *
+     * \pre only one thread is allowed to push data to the spsc_queue
+     * \post span points to the first free element. The free elements are contiguous, so at the end of the ringbuffer fewer
+     *       elements may be provided than are free; the remaining ones are provided after the span has been committed.
+     * \return number of elements in the span, 0 if the ringbuffer is full
+     *
+     * \note Thread-safe and wait-free. The elements are not visible to the consumer, before they are committed via
+     *       commit_write.
+     * */
+    size_type write_span(T *& span)
+    {
+        return base_type::write_span(span);
+    }
+
+    /** Publishes the first count elements of the span, that has been obtained via write_span.
+     *
+     * \pre only one thread is allowed to push data to the spsc_queue
+     * \pre count must not exceed the size of the span returned by the last call to write_span
+     *
+     * \note Thread-safe and wait-free
+     * */
+    void commit_write(size_type count)
+    {
+        base_type::commit_write(count);
+    }
+
+    /** Provides the elements at the front of the ringbuffer, so that the consumer can process them in place.
+     *
+     * \pre only one thread is allowed to pop data to the spsc_queue
+     * \post span points to the first element. The elements are contiguous, so at the end of the ringbuffer fewer elements
+     *       may be provided than are available; the remaining ones are provided after the span has been committed.
+     * \return number of elements in the span, 0 if the ringbuffer is empty
+     *
+     * \note Thread-safe and wait-free. The elements stay valid, until they are released via commit_read.
+     * */
+    size_type read_span(const T *& span)
+    {
+        return base_type::read_span(span);
+    }
+
+    /** Releases the first count elements of the span, that has been obtained via read_span, so that the producer can
+     *  reuse them.
+     *
+     * \pre only one thread is allowed to pop data to the spsc_queue
+     * \pre count must not exceed the size of the span returned by the last call to read_span
+     *
+     * \note Thread-safe and wait-free
+     * */
+    void commit_read(size_type count)
+    {
+        base_type::commit_read(count);
+    }
 };
 
 } /* namespace lockfree */
@@ -34,7 +34,8 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
 
 /** The stack class provides a multi-writer/multi-reader stack, pushing and popping is lock-free,
  *  construction/destruction has to be synchronized. It uses a freelist for memory management,
- *  freed nodes are pushed to the freelist and not returned to the OS before the stack is destroyed.
+ *  freed nodes are pushed to the freelist and not returned to the OS before the stack is destroyed,
+ *  unless it is configured to reclaim memory.
  *
  *  \b Policies:
  *
@@ -49,6 +50,11 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
  *    If this template argument is passed to the options, the size of the stack is set at compile-time. <br>
  *    It this option implies \c fixed_sized<true>
  *
+ *  - \c boost::lockfree::reclaim_memory<>, defaults to \c boost::lockfree::reclaim_memory<false> <br>
+ *    If enabled, nodes are returned to the allocator once no thread can reference them any more, except for the nodes
+ *    that have been reserved. Every thread-safe operation takes part in an epoch-based reclamation scheme, which adds a few
+ *    atomic operations to it. Cannot be combined with \c fixed_sized<true> or \c capacity<>.
+ *
  *  - \c boost::lockfree::allocator<>, defaults to \c boost::lockfree::allocator<std::allocator<void>> <br>
  *    Specifies the allocator that is used for the internal freelist
  *
@@ -78,6 +84,10 @@ private:
     static const bool fixed_sized = detail::extract_fixed_sized<bound_args>::value;
     static const bool node_based = !(has_capacity || fixed_sized);
     static const bool compile_time_sized = has_capacity;
+    static const bool reclaim_memory = detail::extract_reclaim_memory<bound_args>::value;
+
+    // memory can only be reclaimed, if the nodes are allocated individually
+    BOOST_STATIC_ASSERT(!reclaim_memory || node_based);
 
     struct node
     {
@@ -91,8 +101,10 @@ private:
     };
 
     typedef typename detail::extract_allocator<bound_args, node>::type node_allocator;
-    typedef typename detail::select_freelist<node, node_allocator, compile_time_sized, fixed_sized, capacity>::type pool_t;
+    typedef typename detail::select_freelist<node, node_allocator, compile_time_sized, fixed_sized, capacity,
+                                             reclaim_memory>::type pool_t;
     typedef typename pool_t::tagged_node_handle tagged_node_handle;
+    typedef typename pool_t::operation_guard operation_guard;
 
     // check compile-time capacity
     BOOST_STATIC_ASSERT((mpl::if_c<has_capacity,
@@ -302,6 +314,7 @@ private:
     template <bool Bounded>
     bool do_push(T const & v)
     {
+        operation_guard guard(pool);
         node * newnode = pool.template construct<true, Bounded>(v);
         if (newnode == 0)
             return false;
@@ -313,6 +326,7 @@ private:
     template <bool Bounded, typename ConstIterator>
     ConstIterator do_push(ConstIterator begin, ConstIterator end)
     {
+        operation_guard guard(pool);
         node * new_top_node;
         node * end_node;
         ConstIterator ret;
@@ -425,6 +439,7 @@ public:
     bool pop(U & ret)
     {
         BOOST_STATIC_ASSERT((boost::is_convertible<T, U>::value));
+        operation_guard guard(pool);
         tagged_node_handle old_tos = tos.load(detail::memory_order_consume);
 
         for (;;) {
@@ -436,7 +451,7 @@ public:
 
             if (tos.compare_exchange_weak(old_tos, new_tos)) {
                 detail::copy_payload(old_tos_pointer->v, ret);
-                pool.template destruct<true>(old_tos);
+                pool.retire(guard, old_tos);
                 return true;
             }
         }
@@ -179,6 +179,28 @@ public:
       details::pool::guard<Mutex> g(p);
       p.ordered_free(ptr, n);
     }
+    static size_type malloc_batch(void ** const chunks, const size_type n)
+    { //! Equivalent to calling SingletonPool::p.malloc() up to n times, taking the lock once; synchronized.
+      //! Used to refill per-thread caches, see thread_cached_pool.
+      //! \returns The number of chunks stored in chunks, less than n only if the pool ran out of memory.
+      pool_type & p = get_pool();
+      details::pool::guard<Mutex> g(p);
+      size_type i = 0;
+      for (; i < n; ++i)
+      {
+        chunks[i] = (p.malloc)();
+        if (chunks[i] == 0)
+          break;
+      }
+      return i;
+    }
+    static void free_batch(void * const * const chunks, const size_type n)
+    { //! Equivalent to calling SingletonPool::p.free(chunk) for each of the n chunks, taking the lock once; synchronized.
+      pool_type & p = get_pool();
+      details::pool::guard<Mutex> g(p);
+      for (size_type i = 0; i < n; ++i)
+        (p.free)(chunks[i]);
+    }
     static bool release_memory()
     { //! Equivalent to SingletonPool::p.release_memory(); synchronized.
       pool_type & p = get_pool();
@@ -0,0 +1,415 @@
+// Copyright (C) 2012 John Maddock
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org for updates, documentation, and revision history.
+
+#ifndef BOOST_THREAD_CACHED_POOL_HPP
+#define BOOST_THREAD_CACHED_POOL_HPP
+
+/*!
+  \file
+  \brief The <tt>thread_cached_pool</tt> class puts a per-thread cache of
+  chunks in front of a <tt>singleton_pool</tt>, and
+  <tt>thread_cached_pool_allocator</tt> is an allocator which uses it.
+
+  \details Every call to <tt>singleton_pool::malloc</tt> and <tt>singleton_pool::free</tt>
+  takes the pool's mutex, which serializes all the threads using the pool.
+  <tt>thread_cached_pool</tt> gives each thread a small stack of free chunks, so most
+  allocations and deallocations don't touch the shared pool at all.  When a thread's
+  cache is empty it is refilled with a batch of chunks, and when it is full half of
+  it is returned, in both cases taking the mutex only once.  When a thread exits its
+  cache is returned to the shared pool.
+*/
+
+#include <boost/pool/poolfwd.hpp>
+#include <boost/pool/singleton_pool.hpp>
+
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/static_assert.hpp>
+
+#include <limits>
+#include <new>
+
+#if defined(BOOST_HAS_THREADS) && !defined(BOOST_NO_MT) && !defined(BOOST_POOL_NO_MT)
+#  define BOOST_POOL_THREAD_CACHE
+#  include <boost/thread/tss.hpp>
+#endif
+
+// A thread local pointer is used to find the cache quickly, thread_specific_ptr
+// is only used to clean up when the thread exits.
+#if defined(BOOST_POOL_THREAD_CACHE) && !defined(BOOST_POOL_NO_THREAD_LOCAL)
+#  if defined(__GNUC__) && !defined(__APPLE__)
+#    define BOOST_POOL_THREAD_LOCAL __thread
+#  elif defined(BOOST_MSVC)
+#    define BOOST_POOL_THREAD_LOCAL __declspec(thread)
+#  endif
+#endif
+
+namespace boost {
+
+namespace details {
+namespace pool {
+
+//! A thread's stack of free chunks.
+template <unsigned CacheSize>
+struct thread_cache
+{
+  BOOST_STATIC_ASSERT(CacheSize >= 2);
+
+  void * chunks[CacheSize];
+  unsigned count;
+
+  thread_cache() : count(0) { }
+};
+
+} // namespace pool
+} // namespace details
+
+/*!
+  The thread_cached_pool class has the same static interface for single chunks as
+  singleton_pool, but keeps a cache of up to CacheSize free chunks for each thread.
+
+  The template parameters are the same as singleton_pool's, and the underlying
+  pool is <tt>singleton_pool<Tag, RequestedSize, UserAllocator, Mutex, NextSize, MaxSize></tt>,
+  which can be used directly for the operations that aren't cached.
+  In particular, ordered allocations and allocations of several chunks
+  go straight to the shared pool.
+
+  <b>CacheSize</b> The maximum number of free chunks cached by each thread
+  (default 32).  The cache is refilled and flushed CacheSize / 2 chunks at a time.
+
+  \attention
+  Chunks in a thread's cache are counted as allocated by the shared pool, so
+  <tt>release_memory</tt> can't release the blocks containing them.  Call
+  <tt>flush()</tt> from each thread first.  Don't call <tt>purge_memory</tt> on the
+  shared pool while any thread may have a non-empty cache.
+
+  When threading support is turned off (see singleton_pool) there is no cache,
+  and all calls are forwarded to the shared pool.
+*/
+template <typename Tag,
+    unsigned RequestedSize,
+    typename UserAllocator = default_user_allocator_new_delete,
+    typename Mutex = details::pool::default_mutex,
+    unsigned NextSize = 32,
+    unsigned MaxSize = 0,
+    unsigned CacheSize = 32>
+class thread_cached_pool
+{
+  public:
+    typedef Tag tag; //!< The Tag template parameter, shared with the underlying singleton_pool.
+    typedef Mutex mutex; //!< The type of mutex used by the underlying singleton_pool.
+    typedef UserAllocator user_allocator; //!< The user-allocator used by the underlying pool.
+    typedef singleton_pool<Tag, RequestedSize, UserAllocator, Mutex, NextSize, MaxSize> shared_pool; //!< The underlying pool.
+    typedef typename shared_pool::size_type size_type; //!< size_type of user allocator.
+    typedef typename shared_pool::difference_type difference_type; //!< difference_type of user allocator.
+
+    BOOST_STATIC_CONSTANT(unsigned, requested_size = RequestedSize); //!< The size of each chunk allocated by this pool.
+    BOOST_STATIC_CONSTANT(unsigned, cache_size = CacheSize); //!< The maximum number of chunks cached per thread.
+
+  private:
+    thread_cached_pool();
+
+    typedef details::pool::thread_cache<CacheSize> cache_type;
+
+  public:
+#ifdef BOOST_POOL_THREAD_CACHE
+    static void * malloc BOOST_PREVENT_MACRO_SUBSTITUTION()
+    { //! Allocates a chunk from this thread's cache, refilling it from the shared pool if it's empty.
+      //! \returns 0 if out of memory.
+      cache_type & c = get_cache();
+      if (c.count == 0)
+      {
+        c.count = static_cast<unsigned>(
+            shared_pool::malloc_batch(c.chunks, CacheSize / 2));
+        if (c.count == 0)
+          return 0;
+      }
+      return c.chunks[--c.count];
+    }
+    static void free BOOST_PREVENT_MACRO_SUBSTITUTION(void * const ptr)
+    { //! Returns a chunk to this thread's cache, flushing half of the cache to the shared pool if it's full.
+      //! The chunk may have been allocated by any thread.
+      cache_type & c = get_cache();
+      if (c.count == CacheSize)
+      {
+        shared_pool::free_batch(c.chunks + CacheSize / 2, CacheSize - CacheSize / 2);
+        c.count = CacheSize / 2;
+      }
+      c.chunks[c.count++] = ptr;
+    }
+    static void flush()
+    { //! Returns all the chunks in this thread's cache to the shared pool.
+      cache_type * const c = find_cache();
+      if (c)
+        flush_cache(*c);
+    }
+#else
+    static void * malloc BOOST_PREVENT_MACRO_SUBSTITUTION()
+    { //! Equivalent to shared_pool::malloc().
+      return (shared_pool::malloc)();
+    }
+    static void free BOOST_PREVENT_MACRO_SUBSTITUTION(void * const ptr)
+    { //! Equivalent to shared_pool::free(ptr).
+      (shared_pool::free)(ptr);
+    }
+    static void flush()
+    { //! Does nothing, as there is no cache.
+    }
+#endif
+
+  private:
+#ifdef BOOST_POOL_THREAD_CACHE
+    static void flush_cache(cache_type & c)
+    {
+      shared_pool::free_batch(c.chunks, c.count);
+      c.count = 0;
+    }
+
+    // Called by thread_specific_ptr when a thread exits, returns its
+    // chunks so they aren't lost.
+    static void cleanup(cache_type * c)
+    {
+      flush_cache(*c);
+#ifdef BOOST_POOL_THREAD_LOCAL
+      current = 0;
+#endif
+      delete c;
+    }
+
+    typedef boost::thread_specific_ptr<cache_type> tss_type;
+    typedef boost::aligned_storage<sizeof(tss_type),
+        boost::alignment_of<tss_type>::value> storage_type;
+    static storage_type storage;
+
+    static tss_type & get_tss()
+    {
+      // The same scheme as singleton_pool: this is first called before
+      // main() starts, while only one thread is running.
+      static bool f = false;
+      if (!f)
+      {
+        f = true;
+        new (&storage) tss_type(&cleanup);
+      }
+      create_object.do_nothing();
+      return *static_cast<tss_type *>(static_cast<void *>(&storage));
+    }
+
+#ifdef BOOST_POOL_THREAD_LOCAL
+    static BOOST_POOL_THREAD_LOCAL cache_type * current;
+
+    static cache_type * find_cache()
+    {
+      return current;
+    }
+
+    static cache_type & get_cache()
+    {
+      cache_type * c = current;
+      return c ? *c : create_cache();
+    }
+#else
+    static cache_type * find_cache()
+    {
+      return get_tss().get();
+    }
+
+    static cache_type & get_cache()
+    {
+      cache_type * c = get_tss().get();
+      return c ? *c : create_cache();
+    }
+#endif
+
+    static cache_type & create_cache()
+    {
+      cache_type * c = new cache_type;
+      get_tss().reset(c);
+#ifdef BOOST_POOL_THREAD_LOCAL
+      current = c;
+#endif
+      return *c;
+    }
+
+    struct object_creator
+    {
+      object_creator()
+      { // Constructs the thread_specific_ptr before main() begins.
+        thread_cached_pool::get_tss();
+      }
+      inline void do_nothing() const
+      {
+      }
+    };
+    static object_creator create_object;
+#endif
+}; // class thread_cached_pool
+
+#ifdef BOOST_POOL_THREAD_CACHE
+template <typename Tag, unsigned RequestedSize, typename UserAllocator,
+    typename Mutex, unsigned NextSize, unsigned MaxSize, unsigned CacheSize>
+typename thread_cached_pool<Tag, RequestedSize, UserAllocator, Mutex, NextSize, MaxSize, CacheSize>::storage_type
+thread_cached_pool<Tag, RequestedSize, UserAllocator, Mutex, NextSize, MaxSize, CacheSize>::storage;
+
+template <typename Tag, unsigned RequestedSize, typename UserAllocator,
+    typename Mutex, unsigned NextSize, unsigned MaxSize, unsigned CacheSize>
+typename thread_cached_pool<Tag, RequestedSize, UserAllocator, Mutex, NextSize, MaxSize, CacheSize>::object_creator
+thread_cached_pool<Tag, RequestedSize, UserAllocator, Mutex, NextSize, MaxSize, CacheSize>::create_object;
+
+#ifdef BOOST_POOL_THREAD_LOCAL
+template <typename Tag, unsigned RequestedSize, typename UserAllocator,
+    typename Mutex, unsigned NextSize, unsigned MaxSize, unsigned CacheSize>
+BOOST_POOL_THREAD_LOCAL
+typename thread_cached_pool<Tag, RequestedSize, UserAllocator, Mutex, NextSize, MaxSize, CacheSize>::cache_type *
+thread_cached_pool<Tag, RequestedSize, UserAllocator, Mutex, NextSize, MaxSize, CacheSize>::current = 0;
+#endif
+#endif
+
+//! Simple tag type used by thread_cached_pool_allocator as a template parameter to the underlying pool.
+struct thread_cached_pool_allocator_tag
+{
+};
+
+/*!
+  \brief An allocator like fast_pool_allocator, which allocates single objects
+  through a thread_cached_pool.
+
+  Allocations of more than one object go to the underlying singleton_pool,
+  as they do for fast_pool_allocator.
+
+  The template parameters are those of fast_pool_allocator, plus
+  <b>CacheSize</b>, the number of chunks cached by each thread.
+*/
+template <typename T,
+    typename UserAllocator = default_user_allocator_new_delete,
+    typename Mutex = details::pool::default_mutex,
+    unsigned NextSize = 32,
+    unsigned MaxSize = 0,
+    unsigned CacheSize = 32>
+class thread_cached_pool_allocator
+{
+  public:
+    typedef T value_type;
+    typedef UserAllocator user_allocator;
+    typedef Mutex mutex;
+    BOOST_STATIC_CONSTANT(unsigned, next_size = NextSize);
+
+    typedef value_type * pointer;
+    typedef const value_type * const_pointer;
+    typedef value_type & reference;
+    typedef const value_type & const_reference;
+    typedef typename pool<UserAllocator>::size_type size_type;
+    typedef typename pool<UserAllocator>::difference_type difference_type;
+
+    //! The thread_cached_pool used by this allocator.
+    typedef thread_cached_pool<thread_cached_pool_allocator_tag, sizeof(T),
+        UserAllocator, Mutex, NextSize, MaxSize, CacheSize> cached_pool;
+
+    template <typename U>
+    struct rebind
+    {
+      typedef thread_cached_pool_allocator<U, UserAllocator, Mutex, NextSize, MaxSize, CacheSize> other;
+    };
+
+  public:
+    thread_cached_pool_allocator()
+    {
+    }
+
+    template <typename U>
+    thread_cached_pool_allocator(
+        const thread_cached_pool_allocator<U, UserAllocator, Mutex, NextSize, MaxSize, CacheSize> &)
+    {
+    }
+
+    static pointer address(reference r)
+    {
+      return &r;
+    }
+    static const_pointer address(const_reference s)
+    { return &s; }
+    static size_type max_size()
+    { return (std::numeric_limits<size_type>::max)(); }
+    void construct(const pointer ptr, const value_type & t)
+    { new (ptr) T(t); }
+    void destroy(const pointer ptr)
+    { //! Destroy ptr using destructor.
+      ptr->~T();
+      (void) ptr; // Avoid unused variable warning.
+    }
+
+    bool operator==(const thread_cached_pool_allocator &) const
+    { return true; }
+    bool operator!=(const thread_cached_pool_allocator &) const
+    { return false; }
+
+    static pointer allocate(const size_type n)
+    {
+      const pointer ret = (n == 1) ?
+          static_cast<pointer>((cached_pool::malloc)()) :
+          static_cast<pointer>(cached_pool::shared_pool::ordered_malloc(n));
+      if (ret == 0)
+        boost::throw_exception(std::bad_alloc());
+      return ret;
+    }
+    static pointer allocate(const size_type n, const void * const)
+    { //! Allocate memory .
+      return allocate(n);
+    }
+    static pointer allocate()
+    { //! Allocate memory.
+      const pointer ret = static_cast<pointer>((cached_pool::malloc)());
+      if (ret == 0)
+        boost::throw_exception(std::bad_alloc());
+      return ret;
+    }
+    static void deallocate(const pointer ptr, const size_type n)
+    { //! Deallocate memory.
+
+#ifdef BOOST_NO_PROPER_STL_DEALLOCATE
+      if (ptr == 0 || n == 0)
+        return;
+#endif
+      if (n == 1)
+        (cached_pool::free)(ptr);
+      else
+        (cached_pool::shared_pool::free)(ptr, n);
+    }
+    static void deallocate(const pointer ptr)
+    { //! deallocate/free
+      (cached_pool::free)(ptr);
+    }
+};
+
+/*! \brief Specialization of thread_cached_pool_allocator<void>.
+
+Specialization of thread_cached_pool_allocator<void> required to make the allocator standard-conforming.
+*/
+template<
+    typename UserAllocator,
+    typename Mutex,
+    unsigned NextSize,
+    unsigned MaxSize,
+    unsigned CacheSize>
+class thread_cached_pool_allocator<void, UserAllocator, Mutex, NextSize, MaxSize, CacheSize>
+{
+public:
+    typedef void*       pointer;
+    typedef const void* const_pointer;
+    typedef void        value_type;
+
+    template <class U> struct rebind
+    {
+        typedef thread_cached_pool_allocator<U, UserAllocator, Mutex, NextSize, MaxSize, CacheSize> other;
+    };
+};
+
+} // namespace boost
+
+#endif
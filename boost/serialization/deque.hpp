@@ -17,21 +17,31 @@
 //  See http://www.boost.org for updates, documentation, and revision history.
 
 #include <deque>
+#include <cstddef> // size_t
 
 #include <boost/config.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/remove_const.hpp>
 
+#include <boost/archive/basic_archive.hpp>
 #include <boost/serialization/collections_save_imp.hpp>
 #include <boost/serialization/collections_load_imp.hpp>
 #include <boost/serialization/split_free.hpp>
+#include <boost/serialization/array.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/and.hpp>
 
 namespace boost { 
 namespace serialization {
 
+// the default versions
+
 template<class Archive, class U, class Allocator>
 inline void save(
     Archive & ar,
     const std::deque<U, Allocator> &t,
-    const unsigned int /* file_version */
+    const unsigned int /* file_version */,
+    mpl::false_
 ){
     boost::serialization::stl::save_collection<
         Archive, std::deque<U, Allocator> 
@@ -42,7 +52,8 @@ template<class Archive, class U, class Allocator>
 inline void load(
     Archive & ar,
     std::deque<U, Allocator> &t,
-    const unsigned int /*file_version*/
+    const unsigned int /*file_version*/,
+    mpl::false_
 ){
     boost::serialization::stl::load_collection<
         Archive,
@@ -54,6 +65,94 @@ inline void load(
     >(ar, t);
 }
 
+// the optimized versions save each block of contiguous elements as an
+// array.  The header is the same as the one of save_collection and, as
+// they are only used for arithmetic types, the elements are written
+// exactly as the default versions do, so archives are interchangeable.
+
+template<class Archive, class U, class Allocator>
+inline void save(
+    Archive & ar,
+    const std::deque<U, Allocator> &t,
+    const unsigned int /* file_version */,
+    mpl::true_
+){
+    const collection_size_type count(t.size());
+    const item_version_type item_version(
+        version<U>::value
+    );
+    ar << BOOST_SERIALIZATION_NVP(count);
+    ar << BOOST_SERIALIZATION_NVP(item_version);
+    BOOST_DEDUCED_TYPENAME std::deque<U, Allocator>::const_iterator 
+        it = t.begin(), last = t.end();
+    while(it != last){
+        U * const first = const_cast<U *>(&*it);
+        std::size_t n = 1;
+        while(++it != last && &*it == first + n)
+            ++n;
+        ar << make_array(first, n);
+    }
+}
+
+template<class Archive, class U, class Allocator>
+inline void load(
+    Archive & ar,
+    std::deque<U, Allocator> &t,
+    const unsigned int /* file_version */,
+    mpl::true_
+){
+    collection_size_type count;
+    item_version_type item_version(0);
+    ar >> BOOST_SERIALIZATION_NVP(count);
+    if(boost::archive::library_version_type(3) < ar.get_library_version()){
+        ar >> BOOST_SERIALIZATION_NVP(item_version);
+    }
+    t.resize(count);
+    BOOST_DEDUCED_TYPENAME std::deque<U, Allocator>::iterator 
+        it = t.begin(), last = t.end();
+    while(it != last){
+        U * const first = &*it;
+        std::size_t n = 1;
+        while(++it != last && &*it == first + n)
+            ++n;
+        ar >> make_array(first, n);
+    }
+}
+
+// dispatch to either default or optimized versions
+
+template<class Archive, class U, class Allocator>
+inline void save(
+    Archive & ar,
+    const std::deque<U, Allocator> &t,
+    const unsigned int file_version
+){
+    typedef BOOST_DEDUCED_TYPENAME mpl::and_<
+        BOOST_DEDUCED_TYPENAME 
+        boost::serialization::use_array_optimization<Archive>::template apply<
+            BOOST_DEDUCED_TYPENAME remove_const<U>::type 
+        >::type,
+        is_arithmetic<U>
+    >::type use_optimized;
+    save(ar, t, file_version, use_optimized());
+}
+
+template<class Archive, class U, class Allocator>
+inline void load(
+    Archive & ar,
+    std::deque<U, Allocator> &t,
+    const unsigned int file_version
+){
+    typedef BOOST_DEDUCED_TYPENAME mpl::and_<
+        BOOST_DEDUCED_TYPENAME 
+        boost::serialization::use_array_optimization<Archive>::template apply<
+            BOOST_DEDUCED_TYPENAME remove_const<U>::type 
+        >::type,
+        is_arithmetic<U>
+    >::type use_optimized;
+    load(ar, t, file_version, use_optimized());
+}
+
 // split non-intrusive serialization function member into separate
 // non intrusive save/load member functions
 template<class Archive, class U, class Allocator>
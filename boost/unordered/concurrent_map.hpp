@@ -0,0 +1,506 @@
+// Copyright (C) 2012 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/unordered for documentation
+
+#ifndef BOOST_UNORDERED_CONCURRENT_MAP_HPP_INCLUDED
+#define BOOST_UNORDERED_CONCURRENT_MAP_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <boost/unordered/concurrent_map_fwd.hpp>
+#include <boost/unordered/detail/unique.hpp>
+#include <boost/unordered/detail/concurrent.hpp>
+#include <boost/unordered/detail/util.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/tuple/tuple.hpp>
+
+namespace boost
+{
+namespace unordered
+{
+    // A hash map which can be used from several threads at once.
+    //
+    // The elements are split between a fixed number of segments, each of
+    // them an ordinary unordered table guarded by its own reader/writer lock,
+    // so operations on keys in different segments don't contend. There are
+    // no iterators: elements are accessed through function objects which are
+    // called while the segment is locked (exclusively for 'visit', shared
+    // for 'cvisit' and the const overloads). A segment grows on its own,
+    // while holding its lock, so a rehash never blocks the whole container.
+    //
+    // The function objects must not call back into the container.
+
+    template <class K, class T, class H, class P, class A>
+    class concurrent_map
+    {
+    public:
+
+        typedef K key_type;
+        typedef std::pair<const K, T> value_type;
+        typedef T mapped_type;
+        typedef H hasher;
+        typedef P key_equal;
+        typedef A allocator_type;
+
+    private:
+
+        typedef boost::unordered::detail::map<A, K, T, H, P> types;
+        typedef typename types::traits allocator_traits;
+        typedef typename types::table table;
+        typedef typename table::iterator iterator;
+        typedef typename table::c_iterator c_iterator;
+        typedef typename table::node_constructor node_constructor;
+        typedef boost::unordered::detail::concurrent_segment_array<table, A>
+            segment_array;
+        typedef typename segment_array::segment segment;
+        typedef boost::unordered::detail::rw_spinlock_guard
+            exclusive_guard;
+        typedef boost::unordered::detail::rw_spinlock_shared_guard
+            shared_guard;
+
+    public:
+
+        typedef typename allocator_traits::pointer pointer;
+        typedef typename allocator_traits::const_pointer const_pointer;
+
+        typedef value_type& reference;
+        typedef value_type const& const_reference;
+
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+    private:
+
+        segment_array segments_;
+
+        concurrent_map(concurrent_map const&);
+        concurrent_map& operator=(concurrent_map const&);
+
+    public:
+
+        // constructors
+
+        explicit concurrent_map(
+                size_type n = boost::unordered::detail::default_bucket_count,
+                const hasher& hf = hasher(),
+                const key_equal& eql = key_equal(),
+                const allocator_type& a = allocator_type())
+          : segments_(a)
+        {
+            segments_.construct(segment_buckets(n), hf, eql, a);
+        }
+
+        explicit concurrent_map(allocator_type const& a)
+          : segments_(a)
+        {
+            segments_.construct(
+                segment_buckets(boost::unordered::detail::default_bucket_count),
+                hasher(), key_equal(), a);
+        }
+
+        template <class InputIt>
+        concurrent_map(InputIt f, InputIt l,
+                size_type n = boost::unordered::detail::default_bucket_count,
+                const hasher& hf = hasher(),
+                const key_equal& eql = key_equal(),
+                const allocator_type& a = allocator_type())
+          : segments_(a)
+        {
+            segments_.construct(segment_buckets((std::max)(n,
+                boost::unordered::detail::initial_size(f, l))), hf, eql, a);
+            insert(f, l);
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator_type(segments_[0].table_.node_alloc());
+        }
+
+        // size and capacity
+        //
+        // These lock one segment at a time, so while other threads are
+        // modifying the container the result is only a snapshot.
+
+        bool empty() const
+        {
+            for (std::size_t i = 0; i != segment_count(); ++i) {
+                shared_guard guard(segments_[i].lock_);
+                if (segments_[i].table_.size_) return false;
+            }
+
+            return true;
+        }
+
+        size_type size() const
+        {
+            size_type result = 0;
+
+            for (std::size_t i = 0; i != segment_count(); ++i) {
+                shared_guard guard(segments_[i].lock_);
+                result += segments_[i].table_.size_;
+            }
+
+            return result;
+        }
+
+        size_type max_size() const
+        {
+            return segments_[0].table_.max_size();
+        }
+
+        // visitation
+        //
+        // Call 'f' with the element whose key is equivalent to 'k', if there
+        // is one. Return the number of elements visited.
+
+        template <class F>
+        size_type visit(key_type const& k, F f)
+        {
+            std::size_t key_hash = hash(k);
+            segment& s = get_segment(key_hash);
+            exclusive_guard guard(s.lock_);
+
+            iterator pos = s.table_.find_node(key_hash, k);
+            if (pos == iterator()) return 0;
+
+            f(*pos);
+            return 1;
+        }
+
+        template <class F>
+        size_type visit(key_type const& k, F f) const
+        {
+            return cvisit(k, f);
+        }
+
+        template <class F>
+        size_type cvisit(key_type const& k, F f) const
+        {
+            std::size_t key_hash = hash(k);
+            segment& s = get_segment(key_hash);
+            shared_guard guard(s.lock_);
+
+            iterator pos = s.table_.find_node(key_hash, k);
+            if (pos == iterator()) return 0;
+
+            f(static_cast<value_type const&>(*pos));
+            return 1;
+        }
+
+        // Call 'f' with every element, one segment at a time.
+
+        template <class F>
+        size_type visit_all(F f)
+        {
+            size_type count = 0;
+
+            for (std::size_t i = 0; i != segment_count(); ++i) {
+                exclusive_guard guard(segments_[i].lock_);
+
+                for (iterator n = segments_[i].table_.begin();
+                        n != iterator(); ++n) {
+                    f(*n);
+                    ++count;
+                }
+            }
+
+            return count;
+        }
+
+        template <class F>
+        size_type visit_all(F f) const
+        {
+            return cvisit_all(f);
+        }
+
+        template <class F>
+        size_type cvisit_all(F f) const
+        {
+            size_type count = 0;
+
+            for (std::size_t i = 0; i != segment_count(); ++i) {
+                shared_guard guard(segments_[i].lock_);
+
+                for (iterator n = segments_[i].table_.begin();
+                        n != iterator(); ++n) {
+                    f(static_cast<value_type const&>(*n));
+                    ++count;
+                }
+            }
+
+            return count;
+        }
+
+        size_type count(key_type const& k) const
+        {
+            std::size_t key_hash = hash(k);
+            segment& s = get_segment(key_hash);
+            shared_guard guard(s.lock_);
+
+            return s.table_.find_node(key_hash, k) != iterator() ? 1 : 0;
+        }
+
+        // modifiers
+        //
+        // The insert functions return true if a new element was inserted.
+
+        bool insert(value_type const& obj)
+        {
+            key_type const& k = obj.first;
+            std::size_t key_hash = hash(k);
+            segment& s = get_segment(key_hash);
+            exclusive_guard guard(s.lock_);
+
+            if (s.table_.find_node(key_hash, k) != iterator()) return false;
+
+            node_constructor a(s.table_.node_alloc());
+            a.construct_with_value2(obj);
+            add_node(s.table_, a, key_hash);
+            return true;
+        }
+
+        template <class InputIt>
+        size_type insert(InputIt first, InputIt last)
+        {
+            size_type count = 0;
+            for (; first != last; ++first)
+                if (insert(*first)) ++count;
+            return count;
+        }
+
+        // If there's already an element with an equivalent key, call 'f'
+        // with it instead of inserting 'obj'.
+
+        template <class F>
+        bool insert_or_visit(value_type const& obj, F f)
+        {
+            key_type const& k = obj.first;
+            std::size_t key_hash = hash(k);
+            segment& s = get_segment(key_hash);
+            exclusive_guard guard(s.lock_);
+
+            iterator pos = s.table_.find_node(key_hash, k);
+            if (pos != iterator()) {
+                f(*pos);
+                return false;
+            }
+
+            node_constructor a(s.table_.node_alloc());
+            a.construct_with_value2(obj);
+            add_node(s.table_, a, key_hash);
+            return true;
+        }
+
+        template <class F>
+        bool insert_or_cvisit(value_type const& obj, F f)
+        {
+            key_type const& k = obj.first;
+            std::size_t key_hash = hash(k);
+            segment& s = get_segment(key_hash);
+            exclusive_guard guard(s.lock_);
+
+            iterator pos = s.table_.find_node(key_hash, k);
+            if (pos != iterator()) {
+                f(static_cast<value_type const&>(*pos));
+                return false;
+            }
+
+            node_constructor a(s.table_.node_alloc());
+            a.construct_with_value2(obj);
+            add_node(s.table_, a, key_hash);
+            return true;
+        }
+
+        bool insert_or_assign(key_type const& k, mapped_type const& obj)
+        {
+            std::size_t key_hash = hash(k);
+            segment& s = get_segment(key_hash);
+            exclusive_guard guard(s.lock_);
+
+            iterator pos = s.table_.find_node(key_hash, k);
+            if (pos != iterator()) {
+                pos->second = obj;
+                return false;
+            }
+
+            node_constructor a(s.table_.node_alloc());
+            a.construct_with_value(BOOST_UNORDERED_EMPLACE_ARGS3(
+                boost::unordered::piecewise_construct,
+                boost::make_tuple(k),
+                boost::make_tuple(obj)));
+            add_node(s.table_, a, key_hash);
+            return true;
+        }
+
+        size_type erase(key_type const& k)
+        {
+            std::size_t key_hash = hash(k);
+            segment& s = get_segment(key_hash);
+            exclusive_guard guard(s.lock_);
+
+            iterator pos = s.table_.find_node(key_hash, k);
+            if (pos == iterator()) return 0;
+
+            s.table_.erase(c_iterator(pos));
+            return 1;
+        }
+
+        // Erase the element whose key is equivalent to 'k' if 'f' returns
+        // true for it.
+
+        template <class F>
+        size_type erase_if(key_type const& k, F f)
+        {
+            std::size_t key_hash = hash(k);
+            segment& s = get_segment(key_hash);
+            exclusive_guard guard(s.lock_);
+
+            iterator pos = s.table_.find_node(key_hash, k);
+            if (pos == iterator() || !f(*pos)) return 0;
+
+            s.table_.erase(c_iterator(pos));
+            return 1;
+        }
+
+        // Erase every element for which 'f' returns true, one segment at a
+        // time.
+
+        template <class F>
+        size_type erase_if(F f)
+        {
+            size_type count = 0;
+
+            for (std::size_t i = 0; i != segment_count(); ++i) {
+                exclusive_guard guard(segments_[i].lock_);
+                table& t = segments_[i].table_;
+
+                for (iterator n = t.begin(); n != iterator();) {
+                    if (f(*n)) {
+                        n = t.erase(c_iterator(n));
+                        ++count;
+                    }
+                    else {
+                        ++n;
+                    }
+                }
+            }
+
+            return count;
+        }
+
+        void clear()
+        {
+            for (std::size_t i = 0; i != segment_count(); ++i) {
+                exclusive_guard guard(segments_[i].lock_);
+                segments_[i].table_.clear();
+            }
+        }
+
+        // observers
+
+        hasher hash_function() const
+        {
+            return segments_[0].table_.hash_function();
+        }
+
+        key_equal key_eq() const
+        {
+            return segments_[0].table_.key_eq();
+        }
+
+        // hash policy
+
+        size_type bucket_count() const
+        {
+            size_type result = 0;
+
+            for (std::size_t i = 0; i != segment_count(); ++i) {
+                shared_guard guard(segments_[i].lock_);
+                result += segments_[i].table_.bucket_count_;
+            }
+
+            return result;
+        }
+
+        float load_factor() const
+        {
+            size_type buckets = bucket_count();
+            return buckets ?
+                static_cast<float>(size()) / static_cast<float>(buckets) : 0;
+        }
+
+        float max_load_factor() const
+        {
+            shared_guard guard(segments_[0].lock_);
+            return segments_[0].table_.mlf_;
+        }
+
+        void max_load_factor(float z)
+        {
+            for (std::size_t i = 0; i != segment_count(); ++i) {
+                exclusive_guard guard(segments_[i].lock_);
+                segments_[i].table_.max_load_factor(z);
+            }
+        }
+
+        // Rehashes one segment at a time, the others stay available.
+
+        void rehash(size_type n)
+        {
+            for (std::size_t i = 0; i != segment_count(); ++i) {
+                exclusive_guard guard(segments_[i].lock_);
+                segments_[i].table_.rehash(segment_buckets(n));
+            }
+        }
+
+        void reserve(size_type n)
+        {
+            for (std::size_t i = 0; i != segment_count(); ++i) {
+                exclusive_guard guard(segments_[i].lock_);
+                segments_[i].table_.reserve(segment_buckets(n));
+            }
+        }
+
+    private:
+
+        static std::size_t segment_count()
+        {
+            return boost::unordered::detail::concurrent_segment_count;
+        }
+
+        static std::size_t segment_buckets(size_type n)
+        {
+            return (n + segment_count() - 1) / segment_count();
+        }
+
+        // The hash function is never changed after construction, so it's
+        // safe to call it before locking the segment.
+
+        std::size_t hash(key_type const& k) const
+        {
+            return segments_[0].table_.hash(k);
+        }
+
+        segment& get_segment(std::size_t key_hash) const
+        {
+            return segments_[
+                boost::unordered::detail::concurrent_segment_index(key_hash)];
+        }
+
+        static void add_node(table& t, node_constructor& a,
+                std::size_t key_hash)
+        {
+            // reserve has basic exception safety if the hash function
+            // throws, strong otherwise.
+            t.reserve_for_insert(t.size_ + 1);
+            t.add_node(a, key_hash);
+        }
+    };
+} // namespace unordered
+} // namespace boost
+
+#endif // BOOST_UNORDERED_CONCURRENT_MAP_HPP_INCLUDED
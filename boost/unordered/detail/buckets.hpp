@@ -12,6 +12,7 @@
 #endif
 
 #include <boost/unordered/detail/util.hpp>
+#include <boost/unordered/detail/fwd.hpp>
 #include <boost/unordered/detail/allocate.hpp>
 #include <boost/type_traits/aligned_storage.hpp>
 #include <boost/type_traits/alignment_of.hpp>
@@ -643,6 +644,133 @@ namespace boost { namespace unordered { namespace detail {
         }
     };
 
+    // A stronger mix for the power of two and fast range policies, which
+    // don't rely on a prime modulus to use every bit of the hash value.
+
+    template <int digits>
+    struct post_mix_impl
+    {
+        template <typename Hash, typename T>
+        static inline std::size_t apply_hash(Hash const& hf, T const& x) {
+            // The finalizer from MurmurHash3.
+            std::size_t key = hf(x);
+            key ^= key >> 16;
+            key *= 0x85ebca6bu;
+            key ^= key >> 13;
+            key *= 0xc2b2ae35u;
+            key ^= key >> 16;
+            return key;
+        }
+    };
+
+    template <>
+    struct post_mix_impl<64> : mix64_policy<std::size_t> {};
+
+    typedef post_mix_impl<std::numeric_limits<std::size_t>::digits>
+        post_mix;
+
+    template <typename SizeT>
+    struct power_of_two_policy
+    {
+        template <typename Hash, typename T>
+        static inline SizeT apply_hash(Hash const& hf, T const& x) {
+            return boost::unordered::detail::post_mix::apply_hash(hf, x);
+        }
+
+        static inline SizeT to_bucket(SizeT bucket_count, SizeT hash) {
+            return hash & (bucket_count - 1);
+        }
+
+        static inline SizeT new_bucket_count(SizeT min) {
+            SizeT count = 4;
+            while (count < min && count << 1) count <<= 1;
+            return count;
+        }
+
+        static inline SizeT prev_bucket_count(SizeT max) {
+            SizeT count = 4;
+            while ((count << 1) && (count << 1) <= max) count <<= 1;
+            return count;
+        }
+    };
+
+    // Maps the hash value to a bucket by taking the high word of
+    // 'hash * bucket_count' rather than the remainder, which replaces the
+    // division with a multiplication. The bucket counts are still primes, so
+    // the table grows in the same steps as with prime_policy.
+
+    template <int digits>
+    struct fast_range_impl
+    {
+        // Portable version of the high word of a double width multiply.
+        static inline std::size_t apply(std::size_t hash, std::size_t n) {
+            std::size_t const half =
+                std::numeric_limits<std::size_t>::digits / 2;
+            std::size_t const low_mask = (std::size_t(1) << half) - 1;
+            std::size_t x0 = hash & low_mask, x1 = hash >> half;
+            std::size_t y0 = n & low_mask, y1 = n >> half;
+            std::size_t p00 = x0 * y0, p01 = x0 * y1;
+            std::size_t p10 = x1 * y0, p11 = x1 * y1;
+            std::size_t middle = (p00 >> half) + (p10 & low_mask) + p01;
+            return p11 + (p10 >> half) + (middle >> half);
+        }
+    };
+
+#if !defined(BOOST_NO_LONG_LONG)
+    template <>
+    struct fast_range_impl<32>
+    {
+        static inline std::size_t apply(std::size_t hash, std::size_t n) {
+            return static_cast<std::size_t>(
+                (static_cast<boost::ulong_long_type>(hash) * n) >> 32);
+        }
+    };
+#endif
+
+#if defined(BOOST_HAS_INT128)
+    template <>
+    struct fast_range_impl<64>
+    {
+        static inline std::size_t apply(std::size_t hash, std::size_t n) {
+            return static_cast<std::size_t>(
+                (static_cast<boost::uint128_type>(hash) * n) >> 64);
+        }
+    };
+#elif defined(BOOST_MSVC) && defined(_M_X64)
+    template <>
+    struct fast_range_impl<64>
+    {
+        static inline std::size_t apply(std::size_t hash, std::size_t n) {
+            return __umulh(hash, n);
+        }
+    };
+#endif
+
+    typedef fast_range_impl<std::numeric_limits<std::size_t>::digits>
+        fast_range;
+
+    template <typename SizeT>
+    struct fast_range_policy
+    {
+        template <typename Hash, typename T>
+        static inline SizeT apply_hash(Hash const& hf, T const& x) {
+            return boost::unordered::detail::post_mix::apply_hash(hf, x);
+        }
+
+        static inline SizeT to_bucket(SizeT bucket_count, SizeT hash) {
+            return boost::unordered::detail::fast_range::apply(
+                hash, bucket_count);
+        }
+
+        static inline SizeT new_bucket_count(SizeT min) {
+            return boost::unordered::detail::next_prime(min);
+        }
+
+        static inline SizeT prev_bucket_count(SizeT max) {
+            return boost::unordered::detail::prev_prime(max);
+        }
+    };
+
     template <int digits, int radix>
     struct pick_policy_impl {
         typedef prime_policy<std::size_t> type;
@@ -653,11 +781,35 @@ namespace boost { namespace unordered { namespace detail {
         typedef mix64_policy<std::size_t> type;
     };
 
-    struct pick_policy :
+    template <typename Tag>
+    struct policy_for_tag :
         pick_policy_impl<
             std::numeric_limits<std::size_t>::digits,
             std::numeric_limits<std::size_t>::radix> {};
 
+    template <>
+    struct policy_for_tag<boost::unordered::prime_buckets> {
+        typedef prime_policy<std::size_t> type;
+    };
+
+    template <>
+    struct policy_for_tag<boost::unordered::power_of_two_buckets> {
+        typedef power_of_two_policy<std::size_t> type;
+    };
+
+    template <>
+    struct policy_for_tag<boost::unordered::fast_range_buckets> {
+        typedef fast_range_policy<std::size_t> type;
+    };
+
+    template <typename H>
+    struct pick_policy :
+        policy_for_tag<boost::unordered::default_buckets> {};
+
+    template <typename H, typename Tag>
+    struct pick_policy<boost::unordered::hash_with_bucket_policy<H, Tag> > :
+        policy_for_tag<Tag> {};
+
     ////////////////////////////////////////////////////////////////////////////
     // Functions
 
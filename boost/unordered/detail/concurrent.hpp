@@ -0,0 +1,231 @@
+
+// Copyright (C) 2012 Daniel James
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNORDERED_DETAIL_CONCURRENT_HPP_INCLUDED
+#define BOOST_UNORDERED_DETAIL_CONCURRENT_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <boost/unordered/detail/table.hpp>
+#include <boost/atomic.hpp>
+#include <boost/smart_ptr/detail/yield_k.hpp>
+#include <limits>
+
+namespace boost { namespace unordered { namespace detail {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // rw_spinlock
+    //
+    // A small reader/writer lock for the segments of concurrent_map. The
+    // lowest bit of the state is set by a writer, the other bits count the
+    // readers. A writer sets the bit before waiting for the readers to leave,
+    // so that new readers can't starve it.
+
+    class rw_spinlock
+    {
+        static const std::size_t writer = 1;
+        static const std::size_t reader = 2;
+
+        boost::atomic<std::size_t> state_;
+
+        rw_spinlock(rw_spinlock const&);
+        rw_spinlock& operator=(rw_spinlock const&);
+
+    public:
+
+        rw_spinlock() : state_(0) {}
+
+        void lock()
+        {
+            for (unsigned k = 0;; ++k) {
+                std::size_t state = state_.load(boost::memory_order_relaxed);
+                if (!(state & writer) && state_.compare_exchange_weak(
+                        state, state | writer, boost::memory_order_acquire,
+                        boost::memory_order_relaxed))
+                    break;
+                boost::detail::yield(k);
+            }
+
+            for (unsigned k = 0;
+                    state_.load(boost::memory_order_acquire) != writer; ++k)
+                boost::detail::yield(k);
+        }
+
+        void unlock()
+        {
+            state_.store(0, boost::memory_order_release);
+        }
+
+        void lock_shared()
+        {
+            for (unsigned k = 0;; ++k) {
+                std::size_t state = state_.load(boost::memory_order_relaxed);
+                if (!(state & writer) && state_.compare_exchange_weak(
+                        state, state + reader, boost::memory_order_acquire,
+                        boost::memory_order_relaxed))
+                    break;
+                boost::detail::yield(k);
+            }
+        }
+
+        void unlock_shared()
+        {
+            state_.fetch_sub(reader, boost::memory_order_release);
+        }
+    };
+
+    class rw_spinlock_guard
+    {
+        rw_spinlock& lock_;
+
+        rw_spinlock_guard(rw_spinlock_guard const&);
+        rw_spinlock_guard& operator=(rw_spinlock_guard const&);
+
+    public:
+
+        explicit rw_spinlock_guard(rw_spinlock& l) : lock_(l) { lock_.lock(); }
+        ~rw_spinlock_guard() { lock_.unlock(); }
+    };
+
+    class rw_spinlock_shared_guard
+    {
+        rw_spinlock& lock_;
+
+        rw_spinlock_shared_guard(rw_spinlock_shared_guard const&);
+        rw_spinlock_shared_guard& operator=(rw_spinlock_shared_guard const&);
+
+    public:
+
+        explicit rw_spinlock_shared_guard(rw_spinlock& l) : lock_(l)
+        {
+            lock_.lock_shared();
+        }
+
+        ~rw_spinlock_shared_guard() { lock_.unlock_shared(); }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Segments
+    //
+    // concurrent_map splits its elements between a fixed number of tables,
+    // each one guarded by its own lock. The tables pick their buckets from
+    // the low bits of the hash value (or its remainder), so the segment is
+    // picked from the high bits of the hash value multiplied by the golden
+    // ratio.
+
+    static const std::size_t concurrent_segment_bits = 6;
+    static const std::size_t concurrent_segment_count =
+        std::size_t(1) << concurrent_segment_bits;
+
+    // Keep the locks of neighbouring segments on different cache lines.
+    static const std::size_t concurrent_cacheline_bytes = 64;
+
+    template <int digits>
+    struct concurrent_segment_mix_impl
+    {
+        static const std::size_t multiplier = 0x9e3779b9u;
+    };
+
+    template <>
+    struct concurrent_segment_mix_impl<64>
+    {
+        static const std::size_t multiplier =
+            (std::size_t(0x9e3779b9u) << 32) + 0x7f4a7c15u;
+    };
+
+    inline std::size_t concurrent_segment_index(std::size_t key_hash)
+    {
+        typedef concurrent_segment_mix_impl<
+            std::numeric_limits<std::size_t>::digits> mix;
+
+        return (key_hash * mix::multiplier) >>
+            (std::numeric_limits<std::size_t>::digits -
+                concurrent_segment_bits);
+    }
+
+    template <typename Table>
+    struct concurrent_segment
+    {
+        rw_spinlock lock_;
+        Table table_;
+        char padding_[concurrent_cacheline_bytes];
+
+        concurrent_segment(std::size_t n,
+                typename Table::hasher const& hf,
+                typename Table::key_equal const& eq,
+                typename Table::node_allocator const& a)
+          : lock_(), table_(n, hf, eq, a)
+        {}
+    };
+
+    // Owns the storage for the segments. The segments are constructed by
+    // 'construct' rather than in the constructor, so that if constructing
+    // one of them throws, the destructor still cleans up the others.
+
+    template <typename Table, typename A>
+    class concurrent_segment_array
+    {
+    public:
+
+        typedef boost::unordered::detail::concurrent_segment<Table> segment;
+
+    private:
+
+        typedef typename boost::unordered::detail::
+            rebind_wrap<A, segment>::type segment_allocator;
+        typedef boost::unordered::detail::allocator_traits<segment_allocator>
+            segment_allocator_traits;
+        typedef typename segment_allocator_traits::pointer segment_pointer;
+
+        segment_allocator alloc_;
+        segment_pointer segments_;
+        std::size_t constructed_;
+
+        concurrent_segment_array(concurrent_segment_array const&);
+        concurrent_segment_array& operator=(concurrent_segment_array const&);
+
+    public:
+
+        explicit concurrent_segment_array(A const& a)
+          : alloc_(a), segments_(), constructed_(0)
+        {
+            segments_ = segment_allocator_traits::allocate(
+                alloc_, concurrent_segment_count);
+        }
+
+        ~concurrent_segment_array()
+        {
+            while (constructed_) {
+                --constructed_;
+                boost::unordered::detail::destroy(
+                    boost::addressof(segments_[constructed_]));
+            }
+
+            segment_allocator_traits::deallocate(
+                alloc_, segments_, concurrent_segment_count);
+        }
+
+        void construct(std::size_t n,
+                typename Table::hasher const& hf,
+                typename Table::key_equal const& eq,
+                typename Table::node_allocator const& a)
+        {
+            for (; constructed_ != concurrent_segment_count; ++constructed_) {
+                new ((void*) boost::addressof(segments_[constructed_]))
+                    segment(n, hf, eq, a);
+            }
+        }
+
+        segment& operator[](std::size_t index) const
+        {
+            BOOST_ASSERT(index < constructed_);
+            return segments_[static_cast<std::ptrdiff_t>(index)];
+        }
+    };
+}}}
+
+#endif
@@ -0,0 +1,982 @@
+
+// Copyright (C) 2012 Daniel James
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNORDERED_DETAIL_FLAT_TABLE_HPP_INCLUDED
+#define BOOST_UNORDERED_DETAIL_FLAT_TABLE_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <boost/unordered/detail/buckets.hpp>
+#include <boost/unordered/detail/extract_key.hpp>
+#include <boost/unordered/detail/util.hpp>
+#include <boost/iterator.hpp>
+#include <boost/swap.hpp>
+#include <boost/limits.hpp>
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <stdexcept>
+#include <cstring>
+
+// The metadata bytes are probed 16 at a time. With SSE2 a whole group is
+// compared with a couple of instructions, otherwise it's done a byte at a
+// time. Define BOOST_UNORDERED_DISABLE_SSE2 to always use the portable
+// version.
+
+#if !defined(BOOST_UNORDERED_DISABLE_SSE2)
+#   if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define BOOST_UNORDERED_FLAT_SSE2
+#   endif
+#endif
+
+#if defined(BOOST_UNORDERED_FLAT_SSE2)
+#include <emmintrin.h>
+#endif
+
+#if defined(BOOST_MSVC)
+#include <intrin.h>
+#pragma warning(push)
+#pragma warning(disable:4127) // conditional expression is constant
+#endif
+
+namespace boost { namespace unordered { namespace detail {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Metadata
+    //
+    // Every slot has a metadata byte. For a full slot it holds the lowest 7
+    // bits of the element's hash value, otherwise the high bit is set to mark
+    // an empty or a deleted slot. There's a sentinel byte after the last slot
+    // to stop iteration.
+
+    static const unsigned char flat_empty = 0x80;
+    static const unsigned char flat_deleted = 0xfe;
+    static const unsigned char flat_sentinel = 0xff;
+    static const std::size_t flat_group_width = 16;
+
+    // Used by tables which haven't allocated anything yet, so that lookups
+    // don't need to check for that.
+
+    template <typename T>
+    struct flat_empty_group_impl
+    {
+        static unsigned char const control[flat_group_width + 1];
+    };
+
+    template <typename T>
+    unsigned char const flat_empty_group_impl<T>::control[
+        flat_group_width + 1] =
+    {
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0xff
+    };
+
+    typedef flat_empty_group_impl<void> flat_empty_group;
+
+    // Index of the lowest set bit, 'mask' must not be zero.
+
+    inline unsigned flat_first_bit(unsigned mask)
+    {
+        BOOST_ASSERT(mask);
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#elif defined(BOOST_MSVC)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        unsigned index = 0;
+        while (!(mask & 1u)) { mask >>= 1; ++index; }
+        return index;
+#endif
+    }
+
+    // A group of 16 metadata bytes. The 'match' functions return a bit mask
+    // of the matching slots.
+
+#if defined(BOOST_UNORDERED_FLAT_SSE2)
+
+    struct flat_group
+    {
+        __m128i bytes_;
+
+        explicit flat_group(unsigned char const* p)
+          : bytes_(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p)))
+        {}
+
+        unsigned match(unsigned char h) const
+        {
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                bytes_, _mm_set1_epi8(static_cast<char>(h)))));
+        }
+
+        unsigned match_empty() const
+        {
+            return match(flat_empty);
+        }
+
+        // Empty and deleted slots have the high bit set.
+        unsigned match_available() const
+        {
+            return static_cast<unsigned>(_mm_movemask_epi8(bytes_));
+        }
+    };
+
+#else
+
+    struct flat_group
+    {
+        unsigned char const* bytes_;
+
+        explicit flat_group(unsigned char const* p) : bytes_(p) {}
+
+        unsigned match(unsigned char h) const
+        {
+            unsigned mask = 0;
+            for (unsigned i = 0; i != flat_group_width; ++i)
+                if (bytes_[i] == h) mask |= 1u << i;
+            return mask;
+        }
+
+        unsigned match_empty() const
+        {
+            return match(flat_empty);
+        }
+
+        unsigned match_available() const
+        {
+            unsigned mask = 0;
+            for (unsigned i = 0; i != flat_group_width; ++i)
+                if (bytes_[i] & 0x80) mask |= 1u << i;
+            return mask;
+        }
+    };
+
+#endif
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Iterators
+
+    template <typename Types> struct flat_table;
+
+    template <typename Value, typename Reference, typename Pointer>
+    class flat_iterator
+        : public boost::iterator<
+            std::forward_iterator_tag,
+            Value,
+            std::ptrdiff_t,
+            Pointer,
+            Reference>
+    {
+#if !defined(BOOST_NO_MEMBER_TEMPLATE_FRIENDS)
+        template <typename, typename, typename>
+        friend class boost::unordered::detail::flat_iterator;
+        template <typename>
+        friend struct boost::unordered::detail::flat_table;
+    private:
+#endif
+        unsigned char const* control_;
+        Value* value_;
+
+        flat_iterator(unsigned char const* c, Value* v)
+          : control_(c), value_(v) {}
+
+        void skip_available()
+        {
+            while (*control_ & 0x80 && *control_ != flat_sentinel) {
+                ++control_;
+                ++value_;
+            }
+        }
+
+    public:
+
+        flat_iterator() : control_(), value_() {}
+
+        flat_iterator(flat_iterator<Value, Value&, Value*> const& x)
+          : control_(x.control_), value_(x.value_) {}
+
+        Reference operator*() const {
+            return *value_;
+        }
+
+        Pointer operator->() const {
+            return value_;
+        }
+
+        flat_iterator& operator++() {
+            ++control_;
+            ++value_;
+            skip_available();
+            return *this;
+        }
+
+        flat_iterator operator++(int) {
+            flat_iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(flat_iterator const& x) const {
+            return control_ == x.control_;
+        }
+
+        bool operator!=(flat_iterator const& x) const {
+            return control_ != x.control_;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Types
+
+    template <typename A, typename K, typename M, typename H, typename P>
+    struct flat_map
+    {
+        typedef A allocator;
+        typedef std::pair<K const, M> value_type;
+        typedef H hasher;
+        typedef P key_equal;
+        typedef K key_type;
+
+        typedef boost::unordered::detail::map_extractor<key_type, value_type>
+            extractor;
+
+        typedef boost::unordered::detail::flat_iterator<
+            value_type, value_type&, value_type*> iterator;
+        typedef boost::unordered::detail::flat_iterator<
+            value_type, value_type const&, value_type const*> c_iterator;
+    };
+
+    template <typename A, typename T, typename H, typename P>
+    struct flat_set
+    {
+        typedef A allocator;
+        typedef T value_type;
+        typedef H hasher;
+        typedef P key_equal;
+        typedef T key_type;
+
+        typedef boost::unordered::detail::set_extractor<value_type> extractor;
+
+        typedef boost::unordered::detail::flat_iterator<
+            value_type, value_type const&, value_type const*> iterator;
+        typedef iterator c_iterator;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // flat_table
+    //
+    // An open addressing table, storing the elements inline in an array which
+    // is split into groups of 16 slots. Lookup probes whole groups, moving to
+    // the next group only when the current one is full. The groups are visited
+    // in triangular order, which visits every group for a power of two.
+    //
+    // Erasing leaves a 'deleted' marker, unless the group has an empty slot,
+    // in which case no probe sequence could have gone past it. The deleted
+    // slots are reused by inserts and cleared by a rehash.
+
+    template <typename Types>
+    struct flat_table :
+        boost::unordered::detail::functions<
+            typename Types::hasher,
+            typename Types::key_equal>
+    {
+    private:
+        flat_table(flat_table const&);
+        flat_table& operator=(flat_table const&);
+    public:
+        typedef typename Types::hasher hasher;
+        typedef typename Types::key_equal key_equal;
+        typedef typename Types::key_type key_type;
+        typedef typename Types::extractor extractor;
+        typedef typename Types::value_type value_type;
+        typedef typename Types::iterator iterator;
+        typedef typename Types::c_iterator c_iterator;
+
+        typedef boost::unordered::detail::functions<hasher, key_equal>
+            functions;
+
+        // The table is a power of two, so the hash value is mixed to make
+        // sure all of its bits affect the position. The high bits pick the
+        // group, the low 7 are stored in the metadata.
+        typedef boost::unordered::detail::post_mix policy;
+
+        typedef typename boost::unordered::detail::
+            rebind_wrap<typename Types::allocator, value_type>::type
+            value_allocator;
+        typedef typename boost::unordered::detail::
+            rebind_wrap<typename Types::allocator, unsigned char>::type
+            control_allocator;
+        typedef boost::unordered::detail::allocator_traits<value_allocator>
+            value_allocator_traits;
+        typedef boost::unordered::detail::allocator_traits<control_allocator>
+            control_allocator_traits;
+        typedef typename value_allocator_traits::pointer value_pointer;
+        typedef typename control_allocator_traits::pointer control_pointer;
+
+        static std::size_t const npos = static_cast<std::size_t>(-1);
+
+        // The storage for a table, kept separate so that a rehash can build
+        // the new one on the side.
+
+        struct storage
+        {
+            value_pointer values_;
+            control_pointer controls_;
+            value_type* value_;
+            unsigned char* control_;
+            std::size_t group_mask_;
+
+            storage()
+              : values_(), controls_(), value_(),
+                control_(const_cast<unsigned char*>(
+                    flat_empty_group::control)),
+                group_mask_(0)
+            {}
+
+            std::size_t capacity() const
+            {
+                return value_ ? (group_mask_ + 1) * flat_group_width : 0;
+            }
+
+            void swap(storage& x)
+            {
+                boost::swap(values_, x.values_);
+                boost::swap(controls_, x.controls_);
+                std::swap(value_, x.value_);
+                std::swap(control_, x.control_);
+                std::swap(group_mask_, x.group_mask_);
+            }
+        };
+
+        // Destroys the storage it holds, used by rehash to clean up either the
+        // new storage, if moving an element throws, or the old one.
+
+        struct storage_holder
+        {
+            flat_table& table_;
+            storage storage_;
+
+            explicit storage_holder(flat_table& t) : table_(t), storage_() {}
+
+            ~storage_holder()
+            {
+                table_.destroy_storage(storage_);
+            }
+
+        private:
+            storage_holder(storage_holder const&);
+            storage_holder& operator=(storage_holder const&);
+        };
+
+        ////////////////////////////////////////////////////////////////////////
+        // Members
+
+        boost::unordered::detail::compressed<value_allocator, control_allocator>
+            allocators_;
+        storage storage_;
+        std::size_t size_;
+
+        // The number of empty slots that can be filled before the maximum
+        // load factor is reached. Deleted slots aren't counted, as reusing
+        // them doesn't increase the number of slots a lookup has to visit.
+        std::size_t available_;
+
+        ////////////////////////////////////////////////////////////////////////
+        // Data access
+
+        value_allocator const& value_alloc() const
+        {
+            return allocators_.first();
+        }
+
+        value_allocator& value_alloc()
+        {
+            return allocators_.first();
+        }
+
+        control_allocator& control_alloc()
+        {
+            return allocators_.second();
+        }
+
+        std::size_t capacity() const
+        {
+            return storage_.capacity();
+        }
+
+        iterator begin() const
+        {
+            if (!size_) return end();
+            iterator it(storage_.control_, storage_.value_);
+            it.skip_available();
+            return it;
+        }
+
+        iterator end() const
+        {
+            return iterator(storage_.control_ + capacity(),
+                storage_.value_ + capacity());
+        }
+
+        iterator iterator_at(std::size_t index) const
+        {
+            return iterator(storage_.control_ + index,
+                storage_.value_ + index);
+        }
+
+        std::size_t index_of(c_iterator it) const
+        {
+            return static_cast<std::size_t>(it.control_ - storage_.control_);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Load methods
+
+        static std::size_t max_load_for(std::size_t capacity)
+        {
+            // A maximum load factor of 7/8.
+            return capacity - capacity / 8;
+        }
+
+        static std::size_t capacity_for_size(std::size_t size)
+        {
+            std::size_t capacity = flat_group_width;
+            while (max_load_for(capacity) < size) capacity *= 2;
+            return capacity;
+        }
+
+        static std::size_t min_capacity(std::size_t slots)
+        {
+            std::size_t capacity = flat_group_width;
+            while (capacity < slots) capacity *= 2;
+            return capacity;
+        }
+
+        float max_load_factor() const
+        {
+            return 0.875f;
+        }
+
+        float load_factor() const
+        {
+            return capacity() ? static_cast<float>(size_) /
+                static_cast<float>(capacity()) : 0;
+        }
+
+        std::size_t max_size() const
+        {
+            return max_load_for((std::min)(
+                value_allocator_traits::max_size(value_alloc()),
+                (std::numeric_limits<std::size_t>::max)() / 2 + 1) / 2);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Constructors
+
+        flat_table(std::size_t num_buckets,
+                hasher const& hf,
+                key_equal const& eq,
+                value_allocator const& a) :
+            functions(hf, eq),
+            allocators_(a, a),
+            storage_(),
+            size_(0),
+            available_(0)
+        {
+            if (num_buckets > flat_group_width)
+                rehash_impl(min_capacity(num_buckets));
+        }
+
+        flat_table(flat_table const& x, value_allocator const& a) :
+            functions(x),
+            allocators_(a, a),
+            storage_(),
+            size_(0),
+            available_(0)
+        {
+            if (x.size_) {
+                rehash_impl(capacity_for_size(x.size_));
+                for (iterator it = x.begin(); it != x.end(); ++it)
+                    insert_new(hash(extractor::extract(*it)), *it);
+            }
+        }
+
+        flat_table(flat_table& x, boost::unordered::detail::move_tag) :
+            functions(x),
+            allocators_(x.allocators_, boost::unordered::detail::move_tag()),
+            storage_(),
+            size_(x.size_),
+            available_(x.available_)
+        {
+            storage_.swap(x.storage_);
+            x.size_ = 0;
+            x.available_ = 0;
+        }
+
+        ~flat_table()
+        {
+            destroy_storage(storage_);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Storage
+
+        void create_storage(storage& s, std::size_t capacity)
+        {
+            BOOST_ASSERT(capacity >= flat_group_width &&
+                !(capacity & (capacity - 1)));
+
+            s.controls_ = control_allocator_traits::allocate(
+                control_alloc(), capacity + 1);
+            s.control_ = boost::addressof(*s.controls_);
+            std::memset(s.control_, flat_empty, capacity);
+            s.control_[capacity] = flat_sentinel;
+
+            // Set the group mask before allocating the values, so that if
+            // that throws, the controls are still deallocated.
+            s.group_mask_ = capacity / flat_group_width - 1;
+            s.values_ = value_allocator_traits::allocate(
+                value_alloc(), capacity);
+            s.value_ = boost::addressof(*s.values_);
+        }
+
+        void destroy_storage(storage& s)
+        {
+            std::size_t capacity = (s.group_mask_ + 1) * flat_group_width;
+
+            if (s.value_) {
+                for (std::size_t i = 0; i != capacity; ++i) {
+                    if (!(s.control_[i] & 0x80)) {
+                        boost::unordered::detail::destroy_value_impl(
+                            value_alloc(), s.value_ + i);
+                    }
+                }
+
+                value_allocator_traits::deallocate(value_alloc(),
+                    s.values_, capacity);
+            }
+
+            if (s.controls_) {
+                control_allocator_traits::deallocate(control_alloc(),
+                    s.controls_, capacity + 1);
+            }
+
+            s = storage();
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Swap
+
+        void swap_allocators(flat_table& other, false_type)
+        {
+            // According to 23.2.1.8, if propagate_on_container_swap is
+            // false the behaviour is undefined unless the allocators
+            // are equal.
+            BOOST_ASSERT(value_alloc() == other.value_alloc());
+        }
+
+        void swap_allocators(flat_table& other, true_type)
+        {
+            allocators_.swap(other.allocators_);
+        }
+
+        void swap(flat_table& x)
+        {
+            boost::unordered::detail::set_hash_functions<hasher, key_equal>
+                op1(*this, x);
+            boost::unordered::detail::set_hash_functions<hasher, key_equal>
+                op2(x, *this);
+
+            swap_allocators(x,
+                boost::unordered::detail::integral_constant<bool,
+                    allocator_traits<value_allocator>::
+                    propagate_on_container_swap::value>());
+
+            storage_.swap(x.storage_);
+            std::swap(size_, x.size_);
+            std::swap(available_, x.available_);
+            op1.commit();
+            op2.commit();
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Assignment
+        //
+        // The new contents are built in a temporary table and swapped in,
+        // which gives the strong exception guarantee.
+
+        void assign(flat_table const& x)
+        {
+            if (this != boost::addressof(x))
+            {
+                assign(x,
+                    boost::unordered::detail::integral_constant<bool,
+                        allocator_traits<value_allocator>::
+                        propagate_on_container_copy_assignment::value>());
+            }
+        }
+
+        void assign(flat_table const& x, false_type)
+        {
+            flat_table tmp(x, value_alloc());
+            swap_contents(tmp, false);
+        }
+
+        void assign(flat_table const& x, true_type)
+        {
+            flat_table tmp(x, x.value_alloc());
+            swap_contents(tmp, true);
+        }
+
+        void move_assign(flat_table& x)
+        {
+            if (this != boost::addressof(x))
+            {
+                move_assign(x,
+                    boost::unordered::detail::integral_constant<bool,
+                        allocator_traits<value_allocator>::
+                        propagate_on_container_move_assignment::value>());
+            }
+        }
+
+        void move_assign(flat_table& x, true_type)
+        {
+            flat_table tmp(x, boost::unordered::detail::move_tag());
+            swap_contents(tmp, true);
+        }
+
+        void move_assign(flat_table& x, false_type)
+        {
+            if (value_alloc() == x.value_alloc()) {
+                flat_table tmp(x, boost::unordered::detail::move_tag());
+                swap_contents(tmp, false);
+            }
+            else {
+                // Can't take the other table's storage, so move the
+                // elements individually.
+                flat_table tmp(0, x.hash_function(), x.key_eq(),
+                    value_alloc());
+                if (x.size_) {
+                    tmp.rehash_impl(capacity_for_size(x.size_));
+                    for (iterator it = x.begin(); it != x.end(); ++it)
+                        tmp.insert_new(tmp.hash(extractor::extract(*it)),
+                            boost::move(*it));
+                }
+                swap_contents(tmp, false);
+            }
+        }
+
+        void swap_contents(flat_table& x, bool swap_allocators)
+        {
+            boost::unordered::detail::set_hash_functions<hasher, key_equal>
+                op1(*this, x);
+            // No throw from here.
+            if (swap_allocators) allocators_.swap(x.allocators_);
+            storage_.swap(x.storage_);
+            std::swap(size_, x.size_);
+            std::swap(available_, x.available_);
+            op1.commit();
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Lookup
+
+        std::size_t hash(key_type const& k) const
+        {
+            return policy::apply_hash(this->hash_function(), k);
+        }
+
+        static unsigned char hash_bits(std::size_t key_hash)
+        {
+            return static_cast<unsigned char>(key_hash & 0x7f);
+        }
+
+        static std::size_t hash_group(std::size_t key_hash,
+                std::size_t group_mask)
+        {
+            return (key_hash >> 7) & group_mask;
+        }
+
+        std::size_t find_index(std::size_t key_hash, key_type const& k) const
+        {
+            unsigned char const h = hash_bits(key_hash);
+            std::size_t const group_mask = storage_.group_mask_;
+            std::size_t group = hash_group(key_hash, group_mask);
+
+            for (std::size_t step = 0;;) {
+                unsigned char const* control =
+                    storage_.control_ + group * flat_group_width;
+                flat_group g(control);
+
+                for (unsigned mask = g.match(h); mask; mask &= mask - 1) {
+                    std::size_t index = group * flat_group_width +
+                        flat_first_bit(mask);
+                    if (this->key_eq()(k,
+                            extractor::extract(storage_.value_[index])))
+                        return index;
+                }
+
+                if (g.match_empty() || step == group_mask) return npos;
+
+                ++step;
+                group = (group + step) & group_mask;
+            }
+        }
+
+        iterator find_node(key_type const& k) const
+        {
+            if (!size_) return end();
+            std::size_t index = find_index(hash(k), k);
+            return index == npos ? end() : iterator_at(index);
+        }
+
+        // Find an empty or deleted slot, there is always at least one.
+
+        static std::size_t find_available(storage const& s,
+                std::size_t key_hash)
+        {
+            std::size_t group = hash_group(key_hash, s.group_mask_);
+
+            for (std::size_t step = 0;;) {
+                unsigned mask = flat_group(
+                    s.control_ + group * flat_group_width).match_available();
+                if (mask)
+                    return group * flat_group_width + flat_first_bit(mask);
+
+                ++step;
+                BOOST_ASSERT(step <= s.group_mask_);
+                group = (group + step) & s.group_mask_;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Insert
+
+        // Returns the slot to construct a new element in, rehashing first if
+        // there's no room.
+
+        std::size_t prepare_insert(std::size_t key_hash)
+        {
+            if (capacity()) {
+                std::size_t index = find_available(storage_, key_hash);
+                if (available_ || storage_.control_[index] == flat_deleted)
+                    return index;
+            }
+
+            // Out of empty slots. If a lot of them were taken by deleted
+            // elements, rehash in place to clear them, otherwise grow.
+            std::size_t capacity = this->capacity();
+            rehash_impl(!capacity ? flat_group_width :
+                size_ + 1 <= max_load_for(capacity) / 2 ?
+                    capacity : capacity * 2);
+
+            return find_available(storage_, key_hash);
+        }
+
+        // Called once the element has been constructed in 'index'.
+        void commit_insert(std::size_t index, std::size_t key_hash)
+        {
+            if (storage_.control_[index] == flat_empty) --available_;
+            storage_.control_[index] = hash_bits(key_hash);
+            ++size_;
+        }
+
+        // Insert a value which isn't already in the table.
+        template <typename Arg>
+        iterator insert_new(std::size_t key_hash, BOOST_FWD_REF(Arg) arg)
+        {
+            std::size_t index = prepare_insert(key_hash);
+            boost::unordered::detail::construct_value_impl(
+                value_alloc(), storage_.value_ + index,
+                BOOST_UNORDERED_EMPLACE_ARGS1(boost::forward<Arg>(arg)));
+            commit_insert(index, key_hash);
+            return iterator_at(index);
+        }
+
+        template <typename Arg>
+        std::pair<iterator, bool> insert_unique(key_type const& k,
+                BOOST_FWD_REF(Arg) arg)
+        {
+            std::size_t key_hash = hash(k);
+            std::size_t index = size_ ? find_index(key_hash, k) : npos;
+            if (index != npos) return std::make_pair(iterator_at(index), false);
+            return std::make_pair(
+                insert_new(key_hash, boost::forward<Arg>(arg)), true);
+        }
+
+        // Find the element with key 'k', constructing it from the key and a
+        // default constructed mapped value if it's missing.
+        value_type& find_or_insert_key(key_type const& k)
+        {
+            std::size_t key_hash = hash(k);
+            std::size_t index = size_ ? find_index(key_hash, k) : npos;
+            if (index != npos) return storage_.value_[index];
+
+            index = prepare_insert(key_hash);
+            boost::unordered::detail::construct_value_impl(
+                value_alloc(), storage_.value_ + index,
+                BOOST_UNORDERED_EMPLACE_ARGS3(
+                    boost::unordered::piecewise_construct,
+                    boost::make_tuple(k),
+                    boost::make_tuple()));
+            commit_insert(index, key_hash);
+            return storage_.value_[index];
+        }
+
+        template <class InputIt>
+        void insert_range(InputIt i, InputIt j)
+        {
+            std::size_t n = boost::unordered::detail::insert_size(i, j);
+            if (n > available_) reserve(size_ + n);
+
+            for (; i != j; ++i)
+                insert_unique(extractor::extract(*i), *i);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Erase
+
+        void erase_index(std::size_t index)
+        {
+            BOOST_ASSERT(!(storage_.control_[index] & 0x80));
+
+            boost::unordered::detail::destroy_value_impl(
+                value_alloc(), storage_.value_ + index);
+            --size_;
+
+            flat_group g(storage_.control_ +
+                (index & ~(flat_group_width - 1)));
+            if (g.match_empty()) {
+                storage_.control_[index] = flat_empty;
+                ++available_;
+            }
+            else {
+                storage_.control_[index] = flat_deleted;
+            }
+        }
+
+        std::size_t erase_key(key_type const& k)
+        {
+            if (!size_) return 0;
+            std::size_t index = find_index(hash(k), k);
+            if (index == npos) return 0;
+            erase_index(index);
+            return 1;
+        }
+
+        iterator erase(c_iterator it)
+        {
+            iterator next(iterator_at(index_of(it)));
+            ++next;
+            erase_index(index_of(it));
+            return next;
+        }
+
+        iterator erase_range(c_iterator first, c_iterator last)
+        {
+            while (first != last) {
+                c_iterator next = first;
+                ++next;
+                erase_index(index_of(first));
+                first = next;
+            }
+
+            return iterator_at(index_of(last));
+        }
+
+        void clear()
+        {
+            if (!size_) return;
+
+            for (std::size_t i = 0; i != capacity(); ++i) {
+                if (!(storage_.control_[i] & 0x80)) {
+                    boost::unordered::detail::destroy_value_impl(
+                        value_alloc(), storage_.value_ + i);
+                }
+            }
+
+            std::memset(storage_.control_, flat_empty, capacity());
+            size_ = 0;
+            available_ = max_load_for(capacity());
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Rehash
+        //
+        // Basic exception safety if moving an element throws, the elements
+        // that have already been moved are left moved from.
+
+        void rehash_impl(std::size_t new_capacity)
+        {
+            BOOST_ASSERT(max_load_for(new_capacity) >= size_);
+
+            storage_holder holder(*this);
+            storage& s = holder.storage_;
+            create_storage(s, new_capacity);
+
+            for (std::size_t i = 0; i != capacity(); ++i) {
+                if (!(storage_.control_[i] & 0x80)) {
+                    value_type& v = storage_.value_[i];
+                    std::size_t key_hash = hash(extractor::extract(v));
+                    std::size_t index = find_available(s, key_hash);
+                    boost::unordered::detail::construct_value_impl(
+                        value_alloc(), s.value_ + index,
+                        BOOST_UNORDERED_EMPLACE_ARGS1(boost::move(v)));
+                    s.control_[index] = hash_bits(key_hash);
+                }
+            }
+
+            // The holder now destroys the old elements.
+            storage_.swap(s);
+            available_ = max_load_for(new_capacity) - size_;
+        }
+
+        void rehash(std::size_t min_buckets)
+        {
+            std::size_t new_capacity = (std::max)(
+                capacity_for_size(size_), min_capacity(min_buckets));
+
+            if (!size_ && min_buckets == 0) {
+                destroy_storage(storage_);
+                available_ = 0;
+            }
+            else if (new_capacity != capacity()) {
+                rehash_impl(new_capacity);
+            }
+        }
+
+        void reserve(std::size_t num_elements)
+        {
+            if (num_elements > size_ + available_)
+                rehash_impl(capacity_for_size(num_elements));
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Equality
+
+        bool equals(flat_table const& other) const
+        {
+            if (size_ != other.size_) return false;
+
+            for (iterator it = begin(); it != end(); ++it) {
+                iterator it2 = other.find_node(extractor::extract(*it));
+                if (it2 == other.end() || !(*it == *it2)) return false;
+            }
+
+            return true;
+        }
+    };
+}}}
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop)
+#endif
+
+#endif
@@ -17,6 +17,30 @@ namespace unordered
 {
     struct piecewise_construct_t {};
     const piecewise_construct_t piecewise_construct = piecewise_construct_t();
+
+    // Bucket policies, which control how the containers pick the number of
+    // buckets and map hash values to them. The default is prime_buckets, or
+    // power_of_two_buckets where std::size_t is 64 bit.
+    //
+    // prime_buckets:        prime bucket counts, hash value modulo the count.
+    // power_of_two_buckets: power of two counts, the hash value is mixed then
+    //                       masked.
+    // fast_range_buckets:   prime counts, the hash value is mixed then
+    //                       mapped with a multiply and shift instead of a
+    //                       division.
+    struct default_buckets {};
+    struct prime_buckets {};
+    struct power_of_two_buckets {};
+    struct fast_range_buckets {};
+
+    // Hash function adaptor which selects the bucket policy of the containers
+    // it's used with. 'H' must be a class type.
+    template <class H, class Policy>
+    struct hash_with_bucket_policy : H
+    {
+        hash_with_bucket_policy() : H() {}
+        hash_with_bucket_policy(H const& h) : H(h) {}
+    };
 }
 }
 
@@ -0,0 +1,397 @@
+
+// Copyright (C) 2012 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/unordered for documentation
+
+#ifndef BOOST_UNORDERED_FLAT_UNORDERED_SET_HPP_INCLUDED
+#define BOOST_UNORDERED_FLAT_UNORDERED_SET_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <boost/unordered/flat_unordered_set_fwd.hpp>
+#include <boost/unordered/detail/flat_table.hpp>
+#include <boost/unordered/detail/util.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/move/move.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
+#include <initializer_list>
+#endif
+
+namespace boost
+{
+namespace unordered
+{
+    // The set version of flat_unordered_map, with the same trade offs against
+    // unordered_set: inserting or rehashing invalidates iterators, pointers
+    // and references to the elements, the value type must be move or copy
+    // constructible, the maximum load factor is fixed and there's no bucket
+    // interface.
+
+    template <class T, class H, class P, class A>
+    class flat_unordered_set
+    {
+    public:
+
+        typedef T key_type;
+        typedef T value_type;
+        typedef H hasher;
+        typedef P key_equal;
+        typedef A allocator_type;
+
+    private:
+
+        typedef boost::unordered::detail::flat_set<A, T, H, P> types;
+        typedef boost::unordered::detail::flat_table<types> table;
+        typedef typename table::value_allocator_traits allocator_traits;
+
+    public:
+
+        typedef typename allocator_traits::pointer pointer;
+        typedef typename allocator_traits::const_pointer const_pointer;
+
+        typedef value_type& reference;
+        typedef value_type const& const_reference;
+
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        typedef typename table::c_iterator const_iterator;
+        typedef typename table::iterator iterator;
+
+    private:
+
+        table table_;
+
+    public:
+
+        // constructors
+
+        explicit flat_unordered_set(
+                size_type n = boost::unordered::detail::default_bucket_count,
+                const hasher& hf = hasher(),
+                const key_equal& eql = key_equal(),
+                const allocator_type& a = allocator_type())
+          : table_(n, hf, eql, a)
+        {
+        }
+
+        explicit flat_unordered_set(allocator_type const& a)
+          : table_(boost::unordered::detail::default_bucket_count,
+                hasher(), key_equal(), a)
+        {
+        }
+
+        template <class InputIt>
+        flat_unordered_set(InputIt f, InputIt l,
+                size_type n = boost::unordered::detail::default_bucket_count,
+                const hasher& hf = hasher(),
+                const key_equal& eql = key_equal(),
+                const allocator_type& a = allocator_type())
+          : table_(n, hf, eql, a)
+        {
+            table_.insert_range(f, l);
+        }
+
+        flat_unordered_set(flat_unordered_set const& other)
+          : table_(other.table_, boost::unordered::detail::
+                call_select_on_container_copy_construction(
+                    other.table_.value_alloc()))
+        {
+        }
+
+        flat_unordered_set(flat_unordered_set const& other,
+                allocator_type const& a)
+          : table_(other.table_, a)
+        {
+        }
+
+#if !defined(BOOST_NO_RVALUE_REFERENCES)
+        flat_unordered_set(flat_unordered_set&& other)
+          : table_(other.table_, boost::unordered::detail::move_tag())
+        {
+        }
+#endif
+
+#if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
+        flat_unordered_set(
+                std::initializer_list<value_type> list,
+                size_type n = boost::unordered::detail::default_bucket_count,
+                const hasher& hf = hasher(),
+                const key_equal& eql = key_equal(),
+                const allocator_type& a = allocator_type())
+          : table_(n, hf, eql, a)
+        {
+            table_.insert_range(list.begin(), list.end());
+        }
+#endif
+
+        // Assign
+
+        flat_unordered_set& operator=(flat_unordered_set const& x)
+        {
+            table_.assign(x.table_);
+            return *this;
+        }
+
+#if !defined(BOOST_NO_RVALUE_REFERENCES)
+        flat_unordered_set& operator=(flat_unordered_set&& x)
+        {
+            table_.move_assign(x.table_);
+            return *this;
+        }
+#endif
+
+#if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
+        flat_unordered_set& operator=(std::initializer_list<value_type> list)
+        {
+            table_.clear();
+            table_.insert_range(list.begin(), list.end());
+            return *this;
+        }
+#endif
+
+        allocator_type get_allocator() const
+        {
+            return table_.value_alloc();
+        }
+
+        // size and capacity
+
+        bool empty() const
+        {
+            return table_.size_ == 0;
+        }
+
+        size_type size() const
+        {
+            return table_.size_;
+        }
+
+        size_type max_size() const
+        {
+            return table_.max_size();
+        }
+
+        // iterators
+
+        iterator begin()
+        {
+            return table_.begin();
+        }
+
+        const_iterator begin() const
+        {
+            return table_.begin();
+        }
+
+        iterator end()
+        {
+            return table_.end();
+        }
+
+        const_iterator end() const
+        {
+            return table_.end();
+        }
+
+        const_iterator cbegin() const
+        {
+            return table_.begin();
+        }
+
+        const_iterator cend() const
+        {
+            return table_.end();
+        }
+
+        // modifiers
+
+        std::pair<iterator, bool> insert(value_type const& x)
+        {
+            return table_.insert_unique(x, x);
+        }
+
+        std::pair<iterator, bool> insert(BOOST_RV_REF(value_type) x)
+        {
+            return table_.insert_unique(x, boost::move(x));
+        }
+
+        iterator insert(const_iterator, value_type const& x)
+        {
+            return this->insert(x).first;
+        }
+
+        iterator insert(const_iterator, BOOST_RV_REF(value_type) x)
+        {
+            return this->insert(boost::move(x)).first;
+        }
+
+        template <class InputIt> void insert(InputIt first, InputIt last)
+        {
+            table_.insert_range(first, last);
+        }
+
+#if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
+        void insert(std::initializer_list<value_type> list)
+        {
+            table_.insert_range(list.begin(), list.end());
+        }
+#endif
+
+        iterator erase(const_iterator position)
+        {
+            return table_.erase(position);
+        }
+
+        size_type erase(const key_type& k)
+        {
+            return table_.erase_key(k);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            return table_.erase_range(first, last);
+        }
+
+        // Doesn't find the next element, which is a linear search when the
+        // table is sparse.
+        void quick_erase(const_iterator position)
+        {
+            table_.erase_index(table_.index_of(position));
+        }
+
+        void erase_return_void(const_iterator position)
+        {
+            quick_erase(position);
+        }
+
+        void clear()
+        {
+            table_.clear();
+        }
+
+        void swap(flat_unordered_set& other)
+        {
+            table_.swap(other.table_);
+        }
+
+        // observers
+
+        hasher hash_function() const
+        {
+            return table_.hash_function();
+        }
+
+        key_equal key_eq() const
+        {
+            return table_.key_eq();
+        }
+
+        // lookup
+
+        iterator find(const key_type& k)
+        {
+            return table_.find_node(k);
+        }
+
+        const_iterator find(const key_type& k) const
+        {
+            return table_.find_node(k);
+        }
+
+        size_type count(const key_type& k) const
+        {
+            return table_.find_node(k) != table_.end() ? 1 : 0;
+        }
+
+        std::pair<iterator, iterator> equal_range(const key_type& k)
+        {
+            iterator first = table_.find_node(k);
+            iterator last = first;
+            if (last != table_.end()) ++last;
+            return std::make_pair(first, last);
+        }
+
+        std::pair<const_iterator, const_iterator>
+            equal_range(const key_type& k) const
+        {
+            const_iterator first = table_.find_node(k);
+            const_iterator last = first;
+            if (last != const_iterator(table_.end())) ++last;
+            return std::make_pair(first, last);
+        }
+
+        // hash policy
+        //
+        // There are no buckets as such, bucket_count is the number of slots
+        // in the array.
+
+        size_type bucket_count() const
+        {
+            return table_.capacity();
+        }
+
+        float max_load_factor() const
+        {
+            return table_.max_load_factor();
+        }
+
+        // The maximum load factor is fixed, so this does nothing.
+        void max_load_factor(float)
+        {
+        }
+
+        float load_factor() const
+        {
+            return table_.load_factor();
+        }
+
+        void rehash(size_type n)
+        {
+            table_.rehash(n);
+        }
+
+        void reserve(size_type n)
+        {
+            table_.reserve(n);
+        }
+
+        friend bool operator==<T,H,P,A>(
+                flat_unordered_set const&, flat_unordered_set const&);
+        friend bool operator!=<T,H,P,A>(
+                flat_unordered_set const&, flat_unordered_set const&);
+    }; // class template flat_unordered_set
+
+    template <class T, class H, class P, class A>
+    inline bool operator==(
+            flat_unordered_set<T,H,P,A> const& m1,
+            flat_unordered_set<T,H,P,A> const& m2)
+    {
+        return m1.table_.equals(m2.table_);
+    }
+
+    template <class T, class H, class P, class A>
+    inline bool operator!=(
+            flat_unordered_set<T,H,P,A> const& m1,
+            flat_unordered_set<T,H,P,A> const& m2)
+    {
+        return !m1.table_.equals(m2.table_);
+    }
+
+    template <class T, class H, class P, class A>
+    inline void swap(
+            flat_unordered_set<T,H,P,A> &m1,
+            flat_unordered_set<T,H,P,A> &m2)
+    {
+        m1.swap(m2);
+    }
+
+} // namespace unordered
+} // namespace boost
+
+#endif // BOOST_UNORDERED_FLAT_UNORDERED_SET_HPP_INCLUDED
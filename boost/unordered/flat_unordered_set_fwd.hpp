@@ -0,0 +1,42 @@
+// Copyright (C) 2012 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNORDERED_FLAT_UNORDERED_SET_FWD_HPP_INCLUDED
+#define BOOST_UNORDERED_FLAT_UNORDERED_SET_FWD_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <boost/config.hpp>
+#include <memory>
+#include <functional>
+#include <boost/functional/hash_fwd.hpp>
+#include <boost/unordered/detail/fwd.hpp>
+
+namespace boost
+{
+    namespace unordered
+    {
+        template <class T,
+            class H = boost::hash<T>,
+            class P = std::equal_to<T>,
+            class A = std::allocator<T> >
+        class flat_unordered_set;
+
+        template <class T, class H, class P, class A>
+        inline bool operator==(flat_unordered_set<T, H, P, A> const&,
+            flat_unordered_set<T, H, P, A> const&);
+        template <class T, class H, class P, class A>
+        inline bool operator!=(flat_unordered_set<T, H, P, A> const&,
+            flat_unordered_set<T, H, P, A> const&);
+        template <class T, class H, class P, class A>
+        inline void swap(flat_unordered_set<T, H, P, A> &m1,
+                flat_unordered_set<T, H, P, A> &m2);
+    }
+
+    using boost::unordered::flat_unordered_set;
+}
+
+#endif
@@ -17,6 +17,9 @@
 #include <boost/asio/io_service.hpp>
 
 #include <sstream>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/bind.hpp>
 #include <boost/asio/deadline_timer.hpp>
@@ -324,10 +327,181 @@ void io_service_service_test()
   BOOST_CHECK(!boost::asio::has_service<test_service>(ios3));
 }
 
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+void busy_poll_timer_handler(int* count, const boost::system::error_code&)
+{
+  ++(*count);
+}
+
+void busy_poll_locked_increment(boost::mutex* m, int* count)
+{
+  boost::mutex::scoped_lock lock(*m);
+  ++(*count);
+}
+
+void io_service_busy_poll_test()
+{
+  io_service ios;
+  BOOST_CHECK(ios.busy_poll_duration() == BOOST_ASIO_BUSY_POLL_USEC);
+
+  // Handlers posted from another thread while run() is polling should be
+  // picked up without the thread blocking.
+  ios.busy_poll_duration(5000000);
+  BOOST_CHECK(ios.busy_poll_duration() == 5000000);
+
+  int count = 0;
+  {
+    io_service::work w(ios);
+    boost::thread t(boost::bind(io_service_run, &ios));
+    for (int i = 0; i < 10; ++i)
+    {
+      boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+      ios.post(boost::bind(increment, &count));
+    }
+    ios.post(boost::bind(&io_service::stop, &ios));
+    t.join();
+  }
+
+  BOOST_CHECK(count == 10);
+  BOOST_CHECK(ios.busy_poll_hit_count() >= 10);
+
+  // When nothing happens within the polling duration, the thread blocks.
+  ios.reset();
+  ios.busy_poll_duration(1000);
+  std::size_t parks = ios.busy_poll_park_count();
+  deadline_timer timer(ios, boost::posix_time::milliseconds(100));
+  timer.async_wait(boost::bind(busy_poll_timer_handler, &count, _1));
+  ios.run();
+
+  BOOST_CHECK(count == 11);
+  BOOST_CHECK(ios.busy_poll_park_count() > parks);
+
+  // Several threads polling the same io_service.
+  ios.reset();
+  ios.busy_poll_duration(200);
+  count = 0;
+  boost::mutex count_mutex;
+  {
+    boost::scoped_ptr<io_service::work> w(new io_service::work(ios));
+    boost::thread t1(boost::bind(io_service_run, &ios));
+    boost::thread t2(boost::bind(io_service_run, &ios));
+    for (int i = 0; i < 1000; ++i)
+    {
+      if ((i % 100) == 0)
+        boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+      ios.post(boost::bind(busy_poll_locked_increment, &count_mutex, &count));
+    }
+    w.reset();
+    t1.join();
+    t2.join();
+  }
+
+  BOOST_CHECK(count == 1000);
+
+  // A duration of zero disables busy-polling.
+  ios.reset();
+  count = 0;
+  ios.busy_poll_duration(0);
+  std::size_t hits = ios.busy_poll_hit_count();
+  parks = ios.busy_poll_park_count();
+  timer.expires_from_now(boost::posix_time::milliseconds(10));
+  timer.async_wait(boost::bind(busy_poll_timer_handler, &count, _1));
+  ios.run();
+
+  BOOST_CHECK(count == 1);
+  BOOST_CHECK(ios.busy_poll_hit_count() == hits);
+  BOOST_CHECK(ios.busy_poll_park_count() == parks);
+}
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+struct post_then_wait_state
+{
+  boost::mutex mutex;
+  boost::condition_variable condition;
+  bool ran;
+};
+
+void post_then_wait_signal(post_then_wait_state* state)
+{
+  boost::mutex::scoped_lock lock(state->mutex);
+  state->ran = true;
+  state->condition.notify_all();
+}
+
+void post_then_wait(io_service* ios, post_then_wait_state* state)
+{
+  // The posted handler is queued on this thread, which then blocks until it
+  // has run, so another thread has to steal it.
+  ios->post(boost::bind(post_then_wait_signal, state));
+
+  boost::mutex::scoped_lock lock(state->mutex);
+  boost::system_time deadline = boost::get_system_time()
+    + boost::posix_time::seconds(5);
+  while (!state->ran)
+    if (!state->condition.timed_wait(lock, deadline))
+      break;
+  BOOST_CHECK(state->ran);
+}
+
+void stop_reset_then_post(io_service* ios, int* count)
+{
+  // Stopping marks the local queue of this thread as stopped, and resetting
+  // must clear that again for the posted handler to run.
+  ios->stop();
+  ios->reset();
+  ios->post(boost::bind(increment, count));
+}
+
+void io_service_work_stealing_test()
+{
+  io_service ios;
+
+  int count = 0;
+  ios.post(boost::bind(stop_reset_then_post, &ios, &count));
+  ios.run();
+  BOOST_CHECK(count == 1);
+
+  // A handler that waits for a handler it posted itself must not deadlock,
+  // whether the other thread is idle or running the reactor. The reactor is
+  // only created once the timer is, halfway through.
+  boost::scoped_ptr<deadline_timer> timer;
+  for (int i = 0; i < 40; ++i)
+  {
+    if (i == 20)
+      timer.reset(new deadline_timer(ios));
+
+    post_then_wait_state state;
+    state.ran = false;
+
+    ios.reset();
+    {
+      boost::scoped_ptr<io_service::work> w(new io_service::work(ios));
+      boost::thread t1(boost::bind(io_service_run, &ios));
+      boost::thread t2(boost::bind(io_service_run, &ios));
+      if (i % 2)
+        boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+      ios.post(boost::bind(post_then_wait, &ios, &state));
+      w.reset();
+      t1.join();
+      t2.join();
+    }
+
+    BOOST_CHECK(state.ran);
+  }
+}
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
+
 test_suite* init_unit_test_suite(int, char*[])
 {
   test_suite* test = BOOST_TEST_SUITE("io_service");
   test->add(BOOST_TEST_CASE(&io_service_test));
   test->add(BOOST_TEST_CASE(&io_service_service_test));
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+  test->add(BOOST_TEST_CASE(&io_service_busy_poll_test));
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+#if defined(BOOST_ASIO_HAS_WORK_STEALING)
+  test->add(BOOST_TEST_CASE(&io_service_work_stealing_test));
+#endif // defined(BOOST_ASIO_HAS_WORK_STEALING)
   return test;
 }
@@ -21,7 +21,11 @@
 
 #include <boost/array.hpp>
 #include <boost/bind.hpp>
+#include <cstdio>
 #include <cstring>
+#include <vector>
+#include <boost/thread/thread.hpp>
+#include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/placeholders.hpp>
 #include <boost/asio/read.hpp>
@@ -325,6 +329,12 @@ void test()
     socket1.async_send(const_buffers, in_flags, &send_handler);
     socket1.async_send(null_buffers(), in_flags, &send_handler);
 
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+    socket1.send_file(0, 0, 0);
+    socket1.send_file(0, 0, 0, ec);
+    socket1.async_send_file(0, 0, 0, &send_handler);
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
     socket1.receive(buffer(mutable_char_buffer));
     socket1.receive(mutable_buffers);
     socket1.receive(null_buffers());
@@ -437,6 +447,70 @@ void handle_read_eof(const boost::system::error_code& err,
   BOOST_CHECK(bytes_transferred == 0);
 }
 
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+void handle_read_file(const boost::system::error_code& err,
+    size_t bytes_transferred, size_t expected_bytes, bool* called)
+{
+  *called = true;
+  BOOST_CHECK(!err);
+  BOOST_CHECK(bytes_transferred == expected_bytes);
+}
+
+void handle_send_file(const boost::system::error_code& err,
+    size_t bytes_transferred, size_t expected_bytes, bool* called)
+{
+  *called = true;
+  BOOST_CHECK(!err);
+  BOOST_CHECK(bytes_transferred == expected_bytes);
+}
+
+void handle_send_file_eof(const boost::system::error_code& err,
+    size_t bytes_transferred, size_t expected_bytes, bool* called)
+{
+  *called = true;
+  BOOST_CHECK(err == boost::asio::error::eof);
+  BOOST_CHECK(bytes_transferred == expected_bytes);
+}
+
+void handle_send_file_cancel(const boost::system::error_code& err,
+    size_t bytes_transferred, bool* called)
+{
+  *called = true;
+  BOOST_CHECK(err == boost::asio::error::operation_aborted);
+  BOOST_CHECK(bytes_transferred == 0);
+}
+
+void write_pipe(int fd, const char* data, size_t length)
+{
+  BOOST_CHECK(::write(fd, data, length) == static_cast<int>(length));
+}
+
+void cancel_socket(boost::asio::ip::tcp::socket* s)
+{
+  s->cancel();
+}
+
+struct send_file_result
+{
+  int calls;
+  boost::system::error_code ec;
+  size_t bytes_transferred;
+};
+
+void handle_send_file_result(const boost::system::error_code& err,
+    size_t bytes_transferred, send_file_result* result)
+{
+  ++result->calls;
+  result->ec = err;
+  result->bytes_transferred = bytes_transferred;
+}
+
+void run_io_service(boost::asio::io_service* ios)
+{
+  ios->run();
+}
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
 void test()
 {
   using namespace std; // For memcmp.
@@ -507,6 +581,184 @@ void test()
   BOOST_CHECK(write_completed);
   BOOST_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
 
+#if defined(BOOST_ASIO_HAS_SEND_FILE)
+  // Send a region of a file. The region is large enough that the socket's
+  // send buffer fills up and the operation has to continue after a partial
+  // write.
+
+  server_side_socket.set_option(socket_base::send_buffer_size(8192));
+  std::vector<char> file_data(1024 * 1024);
+  for (size_t i = 0; i < file_data.size(); ++i)
+    file_data[i] = static_cast<char>(i % 251);
+  FILE* file = tmpfile();
+  BOOST_CHECK(file != 0);
+  BOOST_CHECK(fwrite(&file_data[0], 1, file_data.size(), file)
+      == file_data.size());
+  fflush(file);
+  int fd = fileno(file);
+
+  size_t file_offset = 1000;
+  size_t file_region = file_data.size() - 2 * file_offset;
+  std::vector<char> file_read_buffer(file_region);
+  read_completed = false;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(file_read_buffer),
+      boost::bind(handle_read_file,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred,
+        file_region, &read_completed));
+
+  bool send_file_completed = false;
+  server_side_socket.async_send_file(fd, file_offset, file_region,
+      boost::bind(handle_send_file,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred,
+        file_region, &send_file_completed));
+
+  ios.reset();
+  ios.run();
+  BOOST_CHECK(read_completed);
+  BOOST_CHECK(send_file_completed);
+  BOOST_CHECK(memcmp(&file_read_buffer[0],
+        &file_data[file_offset], file_region) == 0);
+
+  // A region that extends past the end of the file fails with eof once the
+  // available data has been sent.
+
+  boost::system::error_code file_ec;
+  size_t file_bytes = server_side_socket.send_file(fd,
+      file_data.size() - 10, 100, file_ec);
+  BOOST_CHECK(file_ec == boost::asio::error::eof);
+  BOOST_CHECK(file_bytes == 10);
+  BOOST_CHECK(boost::asio::read(client_side_socket,
+        boost::asio::buffer(read_buffer, 10)) == 10);
+  BOOST_CHECK(memcmp(read_buffer, &file_data[file_data.size() - 10], 10) == 0);
+
+  send_file_completed = false;
+  server_side_socket.async_send_file(fd, file_data.size() - 10, 100,
+      boost::bind(handle_send_file_eof,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred,
+        10, &send_file_completed));
+
+  ios.reset();
+  ios.run();
+  BOOST_CHECK(send_file_completed);
+  BOOST_CHECK(boost::asio::read(client_side_socket,
+        boost::asio::buffer(read_buffer, 10)) == 10);
+
+  // The contents of a pipe are sent as they arrive. While the pipe is empty
+  // the operation waits for it to be refilled, not for the socket.
+
+  int pipe_fds[2];
+  BOOST_CHECK(::pipe(pipe_fds) == 0);
+
+  read_completed = false;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(file_read_buffer, 2000),
+      boost::bind(handle_read_file,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred,
+        2000, &read_completed));
+
+  send_file_completed = false;
+  server_side_socket.async_send_file(pipe_fds[0], 0, 2000,
+      boost::bind(handle_send_file,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred,
+        2000, &send_file_completed));
+
+  deadline_timer pipe_timer1(ios, boost::posix_time::milliseconds(50));
+  pipe_timer1.async_wait(boost::bind(write_pipe,
+        pipe_fds[1], &file_data[0], 1000));
+  deadline_timer pipe_timer2(ios, boost::posix_time::milliseconds(100));
+  pipe_timer2.async_wait(boost::bind(write_pipe,
+        pipe_fds[1], &file_data[1000], 1000));
+
+  ios.reset();
+  ios.run();
+  BOOST_CHECK(read_completed);
+  BOOST_CHECK(send_file_completed);
+  BOOST_CHECK(memcmp(&file_read_buffer[0], &file_data[0], 2000) == 0);
+
+  // Cancelling the socket aborts an operation waiting for an empty pipe.
+
+  send_file_completed = false;
+  server_side_socket.async_send_file(pipe_fds[0], 0, 2000,
+      boost::bind(handle_send_file_cancel,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred,
+        &send_file_completed));
+
+  deadline_timer cancel_timer(ios, boost::posix_time::milliseconds(50));
+  cancel_timer.async_wait(boost::bind(cancel_socket, &server_side_socket));
+
+  ios.reset();
+  ios.run();
+  BOOST_CHECK(send_file_completed);
+
+  ::close(pipe_fds[0]);
+  ::close(pipe_fds[1]);
+
+  // Cancelling the socket while the operation is completing, because the
+  // pipe has just been refilled, either aborts the operation or lets it
+  // finish, and the handler is called once either way.
+
+  for (int i = 0; i < 200; ++i)
+  {
+    BOOST_CHECK(::pipe(pipe_fds) == 0);
+    write_pipe(pipe_fds[1], &file_data[0], 100);
+
+    send_file_result result = { 0, boost::system::error_code(), 0 };
+    server_side_socket.async_send_file(pipe_fds[0], 0, 200,
+        boost::bind(handle_send_file_result,
+          boost::asio::placeholders::error,
+          boost::asio::placeholders::bytes_transferred,
+          &result));
+
+    ios.reset();
+    boost::thread runner(boost::bind(run_io_service, &ios));
+    boost::this_thread::sleep(boost::posix_time::microseconds(i % 10 * 100));
+    write_pipe(pipe_fds[1], &file_data[100], 100);
+    if (i % 3)
+      server_side_socket.cancel();
+    runner.join();
+
+    BOOST_CHECK(result.calls == 1);
+    BOOST_CHECK(!result.ec
+        || result.ec == boost::asio::error::operation_aborted);
+    BOOST_CHECK(result.ec || result.bytes_transferred == 200);
+    if (result.bytes_transferred > 0)
+    {
+      BOOST_CHECK(boost::asio::read(client_side_socket,
+            boost::asio::buffer(file_read_buffer, result.bytes_transferred))
+          == result.bytes_transferred);
+    }
+
+    ::close(pipe_fds[0]);
+    ::close(pipe_fds[1]);
+  }
+
+  // Sending to a connection that has been closed by the peer fails without
+  // raising SIGPIPE.
+
+  {
+    ip::tcp::socket sender(ios);
+    ip::tcp::socket receiver(ios);
+    sender.connect(server_endpoint);
+    acceptor.accept(receiver);
+    receiver.close();
+
+    boost::system::error_code pipe_ec;
+    for (int i = 0; i < 100 && !pipe_ec; ++i)
+      sender.send_file(fd, 0, file_data.size(), pipe_ec);
+    BOOST_CHECK(pipe_ec == boost::asio::error::broken_pipe
+        || pipe_ec == boost::asio::error::connection_reset);
+  }
+
+  fclose(file);
+#endif // defined(BOOST_ASIO_HAS_SEND_FILE)
+
   // Cancelled read.
 
   bool read_cancel_completed = false;
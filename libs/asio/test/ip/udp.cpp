@@ -16,8 +16,10 @@
 // Test that header file is self-contained.
 #include <boost/asio/ip/udp.hpp>
 
+#include <boost/array.hpp>
 #include <boost/bind.hpp>
 #include <cstring>
+#include <vector>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/placeholders.hpp>
 #include "../unit_test.hpp"
@@ -299,6 +301,35 @@ void test()
         endpoint, in_flags, &receive_handler);
     socket1.async_receive_from(null_buffers(),
         endpoint, in_flags, &receive_handler);
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+    ip::udp::endpoint endpoints[2];
+    std::size_t sizes[2];
+    boost::array<mutable_buffer, 2> mutable_buffers = {{
+      buffer(mutable_char_buffer), buffer(mutable_char_buffer) }};
+    boost::array<const_buffer, 2> const_buffers = {{
+      buffer(const_char_buffer), buffer(const_char_buffer) }};
+
+    socket1.send_to_batch(mutable_buffers, endpoints);
+    socket1.send_to_batch(const_buffers, endpoints);
+    socket1.send_to_batch(const_buffers, endpoints, in_flags);
+    socket1.send_to_batch(const_buffers, endpoints, in_flags, ec);
+
+    socket1.async_send_to_batch(mutable_buffers, endpoints, &send_handler);
+    socket1.async_send_to_batch(const_buffers, endpoints, &send_handler);
+    socket1.async_send_to_batch(const_buffers, endpoints,
+        in_flags, &send_handler);
+
+    socket1.receive_from_batch(mutable_buffers, endpoints, sizes);
+    socket1.receive_from_batch(mutable_buffers, endpoints, sizes, in_flags);
+    socket1.receive_from_batch(mutable_buffers,
+        endpoints, sizes, in_flags, ec);
+
+    socket1.async_receive_from_batch(mutable_buffers,
+        endpoints, sizes, &receive_handler);
+    socket1.async_receive_from_batch(mutable_buffers,
+        endpoints, sizes, in_flags, &receive_handler);
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
   }
   catch (std::exception&)
   {
@@ -329,6 +360,22 @@ void handle_recv(size_t expected_bytes_recvd,
   BOOST_CHECK(expected_bytes_recvd == bytes_recvd);
 }
 
+void handle_send_batch(const boost::system::error_code& err,
+    size_t messages_sent)
+{
+  BOOST_CHECK(!err);
+  BOOST_CHECK(messages_sent > 0);
+}
+
+void handle_recv_batch(const size_t* sizes,
+    const boost::system::error_code& err, size_t messages_recvd)
+{
+  BOOST_CHECK(!err);
+  BOOST_CHECK(messages_recvd > 0);
+  for (size_t i = 0; i < messages_recvd; ++i)
+    BOOST_CHECK(sizes[i] == i + 1);
+}
+
 void test()
 {
   using namespace std; // For memcmp and memset.
@@ -370,6 +417,67 @@ void test()
   ios.run();
 
   BOOST_CHECK(memcmp(send_msg, recv_msg, sizeof(send_msg)) == 0);
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+  const size_t batch_size = 4;
+  char batch_recv_msgs[batch_size][sizeof(send_msg)];
+  boost::array<const_buffer, batch_size> send_bufs;
+  boost::array<mutable_buffer, batch_size> recv_bufs;
+  ip::udp::endpoint destinations[batch_size];
+  ip::udp::endpoint senders[batch_size];
+  size_t sizes[batch_size];
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    send_bufs[i] = buffer(send_msg, i + 1);
+    recv_bufs[i] = buffer(batch_recv_msgs[i]);
+    destinations[i] = s1.local_endpoint();
+    destinations[i].address(ip::address_v4::loopback());
+    sizes[i] = 0;
+  }
+
+  size_t messages_sent = 0;
+  while (messages_sent < batch_size)
+    messages_sent += s2.send_to_batch(
+        std::vector<const_buffer>(
+          send_bufs.begin() + messages_sent, send_bufs.end()),
+        destinations + messages_sent);
+
+  size_t messages_recvd = 0;
+  while (messages_recvd < batch_size)
+  {
+    size_t n = s1.receive_from_batch(
+        std::vector<mutable_buffer>(
+          recv_bufs.begin() + messages_recvd, recv_bufs.end()),
+        senders + messages_recvd, sizes + messages_recvd);
+    BOOST_CHECK(n > 0);
+    messages_recvd += n;
+  }
+
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    BOOST_CHECK(sizes[i] == i + 1);
+    BOOST_CHECK(memcmp(send_msg, batch_recv_msgs[i], i + 1) == 0);
+    BOOST_CHECK(senders[i].port() == s2.local_endpoint().port());
+  }
+
+  ios.reset();
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    destinations[i] = s2.local_endpoint();
+    destinations[i].address(ip::address_v4::loopback());
+  }
+
+  s2.async_receive_from_batch(recv_bufs, senders, sizes,
+      boost::bind(handle_recv_batch, sizes,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred));
+  s1.async_send_to_batch(send_bufs, destinations,
+      boost::bind(handle_send_batch,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred));
+
+  ios.run();
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
 }
 
 } // namespace ip_udp_socket_runtime
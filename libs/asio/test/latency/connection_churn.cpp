@@ -0,0 +1,198 @@
+//
+// connection_churn.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using boost::asio::ip::tcp;
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// Shared by all of the connections.
+struct churn_state
+{
+  churn_state(boost::asio::io_service& io_service, long connections)
+    : acceptor(io_service,
+        tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)),
+      acceptor_strand(io_service),
+      remaining(connections),
+      completed(0),
+      total(connections)
+  {
+  }
+
+  tcp::acceptor acceptor;
+  boost::asio::io_service::strand acceptor_strand;
+  boost::mutex mutex;
+  long remaining;
+  long completed;
+  long total;
+  ptime stop;
+};
+
+// Keeps an accept outstanding and closes every connection as soon as it has
+// been accepted. The acceptor is shared, so its handlers run in a strand.
+class acceptor_loop
+{
+public:
+  acceptor_loop(boost::asio::io_service& io_service, churn_state& state)
+    : state_(state),
+      socket_(io_service)
+  {
+  }
+
+  void start()
+  {
+    state_.acceptor.async_accept(socket_, state_.acceptor_strand.wrap(
+          boost::bind(&acceptor_loop::handle_accept, this, _1)));
+  }
+
+private:
+  void handle_accept(const boost::system::error_code& ec)
+  {
+    if (ec != boost::asio::error::operation_aborted
+        && state_.acceptor.is_open())
+    {
+      boost::system::error_code ignored_ec;
+      socket_.close(ignored_ec);
+      start();
+    }
+  }
+
+  churn_state& state_;
+  tcp::socket socket_;
+};
+
+// Repeatedly opens a connection and closes it again, until the shared budget
+// of connections is used up.
+class connector_loop
+{
+public:
+  connector_loop(boost::asio::io_service& io_service, churn_state& state)
+    : socket_(io_service),
+      target_(state.acceptor.local_endpoint()),
+      state_(state)
+  {
+  }
+
+  void start()
+  {
+    {
+      boost::mutex::scoped_lock lock(state_.mutex);
+      if (state_.remaining <= 0)
+        return;
+      --state_.remaining;
+    }
+
+    socket_.async_connect(target_,
+        boost::bind(&connector_loop::handle_connect, this, _1));
+  }
+
+private:
+  void handle_connect(const boost::system::error_code& ec)
+  {
+    boost::system::error_code ignored_ec;
+    if (!ec)
+    {
+      // Reset the connection on close so that no port is left in TIME_WAIT.
+      socket_.set_option(tcp::socket::linger(true, 0), ignored_ec);
+    }
+    socket_.close(ignored_ec);
+
+    {
+      // The accepts never finish by themselves, so the last connection to
+      // finish closes the acceptor.
+      boost::mutex::scoped_lock lock(state_.mutex);
+      if (++state_.completed == state_.total)
+      {
+        state_.stop = microsec_clock::universal_time();
+        state_.acceptor_strand.post(
+            boost::bind(&connector_loop::close_acceptor, &state_));
+      }
+    }
+
+    start();
+  }
+
+  static void close_acceptor(churn_state* state)
+  {
+    boost::system::error_code ignored_ec;
+    state->acceptor.close(ignored_ec);
+  }
+
+  tcp::socket socket_;
+  tcp::endpoint target_;
+  churn_state& state_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: connection_churn <nthreads> <nconnectors> <connections>\n");
+    return 1;
+  }
+
+  int num_threads = std::atoi(argv[1]);
+  int num_connectors = std::atoi(argv[2]);
+  long connections = std::atol(argv[3]);
+  if (num_threads <= 0 || num_connectors <= 0 || connections <= 0)
+  {
+    std::fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+
+  boost::asio::io_service io_service;
+  churn_state state(io_service, connections);
+  state.acceptor.listen(1024);
+
+  // One outstanding accept per thread.
+  std::vector<boost::shared_ptr<acceptor_loop> > acceptors;
+  for (int i = 0; i < num_threads; ++i)
+  {
+    boost::shared_ptr<acceptor_loop> a(new acceptor_loop(io_service, state));
+    a->start();
+    acceptors.push_back(a);
+  }
+
+  std::vector<boost::shared_ptr<connector_loop> > connectors;
+  for (int i = 0; i < num_connectors; ++i)
+  {
+    boost::shared_ptr<connector_loop> c(new connector_loop(io_service, state));
+    c->start();
+    connectors.push_back(c);
+  }
+
+  ptime start = microsec_clock::universal_time();
+
+  boost::thread_group threads;
+  for (int i = 0; i < num_threads; ++i)
+    threads.create_thread(boost::bind(&boost::asio::io_service::run,
+          &io_service));
+  threads.join_all();
+
+  double secs = (state.stop - start).total_microseconds() / 1e6;
+
+  std::printf("threads:                %d\n", num_threads);
+  std::printf("connectors:             %d\n", num_connectors);
+  std::printf("connections:            %ld\n", connections);
+  std::printf("connections per second: %f\n", connections / secs);
+
+  return 0;
+}
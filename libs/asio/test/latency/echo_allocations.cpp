@@ -0,0 +1,215 @@
+//
+// echo_allocations.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using boost::asio::ip::tcp;
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// Count every call to the global allocation functions. The program is single
+// threaded so no synchronisation is needed.
+static unsigned long allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+  ++allocation_count;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p)
+{
+  std::free(p);
+}
+
+// One end of a connection. The client end starts each round trip by writing a
+// message, and the server end echoes every message back. The server starts
+// reading the next message as soon as it starts an echo, so the operations
+// that it starts and completes are not paired up within one handler.
+class peer
+{
+public:
+  peer(boost::asio::io_service& io_service, std::size_t message_size)
+    : socket_(io_service),
+      data_(message_size),
+      echo_data_(message_size),
+      round_trips_(0),
+      limit_(0)
+  {
+  }
+
+  tcp::socket& socket()
+  {
+    return socket_;
+  }
+
+  void start_client(unsigned long limit)
+  {
+    limit_ = limit;
+    round_trips_ = 0;
+    write();
+  }
+
+  void start_server()
+  {
+    read();
+  }
+
+  unsigned long round_trips() const
+  {
+    return round_trips_;
+  }
+
+private:
+  void write()
+  {
+    boost::asio::async_write(socket_, boost::asio::buffer(data_),
+        boost::bind(&peer::handle_write, this, _1));
+  }
+
+  void handle_write(const boost::system::error_code& ec)
+  {
+    if (!ec)
+      read();
+  }
+
+  void echo()
+  {
+    echo_data_.swap(data_);
+    boost::asio::async_write(socket_, boost::asio::buffer(echo_data_),
+        boost::bind(&peer::handle_echo, this, _1));
+  }
+
+  void handle_echo(const boost::system::error_code&)
+  {
+  }
+
+  void read()
+  {
+    boost::asio::async_read(socket_, boost::asio::buffer(data_),
+        boost::bind(&peer::handle_read, this, _1));
+  }
+
+  void handle_read(const boost::system::error_code& ec)
+  {
+    if (ec)
+      return;
+
+    if (limit_ == 0)
+    {
+      echo();
+      read();
+    }
+    else if (++round_trips_ < limit_)
+      write();
+  }
+
+  tcp::socket socket_;
+  std::vector<char> data_;
+  std::vector<char> echo_data_;
+  unsigned long round_trips_;
+  unsigned long limit_;
+};
+
+// Run the given number of round trips on every connection. The servers always
+// have a read outstanding, so the io_service is driven one handler at a time
+// until the clients have finished.
+void run_round_trips(boost::asio::io_service& io_service,
+    std::vector<boost::shared_ptr<peer> >& clients, unsigned long count)
+{
+  for (std::size_t i = 0; i < clients.size(); ++i)
+    clients[i]->start_client(count);
+
+  for (;;)
+  {
+    bool done = true;
+    for (std::size_t i = 0; i < clients.size(); ++i)
+      if (clients[i]->round_trips() < count)
+        done = false;
+    if (done)
+      break;
+    io_service.run_one();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: echo_allocations <nconns> <bufsize> <roundtrips>\n");
+    return 1;
+  }
+
+  int num_connections = std::atoi(argv[1]);
+  std::size_t buf_size = static_cast<std::size_t>(std::atoi(argv[2]));
+  unsigned long round_trips = std::strtoul(argv[3], 0, 10);
+
+  boost::asio::io_service io_service;
+  tcp::acceptor acceptor(io_service,
+      tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+
+  std::vector<boost::shared_ptr<peer> > clients;
+  std::vector<boost::shared_ptr<peer> > servers;
+  for (int i = 0; i < num_connections; ++i)
+  {
+    boost::shared_ptr<peer> client(new peer(io_service, buf_size));
+    boost::shared_ptr<peer> server(new peer(io_service, buf_size));
+    client->socket().connect(acceptor.local_endpoint());
+    acceptor.accept(server->socket());
+    client->socket().set_option(tcp::no_delay(true));
+    server->socket().set_option(tcp::no_delay(true));
+    clients.push_back(client);
+    servers.push_back(server);
+  }
+
+  for (std::size_t i = 0; i < servers.size(); ++i)
+    servers[i]->start_server();
+
+  // Warm up so that one-off allocations, such as reactor registration, are
+  // not counted.
+  run_round_trips(io_service, clients, 10);
+
+  unsigned long start_allocations = allocation_count;
+  ptime start = microsec_clock::universal_time();
+
+  run_round_trips(io_service, clients, round_trips);
+
+  ptime stop = microsec_clock::universal_time();
+  unsigned long allocations = allocation_count - start_allocations;
+
+  // Each round trip is a write and a read on each end of the connection.
+  double operations = 4.0 * round_trips * num_connections;
+  double secs = (stop - start).total_microseconds() / 1e6;
+
+  std::printf("recycling:          %s\n",
+#if defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+      "disabled");
+#else
+      "enabled");
+#endif
+  std::printf("operations:         %.0f\n", operations);
+  std::printf("allocations:        %lu\n", allocations);
+  std::printf("allocations per op: %f\n", allocations / operations);
+  std::printf("ops per second:     %f\n", operations / secs);
+
+  return 0;
+}
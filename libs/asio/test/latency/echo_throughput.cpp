@@ -0,0 +1,192 @@
+//
+// echo_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+# include <boost/asio/detail/reactor.hpp>
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+using boost::asio::ip::tcp;
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// Echoes everything it receives until the connection is closed.
+class server_session
+{
+public:
+  server_session(boost::asio::io_service& io_service, std::size_t buf_size)
+    : socket_(io_service),
+      data_(buf_size)
+  {
+  }
+
+  tcp::socket& socket()
+  {
+    return socket_;
+  }
+
+  void start()
+  {
+    socket_.async_read_some(boost::asio::buffer(data_),
+        boost::bind(&server_session::handle_read, this, _1, _2));
+  }
+
+private:
+  void handle_read(const boost::system::error_code& ec, std::size_t n)
+  {
+    if (!ec)
+    {
+      boost::asio::async_write(socket_, boost::asio::buffer(data_, n),
+          boost::bind(&server_session::handle_write, this, _1));
+    }
+  }
+
+  void handle_write(const boost::system::error_code& ec)
+  {
+    if (!ec)
+      start();
+  }
+
+  tcp::socket socket_;
+  std::vector<char> data_;
+};
+
+// Sends a message and waits for it to be echoed back, until the shared round
+// trip budget is used up.
+class client_session
+{
+public:
+  client_session(boost::asio::io_service& io_service,
+      std::size_t message_size, long* remaining)
+    : socket_(io_service),
+      data_(message_size),
+      remaining_(remaining)
+  {
+  }
+
+  tcp::socket& socket()
+  {
+    return socket_;
+  }
+
+  void start()
+  {
+    if (*remaining_ > 0)
+    {
+      --*remaining_;
+      boost::asio::async_write(socket_, boost::asio::buffer(data_),
+          boost::bind(&client_session::handle_write, this, _1));
+    }
+    else
+    {
+      boost::system::error_code ignored_ec;
+      socket_.shutdown(tcp::socket::shutdown_both, ignored_ec);
+    }
+  }
+
+private:
+  void handle_write(const boost::system::error_code& ec)
+  {
+    if (!ec)
+    {
+      boost::asio::async_read(socket_, boost::asio::buffer(data_),
+          boost::bind(&client_session::handle_read, this, _1));
+    }
+  }
+
+  void handle_read(const boost::system::error_code& ec)
+  {
+    if (!ec)
+      start();
+  }
+
+  tcp::socket socket_;
+  std::vector<char> data_;
+  long* remaining_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: echo_throughput <nconns> <bufsize> <roundtrips>\n");
+    return 1;
+  }
+
+  int num_connections = std::atoi(argv[1]);
+  std::size_t buf_size = static_cast<std::size_t>(std::atoi(argv[2]));
+  long round_trips = std::atol(argv[3]);
+  if (num_connections <= 0 || buf_size == 0 || round_trips <= 0)
+  {
+    std::fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+
+  boost::asio::io_service io_service;
+  tcp::acceptor acceptor(io_service,
+      tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+
+  long remaining = round_trips;
+  std::vector<boost::shared_ptr<client_session> > clients;
+  std::vector<boost::shared_ptr<server_session> > servers;
+  for (int i = 0; i < num_connections; ++i)
+  {
+    boost::shared_ptr<client_session> client(
+        new client_session(io_service, buf_size, &remaining));
+    boost::shared_ptr<server_session> server(
+        new server_session(io_service, buf_size));
+    client->socket().connect(acceptor.local_endpoint());
+    acceptor.accept(server->socket());
+    client->socket().set_option(tcp::no_delay(true));
+    server->socket().set_option(tcp::no_delay(true));
+    clients.push_back(client);
+    servers.push_back(server);
+  }
+
+  for (std::size_t i = 0; i < servers.size(); ++i)
+    servers[i]->start();
+  for (std::size_t i = 0; i < clients.size(); ++i)
+    clients[i]->start();
+
+  // The clients shut down their connections once the budget is used up, so
+  // that the servers' reads complete and the io_service runs out of work.
+  ptime start = microsec_clock::universal_time();
+  io_service.run();
+  ptime stop = microsec_clock::universal_time();
+
+  const char* backend = "reactor";
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  if (boost::asio::use_service<boost::asio::detail::reactor>(
+        io_service).uses_io_uring())
+    backend = "io_uring";
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+  double secs = (stop - start).total_microseconds() / 1e6;
+
+  std::printf("backend:                %s\n", backend);
+  std::printf("connections:            %d\n", num_connections);
+  std::printf("message size:           %lu\n",
+      static_cast<unsigned long>(buf_size));
+  std::printf("round trips:            %ld\n", round_trips);
+  std::printf("round trips per second: %f\n", round_trips / secs);
+  std::printf("usec per round trip:    %f\n", secs * 1e6 / round_trips);
+
+  return 0;
+}
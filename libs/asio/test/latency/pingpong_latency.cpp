@@ -0,0 +1,218 @@
+//
+// pingpong_latency.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/ip/udp.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "high_res_clock.hpp"
+
+using boost::asio::ip::udp;
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// Sends every datagram it receives back to where it came from, on an
+// io_service of its own.
+class echo_server
+{
+public:
+  echo_server(boost::asio::io_service& io_service, std::size_t buf_size)
+    : socket_(io_service,
+        udp::endpoint(boost::asio::ip::address_v4::loopback(), 0)),
+      data_(buf_size)
+  {
+  }
+
+  udp::endpoint local_endpoint() const
+  {
+    return socket_.local_endpoint();
+  }
+
+  void start()
+  {
+    socket_.async_receive_from(boost::asio::buffer(data_), sender_,
+        boost::bind(&echo_server::handle_receive, this, _1, _2));
+  }
+
+  void close()
+  {
+    socket_.close();
+  }
+
+private:
+  void handle_receive(const boost::system::error_code& ec, std::size_t n)
+  {
+    if (!ec)
+    {
+      socket_.async_send_to(boost::asio::buffer(data_, n), sender_,
+          boost::bind(&echo_server::handle_send, this, _1));
+    }
+  }
+
+  void handle_send(const boost::system::error_code& ec)
+  {
+    if (!ec)
+      start();
+  }
+
+  udp::socket socket_;
+  udp::endpoint sender_;
+  std::vector<char> data_;
+};
+
+// Sends one datagram at a time and times how long it takes for it to come
+// back, until the required number of samples has been taken.
+class pinger
+{
+public:
+  pinger(boost::asio::io_service& io_service, std::size_t buf_size,
+      const udp::endpoint& target, std::vector<boost::uint64_t>& samples)
+    : socket_(io_service,
+        udp::endpoint(boost::asio::ip::address_v4::loopback(), 0)),
+      target_(target),
+      data_(buf_size),
+      samples_(samples),
+      count_(0),
+      start_(0)
+  {
+  }
+
+  void start()
+  {
+    start_ = high_res_clock();
+    socket_.async_send_to(boost::asio::buffer(data_), target_,
+        boost::bind(&pinger::handle_send, this, _1));
+  }
+
+private:
+  void handle_send(const boost::system::error_code& ec)
+  {
+    if (!ec)
+    {
+      socket_.async_receive(boost::asio::buffer(data_),
+          boost::bind(&pinger::handle_receive, this, _1));
+    }
+  }
+
+  void handle_receive(const boost::system::error_code& ec)
+  {
+    if (!ec)
+    {
+      samples_[count_] = high_res_clock() - start_;
+      if (++count_ < samples_.size())
+        start();
+    }
+  }
+
+  udp::socket socket_;
+  udp::endpoint target_;
+  std::vector<char> data_;
+  std::vector<boost::uint64_t>& samples_;
+  std::size_t count_;
+  boost::uint64_t start_;
+};
+
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+void print_busy_poll_stats(const char* name,
+    boost::asio::io_service& io_service)
+{
+  std::printf("%s busy-poll hits:  %lu\n", name,
+      static_cast<unsigned long>(io_service.busy_poll_hit_count()));
+  std::printf("%s busy-poll parks: %lu\n", name,
+      static_cast<unsigned long>(io_service.busy_poll_park_count()));
+}
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: pingpong_latency <roundtrips> <bufsize> <busypollusec>\n");
+    return 1;
+  }
+
+  std::size_t num_samples = static_cast<std::size_t>(std::atol(argv[1]));
+  std::size_t buf_size = static_cast<std::size_t>(std::atoi(argv[2]));
+  long busy_poll_usec = std::atol(argv[3]);
+  if (num_samples < 1000 || buf_size == 0)
+  {
+    std::fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+
+  // Each side has an io_service and a thread of its own, so that every
+  // message has to wake the thread at the other end.
+  boost::asio::io_service server_io_service(1);
+  boost::asio::io_service client_io_service(1);
+
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+  server_io_service.busy_poll_duration(busy_poll_usec);
+  client_io_service.busy_poll_duration(busy_poll_usec);
+#else // defined(BOOST_ASIO_HAS_BUSY_POLL)
+  if (busy_poll_usec != 0)
+    std::fprintf(stderr, "Busy-polling is not enabled, ignoring duration\n");
+  busy_poll_usec = 0;
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+
+  echo_server server(server_io_service, buf_size);
+  server.start();
+  boost::thread server_thread(
+      boost::bind(&boost::asio::io_service::run, &server_io_service));
+
+  std::vector<boost::uint64_t> samples(num_samples);
+  pinger client(client_io_service, buf_size,
+      server.local_endpoint(), samples);
+
+  ptime start = microsec_clock::universal_time();
+  boost::uint64_t start_hr = high_res_clock();
+
+  client.start();
+  client_io_service.run();
+
+  ptime stop = microsec_clock::universal_time();
+  boost::uint64_t stop_hr = high_res_clock();
+  boost::uint64_t elapsed_usec = (stop - start).total_microseconds();
+  boost::uint64_t elapsed_hr = stop_hr - start_hr;
+  double scale = 1.0 * elapsed_usec / elapsed_hr;
+
+  server_io_service.post(boost::bind(&echo_server::close, &server));
+  server_thread.join();
+
+  std::printf("busy-poll usec:  %ld\n", busy_poll_usec);
+  std::printf("message size:    %lu\n", static_cast<unsigned long>(buf_size));
+  std::printf("round trips:     %lu\n",
+      static_cast<unsigned long>(num_samples));
+
+  std::sort(samples.begin(), samples.end());
+  std::printf("  0.0%%\t%f\n", samples[0] * scale);
+  std::printf("  1.0%%\t%f\n", samples[num_samples / 100 - 1] * scale);
+  std::printf(" 10.0%%\t%f\n", samples[num_samples / 10 - 1] * scale);
+  std::printf(" 50.0%%\t%f\n", samples[num_samples * 5 / 10 - 1] * scale);
+  std::printf(" 90.0%%\t%f\n", samples[num_samples * 9 / 10 - 1] * scale);
+  std::printf(" 99.0%%\t%f\n", samples[num_samples * 99 / 100 - 1] * scale);
+  std::printf(" 99.9%%\t%f\n", samples[num_samples * 999 / 1000 - 1] * scale);
+  std::printf("100.0%%\t%f\n", samples[num_samples - 1] * scale);
+
+  double total = 0.0;
+  for (std::size_t i = 0; i < num_samples; ++i) total += samples[i] * scale;
+  std::printf("  mean\t%f\n", total / num_samples);
+
+#if defined(BOOST_ASIO_HAS_BUSY_POLL)
+  print_busy_poll_stats("client", client_io_service);
+  print_busy_poll_stats("server", server_io_service);
+#endif // defined(BOOST_ASIO_HAS_BUSY_POLL)
+
+  return 0;
+}
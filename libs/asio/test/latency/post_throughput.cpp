@@ -0,0 +1,112 @@
+//
+// post_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/io_service.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// Each chain posts its successor from within a handler, so all of the posting
+// happens on the threads that are running the io_service. Every fanout'th
+// link also posts a short-lived extra handler to give idle threads something
+// to pick up.
+class chain
+{
+public:
+  chain(boost::asio::io_service& io_service, int length, int fanout)
+    : io_service_(io_service),
+      remaining_(length),
+      fanout_(fanout)
+  {
+  }
+
+  void start()
+  {
+    io_service_.post(boost::bind(&chain::next, this));
+  }
+
+private:
+  void next()
+  {
+    if (--remaining_ > 0)
+    {
+      io_service_.post(boost::bind(&chain::next, this));
+      if (fanout_ > 0 && remaining_ % fanout_ == 0)
+        io_service_.post(&chain::leaf);
+    }
+  }
+
+  static void leaf()
+  {
+  }
+
+  boost::asio::io_service& io_service_;
+  int remaining_;
+  int fanout_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 5)
+  {
+    std::fprintf(stderr,
+        "Usage: post_throughput <nthreads> <nchains> "
+        "<chainlen> <fanout>\n");
+    return 1;
+  }
+
+  int num_threads = std::atoi(argv[1]);
+  int num_chains = std::atoi(argv[2]);
+  int chain_length = std::atoi(argv[3]);
+  int fanout = std::atoi(argv[4]);
+
+  boost::asio::io_service io_service;
+
+  std::vector<boost::shared_ptr<chain> > chains;
+  for (int i = 0; i < num_chains; ++i)
+  {
+    chains.push_back(boost::shared_ptr<chain>(
+          new chain(io_service, chain_length, fanout)));
+    chains.back()->start();
+  }
+
+  ptime start = microsec_clock::universal_time();
+
+  boost::thread_group threads;
+  for (int i = 0; i < num_threads; ++i)
+    threads.create_thread(boost::bind(&boost::asio::io_service::run,
+          &io_service));
+  threads.join_all();
+
+  ptime stop = microsec_clock::universal_time();
+  boost::uint64_t elapsed_usec = (stop - start).total_microseconds();
+
+  double handlers = 1.0 * num_chains * chain_length;
+  if (fanout > 0)
+    handlers += 1.0 * num_chains * ((chain_length - 1) / fanout);
+
+#if defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+  std::printf("mode: work stealing\n");
+#else // defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+  std::printf("mode: single queue\n");
+#endif // defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+  std::printf("handlers: %.0f\n", handlers);
+  std::printf("elapsed usec: %llu\n",
+      static_cast<unsigned long long>(elapsed_usec));
+  std::printf("handlers/sec: %.0f\n",
+      elapsed_usec ? handlers * 1000000.0 / elapsed_usec : 0.0);
+}
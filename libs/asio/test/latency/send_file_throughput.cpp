@@ -0,0 +1,186 @@
+//
+// send_file_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using boost::asio::ip::tcp;
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// CPU time used by the calling thread, in seconds. Falls back to the whole
+// process where per-thread usage is not available.
+double cpu_seconds()
+{
+  rusage usage;
+#if defined(RUSAGE_THREAD)
+  getrusage(RUSAGE_THREAD, &usage);
+#else
+  getrusage(RUSAGE_SELF, &usage);
+#endif
+  return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6
+    + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+// Sends the file repeatedly, either by reading it into a buffer and using
+// async_write, or by using async_send_file.
+class sender
+{
+public:
+  sender(tcp::socket& socket, int fd, std::size_t file_size,
+      int repeats, bool use_send_file, std::size_t chunk_size)
+    : socket_(socket),
+      fd_(fd),
+      file_size_(file_size),
+      repeats_(repeats),
+      use_send_file_(use_send_file),
+      buffer_(chunk_size),
+      offset_(0)
+  {
+  }
+
+  void start()
+  {
+    next();
+  }
+
+private:
+  void next()
+  {
+    if (offset_ == file_size_)
+    {
+      offset_ = 0;
+      if (--repeats_ == 0)
+        return;
+    }
+
+    if (use_send_file_)
+    {
+      std::size_t length = file_size_ - offset_;
+      socket_.async_send_file(fd_, offset_, length,
+          boost::bind(&sender::handle_write, this, _1, _2));
+    }
+    else
+    {
+      std::size_t length = file_size_ - offset_;
+      if (length > buffer_.size())
+        length = buffer_.size();
+      ssize_t n = ::pread(fd_, &buffer_[0], length, offset_);
+      if (n <= 0)
+      {
+        std::perror("pread");
+        std::exit(1);
+      }
+      boost::asio::async_write(socket_, boost::asio::buffer(&buffer_[0], n),
+          boost::bind(&sender::handle_write, this, _1, _2));
+    }
+  }
+
+  void handle_write(const boost::system::error_code& ec, std::size_t n)
+  {
+    if (ec)
+    {
+      std::fprintf(stderr, "write failed: %s\n", ec.message().c_str());
+      std::exit(1);
+    }
+
+    offset_ += n;
+    next();
+  }
+
+  tcp::socket& socket_;
+  int fd_;
+  std::size_t file_size_;
+  int repeats_;
+  bool use_send_file_;
+  std::vector<char> buffer_;
+  std::size_t offset_;
+};
+
+void drain(tcp::socket* socket, boost::uint64_t expected)
+{
+  std::vector<char> buf(256 * 1024);
+  boost::uint64_t total = 0;
+  while (total < expected)
+    total += socket->read_some(boost::asio::buffer(buf));
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4 && argc != 5)
+  {
+    std::fprintf(stderr,
+        "Usage: send_file_throughput <file> <repeats> "
+        "{write|send_file} [<chunksize>]\n");
+    return 1;
+  }
+
+  const char* path = argv[1];
+  int repeats = std::atoi(argv[2]);
+  bool use_send_file = (std::strcmp(argv[3], "send_file") == 0);
+  std::size_t chunk_size = (argc == 5)
+    ? static_cast<std::size_t>(std::atoi(argv[4])) : 65536;
+
+  int fd = ::open(path, O_RDONLY);
+  struct stat st;
+  if (fd < 0 || ::fstat(fd, &st) != 0 || st.st_size == 0 || repeats <= 0)
+  {
+    std::fprintf(stderr, "Cannot use file %s\n", path);
+    return 1;
+  }
+  std::size_t file_size = static_cast<std::size_t>(st.st_size);
+
+  boost::asio::io_service io_service;
+  tcp::acceptor acceptor(io_service,
+      tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+  tcp::socket client(io_service);
+  client.connect(acceptor.local_endpoint());
+  tcp::socket server(io_service);
+  acceptor.accept(server);
+
+  boost::uint64_t total = static_cast<boost::uint64_t>(file_size) * repeats;
+  boost::thread reader(boost::bind(drain, &client, total));
+
+  sender s(server, fd, file_size, repeats, use_send_file, chunk_size);
+
+  ptime start = microsec_clock::universal_time();
+  double cpu_start = cpu_seconds();
+
+  s.start();
+  io_service.run();
+  reader.join();
+
+  double cpu = cpu_seconds() - cpu_start;
+  ptime stop = microsec_clock::universal_time();
+  double secs = (stop - start).total_microseconds() / 1e6;
+  double gb = total / (1024.0 * 1024.0 * 1024.0);
+
+  std::printf("mode:            %s\n", use_send_file ? "send_file" : "write");
+  std::printf("bytes:           %llu\n", static_cast<unsigned long long>(total));
+  std::printf("elapsed:         %f s\n", secs);
+  std::printf("throughput:      %f MB/s\n", total / secs / (1024.0 * 1024.0));
+  std::printf("sender cpu:      %f s\n", cpu);
+  std::printf("sender cpu/GB:   %f s\n", cpu / gb);
+
+  ::close(fd);
+  return 0;
+}
@@ -0,0 +1,200 @@
+//
+// ssl_write_batching.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using boost::asio::ip::tcp;
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+typedef boost::asio::ssl::stream<tcp::socket> ssl_socket;
+
+// Use an anonymous cipher suite so that no certificate is needed. This is
+// only suitable for a loopback test.
+void use_anonymous_ciphers(boost::asio::ssl::context& context)
+{
+  SSL_CTX* ctx = context.native_handle();
+#if defined(SSL_OP_NO_TLSv1_3)
+  ::SSL_CTX_set_options(ctx, SSL_OP_NO_TLSv1_3);
+#endif // defined(SSL_OP_NO_TLSv1_3)
+#if defined(SSL_CTX_set_ecdh_auto)
+  SSL_CTX_set_ecdh_auto(ctx, 1);
+#endif // defined(SSL_CTX_set_ecdh_auto)
+  ::SSL_CTX_set_cipher_list(ctx, "aNULL:!eNULL:@SECLEVEL=0");
+}
+
+// Reads everything the client sends until the connection is shut down.
+class receiver
+{
+public:
+  receiver(boost::asio::io_service& io_service,
+      boost::asio::ssl::context& context)
+    : stream_(io_service, context),
+      data_(64 * 1024),
+      bytes_received_(0)
+  {
+  }
+
+  ssl_socket& stream()
+  {
+    return stream_;
+  }
+
+  std::size_t bytes_received() const
+  {
+    return bytes_received_;
+  }
+
+  void start()
+  {
+    stream_.async_handshake(boost::asio::ssl::stream_base::server,
+        boost::bind(&receiver::handle_read, this, _1, 0));
+  }
+
+private:
+  void handle_read(const boost::system::error_code& ec, std::size_t n)
+  {
+    bytes_received_ += n;
+    if (!ec)
+    {
+      stream_.async_read_some(boost::asio::buffer(data_),
+          boost::bind(&receiver::handle_read, this, _1, _2));
+    }
+  }
+
+  ssl_socket stream_;
+  std::vector<char> data_;
+  std::size_t bytes_received_;
+};
+
+// Sends messages made up of several small buffers, one after the other.
+class sender
+{
+public:
+  sender(boost::asio::io_service& io_service,
+      boost::asio::ssl::context& context, std::size_t parts,
+      std::size_t part_size, long messages)
+    : stream_(io_service, context),
+      data_(parts * part_size),
+      remaining_(messages)
+  {
+    for (std::size_t i = 0; i < parts; ++i)
+      buffers_.push_back(boost::asio::buffer(&data_[i * part_size], part_size));
+  }
+
+  ssl_socket& stream()
+  {
+    return stream_;
+  }
+
+  void start()
+  {
+    stream_.async_handshake(boost::asio::ssl::stream_base::client,
+        boost::bind(&sender::handle_write, this, _1));
+  }
+
+private:
+  void handle_write(const boost::system::error_code& ec)
+  {
+    if (!ec && remaining_-- > 0)
+    {
+      boost::asio::async_write(stream_, buffers_,
+          boost::bind(&sender::handle_write, this, _1));
+    }
+    else
+    {
+      // Closing the connection completes the receiver's outstanding read.
+      boost::system::error_code ignored_ec;
+      stream_.lowest_layer().shutdown(tcp::socket::shutdown_both, ignored_ec);
+    }
+  }
+
+  ssl_socket stream_;
+  std::vector<char> data_;
+  std::vector<boost::asio::const_buffer> buffers_;
+  long remaining_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 5)
+  {
+    std::fprintf(stderr, "Usage: ssl_write_batching "
+        "<messages> <parts> <partsize> <coalesce>\n");
+    return 1;
+  }
+
+  long messages = std::atol(argv[1]);
+  std::size_t parts = static_cast<std::size_t>(std::atoi(argv[2]));
+  std::size_t part_size = static_cast<std::size_t>(std::atoi(argv[3]));
+  bool coalesce = std::atoi(argv[4]) != 0;
+  if (messages <= 0 || parts == 0 || part_size == 0)
+  {
+    std::fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+
+  boost::asio::io_service io_service;
+  boost::asio::ssl::context context(io_service,
+      boost::asio::ssl::context::sslv23);
+  use_anonymous_ciphers(context);
+
+  tcp::acceptor acceptor(io_service,
+      tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+
+  receiver server(io_service, context);
+  sender client(io_service, context, parts, part_size, messages);
+  client.stream().lowest_layer().connect(acceptor.local_endpoint());
+  acceptor.accept(server.stream().lowest_layer());
+  client.stream().lowest_layer().set_option(tcp::no_delay(true));
+  client.stream().set_write_coalescing(coalesce);
+
+  server.start();
+  client.start();
+
+  ptime start = microsec_clock::universal_time();
+  io_service.run();
+  ptime stop = microsec_clock::universal_time();
+
+  std::size_t expected = messages * parts * part_size;
+  if (server.bytes_received() != expected)
+  {
+    std::fprintf(stderr, "Received %lu bytes, expected %lu\n",
+        static_cast<unsigned long>(server.bytes_received()),
+        static_cast<unsigned long>(expected));
+    return 1;
+  }
+
+  double secs = (stop - start).total_microseconds() / 1e6;
+
+  std::printf("coalescing:          %s\n", coalesce ? "on" : "off");
+  std::printf("messages:            %ld\n", messages);
+  std::printf("buffers per message: %lu\n", static_cast<unsigned long>(parts));
+  std::printf("buffer size:         %lu\n",
+      static_cast<unsigned long>(part_size));
+  std::printf("records written:     %lu\n",
+      static_cast<unsigned long>(client.stream().records_written()));
+  std::printf("sender writes:       %lu\n",
+      static_cast<unsigned long>(client.stream().transport_writes()));
+  std::printf("receiver reads:      %lu\n",
+      static_cast<unsigned long>(server.stream().transport_reads()));
+  std::printf("messages per second: %f\n", messages / secs);
+  std::printf("MB per second:       %f\n", expected / secs / 1e6);
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+//
+// timer_rearm.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/wheel_time_traits.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+using boost::posix_time::milliseconds;
+using boost::posix_time::seconds;
+
+typedef boost::asio::basic_deadline_timer<ptime,
+    boost::asio::wheel_time_traits<boost::asio::time_traits<ptime> > >
+  wheel_timer;
+
+// Handler that does nothing. Rearming a timer cancels its pending wait, so
+// most invocations are for aborted operations.
+struct idle_handler
+{
+  void operator()(const boost::system::error_code&) {}
+};
+
+// Simulates one idle-timeout timer per connection, where each message that
+// arrives on a connection pushes its timeout back.
+template <typename Timer>
+double run_test(int num_timers, long rearms)
+{
+  boost::asio::io_service io_service;
+  std::vector<Timer*> timers;
+  for (int i = 0; i < num_timers; ++i)
+  {
+    Timer* t = new Timer(io_service);
+    t->expires_from_now(seconds(30) + milliseconds(i % 1000));
+    t->async_wait(idle_handler());
+    timers.push_back(t);
+  }
+  io_service.poll();
+
+  // Touch the timers in a scattered order so that the heap sees a mix of
+  // positions rather than always rearming the same one.
+  boost::uint64_t state = 88172645463325252ULL;
+  ptime start = microsec_clock::universal_time();
+  for (long i = 0; i < rearms; ++i)
+  {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    std::size_t index = static_cast<std::size_t>(state % num_timers);
+    Timer* t = timers[index];
+    t->expires_from_now(seconds(30) + milliseconds(i % 1000));
+    t->async_wait(idle_handler());
+
+    // Deliver the aborted waits in batches.
+    if ((i & 1023) == 0)
+      io_service.poll();
+  }
+  io_service.poll();
+  ptime stop = microsec_clock::universal_time();
+
+  for (int i = 0; i < num_timers; ++i)
+    delete timers[i];
+  io_service.run();
+
+  return (stop - start).total_microseconds() * 1000.0 / rearms;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: timer_rearm <ntimers> <rearms> {heap|wheel}\n");
+    return 1;
+  }
+
+  int num_timers = std::atoi(argv[1]);
+  long rearms = std::atol(argv[2]);
+  bool use_wheel = (std::strcmp(argv[3], "wheel") == 0);
+  if (num_timers <= 0 || rearms <= 0)
+  {
+    std::fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+
+  double nsec = use_wheel
+    ? run_test<wheel_timer>(num_timers, rearms)
+    : run_test<boost::asio::deadline_timer>(num_timers, rearms);
+
+  std::printf("queue:            %s\n", use_wheel ? "wheel" : "heap");
+  std::printf("timers:           %d\n", num_timers);
+  std::printf("rearms:           %ld\n", rearms);
+  std::printf("nsec per rearm:   %f\n", nsec);
+
+  return 0;
+}
@@ -101,6 +101,19 @@ void test()
 
     stream1.set_verify_callback(verify_callback);
     stream1.set_verify_callback(verify_callback, ec);
+
+    stream1.set_write_coalescing(true);
+    bool coalescing = stream3.write_coalescing();
+    (void)coalescing;
+
+    std::size_t records = stream3.records_written();
+    (void)records;
+
+    std::size_t reads = stream3.transport_reads();
+    (void)reads;
+
+    std::size_t writes = stream3.transport_writes();
+    (void)writes;
 #endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
 
     stream1.handshake(ssl::stream_base::client);
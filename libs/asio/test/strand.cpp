@@ -163,6 +163,28 @@ void strand_test()
   BOOST_CHECK(count == 3);
   BOOST_CHECK(exception_count == 2);
 
+#if defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+  count = 0;
+  ios.reset();
+
+  // Check that handlers which find the strand busy are counted, and that
+  // copies of a strand share its state.
+  {
+    strand s3(ios);
+    strand s4(s3);
+    s3.post(boost::bind(increment, &count));
+    s4.post(boost::bind(increment, &count));
+    s3.wrap(boost::bind(increment, &count))();
+    BOOST_CHECK(s3.delayed_handler_count() == 2);
+    BOOST_CHECK(s4.delayed_handler_count() == 2);
+    BOOST_CHECK(s3.enqueue_retry_count() == 0);
+  }
+
+  ios.run();
+
+  BOOST_CHECK(count == 3);
+#endif // defined(BOOST_ASIO_ENABLE_PER_STRAND_IMPLEMENTATIONS)
+
   count = 0;
   ios.reset();
 
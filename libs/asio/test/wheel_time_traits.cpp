@@ -0,0 +1,310 @@
+//
+// wheel_time_traits.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2012 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include <boost/asio/wheel_time_traits.hpp>
+
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/asio/basic_deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/placeholders.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/time_traits.hpp>
+#include "unit_test.hpp"
+
+using namespace boost::posix_time;
+
+typedef boost::asio::basic_deadline_timer<ptime,
+    boost::asio::wheel_time_traits<boost::asio::time_traits<ptime> > >
+  wheel_timer;
+
+typedef boost::asio::basic_deadline_timer<ptime,
+    boost::asio::wheel_time_traits<boost::asio::time_traits<ptime>, 100> >
+  fine_wheel_timer;
+
+ptime now()
+{
+  return microsec_clock::universal_time();
+}
+
+// Time traits whose clock can be set back, as the system clock may be.
+struct adjustable_time_traits
+  : boost::asio::time_traits<ptime>
+{
+  static time_duration offset;
+
+  static ptime now()
+  {
+    return microsec_clock::universal_time() + offset;
+  }
+};
+
+time_duration adjustable_time_traits::offset;
+
+typedef boost::asio::basic_deadline_timer<ptime,
+    boost::asio::wheel_time_traits<adjustable_time_traits> >
+  adjustable_wheel_timer;
+
+struct fired_timer
+{
+  ptime expiry;
+  ptime fired;
+  int index;
+};
+
+void record(std::vector<fired_timer>* fired, ptime expiry, int index,
+    const boost::system::error_code& ec)
+{
+  if (!ec)
+  {
+    fired_timer f = { expiry, now(), index };
+    fired->push_back(f);
+  }
+}
+
+void increment_if_cancelled(int* count, const boost::system::error_code& ec)
+{
+  if (ec == boost::asio::error::operation_aborted)
+    ++(*count);
+}
+
+void wheel_timer_order_test()
+{
+  boost::asio::io_service ios;
+  std::vector<boost::shared_ptr<wheel_timer> > timers;
+  std::vector<fired_timer> fired;
+
+  // Spread the expiry times over the first two levels of the wheel, and
+  // schedule them out of order.
+  ptime start = now();
+  const int num_timers = 200;
+  for (int i = 0; i < num_timers; ++i)
+  {
+    int msec = (i * 37) % 600;
+    boost::shared_ptr<wheel_timer> t(new wheel_timer(ios));
+    t->expires_at(start + milliseconds(msec));
+    t->async_wait(boost::bind(record,
+          &fired, t->expires_at(), i, boost::asio::placeholders::error));
+    timers.push_back(t);
+  }
+
+  ios.run();
+
+  BOOST_CHECK(fired.size() == static_cast<std::size_t>(num_timers));
+  for (std::size_t i = 0; i < fired.size(); ++i)
+  {
+    // No timer may complete before its expiry time.
+    BOOST_CHECK(!(fired[i].fired < fired[i].expiry));
+
+    // Timers complete in order of their expiry times, to the resolution of
+    // the wheel.
+    if (i > 0)
+    {
+      BOOST_CHECK(!(fired[i].expiry + milliseconds(1)
+            < fired[i - 1].expiry));
+    }
+  }
+}
+
+void wheel_timer_cancel_test()
+{
+  boost::asio::io_service ios;
+  int cancelled = 0;
+
+  wheel_timer t1(ios, seconds(10));
+  t1.async_wait(boost::bind(increment_if_cancelled,
+        &cancelled, boost::asio::placeholders::error));
+  t1.async_wait(boost::bind(increment_if_cancelled,
+        &cancelled, boost::asio::placeholders::error));
+
+  wheel_timer t2(ios, ptime(pos_infin));
+  t2.async_wait(boost::bind(increment_if_cancelled,
+        &cancelled, boost::asio::placeholders::error));
+
+  BOOST_CHECK(t1.cancel_one() == 1);
+  BOOST_CHECK(t1.cancel() == 1);
+  BOOST_CHECK(t2.cancel() == 1);
+  BOOST_CHECK(t1.cancel() == 0);
+
+  ptime start = now();
+  ios.run();
+
+  // All operations were cancelled, so run() must not wait for the timers.
+  BOOST_CHECK(cancelled == 3);
+  BOOST_CHECK(now() - start < seconds(1));
+}
+
+void wheel_timer_rearm_test()
+{
+  boost::asio::io_service ios;
+  std::vector<fired_timer> fired;
+  int cancelled = 0;
+
+  // Rearming a timer repeatedly cancels its earlier waits, and only the last
+  // expiry time takes effect.
+  fine_wheel_timer t(ios);
+  ptime start = now();
+  for (int i = 0; i < 1000; ++i)
+  {
+    t.expires_from_now(seconds(100));
+    t.async_wait(boost::bind(increment_if_cancelled,
+          &cancelled, boost::asio::placeholders::error));
+  }
+  t.expires_at(start + milliseconds(50));
+  t.async_wait(boost::bind(record,
+        &fired, t.expires_at(), 0, boost::asio::placeholders::error));
+
+  // An expired timer completes immediately.
+  fine_wheel_timer t2(ios, start - seconds(1));
+  t2.async_wait(boost::bind(record,
+        &fired, t2.expires_at(), 1, boost::asio::placeholders::error));
+
+  ios.run();
+
+  BOOST_CHECK(cancelled == 1000);
+  BOOST_CHECK(fired.size() == 2);
+  if (fired.size() == 2)
+  {
+    BOOST_CHECK(fired[0].index == 1);
+    BOOST_CHECK(fired[1].index == 0);
+    BOOST_CHECK(!(fired[1].fired < fired[1].expiry));
+    BOOST_CHECK(fired[1].fired < fired[1].expiry + milliseconds(500));
+  }
+}
+
+void wheel_timer_long_test()
+{
+  boost::asio::io_service ios;
+  std::vector<fired_timer> fired;
+
+  // With a resolution of 100 microseconds, this timer is past the end of the
+  // first level and must be cascaded down before it fires.
+  fine_wheel_timer t(ios, milliseconds(1200));
+  t.async_wait(boost::bind(record,
+        &fired, t.expires_at(), 0, boost::asio::placeholders::error));
+
+  ptime start = now();
+  t.wait();
+  BOOST_CHECK(!(now() < t.expires_at()));
+
+  ios.run();
+  BOOST_CHECK(fired.size() == 1);
+  BOOST_CHECK(now() - start < seconds(2));
+}
+
+void wheel_timer_clock_change_test()
+{
+  boost::asio::io_service ios;
+  std::vector<fired_timer> fired;
+  int cancelled = 0;
+
+  // Keep a timer queued so that the wheel is not reset when it becomes idle.
+  adjustable_wheel_timer idle(ios, seconds(10));
+  idle.async_wait(boost::bind(increment_if_cancelled,
+        &cancelled, boost::asio::placeholders::error));
+
+  adjustable_wheel_timer t1(ios, milliseconds(50));
+  t1.async_wait(boost::bind(record,
+        &fired, t1.expires_at(), 0, boost::asio::placeholders::error));
+  ios.run_one();
+  BOOST_CHECK(fired.size() == 1);
+
+  // Set the clock back. A new timer must still complete after its delay,
+  // rather than once the clock has caught up again.
+  adjustable_time_traits::offset = -hours(1);
+  adjustable_wheel_timer t2(ios, milliseconds(50));
+  t2.async_wait(boost::bind(record,
+        &fired, t2.expires_at(), 1, boost::asio::placeholders::error));
+  ptime start = now();
+  ios.run_one();
+  BOOST_CHECK(fired.size() == 2);
+  BOOST_CHECK(!(now() < start + milliseconds(50)));
+  BOOST_CHECK(now() - start < seconds(1));
+
+  idle.cancel();
+  ios.run();
+  BOOST_CHECK(cancelled == 1);
+  adjustable_time_traits::offset = time_duration();
+}
+
+#if defined(BOOST_ASIO_HAS_STD_CHRONO) \
+  || defined(BOOST_ASIO_HAS_BOOST_CHRONO)
+
+#if defined(BOOST_ASIO_HAS_STD_CHRONO)
+namespace chrono = std::chrono;
+#else // defined(BOOST_ASIO_HAS_STD_CHRONO)
+namespace chrono = boost::chrono;
+#endif // defined(BOOST_ASIO_HAS_STD_CHRONO)
+
+typedef boost::asio::steady_timer::clock_type test_clock;
+
+typedef boost::asio::basic_waitable_timer<test_clock,
+    boost::asio::wheel_wait_traits<boost::asio::wait_traits<test_clock> > >
+  wheel_waitable_timer;
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void wheel_waitable_timer_test()
+{
+  boost::asio::io_service ios;
+  int count = 0;
+
+  test_clock::time_point start = test_clock::now();
+
+  wheel_waitable_timer t1(ios);
+  t1.expires_from_now(test_clock::duration::zero());
+  t1.async_wait(boost::bind(increment, &count));
+
+  wheel_waitable_timer t2(ios);
+  t2.expires_at(start + chrono::milliseconds(100));
+  t2.async_wait(boost::bind(increment, &count));
+
+  ios.run();
+
+  BOOST_CHECK(count == 2);
+  BOOST_CHECK(!(test_clock::now() < t2.expires_at()));
+}
+
+#else // defined(BOOST_ASIO_HAS_STD_CHRONO)
+      //   || defined(BOOST_ASIO_HAS_BOOST_CHRONO)
+
+void wheel_waitable_timer_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_STD_CHRONO)
+       //   || defined(BOOST_ASIO_HAS_BOOST_CHRONO)
+
+test_suite* init_unit_test_suite(int, char*[])
+{
+  test_suite* test = BOOST_TEST_SUITE("wheel_time_traits");
+  test->add(BOOST_TEST_CASE(&wheel_timer_order_test));
+  test->add(BOOST_TEST_CASE(&wheel_timer_cancel_test));
+  test->add(BOOST_TEST_CASE(&wheel_timer_rearm_test));
+  test->add(BOOST_TEST_CASE(&wheel_timer_long_test));
+  test->add(BOOST_TEST_CASE(&wheel_timer_clock_change_test));
+  test->add(BOOST_TEST_CASE(&wheel_waitable_timer_test));
+  return test;
+}
@@ -0,0 +1,138 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Times the construction and destruction of maps with std::allocator and with
+//the pool allocators. Pool allocators are version 2 allocators, so range
+//constructors and copy constructors obtain all the nodes with a single call.
+//
+//The pools are not faster for every column: adaptive pools are slower
+//destroying maps filled in random order, and node_allocator is slower
+//constructing from a range once its free list has been scattered by such a
+//destruction. See the pool allocators section of the documentation.
+//
+//usage: bench_alloc_map [elements] [iterations]
+
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/map.hpp>
+#include <boost/container/node_allocator.hpp>
+#include <boost/container/adaptive_pool.hpp>
+#include <boost/container/private_adaptive_pool.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <utility>
+#include <cstdlib>
+
+using namespace boost::container;
+
+typedef std::pair<const int, int> value_type;
+
+class timer
+{
+   public:
+   timer()
+      :  m_start(boost::posix_time::microsec_clock::universal_time()), m_elapsed(0)
+   {}
+
+   void resume()
+   {  m_start = boost::posix_time::microsec_clock::universal_time();  }
+
+   void stop()
+   {  m_elapsed += (boost::posix_time::microsec_clock::universal_time() - m_start).total_microseconds();  }
+
+   long elapsed() const
+   {  return m_elapsed;  }
+
+   private:
+   boost::posix_time::ptime m_start;
+   long m_elapsed;
+};
+
+template<class Map>
+void run( const char *name, const std::vector<std::pair<int, int> > &values
+        , const std::vector<std::pair<int, int> > &shuffled, unsigned iterations)
+{
+   //One timer per measured operation
+   timer insert_t, insert_destroy_t, range_t, copy_t, destroy_t;
+   long checksum = 0;
+   for(unsigned it = 0; it != iterations; ++it){
+      {
+         insert_t.resume();
+         Map m;
+         for(std::size_t i = 0, max = shuffled.size(); i != max; ++i){
+            m.insert(shuffled[i]);
+         }
+         insert_t.stop();
+         checksum += long(m.size());
+         insert_destroy_t.resume();
+      }
+      insert_destroy_t.stop();
+      {
+         range_t.resume();
+         Map m(values.begin(), values.end());
+         range_t.stop();
+         copy_t.resume();
+         Map *const copy = new Map(m);
+         copy_t.stop();
+         checksum += long(copy->size());
+         destroy_t.resume();
+         delete copy;
+         destroy_t.stop();
+      }
+   }
+   const double div = double(iterations)*double(values.size())/1000.0;
+   std::cout << std::setw(24) << name << std::fixed << std::setprecision(1)
+             << std::setw(10) << insert_t.elapsed()/div
+             << std::setw(10) << insert_destroy_t.elapsed()/div
+             << std::setw(10) << range_t.elapsed()/div
+             << std::setw(10) << copy_t.elapsed()/div
+             << std::setw(10) << destroy_t.elapsed()/div
+             << "   (" << checksum << ")" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+   const std::size_t elements = argc > 1 ? std::strtoul(argv[1], 0, 10) : 100000;
+   const unsigned iterations = argc > 2 ? unsigned(std::strtoul(argv[2], 0, 10)) : 20;
+   if(!elements || !iterations){
+      std::cerr << "usage: bench_alloc_map [elements] [iterations]" << std::endl;
+      return 1;
+   }
+
+   //Sorted keys for the range constructor, shuffled
+   //keys for insertion one by one
+   std::vector<std::pair<int, int> > values;
+   for(std::size_t i = 0; i != elements; ++i){
+      values.push_back(std::pair<int, int>(int(i), int(i)));
+   }
+   std::vector<std::pair<int, int> > shuffled(values);
+   std::srand(0);
+   for(std::size_t i = shuffled.size(); i > 1; --i){
+      std::swap(shuffled[i-1], shuffled[std::size_t(std::rand()) % i]);
+   }
+
+   std::cout << "elements: " << elements << ", iterations: " << iterations << "\n"
+             << "ns/element" << std::setw(24-10) << " "
+             << std::setw(10) << "insert" << std::setw(10) << "ins-dtor"
+             << std::setw(10) << "range" << std::setw(10) << "copy"
+             << std::setw(10) << "copy-dtor" << std::endl;
+   run< map<int, int, std::less<int>, std::allocator<value_type> > >
+      ("std::allocator", values, shuffled, iterations);
+   run< map<int, int, std::less<int>, node_allocator<value_type> > >
+      ("node_allocator", values, shuffled, iterations);
+   run< map<int, int, std::less<int>, adaptive_pool<value_type> > >
+      ("adaptive_pool", values, shuffled, iterations);
+   run< map<int, int, std::less<int>, private_adaptive_pool<value_type> > >
+      ("private_adaptive_pool", values, shuffled, iterations);
+   return 0;
+}
+
+#include <boost/container/detail/config_end.hpp>
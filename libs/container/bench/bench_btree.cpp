@@ -0,0 +1,187 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Compares btree_map with map and flat_map using 16 byte keys: the time to insert
+//shuffled keys one by one, to find every key in random order and to iterate over
+//all the elements, and the memory allocated per element. One by one insertion
+//in flat_map is quadratic, so it's only measured up to a limit.
+//
+//usage: bench_btree [max_elements] [max_flat_elements]
+
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/btree_map.hpp>
+#include <boost/container/map.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdlib>
+
+using namespace boost::container;
+
+struct key16
+{
+   boost::uint64_t hi, lo;
+
+   friend bool operator<(const key16 &l, const key16 &r)
+   {  return l.hi < r.hi || (l.hi == r.hi && l.lo < r.lo);  }
+};
+
+//Counts the bytes allocated by all the instances
+template<class T>
+class counting_allocator
+   : public std::allocator<T>
+{
+   public:
+   static std::size_t allocated;
+
+   template<class U>
+   struct rebind
+   {  typedef counting_allocator<U> other;  };
+
+   counting_allocator()
+   {}
+
+   template<class U>
+   counting_allocator(const counting_allocator<U> &)
+   {}
+
+   T *allocate(std::size_t n, const void * = 0)
+   {
+      counting_allocator<char>::allocated += n*sizeof(T);
+      return std::allocator<T>::allocate(n);
+   }
+
+   void deallocate(T *p, std::size_t n)
+   {
+      counting_allocator<char>::allocated -= n*sizeof(T);
+      std::allocator<T>::deallocate(p, n);
+   }
+};
+
+template<class T>
+std::size_t counting_allocator<T>::allocated = 0;
+
+template<class T, class U>
+bool operator==(const counting_allocator<T> &, const counting_allocator<U> &)
+{  return true;  }
+
+template<class T, class U>
+bool operator!=(const counting_allocator<T> &, const counting_allocator<U> &)
+{  return false;  }
+
+typedef std::pair<key16, int>          value_type;
+typedef std::pair<const key16, int>    const_value_type;
+
+class timer
+{
+   public:
+   timer()
+      :  m_start(boost::posix_time::microsec_clock::universal_time()), m_elapsed(0)
+   {}
+
+   void resume()
+   {  m_start = boost::posix_time::microsec_clock::universal_time();  }
+
+   void stop()
+   {  m_elapsed += (boost::posix_time::microsec_clock::universal_time() - m_start).total_microseconds();  }
+
+   long elapsed() const
+   {  return m_elapsed;  }
+
+   private:
+   boost::posix_time::ptime m_start;
+   long m_elapsed;
+};
+
+template<class Map>
+void run(const char *name, const std::vector<value_type> &shuffled, bool one_by_one)
+{
+   const std::size_t elements = shuffled.size();
+   //Repeat small sizes to obtain meaningful times
+   const std::size_t iterations = elements < 1000000u ? 1000000u/elements : 1u;
+   timer insert_t, lookup_t, iterate_t;
+   long checksum = 0;
+   std::size_t bytes = 0;
+   for(std::size_t it = 0; it != iterations; ++it){
+      counting_allocator<char>::allocated = 0;
+      insert_t.resume();
+      Map m;
+      if(one_by_one){
+         for(std::size_t i = 0; i != elements; ++i){
+            m.insert(shuffled[i]);
+         }
+      }
+      else{
+         m.insert(shuffled.begin(), shuffled.end());
+      }
+      insert_t.stop();
+      bytes = counting_allocator<char>::allocated;
+
+      lookup_t.resume();
+      for(std::size_t i = 0; i != elements; ++i){
+         checksum += m.find(shuffled[i].first)->second;
+      }
+      lookup_t.stop();
+
+      iterate_t.resume();
+      for(typename Map::const_iterator i = m.begin(), e = m.end(); i != e; ++i){
+         checksum += i->second;
+      }
+      iterate_t.stop();
+   }
+   const double div = double(iterations)*double(elements)/1000.0;
+   std::cout << std::setw(10) << elements << std::setw(12) << name
+             << std::fixed << std::setprecision(1)
+             << std::setw(10) << insert_t.elapsed()/div
+             << std::setw(10) << lookup_t.elapsed()/div
+             << std::setw(10) << iterate_t.elapsed()/div
+             << std::setw(10) << double(bytes)/double(elements)
+             << (one_by_one ? "" : "   (range insertion)")
+             << "   (" << checksum << ")" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+   const std::size_t max_elements = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000u;
+   const std::size_t max_flat = argc > 2 ? std::strtoul(argv[2], 0, 10) : 100000u;
+   if(max_elements < 1000u){
+      std::cerr << "usage: bench_btree [max_elements] [max_flat_elements]" << std::endl;
+      return 1;
+   }
+
+   std::srand(0);
+   std::cout << "  elements   container ns/insert ns/lookup   ns/iter  bytes/elem" << std::endl;
+   for(std::size_t elements = 1000u; elements <= max_elements; elements *= 10u){
+      std::vector<value_type> shuffled;
+      for(std::size_t i = 0; i != elements; ++i){
+         key16 k;
+         k.hi = boost::uint64_t(i) * 2654435761u;
+         k.lo = boost::uint64_t(i);
+         shuffled.push_back(value_type(k, int(i & 0xFF)));
+      }
+      for(std::size_t i = shuffled.size(); i > 1; --i){
+         std::swap(shuffled[i-1], shuffled[(std::size_t(std::rand())*RAND_MAX + std::size_t(std::rand())) % i]);
+      }
+      run< map<key16, int, std::less<key16>, counting_allocator<const_value_type> > >
+         ("map", shuffled, true);
+      run< btree_map<key16, int, std::less<key16>, counting_allocator<const_value_type> > >
+         ("btree_map", shuffled, true);
+      run< flat_map<key16, int, std::less<key16>, counting_allocator<value_type> > >
+         ("flat_map", shuffled, elements <= max_flat);
+   }
+   return 0;
+}
+
+#include <boost/container/detail/config_end.hpp>
@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Times the insertion of unordered keys in a flat_map one by one and as a
+//single range, that is appended, sorted and merged with the stored elements.
+//Ordered range insertion and adopt_sequence are shown as a reference.
+//One by one insertion is quadratic, so it's only measured up to a limit.
+//
+//usage: bench_flat_insert [max_elements] [max_one_by_one_elements]
+
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cstdlib>
+
+using namespace boost::container;
+
+typedef flat_map<int, int>             map_t;
+typedef std::pair<int, int>            value_type;
+
+class timer
+{
+   public:
+   timer()
+      :  m_start(boost::posix_time::microsec_clock::universal_time()), m_elapsed(0)
+   {}
+
+   void resume()
+   {  m_start = boost::posix_time::microsec_clock::universal_time();  }
+
+   void stop()
+   {  m_elapsed += (boost::posix_time::microsec_clock::universal_time() - m_start).total_microseconds();  }
+
+   long elapsed() const
+   {  return m_elapsed;  }
+
+   private:
+   boost::posix_time::ptime m_start;
+   long m_elapsed;
+};
+
+void run(std::size_t elements, std::size_t max_one_by_one)
+{
+   //Half of the keys are inserted in an empty map and the other
+   //half in the resulting map, so both cases are measured
+   std::vector<value_type> shuffled;
+   for(std::size_t i = 0; i != elements; ++i){
+      shuffled.push_back(value_type(int(i), int(i)));
+   }
+   for(std::size_t i = shuffled.size(); i > 1; --i){
+      std::swap(shuffled[i-1], shuffled[(std::size_t(std::rand())*RAND_MAX + std::size_t(std::rand())) % i]);
+   }
+   const std::vector<value_type>::const_iterator beg(shuffled.begin()), end(shuffled.end());
+   const std::vector<value_type>::const_iterator half(beg + elements/2);
+   std::vector<value_type> ordered(shuffled.begin(), shuffled.end());
+   std::sort(ordered.begin(), ordered.end());
+
+   //Repeat small sizes to obtain meaningful times
+   const std::size_t iterations = elements < 1000000u ? 1000000u/elements : 1u;
+   timer one_by_one_t, range_t, ordered_t, adopt_t;
+   long checksum = 0;
+   for(std::size_t it = 0; it != iterations; ++it){
+      if(elements <= max_one_by_one){
+         one_by_one_t.resume();
+         map_t m;
+         for(std::size_t i = 0; i != elements; ++i){
+            m.insert(shuffled[i]);
+         }
+         one_by_one_t.stop();
+         checksum += long(m.size());
+      }
+      {
+         range_t.resume();
+         map_t m;
+         m.insert(beg, half);
+         m.insert(half, end);
+         range_t.stop();
+         checksum += long(m.size());
+      }
+      {
+         ordered_t.resume();
+         map_t m(ordered_unique_range, ordered.begin(), ordered.end());
+         ordered_t.stop();
+         checksum += long(m.size());
+      }
+      {
+         map_t::sequence_type seq(beg, end);
+         adopt_t.resume();
+         map_t m;
+         m.adopt_sequence(boost::move(seq));
+         adopt_t.stop();
+         checksum += long(m.size());
+      }
+   }
+   const double div = double(iterations)*double(elements)/1000.0;
+   std::cout << std::setw(10) << elements << std::fixed << std::setprecision(1);
+   if(elements <= max_one_by_one){
+      std::cout << std::setw(12) << one_by_one_t.elapsed()/div;
+   }
+   else{
+      std::cout << std::setw(12) << "-";
+   }
+   std::cout << std::setw(12) << range_t.elapsed()/div
+             << std::setw(12) << ordered_t.elapsed()/div
+             << std::setw(12) << adopt_t.elapsed()/div
+             << "   (" << checksum << ")" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+   const std::size_t max_elements = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000u;
+   const std::size_t max_one_by_one = argc > 2 ? std::strtoul(argv[2], 0, 10) : 100000u;
+   if(max_elements < 1000u){
+      std::cerr << "usage: bench_flat_insert [max_elements] [max_one_by_one_elements]" << std::endl;
+      return 1;
+   }
+
+   std::srand(0);
+   std::cout << "ns/element" << std::setw(12) << "one-by-one" << std::setw(12) << "range"
+             << std::setw(12) << "ordered" << std::setw(12) << "adopt" << std::endl;
+   for(std::size_t elements = 1000u; elements <= max_elements; elements *= 10u){
+      run(elements, max_one_by_one);
+   }
+   return 0;
+}
+
+#include <boost/container/detail/config_end.hpp>
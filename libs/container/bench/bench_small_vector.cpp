@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Times short-lived vectors holding a few elements, like the ones created
+//to process a request, with std::vector, vector, small_vector and static_vector.
+//
+//usage: bench_small_vector [iterations]
+
+#include <boost/container/detail/config_begin.hpp>
+#include <boost/container/vector.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/container/static_vector.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+
+using namespace boost::container;
+
+//Each iteration builds a container with 1 to MaxElements elements,
+//reads them back and destroys the container
+static const int MaxElements = 8;
+
+struct element
+{
+   element(int i)
+      :  a(i), b(i*3)
+   {}
+
+   int a, b;
+};
+
+template<class Vector>
+double run(unsigned long iterations, long &checksum)
+{
+   boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+   for(unsigned long i = 0; i != iterations; ++i){
+      Vector v;
+      const int elements = int(i % MaxElements) + 1;
+      for(int j = 0; j != elements; ++j){
+         v.push_back(element(j + int(i)));
+      }
+      for(typename Vector::const_iterator it = v.begin(), itend = v.end(); it != itend; ++it){
+         checksum += it->a + it->b;
+      }
+   }
+   boost::posix_time::ptime stop = boost::posix_time::microsec_clock::universal_time();
+   return (stop - start).total_microseconds()*1000.0/iterations;
+}
+
+template<class Vector>
+void print(const char *name, unsigned long iterations, long &checksum)
+{
+   std::cout << std::setw(30) << name << std::setw(16)
+             << std::fixed << std::setprecision(1) << run<Vector>(iterations, checksum) << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+   const unsigned long iterations = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+   if(!iterations){
+      std::cerr << "usage: bench_small_vector [iterations]" << std::endl;
+      return 1;
+   }
+   long checksum = 0;
+
+   std::cout << "iterations: " << iterations << ", elements: 1-" << MaxElements << "\n"
+             << std::setw(30) << " " << std::setw(16) << "ns/iteration" << std::endl;
+   print< std::vector<element> >              ("std::vector", iterations, checksum);
+   print< vector<element> >                   ("vector", iterations, checksum);
+   print< small_vector<element, MaxElements> >("small_vector<8>", iterations, checksum);
+   print< small_vector<element, 4> >          ("small_vector<4> (may spill)", iterations, checksum);
+   print< static_vector<element, MaxElements> >("static_vector<8>", iterations, checksum);
+   //Print the checksum so that the loops are not optimized away
+   std::cout << "checksum: " << checksum << std::endl;
+   return 0;
+}
+
+#include <boost/container/detail/config_end.hpp>
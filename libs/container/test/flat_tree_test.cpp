@@ -12,6 +12,7 @@
 #include <set>
 #include <boost/container/flat_set.hpp>
 #include <boost/container/flat_map.hpp>
+#include <boost/container/slist.hpp>
 #include "print_container.hpp"
 #include "dummy_test_allocator.hpp"
 #include "movable_int.hpp"
@@ -20,6 +21,7 @@
 #include "propagate_allocator_test.hpp"
 #include "emplace_test.hpp"
 #include <vector>
+#include <new>
 #include <boost/container/detail/flat_tree.hpp>
 
 using namespace boost::container;
@@ -466,6 +468,284 @@ bool flat_tree_ordered_insertion_test()
    return true;
 }
 
+bool flat_tree_bulk_insertion_test()
+{
+   using namespace boost::container;
+   const std::size_t NumElements = 1000;
+
+   //Unordered values with duplicates, the mapped value
+   //records the insertion order of each key
+   std::vector<std::pair<int, int> > values;
+   for(std::size_t i = 0; i != NumElements; ++i){
+      values.push_back(std::pair<int, int>(static_cast<int>((i*7919u) % (NumElements/2)), static_cast<int>(i)));
+   }
+   std::vector<std::pair<int, int> > values2;
+   for(std::size_t i = 0; i != NumElements; ++i){
+      values2.push_back(std::pair<int, int>(static_cast<int>((i*104729u) % NumElements), -static_cast<int>(i)));
+   }
+
+   //Unordered insertion map
+   {
+      std::map<int, int> int_map(values.begin(), values.end());
+      flat_map<int, int> fmap(values.begin(), values.end());
+      if(!CheckEqualContainers(&int_map, &fmap))
+         return false;
+      //Insertion in a non-empty container, stored keys win
+      int_map.insert(values2.begin(), values2.end());
+      fmap.insert(values2.begin(), values2.end());
+      if(!CheckEqualContainers(&int_map, &fmap))
+         return false;
+      //Merge
+      flat_map<int, int> fmap2(values.begin(), values.end());
+      flat_map<int, int> fmap3(values2.begin(), values2.end());
+      fmap2.merge(boost::move(fmap3));
+      if(!fmap3.empty() || !CheckEqualContainers(&int_map, &fmap2))
+         return false;
+      //Adoption of an unordered sequence
+      flat_map<int, int>::sequence_type seq(values.begin(), values.end());
+      seq.insert(seq.end(), values2.begin(), values2.end());
+      fmap2.clear();
+      fmap2.adopt_sequence(boost::move(seq));
+      if(!CheckEqualContainers(&int_map, &fmap2))
+         return false;
+      //Adoption of an ordered sequence
+      seq.assign(int_map.begin(), int_map.end());
+      fmap2.adopt_sequence(ordered_unique_range, boost::move(seq));
+      if(!CheckEqualContainers(&int_map, &fmap2))
+         return false;
+   }
+   //Unordered insertion multimap
+   {
+      std::multimap<int, int> int_mmap(values.begin(), values.end());
+      flat_multimap<int, int> fmmap(values.begin(), values.end());
+      if(!CheckEqualContainers(&int_mmap, &fmmap))
+         return false;
+      //Equivalent keys keep their insertion order
+      int_mmap.insert(values2.begin(), values2.end());
+      fmmap.insert(values2.begin(), values2.end());
+      if(!CheckEqualContainers(&int_mmap, &fmmap))
+         return false;
+      //Merge
+      flat_multimap<int, int> fmmap2(values.begin(), values.end());
+      flat_multimap<int, int> fmmap3(values2.begin(), values2.end());
+      fmmap2.merge(boost::move(fmmap3));
+      if(!fmmap3.empty() || !CheckEqualContainers(&int_mmap, &fmmap2))
+         return false;
+      //Adoption of an unordered sequence
+      flat_multimap<int, int>::sequence_type seq(values.begin(), values.end());
+      seq.insert(seq.end(), values2.begin(), values2.end());
+      fmmap2.clear();
+      fmmap2.adopt_sequence(boost::move(seq));
+      if(!CheckEqualContainers(&int_mmap, &fmmap2))
+         return false;
+      //Adoption of an ordered sequence
+      seq.assign(int_mmap.begin(), int_mmap.end());
+      fmmap2.adopt_sequence(ordered_range, boost::move(seq));
+      if(!CheckEqualContainers(&int_mmap, &fmmap2))
+         return false;
+   }
+   //Unordered insertion set and multiset
+   {
+      std::vector<int> keys, keys2;
+      for(std::size_t i = 0; i != NumElements; ++i){
+         keys.push_back(values[i].first);
+         keys2.push_back(values2[i].first);
+      }
+      std::set<int> int_set(keys.begin(), keys.end());
+      std::multiset<int> int_mset(keys.begin(), keys.end());
+      flat_set<int> fset(keys.begin(), keys.end());
+      flat_multiset<int> fmset(keys.begin(), keys.end());
+      if(!CheckEqualContainers(&int_set, &fset) || !CheckEqualContainers(&int_mset, &fmset))
+         return false;
+      int_set.insert(keys2.begin(), keys2.end());
+      int_mset.insert(keys2.begin(), keys2.end());
+      fset.insert(keys2.begin(), keys2.end());
+      fmset.insert(keys2.begin(), keys2.end());
+      if(!CheckEqualContainers(&int_set, &fset) || !CheckEqualContainers(&int_mset, &fmset))
+         return false;
+      //Merge
+      flat_set<int> fset2(keys.begin(), keys.end());
+      flat_multiset<int> fmset2(keys.begin(), keys.end());
+      fset2.merge(flat_set<int>(keys2.begin(), keys2.end()));
+      fmset2.merge(flat_multiset<int>(keys2.begin(), keys2.end()));
+      if(!CheckEqualContainers(&int_set, &fset2) || !CheckEqualContainers(&int_mset, &fmset2))
+         return false;
+      //Adoption
+      flat_set<int>::sequence_type seq(keys.begin(), keys.end());
+      seq.insert(seq.end(), keys2.begin(), keys2.end());
+      flat_multiset<int>::sequence_type mseq(seq);
+      fset2.adopt_sequence(boost::move(seq));
+      fmset2.adopt_sequence(boost::move(mseq));
+      if(!CheckEqualContainers(&int_set, &fset2) || !CheckEqualContainers(&int_mset, &fmset2))
+         return false;
+      seq.assign(int_set.begin(), int_set.end());
+      mseq.assign(int_mset.begin(), int_mset.end());
+      fset2.adopt_sequence(ordered_unique_range, boost::move(seq));
+      fmset2.adopt_sequence(ordered_range, boost::move(mseq));
+      if(!CheckEqualContainers(&int_set, &fset2) || !CheckEqualContainers(&int_mset, &fmset2))
+         return false;
+      //Ordered unique insertion from forward iterators
+      slist<int> ordered_keys(int_set.begin(), int_set.end());
+      fset2.clear();
+      fset2.insert(ordered_unique_range, ordered_keys.begin(), ordered_keys.end());
+      if(!CheckEqualContainers(&int_set, &fset2))
+         return false;
+   }
+   return true;
+}
+
+//Element whose copies throw once the budget is exhausted. It has no move
+//constructor, so elements are also copied when they are moved.
+struct throwing_copy_int
+{
+   static int copies_left;
+
+   explicit throwing_copy_int(int v)
+      : value(v)
+   {}
+
+   throwing_copy_int(const throwing_copy_int &other)
+      : value(other.value)
+   {
+      if(copies_left == 0){
+         throw std::bad_alloc();
+      }
+      --copies_left;
+   }
+
+   throwing_copy_int &operator=(const throwing_copy_int &other)
+   {  value = other.value; return *this;  }
+
+   friend bool operator<(const throwing_copy_int &l, const throwing_copy_int &r)
+   {  return l.value < r.value;  }
+
+   int value;
+};
+
+int throwing_copy_int::copies_left = -1;
+
+bool flat_tree_bulk_insertion_exception_test()
+{
+   using namespace boost::container;
+   std::vector<throwing_copy_int> stored, inserted;
+   for(int i = 0; i != 10; ++i){
+      stored.push_back(throwing_copy_int(i*2));
+      inserted.push_back(throwing_copy_int(19 - i*2));
+   }
+   //Every copy made by the insertion throws in turn. The stored
+   //elements must be left unchanged and the range must not be inserted.
+   for(int budget = 0; ; ++budget){
+      throwing_copy_int::copies_left = -1;
+      flat_set<throwing_copy_int> fset(ordered_unique_range, stored.begin(), stored.end());
+      throwing_copy_int::copies_left = budget;
+      bool thrown = false;
+      try{
+         fset.insert(inserted.begin(), inserted.end());
+      }
+      catch(std::bad_alloc &){
+         thrown = true;
+      }
+      throwing_copy_int::copies_left = -1;
+      const std::size_t expected = thrown ? stored.size() : stored.size() + inserted.size();
+      if(fset.size() != expected)
+         return false;
+      int i = 0;
+      for(flat_set<throwing_copy_int>::const_iterator it = fset.begin(); it != fset.end(); ++it, ++i){
+         if(it->value != (thrown ? i*2 : i))
+            return false;
+      }
+      if(!thrown)
+         break;
+   }
+   return true;
+}
+
+//Allocator that places consecutive allocations next to each other
+//in a static buffer and never reuses memory.
+template<class T>
+class arena_allocator
+{
+   public:
+   typedef T                  value_type;
+   typedef T *                pointer;
+   typedef const T *          const_pointer;
+   typedef T &                reference;
+   typedef const T &          const_reference;
+   typedef std::size_t        size_type;
+   typedef std::ptrdiff_t     difference_type;
+
+   template<class U>
+   struct rebind
+   {  typedef arena_allocator<U> other;  };
+
+   arena_allocator()
+   {}
+
+   template<class U>
+   arena_allocator(const arena_allocator<U> &)
+   {}
+
+   pointer allocate(size_type n)
+   {
+      const std::size_t bytes = n*sizeof(T);
+      if(used + bytes > sizeof(buffer)){
+         throw std::bad_alloc();
+      }
+      pointer p = reinterpret_cast<pointer>(reinterpret_cast<char*>(buffer) + used);
+      used += bytes;
+      return p;
+   }
+
+   void deallocate(pointer, size_type)
+   {}
+
+   size_type max_size() const
+   {  return sizeof(buffer)/sizeof(T);  }
+
+   friend bool operator==(const arena_allocator &, const arena_allocator &)
+   {  return true;  }
+
+   friend bool operator!=(const arena_allocator &, const arena_allocator &)
+   {  return false;  }
+
+   static std::size_t used;
+   static double buffer[32];
+};
+
+template<class T>
+std::size_t arena_allocator<T>::used = 0;
+
+template<class T>
+double arena_allocator<T>::buffer[32];
+
+bool flat_tree_adjacent_merge_test()
+{
+   using namespace boost::container;
+   typedef flat_set<int, std::less<int>, arena_allocator<int> > arena_set;
+   //The elements of the source are placed right after the
+   //elements of the destination, so they must not be taken as
+   //already placed in the destination.
+   arena_set dst, src;
+   dst.reserve(2);
+   dst.insert(1);
+   dst.insert(2);
+   src.reserve(3);
+   src.insert(3);
+   src.insert(4);
+   src.insert(5);
+   if(&*dst.begin() + 2 != &*src.begin())
+      return false;
+   dst.merge(boost::move(src));
+   if(dst.size() != 5 || dst.capacity() < dst.size() || !src.empty())
+      return false;
+   int i = 1;
+   for(arena_set::const_iterator it = dst.begin(); it != dst.end(); ++it, ++i){
+      if(*it != i)
+         return false;
+   }
+   return true;
+}
+
 }}}
 
 int main()
@@ -484,6 +764,18 @@ int main()
       return 1;
    }
 
+   if(!flat_tree_bulk_insertion_test()){
+      return 1;
+   }
+
+   if(!flat_tree_bulk_insertion_exception_test()){
+      return 1;
+   }
+
+   if(!flat_tree_adjacent_merge_test()){
+      return 1;
+   }
+
    if (0 != set_test<
                   MyBoostSet
                   ,MyStdSet
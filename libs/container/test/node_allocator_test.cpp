@@ -0,0 +1,97 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/container/detail/config_begin.hpp>
+#include <set>
+#include <map>
+#include <boost/container/node_allocator.hpp>
+#include <boost/container/list.hpp>
+#include <boost/container/slist.hpp>
+#include <boost/container/set.hpp>
+#include <boost/container/map.hpp>
+#include <boost/container/vector.hpp>
+#include "print_container.hpp"
+#include "movable_int.hpp"
+#include "list_test.hpp"
+#include "set_test.hpp"
+#include "map_test.hpp"
+#include "vector_test.hpp"
+
+using namespace boost::container;
+
+namespace boost {
+namespace container {
+
+//Explicit instantiations to detect compilation errors
+template class node_allocator<int>;
+template class node_allocator<void>;
+template class node_allocator<test::movable_and_copyable_int, 16>;
+
+template class list<test::movable_and_copyable_int,
+   node_allocator<test::movable_and_copyable_int> >;
+
+template class map<test::movable_and_copyable_int
+                  ,test::movable_and_copyable_int
+                  ,std::less<test::movable_and_copyable_int>
+                  ,node_allocator
+                     < std::pair<const test::movable_and_copyable_int
+                                ,test::movable_and_copyable_int> > >;
+
+}}
+
+typedef std::set<int>                                              MyStdSet;
+typedef std::multiset<int>                                         MyStdMultiSet;
+typedef std::map<int, int>                                         MyStdMap;
+typedef std::multimap<int, int>                                    MyStdMultiMap;
+
+//Alias container types
+typedef list<int, node_allocator<int> >                            MyList;
+typedef slist<int, node_allocator<int> >                           MySlist;
+typedef vector<int, node_allocator<int> >                          MyVector;
+typedef set<int, std::less<int>, node_allocator<int> >             MySet;
+typedef multiset<int, std::less<int>, node_allocator<int> >        MyMultiSet;
+typedef map<int, int, std::less<int>
+           , node_allocator<std::pair<const int, int> > >          MyMap;
+typedef multimap<int, int, std::less<int>
+           , node_allocator<std::pair<const int, int> > >          MyMultiMap;
+
+//Alias movable types
+typedef list<test::movable_int
+            , node_allocator<test::movable_int, 8> >               MyMoveList;
+typedef set<test::movable_and_copyable_int
+           , std::less<test::movable_and_copyable_int>
+           , node_allocator<test::movable_and_copyable_int, 8> >   MyMoveCopySet;
+typedef multiset<test::movable_and_copyable_int
+           , std::less<test::movable_and_copyable_int>
+           , node_allocator<test::movable_and_copyable_int, 8> >   MyMoveCopyMultiSet;
+
+int main ()
+{
+   if(test::list_test<MyList, true>())
+      return 1;
+   if(test::list_test<MySlist, false>())
+      return 1;
+   if(test::list_test<MyMoveList, true>())
+      return 1;
+   if(test::vector_test<MyVector>())
+      return 1;
+   if(test::set_test<MySet, MyStdSet, MyMultiSet, MyStdMultiSet>())
+      return 1;
+   if(test::set_test_copyable<MySet, MyStdSet, MyMultiSet, MyStdMultiSet>())
+      return 1;
+   if(test::set_test<MyMoveCopySet, MyStdSet, MyMoveCopyMultiSet, MyStdMultiSet>())
+      return 1;
+   if(test::map_test<MyMap, MyStdMap, MyMultiMap, MyStdMultiMap>())
+      return 1;
+   if(test::map_test_copyable<MyMap, MyStdMap, MyMultiMap, MyStdMultiMap>())
+      return 1;
+   return 0;
+}
+
+#include <boost/container/detail/config_end.hpp>
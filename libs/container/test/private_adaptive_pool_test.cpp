@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/container/detail/config_begin.hpp>
+#include <set>
+#include <map>
+#include <boost/container/private_adaptive_pool.hpp>
+#include <boost/container/list.hpp>
+#include <boost/container/slist.hpp>
+#include <boost/container/set.hpp>
+#include <boost/container/map.hpp>
+#include <boost/container/vector.hpp>
+#include "print_container.hpp"
+#include "movable_int.hpp"
+#include "list_test.hpp"
+#include "set_test.hpp"
+#include "map_test.hpp"
+#include "vector_test.hpp"
+
+using namespace boost::container;
+
+namespace boost {
+namespace container {
+
+//Explicit instantiations to detect compilation errors
+template class private_adaptive_pool<int>;
+template class private_adaptive_pool<void>;
+template class private_adaptive_pool<test::movable_and_copyable_int, 16, 0, 2>;
+
+template class list<test::movable_and_copyable_int,
+   private_adaptive_pool<test::movable_and_copyable_int> >;
+
+template class map<test::movable_and_copyable_int
+                  ,test::movable_and_copyable_int
+                  ,std::less<test::movable_and_copyable_int>
+                  ,private_adaptive_pool
+                     < std::pair<const test::movable_and_copyable_int
+                                ,test::movable_and_copyable_int> > >;
+
+}}
+
+typedef std::set<int>                                                        MyStdSet;
+typedef std::multiset<int>                                                   MyStdMultiSet;
+typedef std::map<int, int>                                                   MyStdMap;
+typedef std::multimap<int, int>                                              MyStdMultiMap;
+
+//Alias container types
+typedef list<int, private_adaptive_pool<int> >                               MyList;
+typedef slist<int, private_adaptive_pool<int> >                              MySlist;
+typedef vector<int, private_adaptive_pool<int> >                             MyVector;
+typedef set<int, std::less<int>, private_adaptive_pool<int> >                MySet;
+typedef multiset<int, std::less<int>, private_adaptive_pool<int> >           MyMultiSet;
+typedef map<int, int, std::less<int>
+           , private_adaptive_pool<std::pair<const int, int> > >             MyMap;
+typedef multimap<int, int, std::less<int>
+           , private_adaptive_pool<std::pair<const int, int> > >             MyMultiMap;
+
+//Alias movable types
+typedef list<test::movable_int
+            , private_adaptive_pool<test::movable_int, 8, 0> >               MyMoveList;
+typedef set<test::movable_and_copyable_int
+           , std::less<test::movable_and_copyable_int>
+           , private_adaptive_pool<test::movable_and_copyable_int, 8, 0> >   MyMoveCopySet;
+typedef multiset<test::movable_and_copyable_int
+           , std::less<test::movable_and_copyable_int>
+           , private_adaptive_pool<test::movable_and_copyable_int, 8, 0> >   MyMoveCopyMultiSet;
+
+int main ()
+{
+   //Copies of a private_adaptive_pool don't share its pool,
+   //so copied allocators never compare equal
+   if(test::list_test<MyList, true>(false))
+      return 1;
+   if(test::list_test<MySlist, false>(false))
+      return 1;
+   if(test::list_test<MyMoveList, true>(false))
+      return 1;
+   if(test::vector_test<MyVector>())
+      return 1;
+   if(test::set_test<MySet, MyStdSet, MyMultiSet, MyStdMultiSet>())
+      return 1;
+   if(test::set_test_copyable<MySet, MyStdSet, MyMultiSet, MyStdMultiSet>())
+      return 1;
+   if(test::set_test<MyMoveCopySet, MyStdSet, MyMoveCopyMultiSet, MyStdMultiSet>())
+      return 1;
+   if(test::map_test<MyMap, MyStdMap, MyMultiMap, MyStdMultiMap>())
+      return 1;
+   if(test::map_test_copyable<MyMap, MyStdMap, MyMultiMap, MyStdMultiMap>())
+      return 1;
+   return 0;
+}
+
+#include <boost/container/detail/config_end.hpp>
@@ -0,0 +1,193 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/container/detail/config_begin.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <iostream>
+#include <functional>
+
+#include <boost/container/small_vector.hpp>
+#include <boost/move/move.hpp>
+#include "check_equal_containers.hpp"
+#include "movable_int.hpp"
+#include "dummy_test_allocator.hpp"
+#include "vector_test.hpp"
+
+using namespace boost::container;
+
+namespace boost {
+namespace container {
+
+//Explicit instantiation to detect compilation errors
+template class boost::container::small_vector<test::movable_and_copyable_int, 10,
+   test::simple_allocator<test::movable_and_copyable_int> >;
+
+template class boost::container::small_vector<test::movable_and_copyable_int, 10,
+   std::allocator<test::movable_and_copyable_int> >;
+
+}}
+
+//An allocator that counts the live allocations
+static int live_allocations = 0;
+
+template<class T>
+class counting_allocator
+   : public std::allocator<T>
+{
+   public:
+   counting_allocator()
+   {}
+
+   T* allocate(std::size_t n)
+   {
+      ++live_allocations;
+      return std::allocator<T>::allocate(n);
+   }
+
+   void deallocate(T *p, std::size_t n)
+   {
+      --live_allocations;
+      std::allocator<T>::deallocate(p, n);
+   }
+};
+
+typedef small_vector<test::movable_int, 4, counting_allocator<test::movable_int> > counted_vector;
+
+template<class SmallVector>
+bool is_internal(const SmallVector &v)
+{
+   const char *data = reinterpret_cast<const char*>(v.data());
+   const char *self = reinterpret_cast<const char*>(&v);
+   return data >= self && data < self + sizeof(v);
+}
+
+bool check_values(const counted_vector &v, int first, int count)
+{
+   if(v.size() != std::size_t(count))
+      return false;
+   for(int i = 0; i != count; ++i){
+      if(v[i] != test::movable_int(first + i))
+         return false;
+   }
+   return true;
+}
+
+void fill(counted_vector &v, int first, int count)
+{
+   v.clear();
+   for(int i = 0; i != count; ++i){
+      v.push_back(test::movable_int(first + i));
+   }
+}
+
+bool test_internal_buffer()
+{
+   {
+      //Up to N elements are stored without allocations
+      counted_vector v;
+      if(v.capacity() != 4 || !is_internal(v))
+         return false;
+      fill(v, 0, 4);
+      if(live_allocations != 0 || !is_internal(v))
+         return false;
+      v.push_back(test::movable_int(4));
+      if(live_allocations != 1 || is_internal(v) || !check_values(v, 0, 5))
+         return false;
+
+      //Moving a dynamic buffer transfers it and x gets its internal buffer back
+      counted_vector moved(boost::move(v));
+      if(live_allocations != 1 || !check_values(moved, 0, 5))
+         return false;
+      if(!v.empty() || v.capacity() != 4 || !is_internal(v))
+         return false;
+
+      //Moving the internal buffer moves the elements
+      fill(v, 10, 3);
+      counted_vector moved2(boost::move(v));
+      if(live_allocations != 1 || !is_internal(moved2) || !check_values(moved2, 10, 3) || !v.empty())
+         return false;
+
+      moved2 = boost::move(moved);
+      if(live_allocations != 1 || is_internal(moved2) || !check_values(moved2, 0, 5))
+         return false;
+      if(!moved.empty() || !is_internal(moved))
+         return false;
+
+      //Swap all the combinations of internal and dynamic buffers
+      counted_vector a, b;
+      fill(a, 0, 2);
+      fill(b, 10, 3);
+      a.swap(b);
+      if(!check_values(a, 10, 3) || !check_values(b, 0, 2) || !is_internal(a) || !is_internal(b))
+         return false;
+      fill(a, 0, 6);
+      a.swap(b);
+      if(!check_values(a, 0, 2) || !check_values(b, 0, 6) || !is_internal(a) || is_internal(b))
+         return false;
+      a.swap(b);
+      if(!check_values(a, 0, 6) || !check_values(b, 0, 2))
+         return false;
+      fill(b, 20, 8);
+      boost::container::swap(a, b);
+      if(!check_values(a, 20, 8) || !check_values(b, 0, 6))
+         return false;
+
+      //shrink_to_fit goes back to the internal buffer when possible
+      b.erase(b.begin() + 3, b.end());
+      b.shrink_to_fit();
+      if(!is_internal(b) || !check_values(b, 0, 3))
+         return false;
+      a.erase(a.begin() + 6, a.end());
+      a.shrink_to_fit();
+      if(a.capacity() != 6 || !check_values(a, 20, 6))
+         return false;
+      if(live_allocations != 2)
+         return false;
+   }
+   return live_allocations == 0;
+}
+
+int main()
+{
+   {
+      //Now test move semantics
+      small_vector<int, 3> original;
+      small_vector<int, 3> move_ctor(boost::move(original));
+      small_vector<int, 3> move_assign;
+      move_assign = boost::move(move_ctor);
+      move_assign.swap(original);
+   }
+   typedef small_vector<int, 10> MyVector;
+   typedef small_vector<test::movable_int, 10> MyMoveVector;
+   typedef small_vector<test::movable_and_copyable_int, 10> MyCopyMoveVector;
+   typedef small_vector<test::copyable_int, 10> MyCopyVector;
+
+   if(test::vector_test<MyVector>())
+      return 1;
+   if(test::vector_test<MyMoveVector>())
+      return 1;
+   if(test::vector_test<MyCopyMoveVector>())
+      return 1;
+   if(test::vector_test<MyCopyVector>())
+      return 1;
+
+   if(!test_internal_buffer())
+      return 1;
+
+   const test::EmplaceOptions Options = (test::EmplaceOptions)(test::EMPLACE_BACK | test::EMPLACE_BEFORE);
+   if(!boost::container::test::test_emplace
+      < small_vector<test::EmplaceInt, 5>, Options>())
+      return 1;
+
+   return 0;
+}
+
+#include <boost/container/detail/config_end.hpp>
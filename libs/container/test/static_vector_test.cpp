@@ -0,0 +1,154 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/container/detail/config_begin.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <iostream>
+#include <functional>
+#include <new>
+
+#include <boost/container/static_vector.hpp>
+#include <boost/move/move.hpp>
+#include "check_equal_containers.hpp"
+#include "movable_int.hpp"
+#include "vector_test.hpp"
+
+using namespace boost::container;
+
+namespace boost {
+namespace container {
+
+//Explicit instantiation to detect compilation errors
+template class boost::container::static_vector<test::movable_and_copyable_int, 10>;
+
+}}
+
+typedef static_vector<test::movable_int, 8> movable_vector;
+
+bool check_values(const movable_vector &v, int first, int count)
+{
+   if(v.size() != std::size_t(count))
+      return false;
+   for(int i = 0; i != count; ++i){
+      if(v[i] != test::movable_int(first + i))
+         return false;
+   }
+   return true;
+}
+
+void fill(movable_vector &v, int first, int count)
+{
+   v.clear();
+   for(int i = 0; i != count; ++i){
+      v.push_back(test::movable_int(first + i));
+   }
+}
+
+bool test_fixed_capacity()
+{
+   movable_vector v;
+   if(v.capacity() != 8 || v.max_size() != 8)
+      return false;
+
+   //Elements are stored in the object
+   fill(v, 0, 8);
+   const char *data = reinterpret_cast<const char*>(v.data());
+   const char *self = reinterpret_cast<const char*>(&v);
+   if(data < self || data >= self + sizeof(v))
+      return false;
+
+   //Exceeding the capacity throws and leaves the vector untouched
+   bool thrown = false;
+   try{
+      v.push_back(test::movable_int(8));
+   }
+   catch(std::bad_alloc &){
+      thrown = true;
+   }
+   if(!thrown || !check_values(v, 0, 8))
+      return false;
+   thrown = false;
+   try{
+      v.reserve(9);
+   }
+   catch(std::bad_alloc &){
+      thrown = true;
+   }
+   if(!thrown || v.capacity() != 8)
+      return false;
+   thrown = false;
+   try{
+      static_vector<int, 8> too_big(9u);
+   }
+   catch(std::bad_alloc &){
+      thrown = true;
+   }
+   if(!thrown)
+      return false;
+
+   //Move and swap move the elements
+   movable_vector moved(boost::move(v));
+   if(!check_values(moved, 0, 8) || !v.empty() || v.capacity() != 8)
+      return false;
+   fill(v, 10, 3);
+   moved = boost::move(v);
+   if(!check_values(moved, 10, 3) || !v.empty())
+      return false;
+   fill(v, 20, 5);
+   v.swap(moved);
+   if(!check_values(v, 10, 3) || !check_values(moved, 20, 5))
+      return false;
+   boost::container::swap(v, moved);
+   if(!check_values(v, 20, 5) || !check_values(moved, 10, 3))
+      return false;
+
+   v.clear();
+   v.shrink_to_fit();
+   return v.capacity() == 8;
+}
+
+int main()
+{
+   {
+      //Now test move semantics
+      static_vector<int, 3> original;
+      static_vector<int, 3> move_ctor(boost::move(original));
+      static_vector<int, 3> move_assign;
+      move_assign = boost::move(move_ctor);
+      move_assign.swap(original);
+   }
+   //vector_test needs room for a few hundred elements
+   typedef static_vector<int, 2000> MyVector;
+   typedef static_vector<test::movable_int, 2000> MyMoveVector;
+   typedef static_vector<test::movable_and_copyable_int, 2000> MyCopyMoveVector;
+   typedef static_vector<test::copyable_int, 2000> MyCopyVector;
+
+   if(test::vector_test<MyVector>())
+      return 1;
+   if(test::vector_test<MyMoveVector>())
+      return 1;
+   if(test::vector_test<MyCopyMoveVector>())
+      return 1;
+   if(test::vector_test<MyCopyVector>())
+      return 1;
+
+   if(!test_fixed_capacity())
+      return 1;
+
+   const test::EmplaceOptions Options = (test::EmplaceOptions)(test::EMPLACE_BACK | test::EMPLACE_BEFORE);
+   if(!boost::container::test::test_emplace
+      < static_vector<test::EmplaceInt, 10>, Options>())
+      return 1;
+
+   return 0;
+}
+
+#include <boost/container/detail/config_end.hpp>
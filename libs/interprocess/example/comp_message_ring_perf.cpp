@@ -0,0 +1,221 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Measures the throughput and latency of messages sent to another process
+//with message_queue and with message_ring, with and without blocking waits.
+//
+//usage: comp_message_ring_perf [messages] [message size]
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/ipc/message_queue.hpp>
+#include <boost/interprocess/ipc/message_ring.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include "../test/get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+//A pair of message queues, one for each direction
+class queue_channel
+{
+   public:
+   queue_channel(const std::string &name, bool parent)
+      :  m_to_child  (open_only, (name + "_to_child").c_str())
+      ,  m_to_parent (open_only, (name + "_to_parent").c_str())
+      ,  m_send(parent ? m_to_child  : m_to_parent)
+      ,  m_recv(parent ? m_to_parent : m_to_child)
+   {}
+
+   void send(const void *buffer, std::size_t size)
+   {  m_send.send(buffer, size, 0);  }
+
+   void receive(void *buffer, std::size_t size)
+   {
+      message_queue::size_type recvd;
+      unsigned int priority;
+      m_recv.receive(buffer, size, recvd, priority);
+   }
+
+   private:
+   message_queue m_to_child, m_to_parent;
+   message_queue &m_send, &m_recv;
+};
+
+//A pair of rings, one for each direction, placed in a mapped region
+class ring_channel
+{
+   public:
+   ring_channel(void *to_child, void *to_parent, bool parent)
+      :  m_to_child  (open_only, to_child)
+      ,  m_to_parent (open_only, to_parent)
+      ,  m_send(parent ? m_to_child  : m_to_parent)
+      ,  m_recv(parent ? m_to_parent : m_to_child)
+   {}
+
+   void send(const void *buffer, std::size_t size)
+   {  m_send.send(buffer, size);  }
+
+   void receive(void *buffer, std::size_t size)
+   {
+      message_ring::size_type recvd;
+      m_recv.receive(buffer, size, recvd);
+   }
+
+   private:
+   message_ring m_to_child, m_to_parent;
+   message_ring &m_send, &m_recv;
+};
+
+struct result
+{
+   double msgs_per_sec;
+   double latency_us;
+};
+
+//The parent sends all the messages and waits for an acknowledgement,
+//then sends messages one by one waiting for the reply.
+template<class Channel>
+result run_parent(Channel &channel, std::size_t messages, std::size_t size)
+{
+   std::vector<char> buffer(size, 'a');
+   result r;
+
+   boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+   for(std::size_t i = 0; i != messages; ++i){
+      channel.send(&buffer[0], size);
+   }
+   channel.receive(&buffer[0], size);
+   boost::posix_time::ptime stop = boost::posix_time::microsec_clock::universal_time();
+   r.msgs_per_sec = messages/((stop - start).total_microseconds()/1e6);
+
+   const std::size_t round_trips = messages/10 ? messages/10 : 1;
+   start = boost::posix_time::microsec_clock::universal_time();
+   for(std::size_t i = 0; i != round_trips; ++i){
+      channel.send(&buffer[0], size);
+      channel.receive(&buffer[0], size);
+   }
+   stop = boost::posix_time::microsec_clock::universal_time();
+   r.latency_us = (stop - start).total_microseconds()/(2.0*round_trips);
+   return r;
+}
+
+template<class Channel>
+void run_child(Channel &channel, std::size_t messages, std::size_t size)
+{
+   std::vector<char> buffer(size);
+   for(std::size_t i = 0; i != messages; ++i){
+      channel.receive(&buffer[0], size);
+   }
+   channel.send(&buffer[0], size);
+
+   const std::size_t round_trips = messages/10 ? messages/10 : 1;
+   for(std::size_t i = 0; i != round_trips; ++i){
+      channel.receive(&buffer[0], size);
+      channel.send(&buffer[0], size);
+   }
+}
+
+void launch(const std::string &command, bool *ok)
+{
+   *ok = 0 == std::system(command.c_str());
+}
+
+int main(int argc, char *argv[])
+{
+   const bool child = argc > 1 && 0 == std::strcmp(argv[1], "child");
+   const int first_arg = child ? 3 : 1;
+   const std::size_t messages = argc > first_arg     ? std::strtoul(argv[first_arg], 0, 10)     : 1000000;
+   const std::size_t size     = argc > first_arg + 1 ? std::strtoul(argv[first_arg + 1], 0, 10) : 64;
+   if(messages == 0 || size == 0){
+      std::cerr << "usage: comp_message_ring_perf [messages] [message size]" << std::endl;
+      return 1;
+   }
+
+   const std::string name(child ? argv[2] : test::get_process_id_name());
+   const std::size_t max_queued = 256;
+   const std::size_t ring_size = message_ring::get_mem_size(max_queued*size/2);
+
+   if(!child){
+      message_queue::remove((name + "_to_child").c_str());
+      message_queue::remove((name + "_to_parent").c_str());
+      shared_memory_object::remove(name.c_str());
+      message_queue to_child (create_only, (name + "_to_child").c_str(),  max_queued, size);
+      message_queue to_parent(create_only, (name + "_to_parent").c_str(), max_queued, size);
+      shared_memory_object shm(create_only, name.c_str(), read_write);
+      shm.truncate(4*ring_size);
+      mapped_region region(shm, read_write);
+      char *base = static_cast<char*>(region.get_address());
+      //Rings using futexes to wait and rings spinning
+      message_ring r0(create_only, base,               ring_size, true);
+      message_ring r1(create_only, base +   ring_size, ring_size, true);
+      message_ring r2(create_only, base + 2*ring_size, ring_size, false);
+      message_ring r3(create_only, base + 3*ring_size, ring_size, false);
+
+      std::ostringstream command;
+      command << argv[0] << " child " << name << ' ' << messages << ' ' << size;
+      bool ok = false;
+      boost::thread child_process(boost::bind(&launch, command.str(), &ok));
+
+      queue_channel queue(name, true);
+      ring_channel ring_blocking(base, base + ring_size, true);
+      ring_channel ring_spinning(base + 2*ring_size, base + 3*ring_size, true);
+      result rq = run_parent(queue, messages, size);
+      result rb = run_parent(ring_blocking, messages, size);
+      result rs = run_parent(ring_spinning, messages, size);
+      child_process.join();
+
+      message_queue::remove((name + "_to_child").c_str());
+      message_queue::remove((name + "_to_parent").c_str());
+      shared_memory_object::remove(name.c_str());
+      if(!ok){
+         std::cerr << "the child process failed" << std::endl;
+         return 1;
+      }
+
+      std::cout << "messages: " << messages << ", size: " << size << " bytes\n"
+                << std::setw(24) << " "
+                << std::setw(16) << "messages/s"
+                << std::setw(16) << "latency (us)" << std::endl << std::fixed;
+      std::cout << std::setw(24) << "message_queue"
+                << std::setw(16) << std::setprecision(0) << rq.msgs_per_sec
+                << std::setw(16) << std::setprecision(2) << rq.latency_us << std::endl;
+      std::cout << std::setw(24) << "message_ring (futex)"
+                << std::setw(16) << std::setprecision(0) << rb.msgs_per_sec
+                << std::setw(16) << std::setprecision(2) << rb.latency_us << std::endl;
+      std::cout << std::setw(24) << "message_ring (spin)"
+                << std::setw(16) << std::setprecision(0) << rs.msgs_per_sec
+                << std::setw(16) << std::setprecision(2) << rs.latency_us << std::endl;
+   }
+   else{
+      shared_memory_object shm(open_only, name.c_str(), read_write);
+      mapped_region region(shm, read_write);
+      char *base = static_cast<char*>(region.get_address());
+
+      queue_channel queue(name, false);
+      ring_channel ring_blocking(base, base + ring_size, false);
+      ring_channel ring_spinning(base + 2*ring_size, base + 3*ring_size, false);
+      run_child(queue, messages, size);
+      run_child(ring_blocking, messages, size);
+      run_child(ring_spinning, messages, size);
+   }
+   return 0;
+}
+
+#include <boost/interprocess/detail/config_end.hpp>
@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Times several processes allocating and freeing small blocks from the same
+//managed shared memory segment at once, with rbtree_best_fit and
+//segregated_fit.
+//
+//usage: comp_segregated_fit_perf [maximum processes] [operations per process]
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/mem_algo/rbtree_best_fit.hpp>
+#include <boost/interprocess/mem_algo/segregated_fit.hpp>
+#include <boost/interprocess/indexes/iset_index.hpp>
+#include <boost/interprocess/sync/mutex_family.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include "../test/get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+typedef basic_managed_shared_memory
+   <char, rbtree_best_fit<mutex_family>, iset_index>  rbtree_shared_memory;
+
+typedef basic_managed_shared_memory
+   <char, segregated_fit<mutex_family>, iset_index>   segregated_shared_memory;
+
+static const std::size_t SegmentSize = 64*1024*1024;
+
+//Each process keeps a small working set of blocks of mixed sizes
+//allocating a batch and freeing it in a different order.
+template<class ManagedMemory>
+int child(const char *name, std::size_t index, unsigned long operations)
+{
+   ManagedMemory segment(open_only, name);
+   unsigned long *times = segment.template find<unsigned long>("times").first;
+   if(!times)
+      return 1;
+
+   const std::size_t Batch = 16;
+   void *live[Batch];
+
+   boost::posix_time::ptime start =
+      boost::posix_time::microsec_clock::universal_time();
+   for(unsigned long i = 0; i < operations; i += Batch){
+      for(std::size_t j = 0; j < Batch; ++j){
+         live[j] = segment.allocate(8 + ((i + j)*24) % 200);
+         std::memset(live[j], 0, 8);
+      }
+      for(std::size_t j = 0; j < Batch; ++j){
+         segment.deallocate(live[(j*7) % Batch]);
+      }
+   }
+   boost::posix_time::ptime stop =
+      boost::posix_time::microsec_clock::universal_time();
+   times[index] = static_cast<unsigned long>((stop - start).total_microseconds());
+   return 0;
+}
+
+void launch(const std::string &command, bool *ok)
+{
+   *ok = 0 == std::system(command.c_str());
+}
+
+//Returns millions of allocate/free pairs per second for all the processes
+template<class ManagedMemory>
+double parent(const char *argv0, const char *algo, std::size_t processes, unsigned long operations)
+{
+   std::string name(test::get_process_id_name());
+   name += algo;
+   shared_memory_object::remove(name.c_str());
+   double result = 0.0;
+   {
+      ManagedMemory segment(create_only, name.c_str(), SegmentSize);
+      unsigned long *times = segment.template construct<unsigned long>("times")[processes](0ul);
+
+      bool ok[64];
+      boost::thread_group threads;
+      for(std::size_t i = 0; i < processes; ++i){
+         std::ostringstream command;
+         command << argv0 << " child " << algo << ' ' << name << ' ' << i << ' ' << operations;
+         threads.create_thread(boost::bind(&launch, command.str(), &ok[i]));
+      }
+      threads.join_all();
+
+      unsigned long slowest = 1;
+      for(std::size_t i = 0; i < processes; ++i){
+         if(!ok[i]){
+            slowest = 0;
+            break;
+         }
+         if(times[i] > slowest)
+            slowest = times[i];
+      }
+      if(slowest){
+         result = static_cast<double>(operations)*processes/slowest;
+      }
+   }
+   shared_memory_object::remove(name.c_str());
+   return result;
+}
+
+int main(int argc, char *argv[])
+{
+   if(argc > 1 && 0 == std::strcmp(argv[1], "child")){
+      if(argc != 6)
+         return 1;
+      std::size_t index = std::strtoul(argv[4], 0, 10);
+      unsigned long operations = std::strtoul(argv[5], 0, 10);
+      if(0 == std::strcmp(argv[2], "rbtree"))
+         return child<rbtree_shared_memory>(argv[3], index, operations);
+      else
+         return child<segregated_shared_memory>(argv[3], index, operations);
+   }
+
+   const std::size_t max_processes = argc > 1 ? std::strtoul(argv[1], 0, 10) : 8;
+   const unsigned long operations  = argc > 2 ? std::strtoul(argv[2], 0, 10) : 1000000;
+   if(max_processes == 0 || max_processes > 64 || operations == 0){
+      std::cerr << "usage: comp_segregated_fit_perf [maximum processes (1-64)] [operations per process]" << std::endl;
+      return 1;
+   }
+
+   std::cout << "operations per process: " << operations << "\n"
+             << "millions of allocate/free pairs per second:\n"
+             << std::setw(10) << "processes"
+             << std::setw(18) << "rbtree_best_fit"
+             << std::setw(18) << "segregated_fit" << std::endl;
+
+   for(std::size_t processes = 1; processes <= max_processes; processes *= 2){
+      double rbtree     = parent<rbtree_shared_memory>(argv[0], "rbtree", processes, operations);
+      double segregated = parent<segregated_shared_memory>(argv[0], "segregated", processes, operations);
+      if(rbtree == 0.0 || segregated == 0.0){
+         std::cerr << "a child process failed" << std::endl;
+         return 1;
+      }
+      std::cout << std::setw(10) << processes << std::fixed << std::setprecision(2)
+                << std::setw(18) << rbtree
+                << std::setw(18) << segregated << std::endl;
+   }
+   return 0;
+}
+
+#include <boost/interprocess/detail/config_end.hpp>
@@ -12,6 +12,7 @@
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/interprocess/mem_algo/simple_seq_fit.hpp>
 #include <boost/interprocess/mem_algo/rbtree_best_fit.hpp>
+#include <boost/interprocess/mem_algo/segregated_fit.hpp>
 #include <boost/interprocess/indexes/null_index.hpp>
 #include <boost/interprocess/sync/mutex_family.hpp>
 #include <boost/interprocess/detail/type_traits.hpp>
@@ -67,6 +68,27 @@ int test_rbtree_best_fit()
    return 0;
 }
 
+template<std::size_t Alignment>
+int test_segregated_fit()
+{
+   //A shared memory with segregated fit algorithm
+   typedef basic_managed_shared_memory
+      <char
+      ,segregated_fit<mutex_family, offset_ptr<void>, Alignment>
+      ,null_index
+      > my_managed_shared_memory;
+
+   //Create shared memory
+   shared_memory_object::remove(shMemName);
+   my_managed_shared_memory segment(create_only, shMemName, memsize);
+
+   //Now take the segment manager and launch memory test
+   if(!test::test_all_allocation(*segment.get_segment_manager())){
+      return 1;
+   }
+   return 0;
+}
+
 int main ()
 {
    const std::size_t void_ptr_align = ::boost::alignment_of<offset_ptr<void> >::value;
@@ -83,6 +105,15 @@ int main ()
    if(test_rbtree_best_fit<4*void_ptr_align>()){
       return 1;
    }
+   if(test_segregated_fit<void_ptr_align>()){
+      return 1;
+   }
+   if(test_segregated_fit<2*void_ptr_align>()){
+      return 1;
+   }
+   if(test_segregated_fit<4*void_ptr_align>()){
+      return 1;
+   }
 
    shared_memory_object::remove(shMemName);
    return 0;
@@ -0,0 +1,250 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/ipc/message_ring.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/detail/os_thread_functions.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <vector>
+#include <cstring>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+//Message contents are derived from the producer, the sequence number and
+//the length, so the receiver can check them
+struct msg_header
+{
+   unsigned int producer;
+   unsigned int seq;
+};
+
+std::size_t msg_length(unsigned int producer, unsigned int seq)
+{  return sizeof(msg_header) + (producer*7 + seq*13) % 90;  }
+
+void fill_msg(void *buffer, unsigned int producer, unsigned int seq)
+{
+   msg_header h = { producer, seq };
+   std::memcpy(buffer, &h, sizeof(h));
+   std::memset(static_cast<char*>(buffer) + sizeof(h), int(seq & 0xFF)
+              ,msg_length(producer, seq) - sizeof(h));
+}
+
+bool check_msg(const void *buffer, std::size_t size, msg_header &h)
+{
+   std::memcpy(&h, buffer, sizeof(h));
+   if(size != msg_length(h.producer, h.seq))
+      return false;
+   const unsigned char *p = static_cast<const unsigned char*>(buffer) + sizeof(h);
+   for(std::size_t i = sizeof(h); i != size; ++i, ++p){
+      if(*p != (h.seq & 0xFF))
+         return false;
+   }
+   return true;
+}
+
+template<class Ring>
+bool test_single_thread(void *addr, std::size_t size, bool blocking_wait)
+{
+   Ring sender(create_only, addr, size, blocking_wait);
+   Ring receiver(open_only, addr);
+   typename Ring::size_type recvd;
+   char buffer[256];
+
+   if(receiver.try_receive(buffer, sizeof(buffer), recvd))
+      return false;
+
+   //Messages bigger than the maximum are rejected
+   bool thrown = false;
+   try{
+      sender.send(buffer, sender.get_max_msg_size() + 1);
+   }
+   catch(interprocess_exception &){
+      thrown = true;
+   }
+   if(!thrown)
+      return false;
+
+   //Send and receive many times the capacity, to wrap the ring
+   for(unsigned int round = 0; round < 100; ++round){
+      unsigned int sent = 0;
+      for(; ; ++sent){
+         void *p = sender.try_reserve(msg_length(0, sent));
+         if(!p)
+            break;
+         fill_msg(p, 0, sent);
+         sender.commit(msg_length(0, sent));
+      }
+      if(!sent)
+         return false;
+
+      //The ring is full
+      fill_msg(buffer, 0, sent);
+      if(!round && sender.timed_send(buffer, msg_length(0, sent),
+            microsec_clock::universal_time() + boost::posix_time::milliseconds(10)))
+         return false;
+
+      for(unsigned int i = 0; i != sent; ++i){
+         msg_header h;
+         receiver.receive(buffer, sizeof(buffer), recvd);
+         if(!check_msg(buffer, recvd, h) || h.seq != i)
+            return false;
+      }
+      if(!round && receiver.timed_receive(buffer, sizeof(buffer), recvd,
+            microsec_clock::universal_time() + boost::posix_time::milliseconds(10)))
+         return false;
+   }
+
+   //A message can be committed with less bytes than reserved,
+   //and read in place
+   void *p = sender.reserve(100);
+   std::memset(p, 1, 10);
+   sender.commit(10);
+   sender.send(buffer, 0);
+   typename Ring::size_type msg_size;
+   const void *msg = receiver.peek(msg_size);
+   if(msg_size != 10 || static_cast<const char*>(msg)[9] != 1)
+      return false;
+   receiver.release();
+   msg = receiver.try_peek(msg_size);
+   if(!msg || msg_size != 0)
+      return false;
+   receiver.release();
+
+   //A message that does not fit in the buffer stays in the ring,
+   //and can be received again with a buffer that is big enough
+   fill_msg(buffer, 0, 1);
+   sender.send(buffer, msg_length(0, 1));
+   for(int i = 0; i != 3; ++i){
+      thrown = false;
+      try{
+         if(i == 0)
+            receiver.try_receive(buffer, sizeof(msg_header), recvd);
+         else if(i == 1)
+            receiver.timed_receive(buffer, sizeof(msg_header), recvd,
+               microsec_clock::universal_time() + boost::posix_time::milliseconds(10));
+         else
+            receiver.receive(buffer, sizeof(msg_header), recvd);
+      }
+      catch(interprocess_exception &){
+         thrown = true;
+      }
+      if(!thrown)
+         return false;
+   }
+   msg_header h;
+   if(!receiver.try_receive(buffer, sizeof(buffer), recvd) ||
+      !check_msg(buffer, recvd, h) || h.seq != 1)
+      return false;
+   return !receiver.try_peek(msg_size);
+}
+
+template<class Ring>
+void produce(void *addr, unsigned int producer, unsigned int count)
+{
+   Ring ring(open_only, addr);
+   for(unsigned int seq = 0; seq != count; ++seq){
+      std::size_t len = msg_length(producer, seq);
+      fill_msg(ring.reserve(len), producer, seq);
+      ring.commit(len);
+   }
+}
+
+template<class Ring>
+void consume(void *addr, unsigned int producers, unsigned int count, bool *ok)
+{
+   Ring ring(open_only, addr);
+   std::vector<unsigned int> next(producers, 0u);
+   for(unsigned int i = 0; i != producers*count; ++i){
+      typename Ring::size_type size;
+      const void *p = ring.peek(size);
+      msg_header h;
+      if(!check_msg(p, size, h) || h.producer >= producers || next[h.producer] != h.seq){
+         *ok = false;
+      }
+      else{
+         ++next[h.producer];
+      }
+      ring.release();
+   }
+}
+
+template<class Ring>
+bool test_threads(void *addr, std::size_t size, unsigned int producers, bool blocking_wait)
+{
+   const unsigned int count = 20000;
+   Ring ring(create_only, addr, size, blocking_wait);
+   bool ok = true;
+   boost::thread_group threads;
+   threads.create_thread(boost::bind(&consume<Ring>, addr, producers, count, &ok));
+   for(unsigned int i = 0; i != producers; ++i){
+      threads.create_thread(boost::bind(&produce<Ring>, addr, i, count));
+   }
+   threads.join_all();
+   typename Ring::size_type msg_size;
+   return ok && !ring.try_peek(msg_size);
+}
+
+//A small ring is used to wrap it often, and a bigger one for threads
+//so that they don't need to wait for each other all the time
+template<class Ring>
+bool test_ring(void *addr, std::size_t small_size, std::size_t size, unsigned int producers)
+{
+   for(int blocking_wait = 0; blocking_wait != 2; ++blocking_wait){
+      if(!test_single_thread<Ring>(addr, small_size, blocking_wait != 0))
+         return false;
+      if(!test_threads<Ring>(addr, size, producers, blocking_wait != 0))
+         return false;
+   }
+   return true;
+}
+
+int main ()
+{
+   const char *const shMemName = test::get_process_id_name();
+
+   //The ring placed in a managed segment
+   shared_memory_object::remove(shMemName);
+   {
+      managed_shared_memory segment(create_only, shMemName, 65536);
+      const std::size_t small_size = message_ring::get_mem_size(200);
+      const std::size_t size = message_ring::get_mem_size(8192);
+      void *addr = segment.allocate(size);
+      if(!test_ring<message_ring>(addr, small_size, size, 1)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+      if(!test_ring<mpsc_message_ring>(addr, small_size, size, 4)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+      segment.deallocate(addr);
+   }
+   shared_memory_object::remove(shMemName);
+
+   //The ring placed in a mapped region
+   {
+      shared_memory_object shm(create_only, shMemName, read_write);
+      shm.truncate(32768);
+      mapped_region region(shm, read_write);
+      if(!test_ring<mpsc_message_ring>(region.get_address(), 1024, region.get_size(), 2)){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+   }
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
+
+#include <boost/interprocess/detail/config_end.hpp>
@@ -0,0 +1,161 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2012. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/interprocess for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/interprocess/detail/config_begin.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/mem_algo/segregated_fit.hpp>
+#include <boost/interprocess/indexes/null_index.hpp>
+#include <boost/interprocess/sync/mutex_family.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include "get_process_id_name.hpp"
+
+using namespace boost::interprocess;
+
+typedef basic_managed_shared_memory
+   <char
+   ,segregated_fit<mutex_family>
+   ,null_index
+   > my_managed_shared_memory;
+
+typedef my_managed_shared_memory::segment_manager segment_manager_t;
+typedef segment_manager_t::multiallocation_chain multiallocation_chain;
+
+//Blocks freed to the free lists must be reused by the next
+//allocations of the same size, and still count as free memory
+bool test_reuse(segment_manager_t &sm)
+{
+   const std::size_t free_memory = sm.get_free_memory();
+   std::vector<void*> buffers;
+   for(int i = 0; i < 100; ++i){
+      void *ptr = sm.allocate(24);
+      std::memset(ptr, 0xFF, sm.size(ptr));
+      buffers.push_back(ptr);
+   }
+   for(int i = 0; i < 100; ++i){
+      sm.deallocate(buffers[i]);
+   }
+   if(free_memory != sm.get_free_memory())
+      return false;
+   if(!sm.check_sanity())
+      return false;
+
+   //The last freed block is the first one reused
+   void *ptr = sm.allocate(24);
+   if(ptr != buffers.back())
+      return false;
+   sm.deallocate(ptr);
+
+   //allocate_many takes the blocks from the free list first
+   multiallocation_chain chain(sm.allocate_many(24, 100));
+   if(chain.size() != 100)
+      return false;
+   std::size_t reused = 0;
+   for(multiallocation_chain::iterator it = chain.begin(); it != chain.end(); ++it){
+      if(std::find(buffers.begin(), buffers.end(), static_cast<void*>(&*it)) != buffers.end())
+         ++reused;
+   }
+   if(!reused)
+      return false;
+   sm.deallocate_many(boost::move(chain));
+
+   //Bigger blocks are not cached
+   void *big = sm.allocate(4096);
+   sm.deallocate(big);
+
+   return free_memory == sm.get_free_memory() &&
+          sm.all_memory_deallocated() && sm.check_sanity();
+}
+
+struct block
+{
+   unsigned char *ptr;
+   std::size_t size;
+   unsigned char pattern;
+};
+
+//Allocates and frees random sized blocks, checking that no other
+//thread writes to the blocks owned by this thread
+void allocate_and_free(segment_manager_t *sm, unsigned seed, bool *ok)
+{
+   std::vector<block> blocks;
+   for(int i = 0; i < 20000; ++i){
+      seed = seed*1103515245u + 12345u;
+      if(blocks.empty() || (seed >> 16) % 3){
+         block b;
+         b.size = 1 + (seed >> 8) % 300;
+         b.ptr = static_cast<unsigned char*>(sm->allocate(b.size, std::nothrow));
+         if(!b.ptr)
+            continue;
+         b.pattern = static_cast<unsigned char>(seed >> 24);
+         std::memset(b.ptr, b.pattern, b.size);
+         blocks.push_back(b);
+      }
+      else{
+         std::size_t index = (seed >> 8) % blocks.size();
+         block &b = blocks[index];
+         for(std::size_t j = 0; j != b.size; ++j){
+            if(b.ptr[j] != b.pattern)
+               *ok = false;
+         }
+         sm->deallocate(b.ptr);
+         blocks[index] = blocks.back();
+         blocks.pop_back();
+      }
+   }
+   for(std::size_t i = 0; i != blocks.size(); ++i){
+      sm->deallocate(blocks[i].ptr);
+   }
+}
+
+bool test_threads(segment_manager_t &sm)
+{
+   const std::size_t free_memory = sm.get_free_memory();
+   const int NumThreads = 8;
+   bool ok[NumThreads];
+   boost::thread_group threads;
+   for(int i = 0; i < NumThreads; ++i){
+      ok[i] = true;
+      threads.create_thread(boost::bind(&allocate_and_free, &sm, i + 1, &ok[i]));
+   }
+   threads.join_all();
+
+   for(int i = 0; i < NumThreads; ++i){
+      if(!ok[i])
+         return false;
+   }
+   return free_memory == sm.get_free_memory() &&
+          sm.all_memory_deallocated() && sm.check_sanity();
+}
+
+int main ()
+{
+   const char *const shMemName = test::get_process_id_name();
+
+   shared_memory_object::remove(shMemName);
+   {
+      my_managed_shared_memory segment(create_only, shMemName, 4*1024*1024);
+      if(!test_reuse(*segment.get_segment_manager())){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+      if(!test_threads(*segment.get_segment_manager())){
+         shared_memory_object::remove(shMemName);
+         return 1;
+      }
+   }
+   shared_memory_object::remove(shMemName);
+   return 0;
+}
+
+#include <boost/interprocess/detail/config_end.hpp>
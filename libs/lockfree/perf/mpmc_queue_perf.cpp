@@ -0,0 +1,142 @@
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+// compares the throughput of mpmc_queue with queue and spsc_queue. the first row fills and drains the queues from a single
+// thread, which measures the cost of the operations themselves. spsc_queue only takes part in the runs with a single
+// producer and a single consumer.
+//
+// usage: mpmc_queue_perf [items per producer] [queue size]
+
+#include <boost/lockfree/mpmc_queue.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+typedef boost::lockfree::queue<long, boost::lockfree::fixed_sized<true> > queue_type;
+typedef boost::lockfree::mpmc_queue<long> mpmc_queue_type;
+typedef boost::lockfree::spsc_queue<long> spsc_queue_type;
+
+boost::lockfree::detail::atomic<int> producers_running(0);
+boost::lockfree::detail::atomic<long> consumed(0);
+
+template <typename Queue>
+void produce(Queue & q, long items)
+{
+    for (long i = 0; i != items; ++i)
+        while (!q.push(i))
+            ;
+
+    --producers_running;
+}
+
+template <typename Queue>
+void consume(Queue & q)
+{
+    long count = 0;
+    long value;
+    for (;;) {
+        bool drained = producers_running.load() == 0;
+        while (q.pop(value))
+            ++count;
+        if (drained)
+            break;
+    }
+    consumed += count;
+}
+
+template <typename Queue>
+double run_single_threaded(Queue & q, long items, long queue_size)
+{
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+    long count = 0;
+    long value;
+    for (long i = 0; i < items; i += queue_size - 1) {
+        for (long j = 0; j != queue_size - 1; ++j)
+            q.push(j);
+        while (q.pop(value))
+            ++count;
+    }
+
+    boost::posix_time::ptime stop = boost::posix_time::microsec_clock::universal_time();
+
+    double seconds = (stop - start).total_microseconds() / 1e6;
+    return count / seconds / 1e6;
+}
+
+template <typename Queue>
+double run(Queue & q, int producers, int consumers, long items)
+{
+    producers_running.store(producers);
+    consumed.store(0);
+
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+    boost::thread_group threads;
+    for (int i = 0; i != consumers; ++i)
+        threads.create_thread(boost::bind(&consume<Queue>, boost::ref(q)));
+    for (int i = 0; i != producers; ++i)
+        threads.create_thread(boost::bind(&produce<Queue>, boost::ref(q), items));
+    threads.join_all();
+
+    boost::posix_time::ptime stop = boost::posix_time::microsec_clock::universal_time();
+
+    if (consumed.load() != producers * items) {
+        std::fprintf(stderr, "consumed %ld items, expected %ld\n", consumed.load(), producers * items);
+        std::exit(1);
+    }
+
+    double seconds = (stop - start).total_microseconds() / 1e6;
+    return consumed.load() / seconds / 1e6;
+}
+
+int main(int argc, char * argv[])
+{
+    long items = argc > 1 ? std::atol(argv[1]) : 1000000;
+    long queue_size = argc > 2 ? std::atol(argv[2]) : 1024;
+    if (items <= 0 || queue_size <= 1 || queue_size >= 65535) {
+        std::fprintf(stderr, "usage: mpmc_queue_perf [items per producer] [queue size]\n");
+        return 1;
+    }
+
+    std::printf("items per producer: %ld\n", items);
+    std::printf("queue size:         %ld\n", queue_size);
+    std::printf("producers  consumers  queue (M items/s)  mpmc_queue (M items/s)  spsc_queue (M items/s)\n");
+
+    {
+        queue_type q(queue_size);
+        mpmc_queue_type mq(queue_size);
+        spsc_queue_type sq(queue_size);
+
+        double queue_result = run_single_threaded(q, items, queue_size);
+        double mpmc_result = run_single_threaded(mq, items, queue_size);
+        double spsc_result = run_single_threaded(sq, items, queue_size);
+        std::printf("%20s  %17.2f  %22.2f  %22.2f\n", "single thread", queue_result, mpmc_result, spsc_result);
+    }
+
+    for (int threads = 1; threads <= 8; threads *= 2) {
+        queue_type q(queue_size);
+        mpmc_queue_type mq(queue_size);
+
+        double queue_result = run(q, threads, threads, items);
+        double mpmc_result = run(mq, threads, threads, items);
+
+        if (threads == 1) {
+            spsc_queue_type sq(queue_size);
+            double spsc_result = run(sq, 1, 1, items);
+            std::printf("%9d  %9d  %17.2f  %22.2f  %22.2f\n", threads, threads, queue_result, mpmc_result, spsc_result);
+        } else
+            std::printf("%9d  %9d  %17.2f  %22.2f  %22s\n", threads, threads, queue_result, mpmc_result, "-");
+    }
+
+    return 0;
+}
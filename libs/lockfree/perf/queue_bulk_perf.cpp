@@ -0,0 +1,133 @@
+//  Copyright (C) 2011 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+// compares element-wise push/pop with range push/pop on a queue that is fed by several producers and drained by a single
+// consumer.
+//
+// usage: queue_bulk_perf [items per producer] [batch size]
+
+#include <boost/lockfree/queue.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+typedef boost::lockfree::queue<long> queue_type;
+
+boost::lockfree::detail::atomic<int> producers_running(0);
+
+void produce_elementwise(queue_type & q, long items)
+{
+    for (long i = 0; i != items; ++i)
+        while (!q.push(i))
+            ;
+
+    --producers_running;
+}
+
+void produce_bulk(queue_type & q, long items, std::size_t batch_size)
+{
+    std::vector<long> batch(batch_size);
+
+    for (long i = 0; i < items; i += long(batch_size)) {
+        std::size_t count = std::min(batch_size, std::size_t(items - i));
+        for (std::size_t j = 0; j != count; ++j)
+            batch[j] = i + long(j);
+
+        std::vector<long>::iterator it = batch.begin();
+        while (it != batch.begin() + count)
+            it = q.push(it, batch.begin() + count);
+    }
+
+    --producers_running;
+}
+
+long consume_elementwise(queue_type & q)
+{
+    long consumed = 0;
+    long value;
+    for (;;) {
+        bool drained = producers_running.load() == 0;
+        while (q.pop(value))
+            ++consumed;
+        if (drained)
+            return consumed;
+    }
+}
+
+long consume_bulk(queue_type & q, std::size_t batch_size)
+{
+    long consumed = 0;
+    std::vector<long> values(batch_size);
+    for (;;) {
+        bool drained = producers_running.load() == 0;
+        for (;;) {
+            std::size_t count = q.pop(values.begin(), batch_size);
+            if (count == 0)
+                break;
+            consumed += long(count);
+        }
+        if (drained)
+            return consumed;
+    }
+}
+
+double run(int producers, long items, std::size_t batch_size)
+{
+    queue_type q(1024);
+    producers_running.store(producers);
+
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+    boost::thread_group threads;
+    for (int i = 0; i != producers; ++i) {
+        if (batch_size)
+            threads.create_thread(boost::bind(&produce_bulk, boost::ref(q), items, batch_size));
+        else
+            threads.create_thread(boost::bind(&produce_elementwise, boost::ref(q), items));
+    }
+
+    long consumed = batch_size ? consume_bulk(q, batch_size) : consume_elementwise(q);
+    threads.join_all();
+
+    boost::posix_time::ptime stop = boost::posix_time::microsec_clock::universal_time();
+
+    if (consumed != producers * items) {
+        std::fprintf(stderr, "consumed %ld items, expected %ld\n", consumed, producers * items);
+        std::exit(1);
+    }
+
+    double seconds = (stop - start).total_microseconds() / 1e6;
+    return consumed / seconds / 1e6;
+}
+
+int main(int argc, char * argv[])
+{
+    long items = argc > 1 ? std::atol(argv[1]) : 1000000;
+    std::size_t batch_size = argc > 2 ? std::size_t(std::atol(argv[2])) : 32;
+    if (items <= 0 || batch_size == 0) {
+        std::fprintf(stderr, "usage: queue_bulk_perf [items per producer] [batch size]\n");
+        return 1;
+    }
+
+    std::printf("items per producer: %ld\n", items);
+    std::printf("batch size:         %lu\n", (unsigned long)batch_size);
+    std::printf("producers  element-wise (M items/s)  bulk (M items/s)\n");
+
+    for (int producers = 1; producers <= 16; producers *= 2) {
+        double elementwise = run(producers, items, 0);
+        double bulk = run(producers, items, batch_size);
+        std::printf("%9d  %24.2f  %16.2f\n", producers, elementwise, bulk);
+    }
+
+    return 0;
+}
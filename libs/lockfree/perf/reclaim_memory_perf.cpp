@@ -0,0 +1,128 @@
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+// compares the default freelist with reclaim_memory<true> for queue and stack. a burst of items is pushed and popped by
+// several threads, then the number of nodes that are still allocated is reported, together with the high-water mark and
+// the throughput.
+//
+// usage: reclaim_memory_perf [burst size] [threads]
+
+#include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/stack.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+using boost::lockfree::detail::atomic;
+
+atomic<long> live_blocks(0);
+atomic<long> peak_blocks(0);
+
+template <typename T>
+struct counting_allocator:
+    std::allocator<T>
+{
+    template <typename U>
+    struct rebind
+    {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator(void)
+    {}
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const &)
+    {}
+
+    T * allocate(std::size_t n)
+    {
+        long live = ++live_blocks;
+        long peak = peak_blocks.load(boost::lockfree::detail::memory_order_relaxed);
+        while (live > peak && !peak_blocks.compare_exchange_weak(peak, live))
+        {}
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T * p, std::size_t n)
+    {
+        --live_blocks;
+        std::allocator<T>::deallocate(p, n);
+    }
+};
+
+typedef boost::lockfree::allocator<counting_allocator<long> > counting;
+
+template <typename Container>
+void produce(Container & c, long items)
+{
+    for (long i = 0; i != items; ++i)
+        c.push(i);
+}
+
+template <typename Container>
+void consume(Container & c, long items)
+{
+    long value;
+    for (long i = 0; i != items;)
+        if (c.pop(value))
+            ++i;
+}
+
+template <typename Container>
+void run(const char * name, long burst, int threads)
+{
+    live_blocks.store(0);
+    peak_blocks.store(0);
+
+    Container c(128);
+    long items = burst / threads;
+
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+    boost::thread_group producers;
+    for (int i = 0; i != threads; ++i)
+        producers.create_thread(boost::bind(&produce<Container>, boost::ref(c), items));
+    producers.join_all();
+
+    boost::thread_group consumers;
+    for (int i = 0; i != threads; ++i)
+        consumers.create_thread(boost::bind(&consume<Container>, boost::ref(c), items));
+    consumers.join_all();
+
+    boost::posix_time::ptime stop = boost::posix_time::microsec_clock::universal_time();
+
+    double seconds = (stop - start).total_microseconds() / 1e6;
+    std::printf("%-28s  %14ld  %16ld  %14.2f\n", name, peak_blocks.load(), live_blocks.load(),
+                2 * items * threads / seconds / 1e6);
+}
+
+int main(int argc, char * argv[])
+{
+    long burst = argc > 1 ? std::atol(argv[1]) : 1000000;
+    int threads = argc > 2 ? std::atoi(argv[2]) : 4;
+    if (burst <= 0 || threads <= 0) {
+        std::fprintf(stderr, "usage: reclaim_memory_perf [burst size] [threads]\n");
+        return 1;
+    }
+
+    std::printf("burst size: %ld\n", burst);
+    std::printf("threads:    %d\n", threads);
+    std::printf("%-28s  %14s  %16s  %14s\n", "", "peak (blocks)", "retained (blocks)", "M ops/s");
+
+    using boost::lockfree::reclaim_memory;
+    run<boost::lockfree::queue<long, counting> >("queue", burst, threads);
+    run<boost::lockfree::queue<long, counting, reclaim_memory<true> > >("queue, reclaim_memory", burst, threads);
+    run<boost::lockfree::stack<long, counting> >("stack", burst, threads);
+    run<boost::lockfree::stack<long, counting, reclaim_memory<true> > >("stack, reclaim_memory", burst, threads);
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+//  Copyright (C) 2011 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+// compares copying push/pop with the write_span/read_span interface of spsc_queue. one producer fills the payloads and
+// one consumer sums them up, either through a local copy or in place inside the ringbuffer.
+//
+// usage: spsc_queue_span_perf [items] [queue size]
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+template <std::size_t Size>
+struct payload
+{
+    long data[Size / sizeof(long)];
+
+    static const std::size_t words = Size / sizeof(long);
+};
+
+template <typename Payload>
+void fill(Payload & p, long value)
+{
+    for (std::size_t i = 0; i != Payload::words; ++i)
+        p.data[i] = value;
+}
+
+template <typename Payload>
+long sum(Payload const & p)
+{
+    long result = 0;
+    for (std::size_t i = 0; i != Payload::words; ++i)
+        result += p.data[i];
+    return result;
+}
+
+template <typename Queue, typename Payload>
+void copy_producer(Queue & q, long items)
+{
+    Payload p;
+    for (long i = 0; i != items; ++i) {
+        fill(p, i);
+        while (!q.push(p))
+        {}
+    }
+}
+
+template <typename Queue, typename Payload>
+void copy_consumer(Queue & q, long items, long & result)
+{
+    Payload p;
+    long checksum = 0;
+    for (long i = 0; i != items;) {
+        if (q.pop(p)) {
+            checksum += sum(p);
+            ++i;
+        }
+    }
+    result = checksum;
+}
+
+template <typename Queue, typename Payload>
+void span_producer(Queue & q, long items)
+{
+    for (long i = 0; i != items;) {
+        Payload * span;
+        long count = (std::min)(long(q.write_span(span)), items - i);
+        for (long j = 0; j != count; ++j)
+            fill(span[j], i + j);
+        q.commit_write(count);
+        i += count;
+    }
+}
+
+template <typename Queue, typename Payload>
+void span_consumer(Queue & q, long items, long & result)
+{
+    long checksum = 0;
+    for (long i = 0; i != items;) {
+        const Payload * span;
+        long count = q.read_span(span);
+        for (long j = 0; j != count; ++j)
+            checksum += sum(span[j]);
+        q.commit_read(count);
+        i += count;
+    }
+    result = checksum;
+}
+
+template <typename Payload>
+void run(long items, long queue_size)
+{
+    typedef boost::lockfree::spsc_queue<Payload> queue_t;
+
+    double rate[2];
+    long checksum[2];
+
+    for (int mode = 0; mode != 2; ++mode) {
+        queue_t q(queue_size);
+
+        boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+        if (mode == 0) {
+            boost::thread consumer(boost::bind(&copy_consumer<queue_t, Payload>, boost::ref(q), items,
+                                               boost::ref(checksum[mode])));
+            copy_producer<queue_t, Payload>(q, items);
+            consumer.join();
+        } else {
+            boost::thread consumer(boost::bind(&span_consumer<queue_t, Payload>, boost::ref(q), items,
+                                               boost::ref(checksum[mode])));
+            span_producer<queue_t, Payload>(q, items);
+            consumer.join();
+        }
+
+        boost::posix_time::ptime stop = boost::posix_time::microsec_clock::universal_time();
+        rate[mode] = items / ((stop - start).total_microseconds() / 1e6) / 1e6;
+    }
+
+    if (checksum[0] != checksum[1])
+        std::fprintf(stderr, "checksum mismatch: %ld != %ld\n", checksum[0], checksum[1]);
+
+    std::printf("%12lu  %16.2f  %16.2f  %10.2f\n", (unsigned long)sizeof(Payload), rate[0], rate[1],
+                rate[0] != 0 ? rate[1] / rate[0] : 0.0);
+}
+
+int main(int argc, char * argv[])
+{
+    long items = argc > 1 ? std::atol(argv[1]) : 10000000;
+    long queue_size = argc > 2 ? std::atol(argv[2]) : 1024;
+    if (items <= 0 || queue_size <= 1) {
+        std::fprintf(stderr, "usage: spsc_queue_span_perf [items] [queue size]\n");
+        return 1;
+    }
+
+    std::printf("items:      %ld\n", items);
+    std::printf("queue size: %ld\n", queue_size);
+    std::printf("%12s  %16s  %16s  %10s\n", "payload (B)", "copy (M items/s)", "span (M items/s)", "speedup");
+
+    run<payload<64> >(items, queue_size);
+    run<payload<256> >(items, queue_size);
+    run<payload<1024> >(items, queue_size);
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/detail/epoch_freelist.hpp>
+
+#include <boost/thread.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <cstring>
+#include <memory>
+
+using boost::lockfree::detail::atomic;
+using boost::lockfree::detail::epoch_freelist;
+
+const long magic = 0x5a5a5a5a;
+
+struct node
+{
+    node(void):
+        value(magic)
+    {}
+
+    void * padding[2]; // used for the freelist node
+    long value;
+};
+
+// reports the deallocation of the watched node and poisons deallocated nodes
+void * watched = NULL;
+bool watched_freed = false;
+
+template <typename T>
+struct watching_allocator:
+    std::allocator<T>
+{
+    template <typename U>
+    struct rebind
+    {
+        typedef watching_allocator<U> other;
+    };
+
+    watching_allocator(void)
+    {}
+
+    template <typename U>
+    watching_allocator(watching_allocator<U> const &)
+    {}
+
+    void deallocate(T * p, std::size_t n)
+    {
+        if (p == watched)
+            watched_freed = true;
+        std::memset(static_cast<void*>(p), 0xdd, n * sizeof(T));
+        std::allocator<T>::deallocate(p, n);
+    }
+};
+
+typedef epoch_freelist<node, watching_allocator<node> > pool_type;
+
+/* the epoch is advanced every 64 retirements, if all active operations have observed it */
+void try_advance_epoch(pool_type & pool)
+{
+    pool_type::operation_guard guard(pool);
+    for (int i = 0; i != 64; ++i)
+        pool.retire(guard, pool.construct<true, false>());
+}
+
+/* a node is retired by an operation, which has entered one epoch before another operation, which has read the node.
+ * the node must not be released, before the reader has finished */
+BOOST_AUTO_TEST_CASE( epoch_freelist_pinned_reader_test )
+{
+    watching_allocator<node> alloc;
+    pool_type pool(alloc);
+
+    node * x = pool.construct<true, false>();
+    watched = x;
+    watched_freed = false;
+
+    {
+        pool_type::operation_guard * writer = new pool_type::operation_guard(pool);
+        try_advance_epoch(pool);
+
+        // the reader enters in the next epoch and reads x, which is then unlinked and retired by the writer
+        pool_type::operation_guard reader(pool);
+        pool.retire(*writer, x);
+        delete writer;
+
+        for (int i = 0; i != 4; ++i) {
+            try_advance_epoch(pool);
+            BOOST_REQUIRE(!watched_freed);
+        }
+    }
+
+    // once the reader has finished, the node is reclaimed
+    for (int i = 0; i != 4; ++i)
+        try_advance_epoch(pool);
+    BOOST_REQUIRE(watched_freed);
+    watched = NULL;
+}
+
+struct pinned_reader_tester
+{
+    static const int writer_count = 2;
+    static const int reader_count = 2;
+    static const long iterations = 200000;
+
+    pinned_reader_tester(void):
+        pool(watching_allocator<node>()), shared(NULL), running(true), errors(0)
+    {}
+
+    void write(void)
+    {
+        for (long i = 0; i != iterations; ++i) {
+            pool_type::operation_guard guard(pool);
+            node * n = pool.construct<true, false>();
+            node * old = shared.exchange(n);
+            if (old)
+                pool.retire(guard, old);
+        }
+    }
+
+    /* keeps the operation alive over many retirements of the writers, so the epoch is advanced around it */
+    void read(void)
+    {
+        while (running.load()) {
+            pool_type::operation_guard guard(pool);
+            node * n = shared.load();
+            if (!n)
+                continue;
+
+            for (int i = 0; i != 100; ++i) {
+                if (n->value != magic)
+                    ++errors;
+                boost::thread::yield();
+            }
+        }
+    }
+
+    void run(void)
+    {
+        boost::thread_group writers, readers;
+        for (int i = 0; i != reader_count; ++i)
+            readers.create_thread(boost::bind(&pinned_reader_tester::read, this));
+        for (int i = 0; i != writer_count; ++i)
+            writers.create_thread(boost::bind(&pinned_reader_tester::write, this));
+
+        writers.join_all();
+        running.store(false);
+        readers.join_all();
+
+        BOOST_REQUIRE_EQUAL(errors.load(), 0);
+
+        node * last = shared.exchange(NULL);
+        if (last)
+            pool.destruct<false>(last);
+    }
+
+    pool_type pool;
+    atomic<node*> shared;
+    atomic<bool> running;
+    atomic<long> errors;
+};
+
+BOOST_AUTO_TEST_CASE( epoch_freelist_pinned_reader_stress_test )
+{
+    boost::scoped_ptr<pinned_reader_tester> tester(new pinned_reader_tester);
+    tester->run();
+}
@@ -228,3 +228,56 @@ BOOST_AUTO_TEST_CASE( fixed_size_freelist_test )
     typedef freelist_tester<boost::lockfree::detail::fixed_size_freelist<dummy>, true > test_type;
     run_tester<test_type>();
 }
+
+struct bulk_node
+{
+    size_t padding[2]; // for used for the freelist node
+};
+
+template <typename freelist_type, bool threadsafe>
+void bulk_test(void)
+{
+    freelist_type fl(std::allocator<int>(), 16);
+
+    bulk_node * nodes[24];
+    std::size_t allocated = fl.template allocate_many<threadsafe, true>(nodes, 24);
+    BOOST_REQUIRE_EQUAL(allocated, 16u);
+
+    std::set<bulk_node*> unique_nodes(nodes, nodes + allocated);
+    BOOST_REQUIRE_EQUAL(unique_nodes.size(), 16u);
+
+    BOOST_REQUIRE((fl.template construct<threadsafe, true>() == NULL));
+    BOOST_REQUIRE_EQUAL((fl.template allocate_many<threadsafe, true>(nodes + 16, 8)), 0u);
+
+    fl.template destruct_many<threadsafe>(nodes, 10);
+    fl.template deallocate_many<threadsafe>(nodes + 10, 6);
+
+    bulk_node * reallocated[16];
+    BOOST_REQUIRE_EQUAL((fl.template allocate_many<threadsafe, true>(reallocated, 16)), 16u);
+    BOOST_REQUIRE(std::set<bulk_node*>(reallocated, reallocated + 16) == unique_nodes);
+
+    fl.template deallocate_many<threadsafe>(reallocated, 16);
+}
+
+template <typename freelist_type, bool threadsafe>
+void unbounded_bulk_test(void)
+{
+    freelist_type fl(std::allocator<int>(), 4);
+
+    bulk_node * nodes[12];
+    BOOST_REQUIRE_EQUAL((fl.template allocate_many<threadsafe, false>(nodes, 12)), 12u);
+    BOOST_REQUIRE_EQUAL(std::set<bulk_node*>(nodes, nodes + 12).size(), 12u);
+
+    fl.template deallocate_many<threadsafe>(nodes, 12);
+}
+
+BOOST_AUTO_TEST_CASE( bulk_freelist_tests )
+{
+    bulk_test<boost::lockfree::detail::freelist_stack<bulk_node>, true>();
+    bulk_test<boost::lockfree::detail::freelist_stack<bulk_node>, false>();
+    bulk_test<boost::lockfree::detail::fixed_size_freelist<bulk_node>, true>();
+    bulk_test<boost::lockfree::detail::fixed_size_freelist<bulk_node>, false>();
+
+    unbounded_bulk_test<boost::lockfree::detail::freelist_stack<bulk_node>, true>();
+    unbounded_bulk_test<boost::lockfree::detail::freelist_stack<bulk_node>, false>();
+}
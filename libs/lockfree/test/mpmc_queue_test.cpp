@@ -0,0 +1,146 @@
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/mpmc_queue.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <memory>
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( simple_mpmc_queue_test )
+{
+    mpmc_queue<int, capacity<64> > f;
+
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE_EQUAL(f.capacity(), 64u);
+    f.push(1);
+    f.push(2);
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.pop(i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.pop(i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( simple_mpmc_queue_test_runtime_size )
+{
+    mpmc_queue<int> f(64);
+
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE_EQUAL(f.capacity(), 64u);
+    f.push(1);
+    f.push(2);
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.pop(i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.pop(i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_queue_allocator_test )
+{
+    mpmc_queue<int, boost::lockfree::allocator<std::allocator<int> > > f(16, std::allocator<int>());
+
+    BOOST_REQUIRE(f.push(1));
+    int out;
+    BOOST_REQUIRE(f.pop(out));
+    BOOST_REQUIRE_EQUAL(out, 1);
+}
+
+template <typename queue_type>
+void mpmc_queue_full_test(queue_type & q)
+{
+    const int size = int(q.capacity());
+
+    // several rounds, so that the positions wrap around the ringbuffer
+    for (int round = 0; round != 4; ++round) {
+        for (int i = 0; i != size; ++i)
+            BOOST_REQUIRE(q.push(round * size + i));
+        BOOST_REQUIRE(!q.push(-1));
+
+        for (int i = 0; i != size / 2; ++i) {
+            int out;
+            BOOST_REQUIRE(q.pop(out));
+            BOOST_REQUIRE_EQUAL(out, round * size + i);
+        }
+
+        for (int i = 0; i != size / 2; ++i)
+            BOOST_REQUIRE(q.push(-1));
+        BOOST_REQUIRE(!q.push(-1));
+
+        for (int i = size / 2; i != size; ++i) {
+            int out;
+            BOOST_REQUIRE(q.pop(out));
+            BOOST_REQUIRE_EQUAL(out, round * size + i);
+        }
+
+        for (int i = 0; i != size / 2; ++i) {
+            int out;
+            BOOST_REQUIRE(q.pop(out));
+            BOOST_REQUIRE_EQUAL(out, -1);
+        }
+
+        int out;
+        BOOST_REQUIRE(!q.pop(out));
+        BOOST_REQUIRE(q.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_queue_full_test_compile_time_size )
+{
+    mpmc_queue<int, capacity<10> > q;
+    mpmc_queue_full_test(q);
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_queue_full_test_runtime_size )
+{
+    mpmc_queue<int> q(16);
+    mpmc_queue_full_test(q);
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_queue_convert_pop_test )
+{
+    mpmc_queue<int*, capacity<16> > q;
+
+    {
+        int * i1 = new int(1);
+        q.push(i1);
+    }
+
+    {
+        boost::shared_ptr<int> i2;
+        BOOST_REQUIRE(q.pop(i2));
+        BOOST_REQUIRE_EQUAL(*i2, 1);
+    }
+
+    {
+        std::auto_ptr<int> i3(new int(3));
+        q.push(i3.release());
+
+        std::auto_ptr<int> out;
+        BOOST_REQUIRE(q.pop(out));
+        BOOST_REQUIRE_EQUAL(*out, 3);
+    }
+}
@@ -0,0 +1,149 @@
+//  Copyright (C) 2011 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/queue.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <iterator>
+#include <vector>
+
+#include "test_helpers.hpp"
+
+using boost::lockfree::detail::atomic;
+
+// writers push ranges of values, readers pop ranges. every value carries the index of its writer and a sequence number,
+// so that each reader can check that it sees the values of every writer in order.
+template <typename queue_type, bool Bounded>
+struct queue_bulk_stress_tester
+{
+    static const int writer_threads = 4;
+    static const int reader_threads = 4;
+#ifndef BOOST_LOCKFREE_STRESS_TEST
+    static const long node_count = 20000;
+#else
+    static const long node_count = 500000;
+#endif
+
+    static_hashed_set<boost::uint64_t, 1<<13> data;
+    atomic<long> pop_count;
+    atomic<bool> running;
+    atomic<bool> ordered;
+
+    queue_bulk_stress_tester(void):
+        pop_count(0), running(true), ordered(true)
+    {}
+
+    static boost::uint64_t make_value(int writer, long sequence)
+    {
+        return (boost::uint64_t(writer) << 32) | boost::uint64_t(sequence);
+    }
+
+    void add_items(queue_type & q, int writer)
+    {
+        std::vector<boost::uint64_t> batch;
+        long sequence = 0;
+        while (sequence != node_count) {
+            batch.clear();
+            long batch_size = 1 + sequence % 97;
+            for (long i = 0; i != batch_size && sequence != node_count; ++i, ++sequence) {
+                boost::uint64_t value = make_value(writer, sequence);
+                bool inserted = data.insert(value);
+                assert(inserted);
+                batch.push_back(value);
+            }
+
+            std::vector<boost::uint64_t>::iterator it = batch.begin();
+            while (it != batch.end()) {
+                if (Bounded)
+                    it = q.bounded_push(it, batch.end());
+                else
+                    it = q.push(it, batch.end());
+            }
+        }
+    }
+
+    void check_values(std::vector<boost::uint64_t> const & values, std::vector<long> & last_sequence)
+    {
+        for (std::size_t i = 0; i != values.size(); ++i) {
+            int writer = int(values[i] >> 32);
+            long sequence = long(values[i] & 0xffffffff);
+            if (sequence <= last_sequence[writer])
+                ordered.store(false);
+            last_sequence[writer] = sequence;
+
+            bool erased = data.erase(values[i]);
+            assert(erased);
+        }
+        pop_count += long(values.size());
+    }
+
+    void get_items(queue_type & q, int reader)
+    {
+        std::vector<long> last_sequence(writer_threads, -1);
+        std::vector<boost::uint64_t> values;
+
+        for (;;) {
+            values.clear();
+            q.pop(std::back_inserter(values), 1 + reader * 31);
+            if (!values.empty())
+                check_values(values, last_sequence);
+            else if (!running.load())
+                break;
+        }
+
+        values.clear();
+        while (q.pop(std::back_inserter(values), 1000))
+        {}
+        check_values(values, last_sequence);
+    }
+
+    void run(queue_type & q)
+    {
+        boost::thread_group writers;
+        boost::thread_group readers;
+
+        for (int i = 0; i != reader_threads; ++i)
+            readers.create_thread(boost::bind(&queue_bulk_stress_tester::get_items, this, boost::ref(q), i));
+
+        for (int i = 0; i != writer_threads; ++i)
+            writers.create_thread(boost::bind(&queue_bulk_stress_tester::add_items, this, boost::ref(q), i));
+
+        writers.join_all();
+        running = false;
+        readers.join_all();
+
+        BOOST_REQUIRE(ordered.load());
+        BOOST_REQUIRE_EQUAL(data.count_nodes(), 0u);
+        BOOST_REQUIRE_EQUAL(pop_count.load(), writer_threads * node_count);
+        BOOST_REQUIRE(q.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( queue_bulk_stress_test_unbounded )
+{
+    typedef boost::lockfree::queue<boost::uint64_t> queue_type;
+    typedef queue_bulk_stress_tester<queue_type, false> tester_type;
+
+    boost::scoped_ptr<tester_type> tester(new tester_type);
+    queue_type q(128);
+    tester->run(q);
+}
+
+BOOST_AUTO_TEST_CASE( queue_bulk_stress_test_fixed_size )
+{
+    typedef boost::lockfree::queue<boost::uint64_t, boost::lockfree::fixed_sized<true> > queue_type;
+    typedef queue_bulk_stress_tester<queue_type, true> tester_type;
+
+    boost::scoped_ptr<tester_type> tester(new tester_type);
+    queue_type q(200);
+    tester->run(q);
+}
@@ -14,7 +14,11 @@
 #include <boost/test/unit_test.hpp>
 #endif
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <sstream>
+#include <vector>
 
 using namespace boost;
 using namespace boost::lockfree;
@@ -123,3 +127,132 @@ BOOST_AUTO_TEST_CASE( queue_convert_pop_test )
 
     BOOST_REQUIRE(f.empty());
 }
+
+template <typename queue_type>
+void bulk_queue_test(queue_type & f)
+{
+    BOOST_REQUIRE(f.empty());
+
+    std::vector<int> in;
+    for (int i = 0; i != 200; ++i)
+        in.push_back(i);
+
+    BOOST_REQUIRE(f.push(in.begin(), in.end()) == in.end());
+    BOOST_REQUIRE(!f.empty());
+
+    std::vector<int> out;
+    BOOST_REQUIRE_EQUAL(f.pop(std::back_inserter(out), 0), 0u);
+    BOOST_REQUIRE_EQUAL(f.pop(std::back_inserter(out), 1), 1u);
+    BOOST_REQUIRE_EQUAL(f.pop(std::back_inserter(out), 99), 99u);
+
+    int i1(0);
+    BOOST_REQUIRE(f.pop(i1));
+    out.push_back(i1);
+
+    while (f.pop(std::back_inserter(out), 7))
+    {}
+
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE(in == out);
+}
+
+BOOST_AUTO_TEST_CASE( queue_bulk_test )
+{
+    queue<int> f(64);
+    bulk_queue_test(f);
+    bulk_queue_test(f);
+}
+
+BOOST_AUTO_TEST_CASE( queue_bulk_test_capacity )
+{
+    queue<int, capacity<256> > f;
+    bulk_queue_test(f);
+    bulk_queue_test(f);
+}
+
+BOOST_AUTO_TEST_CASE( queue_bounded_bulk_test )
+{
+    queue<int, fixed_sized<true> > f(100);
+
+    std::vector<int> in;
+    for (int i = 0; i != 150; ++i)
+        in.push_back(i);
+
+    // one node is used as the dummy node
+    std::vector<int>::iterator it = f.bounded_push(in.begin(), in.end());
+    BOOST_REQUIRE(it == in.begin() + 100);
+    BOOST_REQUIRE(f.bounded_push(it, in.end()) == it);
+
+    std::vector<int> out;
+    BOOST_REQUIRE_EQUAL(f.pop(std::back_inserter(out), 1000), 100u);
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE(std::equal(out.begin(), out.end(), in.begin()));
+
+    BOOST_REQUIRE(f.bounded_push(it, in.end()) == in.end());
+    BOOST_REQUIRE_EQUAL(f.pop(std::back_inserter(out), 1000), 50u);
+    BOOST_REQUIRE(in == out);
+}
+
+/* single pass iterators can only be read once, so no element may be lost by counting the range in advance */
+BOOST_AUTO_TEST_CASE( queue_bulk_input_iterator_test )
+{
+    std::stringstream stream;
+    for (int i = 0; i != 200; ++i)
+        stream << i << ' ';
+
+    queue<int, fixed_sized<true> > f(150);
+    std::istream_iterator<int> it(stream), end;
+
+    // one node is used as the dummy node
+    it = f.bounded_push(it, end);
+    BOOST_REQUIRE(it != end);
+
+    std::vector<int> out;
+    BOOST_REQUIRE_EQUAL(f.pop(std::back_inserter(out), 1000), 150u);
+
+    BOOST_REQUIRE(f.bounded_push(it, end) == end);
+    BOOST_REQUIRE_EQUAL(f.pop(std::back_inserter(out), 1000), 50u);
+
+    BOOST_REQUIRE_EQUAL(out.size(), 200u);
+    for (int i = 0; i != 200; ++i)
+        BOOST_REQUIRE_EQUAL(out[i], i);
+
+    queue<int> g(0);
+    std::stringstream stream2;
+    for (int i = 0; i != 1000; ++i)
+        stream2 << i << ' ';
+    BOOST_REQUIRE(g.push(std::istream_iterator<int>(stream2), end) == end);
+
+    out.clear();
+    BOOST_REQUIRE_EQUAL(g.pop(std::back_inserter(out), 2000), 1000u);
+    for (int i = 0; i != 1000; ++i)
+        BOOST_REQUIRE_EQUAL(out[i], i);
+}
+
+struct summing_functor
+{
+    summing_functor(void):
+        sum(0)
+    {}
+
+    void operator()(int i)
+    {
+        sum += i;
+    }
+
+    int sum;
+};
+
+BOOST_AUTO_TEST_CASE( queue_consume_all_test )
+{
+    queue<int> f(64);
+
+    for (int i = 1; i != 101; ++i)
+        f.push(i);
+
+    summing_functor functor;
+    BOOST_REQUIRE_EQUAL(f.consume_all(functor), 100u);
+    BOOST_REQUIRE_EQUAL(functor.sum, 5050);
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE_EQUAL(f.consume_all(functor), 0u);
+}
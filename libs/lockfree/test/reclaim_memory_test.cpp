@@ -0,0 +1,156 @@
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/stack.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <iterator>
+#include <memory>
+#include <vector>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+// counts the blocks that are currently allocated by all instances
+long live_blocks = 0;
+
+template <typename T>
+struct counting_allocator:
+    std::allocator<T>
+{
+    template <typename U>
+    struct rebind
+    {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator(void)
+    {}
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const &)
+    {}
+
+    T * allocate(std::size_t n)
+    {
+        ++live_blocks;
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T * p, std::size_t n)
+    {
+        --live_blocks;
+        std::allocator<T>::deallocate(p, n);
+    }
+};
+
+const long burst_size = 10000;
+
+/* once the burst has been popped, only the reserved nodes, the nodes of the last epochs and the epoch records may stay
+ * allocated */
+const long retained_limit = 512;
+
+template <typename Container>
+void push_and_pop_burst(Container & c)
+{
+    for (long i = 0; i != burst_size; ++i)
+        BOOST_REQUIRE(c.push(i));
+
+    long out;
+    for (long i = 0; i != burst_size; ++i)
+        BOOST_REQUIRE(c.pop(out));
+    BOOST_REQUIRE(!c.pop(out));
+}
+
+BOOST_AUTO_TEST_CASE( queue_retains_nodes_by_default )
+{
+    {
+        queue<long, boost::lockfree::allocator<counting_allocator<long> > > q(16);
+        push_and_pop_burst(q);
+        BOOST_REQUIRE_GE(live_blocks, burst_size);
+    }
+    BOOST_REQUIRE_EQUAL(live_blocks, 0);
+}
+
+BOOST_AUTO_TEST_CASE( queue_reclaim_memory_test )
+{
+    {
+        queue<long, reclaim_memory<true>, boost::lockfree::allocator<counting_allocator<long> > > q(16);
+        BOOST_WARN(q.is_lock_free());
+
+        push_and_pop_burst(q);
+        BOOST_REQUIRE_LT(live_blocks, retained_limit);
+
+        // a second burst does not accumulate further nodes
+        push_and_pop_burst(q);
+        BOOST_REQUIRE_LT(live_blocks, retained_limit);
+        BOOST_REQUIRE(q.empty());
+    }
+    BOOST_REQUIRE_EQUAL(live_blocks, 0);
+}
+
+BOOST_AUTO_TEST_CASE( queue_reclaim_memory_bulk_test )
+{
+    {
+        queue<long, reclaim_memory<true>, boost::lockfree::allocator<counting_allocator<long> > > q(16);
+
+        std::vector<long> data;
+        for (long i = 0; i != burst_size; ++i)
+            data.push_back(i);
+
+        BOOST_REQUIRE(q.push(data.begin(), data.end()) == data.end());
+
+        std::vector<long> out;
+        BOOST_REQUIRE_EQUAL(q.pop(std::back_inserter(out), burst_size / 2), std::size_t(burst_size / 2));
+        while (q.pop(std::back_inserter(out), 100))
+        {}
+
+        BOOST_REQUIRE(out == data);
+        BOOST_REQUIRE_LT(live_blocks, retained_limit);
+    }
+    BOOST_REQUIRE_EQUAL(live_blocks, 0);
+}
+
+BOOST_AUTO_TEST_CASE( queue_reclaim_memory_bounded_push_test )
+{
+    queue<long, reclaim_memory<true> > q(8);
+
+    // bounded_push only uses the reserved nodes
+    for (long i = 0; i != 8; ++i)
+        BOOST_REQUIRE(q.bounded_push(i));
+    BOOST_REQUIRE(!q.bounded_push(8));
+
+    long out;
+    for (long i = 0; i != 8; ++i) {
+        BOOST_REQUIRE(q.pop(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE( stack_reclaim_memory_test )
+{
+    {
+        stack<long, reclaim_memory<true>, boost::lockfree::allocator<counting_allocator<long> > > s(16);
+        BOOST_WARN(s.is_lock_free());
+
+        push_and_pop_burst(s);
+        BOOST_REQUIRE_LT(live_blocks, retained_limit);
+
+        push_and_pop_burst(s);
+        BOOST_REQUIRE_LT(live_blocks, retained_limit);
+        BOOST_REQUIRE(s.empty());
+    }
+    BOOST_REQUIRE_EQUAL(live_blocks, 0);
+}
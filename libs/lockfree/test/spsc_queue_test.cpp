@@ -247,6 +247,68 @@ BOOST_AUTO_TEST_CASE( spsc_queue_buffer_pop_test )
     spsc_queue_buffer_pop<output_iterator_, 7, 16, 64>();
 }
 
+template <typename Queue>
+void spsc_queue_span_test(Queue & rb)
+{
+    int * write_span;
+    const int * read_span;
+
+    BOOST_REQUIRE_EQUAL(rb.read_span(read_span), 0u);
+
+    int next_write = 0, next_read = 0;
+    for (int i = 0; i != 64; ++i) {
+        /* push 7 elements, which may be split at the end of the ringbuffer */
+        int pushed = 0;
+        while (pushed != 7) {
+            size_t available = rb.write_span(write_span);
+            BOOST_REQUIRE(available != 0);
+
+            size_t count = (std::min)(available, size_t(7 - pushed));
+            for (size_t j = 0; j != count; ++j)
+                write_span[j] = next_write++;
+            rb.commit_write(count);
+            pushed += count;
+        }
+
+        int popped = 0;
+        for (;;) {
+            size_t available = rb.read_span(read_span);
+            if (available == 0)
+                break;
+
+            for (size_t j = 0; j != available; ++j)
+                BOOST_REQUIRE_EQUAL(read_span[j], next_read++);
+            rb.commit_read(available);
+            popped += available;
+        }
+        BOOST_REQUIRE_EQUAL(popped, 7);
+        BOOST_REQUIRE(rb.empty());
+    }
+
+    /* one slot of the ringbuffer is always kept empty */
+    size_t writable = 0;
+    for (;;) {
+        size_t available = rb.write_span(write_span);
+        if (available == 0)
+            break;
+        rb.commit_write(available);
+        writable += available;
+    }
+    BOOST_REQUIRE_EQUAL(writable, 15u);
+}
+
+BOOST_AUTO_TEST_CASE( spsc_queue_span_test_compile_time_size )
+{
+    spsc_queue<int, capacity<16> > rb;
+    spsc_queue_span_test(rb);
+}
+
+BOOST_AUTO_TEST_CASE( spsc_queue_span_test_runtime_size )
+{
+    spsc_queue<int> rb(16);
+    spsc_queue_span_test(rb);
+}
+
 
 static const boost::uint32_t nodes_per_thread = 100000;
 
@@ -434,3 +496,89 @@ BOOST_AUTO_TEST_CASE( spsc_queue_test_buffering )
 {
     test1.run();
 }
+
+struct spsc_queue_tester_span
+{
+    spsc_queue<int, capacity<128> > sf;
+
+    static_hashed_set<int, 1<<16 > working_set;
+    atomic<long> received_nodes;
+
+    spsc_queue_tester_span(void):
+        received_nodes(0)
+    {}
+
+    void add(void)
+    {
+        for (boost::uint32_t i = 0; i != nodes_per_thread;)
+        {
+            int * span;
+            size_t available = sf.write_span(span);
+            size_t count = (std::min)(available, size_t(nodes_per_thread - i));
+
+            for (size_t j = 0; j != count; ++j) {
+                int id = generate_id<int>();
+                working_set.insert(id);
+                span[j] = id;
+            }
+
+            sf.commit_write(count);
+            i += count;
+        }
+    }
+
+    bool get_elements(void)
+    {
+        const int * span;
+        size_t available = sf.read_span(span);
+
+        if (available) {
+            for (size_t i = 0; i != available; ++i) {
+                bool erased = working_set.erase(span[i]);
+                assert(erased);
+            }
+
+            sf.commit_read(available);
+            received_nodes += available;
+            return true;
+        } else
+            return false;
+    }
+
+    atomic<bool> running;
+
+    void get(void)
+    {
+        for(;;) {
+            bool writer_done = !running;
+            bool success = get_elements();
+            if (writer_done && !success)
+                return;
+        }
+    }
+
+    void run(void)
+    {
+        running = true;
+
+        thread reader(boost::bind(&spsc_queue_tester_span::get, this));
+        thread writer(boost::bind(&spsc_queue_tester_span::add, this));
+        cout << "reader and writer threads created" << endl;
+
+        writer.join();
+        cout << "writer threads joined. waiting for readers to finish" << endl;
+
+        running = false;
+        reader.join();
+
+        BOOST_REQUIRE_EQUAL(received_nodes, nodes_per_thread);
+        BOOST_REQUIRE(sf.empty());
+        BOOST_REQUIRE(working_set.count_nodes() == 0);
+    }
+};
+
+BOOST_AUTO_TEST_CASE( spsc_queue_test_span )
+{
+    boost::scoped_ptr<spsc_queue_tester_span> test(new spsc_queue_tester_span);
+    test->run();
+}
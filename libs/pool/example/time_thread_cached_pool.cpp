@@ -0,0 +1,103 @@
+// Copyright (C) 2012 John Maddock
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Times allocating and freeing from several threads at once, with the
+// mutex based singleton_pool, thread_cached_pool and malloc/free.
+//
+// usage: time_thread_cached_pool [operations per thread] [maximum threads]
+
+#include <boost/pool/thread_cached_pool.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+struct order
+{
+  char data[48];
+};
+
+struct singleton_tag { };
+struct cached_tag { };
+
+typedef boost::singleton_pool<singleton_tag, sizeof(order)> locked_pool;
+typedef boost::thread_cached_pool<cached_tag, sizeof(order)> cached_pool;
+
+struct use_malloc
+{
+  static void * malloc BOOST_PREVENT_MACRO_SUBSTITUTION()
+  { return std::malloc(sizeof(order)); }
+  static void free BOOST_PREVENT_MACRO_SUBSTITUTION(void * const ptr)
+  { std::free(ptr); }
+};
+
+// Each thread keeps a small working set, like an order book adding and
+// removing orders: allocate a batch, then free it in a different order.
+template <typename Pool>
+void worker(unsigned long operations)
+{
+  const unsigned batch = 16;
+  void * live[batch];
+
+  for (unsigned long i = 0; i < operations; i += batch)
+  {
+    for (unsigned j = 0; j < batch; ++j)
+      live[j] = (Pool::malloc)();
+    for (unsigned j = 0; j < batch; ++j)
+      (Pool::free)(live[(j * 7) % batch]);
+  }
+}
+
+// Returns millions of operations (an allocation and a free) per second.
+template <typename Pool>
+double run(unsigned threads, unsigned long operations)
+{
+  boost::posix_time::ptime start =
+      boost::posix_time::microsec_clock::universal_time();
+
+  boost::thread_group group;
+  for (unsigned i = 0; i < threads; ++i)
+    group.create_thread(boost::bind(&worker<Pool>, operations));
+  group.join_all();
+
+  boost::posix_time::ptime stop =
+      boost::posix_time::microsec_clock::universal_time();
+  double seconds = (stop - start).total_microseconds() / 1e6;
+  return static_cast<double>(operations) * threads / seconds / 1e6;
+}
+
+int main(int argc, char * argv[])
+{
+  const unsigned long operations = (argc > 1) ? std::strtoul(argv[1], 0, 10) : 1000000;
+  const unsigned max_threads = (argc > 2) ? static_cast<unsigned>(std::strtoul(argv[2], 0, 10)) : 16;
+
+  if (operations == 0 || max_threads == 0)
+  {
+    std::cerr << "usage: time_thread_cached_pool [operations per thread] [maximum threads]" << std::endl;
+    return 1;
+  }
+
+  std::cout << "operations per thread: " << operations << "\n"
+            << "millions of allocate/free pairs per second:\n"
+            << std::setw(8) << "threads"
+            << std::setw(16) << "singleton_pool"
+            << std::setw(20) << "thread_cached_pool"
+            << std::setw(16) << "malloc/free" << std::endl;
+
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2)
+  {
+    std::cout << std::setw(8) << threads << std::fixed << std::setprecision(2)
+              << std::setw(16) << run<locked_pool>(threads, operations)
+              << std::setw(20) << run<cached_pool>(threads, operations)
+              << std::setw(16) << run<use_malloc>(threads, operations)
+              << std::endl;
+  }
+
+  return 0;
+}
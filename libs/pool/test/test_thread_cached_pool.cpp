@@ -0,0 +1,208 @@
+/* Copyright (C) 2012 John Maddock
+*
+* Use, modification and distribution is subject to the
+* Boost Software License, Version 1.0. (See accompanying
+* file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <boost/pool/thread_cached_pool.hpp>
+#include <boost/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#include <algorithm>
+#include <list>
+#include <new>
+#include <vector>
+
+// Counts the blocks allocated by the underlying pool.
+template <class Tag>
+struct counting_allocator
+{
+   typedef std::size_t size_type;
+   typedef std::ptrdiff_t difference_type;
+
+   static int blocks;
+
+   static char * malloc BOOST_PREVENT_MACRO_SUBSTITUTION(const size_type bytes)
+   {
+      ++blocks;
+      return new (std::nothrow) char[bytes];
+   }
+   static void free BOOST_PREVENT_MACRO_SUBSTITUTION(char * const block)
+   {
+      --blocks;
+      delete [] block;
+   }
+};
+
+template <class Tag>
+int counting_allocator<Tag>::blocks = 0;
+
+struct single_thread_tag { };
+struct multi_thread_tag { };
+struct exchange_tag { };
+
+// With NextSize == MaxSize, every block holds the same number of chunks.
+const unsigned block_chunks = 64;
+
+typedef boost::thread_cached_pool<single_thread_tag, sizeof(int),
+    counting_allocator<single_thread_tag>, boost::details::pool::default_mutex,
+    block_chunks, block_chunks, 8> single_thread_pool;
+typedef boost::thread_cached_pool<multi_thread_tag, sizeof(long),
+    counting_allocator<multi_thread_tag>, boost::details::pool::default_mutex,
+    block_chunks, block_chunks> multi_thread_pool;
+typedef boost::thread_cached_pool<exchange_tag, sizeof(long),
+    counting_allocator<exchange_tag>, boost::details::pool::default_mutex,
+    block_chunks, block_chunks> exchange_pool;
+
+// Checks that every chunk is free in the shared pool, by allocating from it
+// until it has to allocate another block. Then releases all the memory.
+template <class Pool>
+bool all_chunks_returned()
+{
+   const int blocks = Pool::user_allocator::blocks;
+   int chunks = 0;
+   while((Pool::shared_pool::malloc)() && Pool::user_allocator::blocks == blocks)
+      ++chunks;
+   Pool::shared_pool::purge_memory();
+   return chunks == blocks * static_cast<int>(block_chunks);
+}
+
+void test_single_thread()
+{
+   // Enough chunks to refill and flush the cache several times.
+   std::vector<int*> chunks;
+   for(int i = 0; i < 1000; ++i)
+   {
+      int* p = static_cast<int*>((single_thread_pool::malloc)());
+      BOOST_TEST(p != 0);
+      BOOST_TEST(single_thread_pool::shared_pool::is_from(p));
+      *p = i;
+      chunks.push_back(p);
+   }
+
+   std::vector<int*> sorted(chunks);
+   std::sort(sorted.begin(), sorted.end());
+   BOOST_TEST(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+
+   for(int i = 0; i < 1000; ++i)
+   {
+      BOOST_TEST(*chunks[i] == i);
+      (single_thread_pool::free)(chunks[i]);
+   }
+
+   // Once the cache is flushed, every chunk is back in the shared pool.
+   single_thread_pool::flush();
+   BOOST_TEST(all_chunks_returned<single_thread_pool>());
+}
+
+void allocate_and_free(unsigned seed)
+{
+   std::vector<long*> chunks;
+   for(int i = 0; i < 20000; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      if(chunks.empty() || (seed >> 16) % 3)
+      {
+         long* p = static_cast<long*>((multi_thread_pool::malloc)());
+         BOOST_TEST(p != 0);
+         *p = i;
+         chunks.push_back(p);
+      }
+      else
+      {
+         std::size_t index = (seed >> 8) % chunks.size();
+         BOOST_TEST(*chunks[index] >= 0);
+         (multi_thread_pool::free)(chunks[index]);
+         chunks[index] = chunks.back();
+         chunks.pop_back();
+      }
+   }
+
+   // Leave the cache full when the thread exits, it should be returned
+   // to the shared pool.
+   for(std::size_t i = 0; i < chunks.size(); ++i)
+      (multi_thread_pool::free)(chunks[i]);
+}
+
+void test_multi_thread()
+{
+   boost::thread_group threads;
+   for(unsigned i = 0; i < 8; ++i)
+      threads.create_thread(boost::bind(&allocate_and_free, i + 1));
+   threads.join_all();
+
+   // The threads' caches are flushed when they exit.
+   BOOST_TEST(all_chunks_returned<multi_thread_pool>());
+}
+
+// Chunks allocated in one thread and freed in another.
+
+struct exchange
+{
+   boost::mutex mutex;
+   std::vector<void*> chunks;
+};
+
+void produce(exchange& e)
+{
+   for(int i = 0; i < 10000; ++i)
+   {
+      void* p = (exchange_pool::malloc)();
+      BOOST_TEST(p != 0);
+      boost::lock_guard<boost::mutex> lock(e.mutex);
+      e.chunks.push_back(p);
+   }
+}
+
+void consume(exchange& e, int count)
+{
+   while(count)
+   {
+      std::vector<void*> chunks;
+      {
+         boost::lock_guard<boost::mutex> lock(e.mutex);
+         chunks.swap(e.chunks);
+      }
+      for(std::size_t i = 0; i < chunks.size(); ++i)
+         (exchange_pool::free)(chunks[i]);
+      count -= static_cast<int>(chunks.size());
+      if(chunks.empty())
+         boost::this_thread::yield();
+   }
+}
+
+void test_cross_thread_free()
+{
+   exchange e;
+   boost::thread_group threads;
+   threads.create_thread(boost::bind(&produce, boost::ref(e)));
+   threads.create_thread(boost::bind(&produce, boost::ref(e)));
+   threads.create_thread(boost::bind(&consume, boost::ref(e), 20000));
+   threads.join_all();
+
+   BOOST_TEST(all_chunks_returned<exchange_pool>());
+}
+
+void test_allocator()
+{
+   std::list<int, boost::thread_cached_pool_allocator<int> > l;
+   for(int i = 0; i < 1000; ++i)
+      l.push_back(i);
+   int expected = 0;
+   for(std::list<int, boost::thread_cached_pool_allocator<int> >::iterator it = l.begin(); it != l.end(); ++it)
+      BOOST_TEST(*it == expected++);
+
+   std::vector<int, boost::thread_cached_pool_allocator<int> > v(100, 5);
+   BOOST_TEST(v.size() == 100);
+   BOOST_TEST(v[99] == 5);
+}
+
+int main()
+{
+   test_single_thread();
+   test_multi_thread();
+   test_cross_thread_free();
+   test_allocator();
+   return boost::report_errors();
+}
@@ -0,0 +1,125 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// performance_contiguous.cpp
+
+// (C) Copyright 2002 Robert Ramey - http://www.rrsd.com .
+// Use, modification and distribution is subject to the Boost Software
+// License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the throughput of binary archives saving and loading big
+// collections whose elements are stored contiguously.  Collections of
+// bitwise serializable types are saved and loaded as blocks of memory
+// while the other ones are serialized element by element.
+//
+// usage: performance_contiguous [megabytes] [temporary file]
+
+#include <cstddef> // size_t
+#include <cstdlib> // atoi
+#include <cstdio> // remove
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+
+#include <boost/config.hpp>
+#if defined(BOOST_NO_STDC_NAMESPACE)
+namespace std{
+    using ::remove;
+    using ::atoi;
+    using ::clock;
+    using ::clock_t;
+}
+#endif
+
+#include <boost/cstdint.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/deque.hpp>
+#include <boost/serialization/boost_container_vector.hpp>
+#include <boost/serialization/is_bitwise_serializable.hpp>
+#include <boost/serialization/level.hpp>
+#include <boost/serialization/tracking.hpp>
+
+// 32 bytes without padding, serialized member by member
+struct record
+{
+    double x, y, z;
+    boost::int32_t id;
+    float weight;
+    template<class Archive>
+    void serialize(Archive & ar, const unsigned int /* version */){
+        ar & x & y & z & id & weight;
+    }
+};
+
+// the same record, saved and loaded as raw memory
+struct bitwise_record : public record
+{};
+
+BOOST_CLASS_IMPLEMENTATION(record, boost::serialization::object_serializable)
+BOOST_CLASS_TRACKING(record, boost::serialization::track_never)
+BOOST_CLASS_IMPLEMENTATION(bitwise_record, boost::serialization::object_serializable)
+BOOST_CLASS_TRACKING(bitwise_record, boost::serialization::track_never)
+BOOST_IS_BITWISE_SERIALIZABLE(bitwise_record)
+
+double seconds(std::clock_t start){
+    return double(std::clock() - start) / CLOCKS_PER_SEC;
+}
+
+template<class Container>
+void run(const char * name, std::size_t megabytes, const char * testfile){
+    typedef BOOST_DEDUCED_TYPENAME Container::value_type value_type;
+    const std::size_t count = megabytes * 1024 * 1024 / sizeof(value_type);
+    double save_time, load_time;
+    {
+        Container c(count);
+        std::clock_t start = std::clock();
+        std::ofstream os(testfile, std::ios::binary);
+        boost::archive::binary_oarchive oa(os);
+        oa << c;
+        os.flush();
+        save_time = seconds(start);
+    }
+    {
+        Container c;
+        std::clock_t start = std::clock();
+        std::ifstream is(testfile, std::ios::binary);
+        boost::archive::binary_iarchive ia(is);
+        ia >> c;
+        load_time = seconds(start);
+        if(c.size() != count)
+            std::cerr << name << ": wrong size" << std::endl;
+    }
+    std::remove(testfile);
+    std::cout << std::setw(48) << std::left << name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << megabytes / save_time
+              << std::setw(10) << megabytes / load_time << std::endl;
+}
+
+int main(int argc, char * argv[]){
+    const std::size_t megabytes = argc > 1 ? std::atoi(argv[1]) : 1024;
+    const char * testfile = argc > 2 ? argv[2] : "performance_contiguous.tmp";
+    if(megabytes == 0){
+        std::cerr << "usage: performance_contiguous [megabytes] [temporary file]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << std::setw(48) << std::left << "MB/s" << std::right
+              << std::setw(10) << "save" << std::setw(10) << "load" << std::endl;
+    run<std::vector<record> >("std::vector<record>", megabytes, testfile);
+    run<std::vector<bitwise_record> >("std::vector<bitwise_record>", megabytes, testfile);
+    run<boost::container::vector<record> >(
+        "boost::container::vector<record>", megabytes, testfile
+    );
+    run<boost::container::vector<bitwise_record> >(
+        "boost::container::vector<bitwise_record>", megabytes, testfile
+    );
+    run<std::deque<record> >("std::deque<record>", megabytes, testfile);
+    run<std::deque<double> >("std::deque<double>", megabytes, testfile);
+    return EXIT_SUCCESS;
+}
+
+// EOF
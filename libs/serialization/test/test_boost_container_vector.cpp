@@ -0,0 +1,114 @@
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8
+// test_boost_container_vector.cpp
+
+// (C) Copyright 2002 Robert Ramey - http://www.rrsd.com . 
+// Use, modification and distribution is subject to the Boost Software
+// License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// should pass compilation and execution
+
+#include <cstddef> // NULL
+#include <fstream>
+#include <algorithm> // equal
+
+#include <cstdio> // remove
+#include <boost/config.hpp>
+#if defined(BOOST_NO_STDC_NAMESPACE)
+namespace std{ 
+    using ::remove;
+}
+#endif
+
+#include "test_tools.hpp"
+
+#include <boost/serialization/boost_container_vector.hpp>
+
+#include "A.hpp"
+#include "A.ipp"
+
+template <class T>
+int test_vector(T)
+{
+    const char * testfile = boost::archive::tmpnam(NULL);
+    BOOST_REQUIRE(NULL != testfile);
+
+    // test array of objects
+    boost::container::vector< T > avector;
+    avector.push_back(T());
+    avector.push_back(T());
+    {   
+        test_ostream os(testfile, TEST_STREAM_FLAGS);
+        test_oarchive oa(os, TEST_ARCHIVE_FLAGS);
+        oa << boost::serialization::make_nvp("avector", avector);
+    }
+    boost::container::vector< T > avector1;
+    {
+        test_istream is(testfile, TEST_STREAM_FLAGS);
+        test_iarchive ia(is, TEST_ARCHIVE_FLAGS);
+        ia >> boost::serialization::make_nvp("avector", avector1);
+    }
+    BOOST_CHECK(avector == avector1);
+    std::remove(testfile);
+    return EXIT_SUCCESS;
+}
+
+// save one kind of vector and load it as another
+template <class From, class To>
+void test_vector_conversion(const From & avector)
+{
+    const char * testfile = boost::archive::tmpnam(NULL);
+    BOOST_REQUIRE(NULL != testfile);
+
+    {   
+        test_ostream os(testfile, TEST_STREAM_FLAGS);
+        test_oarchive oa(os, TEST_ARCHIVE_FLAGS);
+        oa << boost::serialization::make_nvp("avector", avector);
+    }
+    To avector1;
+    {
+        test_istream is(testfile, TEST_STREAM_FLAGS);
+        test_iarchive ia(is, TEST_ARCHIVE_FLAGS);
+        ia >> boost::serialization::make_nvp("avector", avector1);
+    }
+    BOOST_CHECK(avector.size() == avector1.size());
+    BOOST_CHECK(std::equal(avector.begin(), avector.end(), avector1.begin()));
+    std::remove(testfile);
+}
+
+// archives are interchangeable with the ones of std::vector
+template <class T>
+int test_std_vector_format(T)
+{
+    std::vector<T> avector;
+    boost::container::vector<T> bvector;
+    for(int i = 0; i < 100; ++i){
+        avector.push_back(static_cast<T>(i % 3));
+        bvector.push_back(static_cast<T>(i % 3));
+    }
+    test_vector_conversion<
+        std::vector<T>, boost::container::vector<T>
+    >(avector);
+    test_vector_conversion<
+        boost::container::vector<T>, std::vector<T>
+    >(bvector);
+    return EXIT_SUCCESS;
+}
+
+int test_main( int /* argc */, char* /* argv */[] )
+{
+   int res = test_vector(A());
+    // test an int vector for which optimized versions should be available
+   if (res == EXIT_SUCCESS)
+     res = test_vector(0);  
+    // test a bool vector
+   if (res == EXIT_SUCCESS)
+     res = test_vector(false);  
+   if (res == EXIT_SUCCESS)
+     res = test_std_vector_format(0);  
+   if (res == EXIT_SUCCESS)
+     res = test_std_vector_format(false);  
+   return res;
+}
+
+// EOF
@@ -45,6 +45,25 @@ int test_main( int /* argc */, char* /* argv */[] )
         ia >> boost::serialization::make_nvp("adeque",adeque1);
     }
     BOOST_CHECK(adeque == adeque1);
+
+    // test a deque of ints spanning several blocks, for which
+    // optimized versions should be available
+    std::deque<int> ideque, ideque1;
+    for(int i = 0; i < 1000; ++i){
+        ideque.push_back(i);
+        ideque.push_front(-i);
+    }
+    {   
+        test_ostream os(testfile, TEST_STREAM_FLAGS);
+        test_oarchive oa(os, TEST_ARCHIVE_FLAGS);
+        oa << boost::serialization::make_nvp("ideque",ideque);
+    }
+    {
+        test_istream is(testfile, TEST_STREAM_FLAGS);
+        test_iarchive ia(is, TEST_ARCHIVE_FLAGS);
+        ia >> boost::serialization::make_nvp("ideque",ideque1);
+    }
+    BOOST_CHECK(ideque == ideque1);
     
     std::remove(testfile);
     return EXIT_SUCCESS;
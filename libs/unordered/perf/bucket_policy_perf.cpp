@@ -0,0 +1,137 @@
+// Copyright 2012 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the time for successful and failed lookups in unordered_map with
+// each of the bucket policies, for integer and string keys.
+//
+// usage: bucket_policy_perf [maximum size]
+
+#include <boost/unordered_map.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/cstdint.hpp>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    struct xorshift
+    {
+        boost::uint64_t state;
+        explicit xorshift(boost::uint64_t seed) : state(seed) {}
+
+        boost::uint64_t operator()()
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+    };
+
+    void make_key(boost::uint64_t r, boost::uint64_t& key)
+    {
+        key = r;
+    }
+
+    void make_key(boost::uint64_t r, std::string& key)
+    {
+        char buffer[32];
+        std::sprintf(buffer, "key%lu", static_cast<unsigned long>(r));
+        key = buffer;
+    }
+
+    // Stops the optimizer from discarding the lookups.
+    volatile std::size_t sink;
+
+    // Returns nanoseconds per lookup, the lookups are repeated so that the
+    // smaller sizes run for long enough to time.
+    template <class Map, class Key>
+    double time_lookups(Map const& m, std::vector<Key> const& keys,
+            std::size_t lookups)
+    {
+        boost::posix_time::ptime start =
+            boost::posix_time::microsec_clock::universal_time();
+
+        std::size_t found = 0;
+        for (std::size_t n = 0; n < lookups; n += keys.size()) {
+            for (std::size_t i = 0; i != keys.size(); ++i)
+                found += m.count(keys[i]);
+        }
+        sink = found;
+
+        boost::posix_time::ptime stop =
+            boost::posix_time::microsec_clock::universal_time();
+        std::size_t performed =
+            (lookups + keys.size() - 1) / keys.size() * keys.size();
+        return static_cast<double>((stop - start).total_microseconds()) *
+            1000.0 / static_cast<double>(performed);
+    }
+
+    template <class Key, class Tag>
+    void run(char const* name, std::vector<Key> const& keys,
+            std::vector<Key> const& hits, std::vector<Key> const& misses)
+    {
+        typedef boost::unordered_map<Key, std::size_t,
+            boost::unordered::hash_with_bucket_policy<boost::hash<Key>, Tag> >
+            map;
+
+        map m;
+        for (std::size_t i = 0; i != keys.size(); ++i)
+            m.insert(std::make_pair(keys[i], i));
+
+        std::size_t const lookups = 4000000;
+        double hit = time_lookups(m, hits, lookups);
+        double miss = time_lookups(m, misses, lookups);
+
+        std::printf("%10s  %-13s  %10.1f  %10.1f\n", "", name, hit, miss);
+    }
+
+    template <class Key>
+    void run_all(char const* key_name, std::size_t maximum)
+    {
+        std::printf("\n%s keys\n", key_name);
+        std::printf("%10s  %-13s  %10s  %10s\n", "size", "policy",
+            "hit (ns)", "miss (ns)");
+
+        for (std::size_t size = 1000; size <= maximum; size *= 10) {
+            xorshift random(size);
+            std::vector<Key> keys(size), misses(size);
+            for (std::size_t i = 0; i != size; ++i) {
+                make_key(random() | (boost::uint64_t(1) << 63), keys[i]);
+                make_key(random() & ~(boost::uint64_t(1) << 63), misses[i]);
+            }
+
+            std::vector<Key> hits(keys);
+            std::random_shuffle(hits.begin(), hits.end());
+
+            std::printf("%10lu\n", static_cast<unsigned long>(size));
+            run<Key, boost::unordered::default_buckets>(
+                "default", keys, hits, misses);
+            run<Key, boost::unordered::prime_buckets>(
+                "prime", keys, hits, misses);
+            run<Key, boost::unordered::power_of_two_buckets>(
+                "power of two", keys, hits, misses);
+            run<Key, boost::unordered::fast_range_buckets>(
+                "fast range", keys, hits, misses);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    long maximum = argc > 1 ? std::atol(argv[1]) : 1000000;
+
+    if (maximum < 1000) {
+        std::fprintf(stderr, "usage: bucket_policy_perf [maximum size]\n");
+        return 1;
+    }
+
+    run_all<boost::uint64_t>("integer", static_cast<std::size_t>(maximum));
+    run_all<std::string>("string", static_cast<std::size_t>(maximum));
+
+    return 0;
+}
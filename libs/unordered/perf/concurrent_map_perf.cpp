@@ -0,0 +1,171 @@
+// Copyright 2012 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares concurrent_map with an unordered_map guarded by a single
+// shared_mutex, for 1 to 64 threads. Each thread runs a mix of lookups and
+// updates on keys drawn from a shared range, about one in ten operations
+// modifies the container.
+//
+// usage: concurrent_map_perf [operations per thread] [keys]
+
+#include <boost/unordered/concurrent_map.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/cstdint.hpp>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    // A small xorshift generator, so that the threads don't share the
+    // state of std::rand.
+    struct xorshift
+    {
+        boost::uint32_t state;
+        explicit xorshift(boost::uint32_t seed) : state(seed) {}
+
+        unsigned long operator()()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+    };
+
+    struct locked_map
+    {
+        boost::unordered_map<unsigned long, unsigned long> map;
+        mutable boost::shared_mutex mutex;
+
+        bool find(unsigned long k) const
+        {
+            boost::shared_lock<boost::shared_mutex> lock(mutex);
+            return map.find(k) != map.end();
+        }
+
+        void update(unsigned long k)
+        {
+            boost::unique_lock<boost::shared_mutex> lock(mutex);
+            ++map[k];
+        }
+
+        void erase(unsigned long k)
+        {
+            boost::unique_lock<boost::shared_mutex> lock(mutex);
+            map.erase(k);
+        }
+    };
+
+    struct increment
+    {
+        void operator()(std::pair<unsigned long const, unsigned long>& x) const
+        {
+            ++x.second;
+        }
+    };
+
+    struct ignore
+    {
+        void operator()(
+                std::pair<unsigned long const, unsigned long> const&) const
+        {}
+    };
+
+    struct concurrent
+    {
+        boost::unordered::concurrent_map<unsigned long, unsigned long> map;
+
+        bool find(unsigned long k) const
+        {
+            return map.cvisit(k, ignore()) != 0;
+        }
+
+        void update(unsigned long k)
+        {
+            map.insert_or_visit(std::make_pair(k, 1ul), increment());
+        }
+
+        void erase(unsigned long k)
+        {
+            map.erase(k);
+        }
+    };
+
+    template <class Map>
+    void worker(Map& m, boost::uint32_t seed, long operations,
+            unsigned long keys)
+    {
+        xorshift random(seed);
+
+        for (long i = 0; i != operations; ++i) {
+            unsigned long r = random();
+            unsigned long k = r % keys;
+
+            switch ((r / keys) % 20) {
+            case 0:
+                m.erase(k);
+                break;
+            case 1:
+                m.update(k);
+                break;
+            default:
+                m.find(k);
+            }
+        }
+    }
+
+    template <class Map>
+    double run(int threads, long operations, unsigned long keys)
+    {
+        Map m;
+        for (unsigned long k = 0; k < keys; k += 2) m.update(k);
+
+        boost::posix_time::ptime start =
+            boost::posix_time::microsec_clock::universal_time();
+
+        boost::thread_group group;
+        for (int i = 0; i != threads; ++i)
+            group.create_thread(boost::bind(&worker<Map>, boost::ref(m),
+                static_cast<boost::uint32_t>(i + 1), operations, keys));
+        group.join_all();
+
+        boost::posix_time::ptime stop =
+            boost::posix_time::microsec_clock::universal_time();
+
+        double seconds = (stop - start).total_microseconds() / 1e6;
+        return static_cast<double>(operations) * threads / seconds / 1e6;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    long operations = argc > 1 ? std::atol(argv[1]) : 1000000;
+    long keys = argc > 2 ? std::atol(argv[2]) : 100000;
+
+    if (operations <= 0 || keys <= 0) {
+        std::fprintf(stderr,
+            "usage: concurrent_map_perf [operations per thread] [keys]\n");
+        return 1;
+    }
+
+    std::printf("operations per thread: %ld\n", operations);
+    std::printf("keys:                  %ld\n", keys);
+    std::printf("%8s  %24s  %24s\n", "threads",
+        "shared_mutex (M ops/s)", "concurrent_map (M ops/s)");
+
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        double locked = run<locked_map>(threads, operations,
+            static_cast<unsigned long>(keys));
+        double segmented = run<concurrent>(threads, operations,
+            static_cast<unsigned long>(keys));
+        std::printf("%8d  %24.2f  %24.2f\n", threads, locked, segmented);
+    }
+
+    return 0;
+}
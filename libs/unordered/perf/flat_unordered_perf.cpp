@@ -0,0 +1,157 @@
+// Copyright 2012 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares flat_unordered_map with unordered_map for inserting, finding
+// (both present and missing keys) and erasing, with sizes from a thousand
+// elements up to a maximum given on the command line. The keys are
+// pseudo-random 64 bit integers, looked up in a different order to the one
+// they were inserted in.
+//
+// usage: flat_unordered_perf [maximum size]
+//
+// The default maximum is 10 million, pass 100000000 for the full range
+// (which needs several gigabytes of memory).
+
+#include <boost/unordered/flat_unordered_map.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/cstdint.hpp>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    struct xorshift
+    {
+        boost::uint64_t state;
+        explicit xorshift(boost::uint64_t seed) : state(seed) {}
+
+        boost::uint64_t operator()()
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+    };
+
+    class timer
+    {
+        boost::posix_time::ptime start_;
+
+    public:
+
+        timer() : start_(boost::posix_time::microsec_clock::universal_time())
+        {}
+
+        // Nanoseconds per operation.
+        double elapsed(std::size_t operations) const
+        {
+            boost::posix_time::ptime stop =
+                boost::posix_time::microsec_clock::universal_time();
+            return static_cast<double>(
+                (stop - start_).total_microseconds()) * 1000.0 /
+                static_cast<double>(operations);
+        }
+    };
+
+    struct results
+    {
+        double insert, find_hit, find_miss, erase;
+    };
+
+    // Stops the optimizer from discarding the lookups.
+    volatile std::size_t sink;
+
+    template <class Map>
+    results run(std::vector<boost::uint64_t> const& keys,
+            std::vector<boost::uint64_t> const& lookups,
+            std::vector<boost::uint64_t> const& missing)
+    {
+        results r;
+        Map m;
+
+        {
+            timer t;
+            for (std::size_t i = 0; i != keys.size(); ++i)
+                m.insert(std::make_pair(keys[i], i));
+            r.insert = t.elapsed(keys.size());
+        }
+
+        {
+            timer t;
+            std::size_t found = 0;
+            for (std::size_t i = 0; i != lookups.size(); ++i)
+                found += m.find(lookups[i])->second;
+            sink = found;
+            r.find_hit = t.elapsed(lookups.size());
+        }
+
+        {
+            timer t;
+            std::size_t found = 0;
+            for (std::size_t i = 0; i != missing.size(); ++i)
+                found += m.count(missing[i]);
+            sink = found;
+            r.find_miss = t.elapsed(missing.size());
+        }
+
+        {
+            timer t;
+            for (std::size_t i = 0; i != lookups.size(); ++i)
+                m.erase(lookups[i]);
+            r.erase = t.elapsed(lookups.size());
+        }
+
+        return r;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    long maximum = argc > 1 ? std::atol(argv[1]) : 10000000;
+
+    if (maximum < 1000) {
+        std::fprintf(stderr, "usage: flat_unordered_perf [maximum size]\n");
+        return 1;
+    }
+
+    typedef boost::unordered_map<boost::uint64_t, std::size_t> node_map;
+    typedef boost::unordered::flat_unordered_map<boost::uint64_t, std::size_t>
+        flat_map;
+
+    std::printf("%10s  %-9s  %10s  %10s  %10s  %10s\n", "size", "map",
+        "insert", "find hit", "find miss", "erase");
+    std::printf("%10s  %-9s  %10s  %10s  %10s  %10s\n", "", "",
+        "(ns/op)", "(ns/op)", "(ns/op)", "(ns/op)");
+
+    for (std::size_t size = 1000; size <= static_cast<std::size_t>(maximum);
+            size *= 10)
+    {
+        // Top bit set for the keys, clear for the missing keys, so they
+        // can't overlap.
+        xorshift random(size);
+        std::vector<boost::uint64_t> keys(size), missing(size);
+        for (std::size_t i = 0; i != size; ++i) {
+            keys[i] = random() | (boost::uint64_t(1) << 63);
+            missing[i] = random() & ~(boost::uint64_t(1) << 63);
+        }
+
+        std::vector<boost::uint64_t> lookups(keys);
+        std::random_shuffle(lookups.begin(), lookups.end());
+
+        results n = run<node_map>(keys, lookups, missing);
+        results f = run<flat_map>(keys, lookups, missing);
+
+        std::printf("%10lu  %-9s  %10.1f  %10.1f  %10.1f  %10.1f\n",
+            static_cast<unsigned long>(size), "unordered",
+            n.insert, n.find_hit, n.find_miss, n.erase);
+        std::printf("%10s  %-9s  %10.1f  %10.1f  %10.1f  %10.1f\n",
+            "", "flat", f.insert, f.find_hit, f.find_miss, f.erase);
+    }
+
+    return 0;
+}
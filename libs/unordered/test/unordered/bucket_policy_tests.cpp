@@ -0,0 +1,176 @@
+
+// Copyright 2012 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "../helpers/prefix.hpp"
+#include <boost/unordered_set.hpp>
+#include <boost/unordered_map.hpp>
+#include "../helpers/postfix.hpp"
+
+#include "../helpers/test.hpp"
+#include "../helpers/random_values.hpp"
+#include "../helpers/tracker.hpp"
+#include "../helpers/helpers.hpp"
+#include "../objects/test.hpp"
+
+namespace bucket_policy_tests
+{
+    typedef boost::unordered::hash_with_bucket_policy<test::hash,
+        boost::unordered::prime_buckets> prime_hash;
+    typedef boost::unordered::hash_with_bucket_policy<test::hash,
+        boost::unordered::power_of_two_buckets> power_of_two_hash;
+    typedef boost::unordered::hash_with_bucket_policy<test::hash,
+        boost::unordered::fast_range_buckets> fast_range_hash;
+}
+
+namespace bucket_policy_tests
+{
+
+test::seed_t initialize_seed(53106);
+
+bool is_power_of_two(std::size_t n)
+{
+    return n && !(n & (n - 1));
+}
+
+bool is_prime(std::size_t n)
+{
+    if (n < 2) return false;
+    for (std::size_t i = 2; i * i <= n; ++i)
+        if (n % i == 0) return false;
+    return true;
+}
+
+bool check_bucket_count(std::size_t n, prime_hash const*)
+{
+    return is_prime(n);
+}
+
+bool check_bucket_count(std::size_t n, power_of_two_hash const*)
+{
+    return is_power_of_two(n);
+}
+
+bool check_bucket_count(std::size_t n, fast_range_hash const*)
+{
+    return is_prime(n);
+}
+
+// Check that every element is in the bucket that 'bucket' returns, and
+// that the buckets are in range.
+template <class X>
+void check_buckets(X const& x)
+{
+    BOOST_TEST(check_bucket_count(x.bucket_count(),
+        (typename X::hasher const*) 0));
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i != x.bucket_count(); ++i) {
+        for (typename X::const_local_iterator it = x.begin(i);
+                it != x.end(i); ++it, ++count)
+        {
+            BOOST_TEST(x.bucket(test::get_key<X>(*it)) == i);
+        }
+    }
+    BOOST_TEST(count == x.size());
+}
+
+template <class X>
+void bucket_policy_test(X*, test::random_generator generator)
+{
+    test::check_instances check_;
+
+    test::random_values<X> v(1000, generator);
+    test::ordered<X> tracker;
+    tracker.insert_range(v.begin(), v.end());
+
+    X x(v.begin(), v.end());
+    tracker.compare(x);
+    check_buckets(x);
+
+    x.rehash(10000);
+    BOOST_TEST(x.bucket_count() >= 10000);
+    tracker.compare(x);
+    check_buckets(x);
+
+    x.max_load_factor(4.0);
+    x.rehash(0);
+    tracker.compare(x);
+    check_buckets(x);
+
+    for (typename test::random_values<X>::iterator it = v.begin();
+            it != v.end(); ++it)
+    {
+        BOOST_TEST(x.count(test::get_key<X>(*it)) ==
+            tracker.count(test::get_key<X>(*it)));
+    }
+
+    int i = 0;
+    for (typename test::random_values<X>::iterator it = v.begin();
+            it != v.end(); ++it, ++i)
+    {
+        if (i % 2) {
+            BOOST_TEST(x.erase(test::get_key<X>(*it)) ==
+                tracker.erase(test::get_key<X>(*it)));
+        }
+    }
+    tracker.compare(x);
+    check_buckets(x);
+}
+
+// The multiply and shift should give the high word of the double width
+// product on any platform.
+UNORDERED_AUTO_TEST(fast_range_tests)
+{
+    typedef boost::unordered::detail::fast_range_impl<0> portable;
+
+    std::size_t const max = (std::numeric_limits<std::size_t>::max)();
+    std::size_t const values[] = { 0, 1, 2, 3, 97, 12289, 1610612741u,
+        max / 3, max / 2, max / 2 + 1, max - 1, max };
+    std::size_t const count = sizeof(values) / sizeof(values[0]);
+
+    for (std::size_t i = 0; i != count; ++i) {
+        for (std::size_t j = 0; j != count; ++j) {
+            std::size_t r = boost::unordered::detail::fast_range::apply(
+                values[i], values[j]);
+            BOOST_TEST(r == portable::apply(values[i], values[j]));
+            BOOST_TEST(!values[j] || r < values[j]);
+        }
+    }
+
+    BOOST_TEST(portable::apply(max, max) == max - 1);
+    BOOST_TEST(portable::apply(max / 2 + 1, 10) == 5);
+}
+
+boost::unordered_set<test::object, prime_hash, test::equal_to,
+    test::allocator1<test::object> >* test_set_prime;
+boost::unordered_multiset<test::object, power_of_two_hash, test::equal_to,
+    test::allocator2<test::object> >* test_multiset_power_of_two;
+boost::unordered_map<test::object, test::object, fast_range_hash,
+    test::equal_to, test::allocator2<test::object> >* test_map_fast_range;
+boost::unordered_multimap<test::object, test::object, power_of_two_hash,
+    test::equal_to, test::allocator1<test::object> >*
+    test_multimap_power_of_two;
+boost::unordered_set<test::object, fast_range_hash, test::equal_to,
+    test::allocator1<test::object> >* test_set_fast_range;
+boost::unordered_multimap<test::object, test::object, fast_range_hash,
+    test::equal_to, test::allocator1<test::object> >*
+    test_multimap_fast_range;
+boost::unordered_map<test::object, test::object, power_of_two_hash,
+    test::equal_to, test::allocator1<test::object> >*
+    test_map_power_of_two;
+
+using test::default_generator;
+using test::generate_collisions;
+
+UNORDERED_TEST(bucket_policy_test,
+    ((test_set_prime)(test_multiset_power_of_two)(test_map_fast_range)
+        (test_multimap_power_of_two)(test_set_fast_range)
+        (test_multimap_fast_range)(test_map_power_of_two))
+    ((default_generator)(generate_collisions))
+)
+
+}
+
+RUN_TESTS()
@@ -0,0 +1,177 @@
+// Copyright 2012 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "../helpers/prefix.hpp"
+#include <boost/unordered/concurrent_map.hpp>
+#include <boost/unordered_map.hpp>
+#include "../helpers/postfix.hpp"
+
+#include "../helpers/test.hpp"
+#include "../objects/test.hpp"
+#include "../helpers/random_values.hpp"
+#include <boost/detail/lightweight_thread.hpp>
+#include <boost/bind.hpp>
+#include <vector>
+
+namespace concurrent_map_tests
+{
+
+test::seed_t initialize_seed(48214);
+
+template <class T>
+struct assign_to
+{
+    T* target;
+    explicit assign_to(T* t) : target(t) {}
+
+    template <class Value>
+    void operator()(Value const& x) const { *target = x.second; }
+};
+
+struct increment
+{
+    template <class Value>
+    void operator()(Value& x) const { ++x.second; }
+};
+
+struct is_odd
+{
+    template <class Value>
+    bool operator()(Value const& x) const { return x.first % 2 != 0; }
+};
+
+struct sum_values
+{
+    long* total;
+    explicit sum_values(long* t) : total(t) {}
+
+    template <class Value>
+    void operator()(Value const& x) const { *total += x.second; }
+};
+
+UNORDERED_AUTO_TEST(concurrent_map_basic_tests)
+{
+    boost::unordered::concurrent_map<int, int> x;
+
+    BOOST_TEST(x.empty());
+    BOOST_TEST(x.insert(std::make_pair(1, 10)));
+    BOOST_TEST(!x.insert(std::make_pair(1, 20)));
+    BOOST_TEST(x.insert(std::make_pair(2, 20)));
+    BOOST_TEST(x.size() == 2);
+    BOOST_TEST(x.count(1) == 1);
+    BOOST_TEST(x.count(3) == 0);
+
+    int value = 0;
+    BOOST_TEST(x.cvisit(1, assign_to<int>(&value)) == 1);
+    BOOST_TEST(value == 10);
+    BOOST_TEST(x.cvisit(3, assign_to<int>(&value)) == 0);
+
+    BOOST_TEST(x.visit(1, increment()) == 1);
+    BOOST_TEST(!x.insert_or_visit(std::make_pair(1, 0), increment()));
+    BOOST_TEST(x.insert_or_visit(std::make_pair(3, 30), increment()));
+    x.cvisit(1, assign_to<int>(&value));
+    BOOST_TEST(value == 12);
+
+    BOOST_TEST(!x.insert_or_assign(2, 21));
+    BOOST_TEST(x.insert_or_assign(4, 40));
+    x.cvisit(2, assign_to<int>(&value));
+    BOOST_TEST(value == 21);
+
+    long total = 0;
+    BOOST_TEST(x.cvisit_all(sum_values(&total)) == 4);
+    BOOST_TEST(total == 12 + 21 + 30 + 40);
+
+    BOOST_TEST(x.erase(4) == 1);
+    BOOST_TEST(x.erase(4) == 0);
+    BOOST_TEST(x.erase_if(2, is_odd()) == 0);
+    BOOST_TEST(x.erase_if(3, is_odd()) == 1);
+    BOOST_TEST(x.size() == 2);
+
+    x.clear();
+    BOOST_TEST(x.empty());
+    BOOST_TEST(x.size() == 0);
+}
+
+UNORDERED_AUTO_TEST(concurrent_map_random_tests)
+{
+    typedef boost::unordered::concurrent_map<test::object, test::object,
+        test::hash, test::equal_to,
+        test::allocator1<std::pair<test::object const, test::object> > >
+        concurrent;
+    typedef boost::unordered_map<test::object, test::object,
+        test::hash, test::equal_to,
+        test::allocator1<std::pair<test::object const, test::object> > >
+        reference;
+
+    test::check_instances check_;
+
+    test::random_values<reference> v(1000, test::generate_collisions);
+    concurrent x(v.begin(), v.end());
+    reference y(v.begin(), v.end());
+
+    BOOST_TEST(x.size() == y.size());
+
+    for (test::random_values<reference>::iterator it = v.begin();
+            it != v.end(); ++it)
+    {
+        BOOST_TEST(x.count(it->first) == y.count(it->first));
+    }
+
+    x.rehash(5000);
+    BOOST_TEST(x.bucket_count() >= 5000);
+    BOOST_TEST(x.size() == y.size());
+
+    for (test::random_values<reference>::iterator it = v.begin();
+            it != v.end(); ++it)
+    {
+        BOOST_TEST(x.erase(it->first) == y.erase(it->first));
+    }
+
+    BOOST_TEST(x.empty());
+}
+
+struct insert_range
+{
+    boost::unordered::concurrent_map<int, long>* map;
+    int first, last;
+
+    void operator()() const
+    {
+        for (int i = first; i != last; ++i) {
+            map->insert(std::make_pair(i, 1l));
+            map->insert_or_visit(std::make_pair(-1 - i % 16, 1l), increment());
+        }
+    }
+};
+
+UNORDERED_AUTO_TEST(concurrent_map_thread_tests)
+{
+    boost::unordered::concurrent_map<int, long> x;
+
+    const int thread_count = 8;
+    const int items_per_thread = 20000;
+
+    std::vector<pthread_t> threads(thread_count);
+    for (int i = 0; i != thread_count; ++i) {
+        insert_range f = { &x, i * items_per_thread,
+            (i + 1) * items_per_thread };
+        boost::detail::lw_thread_create(threads[i], f);
+    }
+
+    for (int i = 0; i != thread_count; ++i)
+        pthread_join(threads[i], 0);
+
+    BOOST_TEST(x.size() == thread_count * items_per_thread + 16);
+
+    long total = 0;
+    x.cvisit_all(sum_values(&total));
+    BOOST_TEST(total == 2l * thread_count * items_per_thread);
+
+    BOOST_TEST(x.erase_if(is_odd()) ==
+        static_cast<std::size_t>(thread_count * items_per_thread / 2 + 8));
+}
+
+}
+
+RUN_TESTS()
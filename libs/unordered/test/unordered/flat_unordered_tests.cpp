@@ -0,0 +1,212 @@
+
+// Copyright 2012 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "../helpers/prefix.hpp"
+#include <boost/unordered/flat_unordered_map.hpp>
+#include <boost/unordered/flat_unordered_set.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+#include "../helpers/postfix.hpp"
+
+#include "../helpers/test.hpp"
+#include "../objects/test.hpp"
+#include "../helpers/random_values.hpp"
+#include "../helpers/helpers.hpp"
+#include <string>
+
+namespace flat_unordered_tests
+{
+
+test::seed_t initialize_seed(72419);
+
+UNORDERED_AUTO_TEST(flat_map_basic_tests)
+{
+    boost::unordered::flat_unordered_map<int, std::string> x;
+
+    BOOST_TEST(x.empty());
+    BOOST_TEST(x.begin() == x.end());
+    BOOST_TEST(x.find(1) == x.end());
+    BOOST_TEST(x.erase(1) == 0);
+
+    BOOST_TEST(x.insert(std::make_pair(1, std::string("one"))).second);
+    BOOST_TEST(!x.insert(std::make_pair(1, std::string("uno"))).second);
+    x[2] = "two";
+    BOOST_TEST(x.size() == 2);
+    BOOST_TEST(x.at(1) == "one");
+    BOOST_TEST(x[2] == "two");
+    BOOST_TEST(x.count(3) == 0);
+
+    bool caught = false;
+    try { x.at(3); }
+    catch (std::out_of_range&) { caught = true; }
+    BOOST_TEST(caught);
+
+    BOOST_TEST(x.equal_range(1).first == x.find(1));
+    BOOST_TEST(std::distance(x.equal_range(1).first,
+        x.equal_range(1).second) == 1);
+    BOOST_TEST(x.equal_range(3).first == x.end());
+
+    BOOST_TEST(x.erase(1) == 1);
+    BOOST_TEST(x.size() == 1);
+    BOOST_TEST(x.find(1) == x.end());
+    BOOST_TEST(x.find(2)->second == "two");
+
+    x.clear();
+    BOOST_TEST(x.empty());
+    BOOST_TEST(x.begin() == x.end());
+}
+
+UNORDERED_AUTO_TEST(flat_set_basic_tests)
+{
+    boost::unordered::flat_unordered_set<std::string> x;
+
+    BOOST_TEST(x.insert("a").second);
+    BOOST_TEST(x.insert("b").second);
+    BOOST_TEST(!x.insert("a").second);
+    BOOST_TEST(x.size() == 2);
+    BOOST_TEST(*x.find("b") == "b");
+
+    boost::unordered::flat_unordered_set<std::string>::iterator
+        it = x.erase(x.find("a"));
+    BOOST_TEST(x.size() == 1);
+    BOOST_TEST(it == x.end() || *it == "b");
+    BOOST_TEST(x.count("a") == 0);
+    BOOST_TEST(x.erase(x.begin(), x.end()) == x.end());
+    BOOST_TEST(x.empty());
+}
+
+template <class X, class Y>
+void compare_containers(X const& x, Y const& y)
+{
+    BOOST_TEST(x.size() == y.size());
+    BOOST_TEST(static_cast<std::size_t>(
+        std::distance(x.begin(), x.end())) == x.size());
+    BOOST_TEST(x.load_factor() <= x.max_load_factor());
+
+    for (typename Y::const_iterator it = y.begin(); it != y.end(); ++it) {
+        typename X::const_iterator pos = x.find(test::get_key<Y>(*it));
+        BOOST_TEST(pos != x.end() && *pos == *it);
+    }
+}
+
+template <class X, class Y>
+void random_tests(X*, Y*, test::random_generator generator)
+{
+    test::check_instances check_;
+
+    test::random_values<Y> v(1000, generator);
+    X x(v.begin(), v.end());
+    Y y(v.begin(), v.end());
+    compare_containers(x, y);
+
+    X x2(x);
+    compare_containers(x2, y);
+    BOOST_TEST(x2 == x);
+
+    x.rehash(5000);
+    BOOST_TEST(x.bucket_count() >= 5000);
+    compare_containers(x, y);
+
+    // Erase half the elements, checking the others can still be found.
+    int i = 0;
+    for (typename test::random_values<Y>::iterator it = v.begin();
+            it != v.end(); ++it, ++i)
+    {
+        if (i % 2) {
+            BOOST_TEST(x.erase(test::get_key<Y>(*it)) ==
+                y.erase(test::get_key<Y>(*it)));
+        }
+    }
+    compare_containers(x, y);
+
+    x.swap(x2);
+    compare_containers(x2, y);
+    x2 = x;
+    BOOST_TEST(x2 == x);
+
+    x.clear();
+    BOOST_TEST(x.empty());
+    x.insert(v.begin(), v.end());
+    y.insert(v.begin(), v.end());
+    compare_containers(x, y);
+}
+
+boost::unordered::flat_unordered_map<test::object, test::object,
+    test::hash, test::equal_to,
+    test::allocator1<std::pair<test::object const, test::object> > >*
+    test_map;
+boost::unordered_map<test::object, test::object,
+    test::hash, test::equal_to,
+    test::allocator1<std::pair<test::object const, test::object> > >*
+    reference_map;
+boost::unordered::flat_unordered_set<test::object,
+    test::hash, test::equal_to,
+    test::allocator2<test::object> >* test_set;
+boost::unordered_set<test::object,
+    test::hash, test::equal_to,
+    test::allocator2<test::object> >* reference_set;
+
+using test::default_generator;
+using test::generate_collisions;
+
+UNORDERED_AUTO_TEST(flat_map_random_tests)
+{
+    random_tests(test_map, reference_map, default_generator);
+    random_tests(test_map, reference_map, generate_collisions);
+}
+
+UNORDERED_AUTO_TEST(flat_set_random_tests)
+{
+    random_tests(test_set, reference_set, default_generator);
+    random_tests(test_set, reference_set, generate_collisions);
+}
+
+// Repeatedly insert and erase, so that the table fills up with deleted
+// slots, which have to be reused or cleared by a rehash.
+
+UNORDERED_AUTO_TEST(flat_map_churn_tests)
+{
+    boost::unordered::flat_unordered_map<int, int> x;
+    boost::unordered_map<int, int> y;
+
+    x.reserve(100);
+    std::size_t bucket_count = x.bucket_count();
+
+    for (int i = 0; i < 100000; ++i) {
+        x[i] = i;
+        y[i] = i;
+        if (i >= 50) {
+            BOOST_TEST(x.erase(i - 50) == 1);
+            y.erase(i - 50);
+        }
+    }
+
+    BOOST_TEST(x.bucket_count() == bucket_count);
+    compare_containers(x, y);
+
+    for (int i = 0; i < 100000 - 50; ++i) BOOST_TEST(!x.count(i));
+}
+
+UNORDERED_AUTO_TEST(flat_map_iterator_erase_tests)
+{
+    boost::unordered::flat_unordered_map<int, int> x;
+    for (int i = 0; i < 1000; ++i) x[i] = i;
+
+    std::size_t count = 0;
+    for (boost::unordered::flat_unordered_map<int, int>::iterator
+            it = x.begin(); it != x.end();)
+    {
+        if (it->first % 3) it = x.erase(it);
+        else { ++it; ++count; }
+    }
+
+    BOOST_TEST(x.size() == count);
+    BOOST_TEST(count == 334);
+    for (int i = 0; i < 1000; ++i) BOOST_TEST(x.count(i) == (i % 3 ? 0u : 1u));
+}
+
+}
+
+RUN_TESTS()